@@ -40,6 +40,7 @@
 #include <string>
 #include "TAppDecCfg.h"
 #include "TAppCommon/program_options_lite.h"
+#include "TLibCommon/TComSimd.h"
 #if RExt__COLOUR_SPACE_CONVERSIONS
 #include "TLibCommon/TComChromaFormat.h"
 #endif
@@ -66,6 +67,7 @@ Bool TAppDecCfg::parseCfg( Int argc, Char* argv[] )
   string cfg_BitstreamFile;
   string cfg_ReconFile;
   string cfg_TargetDecLayerIdSetFile;
+  string cfg_SimdLevel;
 #if RExt__COLOUR_SPACE_CONVERSIONS
   string outputColourSpaceConvert;
 #endif
@@ -94,6 +96,11 @@ Bool TAppDecCfg::parseCfg( Int argc, Char* argv[] )
 #endif
   ("TarDecLayerIdSetFile,l", cfg_TargetDecLayerIdSetFile, string(""), "targetDecLayerIdSet file name. The file should include white space separated LayerId values to be decoded. Omitting the option or a value of -1 in the file decodes all layers.")
   ("RespectDefDispWindow,w", m_respectDefDispWindow, 0, "Only output content inside the default display window\n")
+  ("Threads", m_iNumThreads, 1, "Number of decoder threads (0 or 1: single-threaded); used for wavefront CTU rows, tiles and slices, the output does not depend on it")
+  ("ParallelFrames", m_iNumParallelFrames, 1, "Number of pictures that may be decoded at the same time (with Threads > 1)")
+  ("PipelineCTUs", m_bPipelineCTUs, true, "Parse and reconstruct the CTUs with different threads when a picture has fewer tiles and slices than threads")
+  ("LazyBorderExtension", m_bLazyBorderExtension, false, "Extend the border of a reference picture when it is first used for prediction instead of row by row after its filtering (not with ParallelFrames > 1)")
+  ("SIMD", cfg_SimdLevel, string(""), "SIMD kernels: auto, avx2, sse41 or scalar (default: HM_SIMD environment variable, else auto); the output does not depend on it")
   ;
 
   po::setDefaults(opts);
@@ -129,6 +136,25 @@ Bool TAppDecCfg::parseCfg( Int argc, Char* argv[] )
     return false;
   }
 
+  if (m_iNumThreads < 0)
+  {
+    fprintf(stderr, "Number of threads cannot be negative, aborting\n");
+    return false;
+  }
+
+  if (m_iNumParallelFrames < 1)
+  {
+    fprintf(stderr, "Number of parallel frames must be positive, aborting\n");
+    return false;
+  }
+
+  // select the kernels before the decoding tools are created
+  if (!TComSimd::setLevel(cfg_SimdLevel))
+  {
+    fprintf(stderr, "Bad SIMD level \"%s\", aborting\n", cfg_SimdLevel.c_str());
+    return false;
+  }
+
   if ( !cfg_TargetDecLayerIdSetFile.empty() )
   {
     FILE* targetDecLayerIdSetFile = fopen ( cfg_TargetDecLayerIdSetFile.c_str(), "r" );
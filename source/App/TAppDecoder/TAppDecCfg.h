@@ -71,6 +71,10 @@ protected:
 #endif
   std::vector<Int> m_targetDecLayerIdSet;             ///< set of LayerIds to be included in the sub-bitstream extraction process.
   Int           m_respectDefDispWindow;               ///< Only output content inside the default display window 
+  Int           m_iNumThreads;                        ///< number of decoder threads (0 or 1: single-threaded)
+  Int           m_iNumParallelFrames;                 ///< number of pictures that may be decoded at the same time
+  Bool          m_bPipelineCTUs;                      ///< parse and reconstruct the CTUs with different threads
+  Bool          m_bLazyBorderExtension;               ///< extend the picture border when the picture is first referenced
   
 public:
   TAppDecCfg()
@@ -86,6 +90,10 @@ public:
   , m_decodedNoDisplaySEIEnabled(false)
 #endif
   , m_respectDefDispWindow(0)
+  , m_iNumThreads(1)
+  , m_iNumParallelFrames(1)
+  , m_bPipelineCTUs(true)
+  , m_bLazyBorderExtension(false)
   {
     for (UInt channelTypeIndex = 0; channelTypeIndex < MAX_NUM_CHANNEL_TYPE; channelTypeIndex++)
       m_outputBitDepth[channelTypeIndex] = 0;
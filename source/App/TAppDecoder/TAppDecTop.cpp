@@ -112,7 +112,7 @@ Void TAppDecTop::decode()
   // main decoder loop
   Bool openedReconFile = false; // reconstruction file not yet opened. (must be performed after SPS is seen)
 
-  while (!!bitstreamFile)
+  while (!bytestream.eof())
   {
     /* location serves to work around a design fault in the decoder, whereby
      * the process of reading a new slice that is the first slice of a new frame
@@ -120,10 +120,8 @@ Void TAppDecTop::decode()
      * nal unit. */
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
     TComCodingStatistics::TComCodingStatisticsData backupStats(TComCodingStatistics::GetStatistics());
-    streampos location = bitstreamFile.tellg() - streampos(bytestream.GetNumBufferedBytes());
-#else
-    streampos location = bitstreamFile.tellg();
 #endif
+    streamoff location = bytestream.getPosition();
     AnnexBStats stats = AnnexBStats();
 
     vector<uint8_t> nalUnit;
@@ -153,25 +151,26 @@ Void TAppDecTop::decode()
         bNewPicture = m_cTDecTop.decode(nalu, m_iSkipFrame, m_iPOCLastDisplay);
         if (bNewPicture)
         {
-          bitstreamFile.clear();
-          /* location points to the current nalunit payload[1] due to the
-           * need for the annexB parser to read three extra bytes.
-           * [1] except for the first NAL unit in the file
-           *     (but bNewPicture doesn't happen then) */
+          /* location is the start of the current nal unit, which is usually
+           * still buffered by the annexB parser */
+          bytestream.setPosition(location);
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-          bitstreamFile.seekg(location);
-          bytestream.reset();
           TComCodingStatistics::SetStatistics(backupStats);
-#else
-          bitstreamFile.seekg(location-streamoff(3));
-          bytestream.reset();
 #endif
         }
       }
     }
-    if (bNewPicture || !bitstreamFile)
+    // the output is flushed at an IDR or BLA picture
+    const Bool bFlushOutput = bNewPicture &&
+                              (   nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_W_RADL
+                               || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_N_LP
+                               || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_BLA_N_LP
+                               || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_BLA_W_RADL
+                               || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_BLA_W_LP );
+
+    if (bNewPicture || bytestream.eof())
     {
-      m_cTDecTop.executeLoopFilters(poc, pcListPic);
+      m_cTDecTop.executeLoopFilters(poc, pcListPic, bFlushOutput || bytestream.eof());
     }
 
     if( pcListPic )
@@ -186,12 +185,7 @@ Void TAppDecTop::decode()
         m_cTVideoIOYuvReconFile.open( m_pchReconFile, true, m_outputBitDepth, g_bitDepth ); // write mode
         openedReconFile = true;
       }
-      if ( bNewPicture && 
-           (   nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_W_RADL
-            || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_N_LP
-            || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_BLA_N_LP
-            || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_BLA_W_RADL
-            || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_BLA_W_LP ) )
+      if ( bFlushOutput )
       {
         xFlushOutput( pcListPic );
       }
@@ -218,6 +212,10 @@ Void TAppDecTop::decode()
 Void TAppDecTop::xCreateDecLib()
 {
   // create decoder class
+  m_cTDecTop.setNumThreads( m_iNumThreads );
+  m_cTDecTop.setNumParallelFrames( m_iNumParallelFrames );
+  m_cTDecTop.setPipelineCTUs( m_bPipelineCTUs );
+  m_cTDecTop.setLazyBorderExtension( m_bLazyBorderExtension );
   m_cTDecTop.create();
 }
 
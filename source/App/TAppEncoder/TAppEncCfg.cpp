@@ -40,6 +40,7 @@
 #include <cstring>
 #include <string>
 #include "TLibCommon/TComRom.h"
+#include "TLibCommon/TComSimd.h"
 #include "TAppEncCfg.h"
 #include "TAppCommon/program_options_lite.h"
 #include "TLibEncoder/TEncRateCtrl.h"
@@ -309,6 +310,7 @@ Bool TAppEncCfg::parseCfg( Int argc, Char* argv[] )
   string cfg_ReconFile;
   string cfg_dQPFile;
   string cfg_ColumnWidth;
+  string cfg_SimdLevel;
   string cfg_RowHeight;
   string cfg_ScalingListFile;
   string cfg_startOfCodedInterval;
@@ -500,6 +502,9 @@ Bool TAppEncCfg::parseCfg( Int argc, Char* argv[] )
   ("RowHeightArray",              cfg_RowHeight,                   string(""), "Array containing RowHeight values in units of LCU")
   ("LFCrossTileBoundaryFlag",      m_bLFCrossTileBoundaryFlag,             true,          "1: cross-tile-boundary loop filtering. 0:non-cross-tile-boundary loop filtering")
   ("WaveFrontSynchro",            m_iWaveFrontSynchro,             0,          "0: no synchro; 1 synchro with TR; 2 TRR etc")
+  ("Threads",                     m_iNumThreads,                   1,          "Number of encoder threads (0 or 1: single-threaded); used for wavefront CTU rows, tiles and SAO, the bitstream does not depend on it")
+  ("ParallelFrames",              m_iNumParallelFrames,            1,          "Number of pictures of a GOP that may be compressed at the same time; only pictures that do not reference each other are compressed together, so it has no effect on low-delay GOPs; the bitstream does not depend on it")
+  ("SIMD",                        cfg_SimdLevel,                   string(""), "SIMD kernels: auto, avx2, sse41 or scalar (default: HM_SIMD environment variable, else auto); the bitstream does not depend on it")
   ("ScalingList",                 m_useScalingListId,              0,          "0: no scaling list, 1: default scaling lists, 2: scaling lists specified in ScalingListFile")
   ("ScalingListFile",             cfg_ScalingListFile,             string(""), "Scaling list file name")
   ("SignHideFlag,-SBH",                m_signHideFlag, 1)
@@ -661,6 +666,13 @@ Bool TAppEncCfg::parseCfg( Int argc, Char* argv[] )
     po::doHelp(cout, opts);
     return false;
   }
+
+  // select the kernels before the coding tools are created
+  if ( !TComSimd::setLevel( cfg_SimdLevel ) )
+  {
+    fprintf(stderr, "Bad SIMD level \"%s\"\n", cfg_SimdLevel.c_str());
+    return false;
+  }
   
   /*
    * Set any derived parameters
@@ -1490,6 +1502,19 @@ Void TAppEncCfg::xCheckParameter()
   xConfirmPara( m_iWaveFrontSynchro < 0, "WaveFrontSynchro cannot be negative" );
   xConfirmPara( m_iWaveFrontSubstreams <= 0, "WaveFrontSubstreams must be positive" );
   xConfirmPara( m_iWaveFrontSubstreams > 1 && !m_iWaveFrontSynchro, "Must have WaveFrontSynchro > 0 in order to have WaveFrontSubstreams > 1" );
+  xConfirmPara( m_iNumThreads < 0, "Threads cannot be negative" );
+  xConfirmPara( m_iNumParallelFrames < 1, "ParallelFrames must be positive" );
+  if ( m_iNumParallelFrames > 1 )
+  {
+    xConfirmPara( !m_bUseSBACRD,             "ParallelFrames > 1 requires SBACRD" );
+    xConfirmPara( m_RCEnableRateControl,     "ParallelFrames > 1 is not supported with rate control" );
+    xConfirmPara( m_uiDeltaQpRD > 0,         "ParallelFrames > 1 is not supported with DeltaQpRD" );
+    xConfirmPara( m_sliceSegmentMode != 0,   "ParallelFrames > 1 is not supported with slice segments" );
+    xConfirmPara( m_useWeightedPred || m_useWeightedBiPred, "ParallelFrames > 1 is not supported with weighted prediction" );
+#if ADAPTIVE_QP_SELECTION
+    xConfirmPara( m_bUseAdaptQpSelect,       "ParallelFrames > 1 is not supported with AdaptiveQpSelection" );
+#endif
+  }
 
   xConfirmPara( m_decodedPictureHashSEIEnabled<0 || m_decodedPictureHashSEIEnabled>3, "this hash type is not correct!\n");
 
@@ -1734,6 +1759,7 @@ Void TAppEncCfg::xPrintParameter()
   printf("PME:%d ", m_log2ParallelMergeLevel);
   printf(" WaveFrontSynchro:%d WaveFrontSubstreams:%d",
           m_iWaveFrontSynchro, m_iWaveFrontSubstreams);
+  printf(" Threads:%d ParallelFrames:%d SIMD:%s", m_iNumThreads, m_iNumParallelFrames, TComSimd::getLevelName( TComSimd::getLevel() ) );
   printf(" ScalingList:%d ", m_useScalingListId );
   printf("TMVPMode:%d ", m_TMVPModeId     );
 #if ADAPTIVE_QP_SELECTION
@@ -228,6 +228,8 @@ protected:
   Int       m_iWaveFrontSynchro; //< 0: no WPP. >= 1: WPP is enabled, the "Top right" from which inheritance occurs is this LCU offset in the line above the current.
   Int       m_iWaveFrontFlush; //< enable(1)/disable(0) the CABAC flush at the end of each line of LCUs.
   Int       m_iWaveFrontSubstreams; //< If iWaveFrontSynchro, this is the number of substreams per frame (dependent tiles) or per tile (independent tiles).
+  Int       m_iNumThreads;          //< number of encoder threads (0 or 1: single-threaded)
+  Int       m_iNumParallelFrames;   //< number of pictures of a GOP that may be compressed at the same time
 
   Bool      m_bUseConstrainedIntraPred;                       ///< flag for using constrained intra prediction
   
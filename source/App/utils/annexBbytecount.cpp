@@ -124,7 +124,7 @@ int main(int argc, char*argv[])
   unsigned numNALUnits = 0;
 
   cout << "NALUnits:" << endl;
-  while (!!in)
+  while (!bs.eof())
   {
     AnnexBStats annexBStatsSingle = AnnexBStats();
     vector<uint8_t> nalUnit;
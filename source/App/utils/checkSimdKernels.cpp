@@ -0,0 +1,445 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2013, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     checkSimdKernels.cpp
+    \brief    check that the SIMD kernels give the same results as the C++ kernels
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+#include "TLibCommon/TComRom.h"
+#include "TLibCommon/TComSimd.h"
+#include "TLibCommon/TComTrQuant.h"
+#include "TLibCommon/TComRdCost.h"
+#include "TLibCommon/TComPattern.h"
+#include "TLibCommon/TComInterpolationFilter.h"
+#include "TLibCommon/TComChromaFormat.h"
+
+// transforms of TComTrQuant.cpp, which picks the kernels of the SIMD level
+#if RExt__N0188_EXTENDED_PRECISION_PROCESSING
+void xTrMxN (Int bitDepth, TCoeff *block, TCoeff *coeff, Int iWidth, Int iHeight, Bool useDST, const Int maxTrDynamicRange);
+void xITrMxN(Int bitDepth, TCoeff *coeff, TCoeff *block, Int iWidth, Int iHeight, Bool useDST, const Int maxTrDynamicRange);
+#else
+void xTrMxN (Int bitDepth, TCoeff *block, TCoeff *coeff, Int iWidth, Int iHeight, Bool useDST);
+void xITrMxN(Int bitDepth, TCoeff *coeff, TCoeff *block, Int iWidth, Int iHeight, Bool useDST);
+#endif
+
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+static const Int MAX_CHECKED_BIT_DEPTH = 16;
+#else
+static const Int MAX_CHECKED_BIT_DEPTH = 12;
+#endif
+
+static const Int MAX_REPORTED_MISMATCHES = 10;
+
+// distortion blocks: room for a horizontal offset and, in the current block, for the row step of the motion search
+static const Int DIST_STRIDE   = MAX_CU_SIZE + 16;
+static const Int DIST_MAX_STEP = 4;
+
+// interpolation blocks: room for the filter taps around the block
+static const Int IF_STRIDE     = MAX_CU_SIZE + 16;
+static const Int IF_MARGIN     = NTAPS_LUMA;
+
+static UInt g_uiRandomState = 1;
+static UInt g_uiReportedMismatches = 0;
+
+/** xorshift generator, so that a seed gives the same blocks on every platform
+ */
+static UInt xRandom()
+{
+  g_uiRandomState ^= g_uiRandomState << 13;
+  g_uiRandomState ^= g_uiRandomState >> 17;
+  g_uiRandomState ^= g_uiRandomState << 5;
+  return g_uiRandomState;
+}
+
+static Int xRandomRange( Int iMin, Int iMax )
+{
+  return iMin + Int( xRandom() % UInt( iMax - iMin + 1 ) );
+}
+
+/** Fill a block with values of [iMin, iMax]: uniform, saturated (to exercise the clipping), sparse (as quantised
+ *  coefficients) or small.
+ */
+static Void xFillBlock( TCoeff* piBlock, Int iNumSamples, Int iMin, Int iMax )
+{
+  const Int iMode = xRandomRange( 0, 3 );
+  for ( Int i = 0; i < iNumSamples; i++ )
+  {
+    switch ( iMode )
+    {
+      case 0:  piBlock[i] = xRandomRange( iMin, iMax );                                  break;
+      case 1:  piBlock[i] = ( xRandom() & 1 ) ? iMax : iMin;                             break;
+      case 2:  piBlock[i] = ( xRandom() % 8 ) == 0 ? xRandomRange( iMin, iMax ) : 0;    break;
+      default: piBlock[i] = xRandomRange( std::max( iMin, -16 ), std::min( iMax, 16 ) ); break;
+    }
+  }
+}
+
+/** Fill a block with samples of the bit depth: uniform, saturated or, when piReference is given, close to the
+ *  samples of piReference (as a prediction is to the original).
+ */
+static Void xFillSamples( Pel* piBlock, const Pel* piReference, Int iNumSamples, Int iBitDepth )
+{
+  const Int iMax  = ( 1 << iBitDepth ) - 1;
+  const Int iMode = xRandomRange( 0, piReference == NULL ? 1 : 2 );
+  for ( Int i = 0; i < iNumSamples; i++ )
+  {
+    switch ( iMode )
+    {
+      case 0:  piBlock[i] = Pel( xRandomRange( 0, iMax ) );                                       break;
+      case 1:  piBlock[i] = Pel( ( xRandom() & 1 ) ? iMax : 0 );                                  break;
+      default: piBlock[i] = Pel( Clip3( 0, iMax, piReference[i] + xRandomRange( -8, 8 ) ) );      break;
+    }
+  }
+}
+
+static Void xSetLevel( SimdLevel eLevel )
+{
+  TComSimd::setLevel( TComSimd::getLevelName( eLevel ) );
+}
+
+static Void xReportMismatch( const Char* pcKernel, SimdLevel eLevel, const Char* pcDetails )
+{
+  if ( g_uiReportedMismatches++ < MAX_REPORTED_MISMATCHES )
+  {
+    printf( "mismatch: %s %s, %s\n", pcKernel, TComSimd::getLevelName( eLevel ), pcDetails );
+  }
+}
+
+/** Check the forward and inverse transforms of every size, DCT and DST, against the C++ partial butterflies.
+ * \param iNumBlocks number of random blocks
+ * \returns number of mismatches
+ */
+static UInt xCheckTransforms( Int iNumBlocks )
+{
+  static const Int aiSizes[4] = { 4, 8, 16, 32 };
+  static TCoeff aiInput    [MAX_TU_SIZE * MAX_TU_SIZE];
+  static TCoeff aiReference[MAX_TU_SIZE * MAX_TU_SIZE];
+  static TCoeff aiOutput   [MAX_TU_SIZE * MAX_TU_SIZE];
+  UInt uiMismatches = 0;
+
+  for ( Int iBlock = 0; iBlock < iNumBlocks; iBlock++ )
+  {
+    const Int  iWidth    = aiSizes[xRandom() % 4];
+    const Int  iHeight   = aiSizes[xRandom() % 4];
+    const Bool bUseDST   = iWidth == 4 && iHeight == 4 && ( xRandom() & 1 );
+    const Bool bInverse  = ( xRandom() & 1 ) != 0;
+    const Int  iBitDepth = xRandomRange( 8, MAX_CHECKED_BIT_DEPTH );
+#if RExt__N0188_EXTENDED_PRECISION_PROCESSING
+    // extended precision processing raises the dynamic range with the bit depth, which moves the clipping bounds
+    const Int  iMaxTrDynamicRange = ( xRandom() & 1 ) ? std::max<Int>( 15, iBitDepth + 6 ) : 15;
+#else
+    const Int  iMaxTrDynamicRange = MAX_TR_DYNAMIC_RANGE;
+#endif
+    const Int  iNumSamples = iWidth * iHeight;
+
+    if ( bInverse )
+    {
+      xFillBlock( aiInput, iNumSamples, -( 1 << iMaxTrDynamicRange ), ( 1 << iMaxTrDynamicRange ) - 1 );
+    }
+    else
+    {
+      xFillBlock( aiInput, iNumSamples, -( ( 1 << iBitDepth ) - 1 ), ( 1 << iBitDepth ) - 1 );
+    }
+
+    for ( Int iLevel = SIMD_SCALAR; iLevel <= TComSimd::getCpuLevel(); iLevel++ )
+    {
+      xSetLevel( SimdLevel( iLevel ) );
+      TCoeff* piOutput = iLevel == SIMD_SCALAR ? aiReference : aiOutput;
+#if RExt__N0188_EXTENDED_PRECISION_PROCESSING
+      if ( bInverse ) xITrMxN( iBitDepth, aiInput, piOutput, iWidth, iHeight, bUseDST, iMaxTrDynamicRange );
+      else            xTrMxN ( iBitDepth, aiInput, piOutput, iWidth, iHeight, bUseDST, iMaxTrDynamicRange );
+#else
+      if ( bInverse ) xITrMxN( iBitDepth, aiInput, piOutput, iWidth, iHeight, bUseDST );
+      else            xTrMxN ( iBitDepth, aiInput, piOutput, iWidth, iHeight, bUseDST );
+#endif
+      if ( iLevel != SIMD_SCALAR && memcmp( aiReference, aiOutput, iNumSamples * sizeof( TCoeff ) ) != 0 )
+      {
+        Char acDetails[128];
+        sprintf( acDetails, "%dx%d %s, bit depth %d, dynamic range %d", iWidth, iHeight, bUseDST ? "DST" : "DCT", iBitDepth, iMaxTrDynamicRange );
+        xReportMismatch( bInverse ? "inverse transform" : "forward transform", SimdLevel( iLevel ), acDetails );
+        uiMismatches++;
+      }
+    }
+  }
+  return uiMismatches;
+}
+
+/** Check the SSE, SAD and Hadamard functions of TComRdCost against the C++ ones: the fixed and the AMP widths, any width,
+ * the row step and the subsampling of the motion search.
+ * \param iNumBlocks number of random blocks
+ * \returns number of mismatches
+ */
+static UInt xCheckDistortion( Int iNumBlocks )
+{
+  enum DistKind { DIST_SAD, DIST_SADS, DIST_HADS, DIST_SAD_ANY, DIST_HAD_ANY, DIST_SSE_ANY, NUM_DIST_KINDS };
+  static const Char* apcKindNames[NUM_DIST_KINDS] = { "SAD", "SAD with step", "Hadamard", "SAD of any size", "Hadamard of any even size", "SSE" };
+  static const Int   aiSizes[8] = { 4, 8, 12, 16, 24, 32, 48, 64 };
+  static Pel aiOrg[DIST_STRIDE * MAX_CU_SIZE];
+  static Pel aiCur[DIST_STRIDE * MAX_CU_SIZE * DIST_MAX_STEP];
+  TComRdCost* apcRdCost[SIMD_AVX2 + 1];
+  UInt uiMismatches = 0;
+
+  // the functions are picked when the class is initialised
+  for ( Int iLevel = SIMD_SCALAR; iLevel <= TComSimd::getCpuLevel(); iLevel++ )
+  {
+    xSetLevel( SimdLevel( iLevel ) );
+    apcRdCost[iLevel] = new TComRdCost;
+  }
+
+  for ( Int iBlock = 0; iBlock < iNumBlocks; iBlock++ )
+  {
+    const DistKind eKind     = DistKind( xRandom() % NUM_DIST_KINDS );
+    const Int      iBitDepth = xRandomRange( 8, MAX_CHECKED_BIT_DEPTH );
+    Int iWidth, iHeight;
+    Int iStep     = 1;
+    Int iSubShift = 0;
+
+    switch ( eKind )
+    {
+      case DIST_SAD:
+      case DIST_SADS:
+      case DIST_HADS:
+        iWidth  = aiSizes[xRandom() % 8];
+        iHeight = aiSizes[xRandom() % 8];
+        iStep     = eKind == DIST_SADS ? xRandomRange( 1, DIST_MAX_STEP ) : 1;
+        iSubShift = eKind == DIST_HADS ? 0 : xRandomRange( 0, 2 );
+        break;
+      case DIST_HAD_ANY:
+        iWidth  = 2 * xRandomRange( 1, MAX_CU_SIZE / 2 );
+        iHeight = 2 * xRandomRange( 1, MAX_CU_SIZE / 2 );
+        break;
+      default:
+        iWidth  = xRandomRange( 1, MAX_CU_SIZE );
+        iHeight = xRandomRange( 1, MAX_CU_SIZE );
+        break;
+    }
+
+    xFillSamples( aiOrg, NULL, DIST_STRIDE * iHeight, iBitDepth );
+    for ( Int y = 0; y < iHeight; y++ )
+    {
+      xFillSamples( aiCur + y * iStep * DIST_STRIDE, aiOrg + y * DIST_STRIDE, DIST_STRIDE, iBitDepth );
+    }
+    Pel* piOrg = aiOrg + xRandomRange( 0, DIST_STRIDE - MAX_CU_SIZE );
+    Pel* piCur = aiCur + xRandomRange( 0, DIST_STRIDE - MAX_CU_SIZE );
+
+    Distortion uiReference = 0;
+    for ( Int iLevel = SIMD_SCALAR; iLevel <= TComSimd::getCpuLevel(); iLevel++ )
+    {
+      TComRdCost& rcRdCost = *apcRdCost[iLevel];
+      TComPattern cPattern;
+      DistParam   cDtParam;
+      Distortion  uiDist;
+
+      cPattern.initPattern( piOrg, iWidth, iHeight, DIST_STRIDE );
+      cDtParam.bitDepth     = iBitDepth;
+      cDtParam.bApplyWeight = false;
+      cDtParam.compIdx      = COMPONENT_Y;
+
+      switch ( eKind )
+      {
+        case DIST_SAD:
+          rcRdCost.setDistParam( &cPattern, piCur, DIST_STRIDE, cDtParam );
+          cDtParam.iSubShift = iSubShift;
+          uiDist = cDtParam.DistFunc( &cDtParam );
+          break;
+        case DIST_SADS:
+        case DIST_HADS:
+#if NS_HAD
+          rcRdCost.setDistParam( &cPattern, piCur, DIST_STRIDE, iStep, cDtParam, eKind == DIST_HADS, false );
+#else
+          rcRdCost.setDistParam( &cPattern, piCur, DIST_STRIDE, iStep, cDtParam, eKind == DIST_HADS );
+#endif
+          cDtParam.iSubShift = iSubShift;
+          uiDist = cDtParam.DistFunc( &cDtParam );
+          break;
+        case DIST_SAD_ANY:
+          rcRdCost.setDistParam( iWidth, iHeight, DF_SAD, cDtParam );
+          cDtParam.pOrg       = piOrg;
+          cDtParam.pCur       = piCur;
+          cDtParam.iStrideOrg = DIST_STRIDE;
+          cDtParam.iStrideCur = DIST_STRIDE;
+          uiDist = cDtParam.DistFunc( &cDtParam );
+          break;
+        case DIST_HAD_ANY:
+          uiDist = rcRdCost.calcHAD( iBitDepth, piOrg, DIST_STRIDE, piCur, DIST_STRIDE, iWidth, iHeight );
+          break;
+        default:
+#if WEIGHTED_CHROMA_DISTORTION
+          uiDist = rcRdCost.getDistPart( iBitDepth, piCur, DIST_STRIDE, piOrg, DIST_STRIDE, iWidth, iHeight, COMPONENT_Y );
+#else
+          uiDist = rcRdCost.getDistPart( iBitDepth, piCur, DIST_STRIDE, piOrg, DIST_STRIDE, iWidth, iHeight );
+#endif
+          break;
+      }
+
+      if ( iLevel == SIMD_SCALAR )
+      {
+        uiReference = uiDist;
+      }
+      else if ( uiDist != uiReference )
+      {
+        Char acDetails[128];
+        sprintf( acDetails, "%dx%d, step %d, subsampling %d, bit depth %d", iWidth, iHeight, iStep, iSubShift, iBitDepth );
+        xReportMismatch( apcKindNames[eKind], SimdLevel( iLevel ), acDetails );
+        uiMismatches++;
+      }
+    }
+  }
+
+  for ( Int iLevel = SIMD_SCALAR; iLevel <= TComSimd::getCpuLevel(); iLevel++ )
+  {
+    delete apcRdCost[iLevel];
+  }
+  return uiMismatches;
+}
+
+/** Check the luma and chroma interpolation filters against the C++ ones: horizontal, vertical and two-stage as in
+ * TComPrediction::xPredInterBlk(), with the copy of the integer positions and with or without the final rounding.
+ * \param iNumBlocks number of random blocks
+ * \returns number of mismatches
+ */
+static UInt xCheckInterpolation( Int iNumBlocks )
+{
+  enum FilterKind { FILTER_HOR, FILTER_VER, FILTER_2D, NUM_FILTER_KINDS };
+  static const Char* apcKindNames[NUM_FILTER_KINDS] = { "horizontal filter", "vertical filter", "two-stage filter" };
+  static Pel aiSrc   [IF_STRIDE * ( MAX_CU_SIZE + 2 * IF_MARGIN )];
+  static Pel aiTmp[2][IF_STRIDE * ( MAX_CU_SIZE + IF_MARGIN )];
+  static Pel aiDst[2][IF_STRIDE * MAX_CU_SIZE];
+  TComInterpolationFilter cFilter;
+  UInt uiMismatches = 0;
+
+  for ( Int iBlock = 0; iBlock < iNumBlocks; iBlock++ )
+  {
+    const FilterKind   eKind     = FilterKind( xRandom() % NUM_FILTER_KINDS );
+    const ComponentID  compID    = ( xRandom() & 1 ) ? COMPONENT_Y : COMPONENT_Cb;
+    const ChromaFormat chFmt     = ChromaFormat( xRandomRange( CHROMA_420, CHROMA_444 ) );
+    const Int          iBitDepth = xRandomRange( 8, MAX_CHECKED_BIT_DEPTH );
+    const Int          iWidth    = xRandomRange( 1, MAX_CU_SIZE );
+    const Int          iHeight   = xRandomRange( 1, MAX_CU_SIZE );
+    const Bool         bIsLast   = ( xRandom() & 1 ) != 0; // false for bi-prediction
+    const Int          iTaps     = isLuma( compID ) ? NTAPS_LUMA : NTAPS_CHROMA;
+    const Int          iNumFracX = isLuma( compID ) ? LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS
+                                                    : CHROMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS >> ( 1 - getComponentScaleX( compID, chFmt ) );
+    const Int          iNumFracY = isLuma( compID ) ? LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS
+                                                    : CHROMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS >> ( 1 - getComponentScaleY( compID, chFmt ) );
+    // a fraction of 0 copies the samples
+    const Int          iFracX    = eKind == FILTER_VER ? 0 : xRandomRange( 0, iNumFracX - 1 );
+    const Int          iFracY    = eKind == FILTER_HOR ? 0 : xRandomRange( 0, iNumFracY - 1 );
+
+    g_bitDepth[toChannelType( compID )] = iBitDepth;
+    xFillSamples( aiSrc, NULL, IF_STRIDE * ( MAX_CU_SIZE + 2 * IF_MARGIN ), iBitDepth );
+    Pel* piSrc = aiSrc + IF_MARGIN * IF_STRIDE + IF_MARGIN / 2 + xRandomRange( 0, IF_STRIDE - MAX_CU_SIZE - IF_MARGIN );
+
+    for ( Int iLevel = SIMD_SCALAR; iLevel <= TComSimd::getCpuLevel(); iLevel++ )
+    {
+      const Int iOutput = iLevel == SIMD_SCALAR ? 0 : 1;
+      Pel* piTmp = aiTmp[iOutput];
+      Pel* piDst = aiDst[iOutput];
+
+      xSetLevel( SimdLevel( iLevel ) );
+      memset( piTmp, 0, sizeof( aiTmp[0] ) );
+      memset( piDst, 0, sizeof( aiDst[0] ) );
+
+      switch ( eKind )
+      {
+        case FILTER_HOR:
+          cFilter.filterHor( compID, piSrc, IF_STRIDE, piDst, IF_STRIDE, iWidth, iHeight, iFracX, bIsLast, chFmt );
+          break;
+        case FILTER_VER:
+          cFilter.filterVer( compID, piSrc, IF_STRIDE, piDst, IF_STRIDE, iWidth, iHeight, iFracY, true, bIsLast, chFmt );
+          break;
+        default:
+          cFilter.filterHor( compID, piSrc - ( ( iTaps >> 1 ) - 1 ) * IF_STRIDE, IF_STRIDE, piTmp, IF_STRIDE, iWidth, iHeight + iTaps - 1, iFracX, false, chFmt );
+          cFilter.filterVer( compID, piTmp + ( ( iTaps >> 1 ) - 1 ) * IF_STRIDE, IF_STRIDE, piDst, IF_STRIDE, iWidth, iHeight, iFracY, false, bIsLast, chFmt );
+          break;
+      }
+
+      if ( iLevel != SIMD_SCALAR
+        && ( memcmp( aiTmp[0], aiTmp[1], sizeof( aiTmp[0] ) ) != 0 || memcmp( aiDst[0], aiDst[1], sizeof( aiDst[0] ) ) != 0 ) )
+      {
+        Char acDetails[128];
+        sprintf( acDetails, "%s %dx%d, fraction %d/%d, %s, bit depth %d", isLuma( compID ) ? "luma" : "chroma", iWidth, iHeight,
+                 iFracX, iFracY, bIsLast ? "rounded" : "intermediate", iBitDepth );
+        xReportMismatch( apcKindNames[eKind], SimdLevel( iLevel ), acDetails );
+        uiMismatches++;
+      }
+    }
+  }
+  return uiMismatches;
+}
+
+int main( int argc, char* argv[] )
+{
+  const Int iNumBlocks = argc > 1 ? atoi( argv[1] ) : 20000;
+  g_uiRandomState      = argc > 2 ? UInt( strtoul( argv[2], NULL, 0 ) ) : 1;
+
+  if ( argc > 3 || iNumBlocks <= 0 || g_uiRandomState == 0 )
+  {
+    fprintf( stderr, "usage: %s [number of blocks per kernel (default 20000) [seed, not 0 (default 1)]]\n", argv[0] );
+    fprintf( stderr, "Runs random blocks through the C++ and the SIMD kernels of every level of the processor.\n" );
+    return EXIT_FAILURE;
+  }
+
+  if ( TComSimd::getCpuLevel() == SIMD_SCALAR )
+  {
+    printf( "no SIMD kernels to check: the processor or the build has none\n" );
+    return EXIT_SUCCESS;
+  }
+  printf( "checking the SIMD levels up to %s against the C++ kernels\n", TComSimd::getLevelName( TComSimd::getCpuLevel() ) );
+
+  initROM();
+
+  UInt uiMismatches = 0;
+  UInt uiKernelMismatches;
+
+  uiKernelMismatches = xCheckTransforms( iNumBlocks );
+  printf( "transforms:     %u mismatches\n", uiKernelMismatches );
+  uiMismatches += uiKernelMismatches;
+
+  uiKernelMismatches = xCheckDistortion( iNumBlocks );
+  printf( "distortion:     %u mismatches\n", uiKernelMismatches );
+  uiMismatches += uiKernelMismatches;
+
+  uiKernelMismatches = xCheckInterpolation( iNumBlocks );
+  printf( "interpolation:  %u mismatches\n", uiKernelMismatches );
+  uiMismatches += uiKernelMismatches;
+
+  destroyROM();
+
+  return uiMismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -38,14 +38,93 @@
 #include <stdint.h>
 #include <vector>
 #include "TComBitStream.h"
+#include "TComSimd.h"
 #include <string.h>
 #include <memory.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 using namespace std;
 
 //! \ingroup TLibCommon
 //! \{
 
+// ====================================================================================================================
+// Zero byte pair search
+// ====================================================================================================================
+
+static const UChar* findZeroBytePairScalar( const UChar* pucBegin, const UChar* pucEnd )
+{
+  const UChar* p = pucBegin;
+  while (pucEnd - p >= 2)
+  {
+    p = static_cast<const UChar*>(memchr(p, 0, (pucEnd - 1) - p));
+    if (p == NULL)
+    {
+      return pucEnd;
+    }
+    if (p[1] == 0)
+    {
+      return p;
+    }
+    p += 2;
+  }
+  return pucEnd;
+}
+
+#if SIMD_X86
+/// index of the lowest set bit of a non-zero 32-bit value
+static inline Int countTrailingZeros( UInt uiValue )
+{
+#if defined(__GNUC__)
+  return __builtin_ctz( uiValue );
+#else
+  unsigned long uiIdx;
+  _BitScanForward( &uiIdx, uiValue );
+  return Int(uiIdx);
+#endif
+}
+
+/**
+ * SSE4.1 version of findZeroBytePair(): each byte is OR'ed with the byte that follows it, so that a zero result marks
+ * the first byte of a pair. 16 pairs are tested per compare, the tail is left to the scalar search.
+ */
+static SIMD_TARGET_SSE41 const UChar* findZeroBytePairSSE41( const UChar* pucBegin, const UChar* pucEnd )
+{
+  const __m128i vZero = _mm_setzero_si128();
+  const UChar*  p     = pucBegin;
+  for (; pucEnd - p >= 17; p += 16)
+  {
+    const __m128i vPair = _mm_or_si128(_mm_loadu_si128((const __m128i*)p), _mm_loadu_si128((const __m128i*)(p + 1)));
+    const Int     iMask = _mm_movemask_epi8(_mm_cmpeq_epi8(vPair, vZero));
+    if (iMask)
+    {
+      return p + countTrailingZeros(UInt(iMask));
+    }
+  }
+  return findZeroBytePairScalar(p, pucEnd);
+}
+#endif
+
+/**
+ * Find the first pair of consecutive zero bytes, the only place where an emulation prevention byte can be inserted or
+ * removed. The runs of bytes in between can then be copied as a whole.
+ * \param pucBegin first byte to search
+ * \param pucEnd   end of the bytes to search
+ * \returns pointer to the first zero byte of the pair, or pucEnd if there is none
+ */
+const UChar* findZeroBytePair( const UChar* pucBegin, const UChar* pucEnd )
+{
+#if SIMD_X86
+  if (TComSimd::getLevel() != SIMD_SCALAR)
+  {
+    return findZeroBytePairSSE41(pucBegin, pucEnd);
+  }
+#endif
+  return findZeroBytePairScalar(pucBegin, pucEnd);
+}
+
 // ====================================================================================================================
 // Constructor / destructor / create / destroy
 // ====================================================================================================================
@@ -64,12 +143,31 @@ TComOutputBitstream::~TComOutputBitstream()
 TComInputBitstream::TComInputBitstream(std::vector<uint8_t>* buf)
 {
   m_fifo = buf;
+  m_bView = false;
+  m_fifo_begin = 0;
+  m_fifo_end = buf ? UInt(buf->size()) : 0;
   m_fifo_idx = 0;
   m_held_bits = 0;
   m_num_held_bits = 0;
   m_numBitsRead = 0;
 }
 
+/**
+ * Create a bitstream reader object that reads bytes #uiBegin# to #uiEnd#-1 of
+ * #buf#, which belongs to another bitstream and must outlive this one
+ */
+TComInputBitstream::TComInputBitstream(std::vector<uint8_t>* buf, UInt uiBegin, UInt uiEnd)
+{
+  m_fifo = buf;
+  m_bView = true;
+  m_fifo_begin = uiBegin;
+  m_fifo_end = uiEnd;
+  m_fifo_idx = uiBegin;
+  m_held_bits = 0;
+  m_num_held_bits = 0;
+  m_numBitsRead = 0;
+}
+
 TComInputBitstream::~TComInputBitstream()
 {
 }
@@ -105,37 +203,33 @@ Void TComOutputBitstream::write   ( UInt uiBits, UInt uiNumberOfBits )
   UInt num_total_bits = uiNumberOfBits + m_num_held_bits;
   UInt next_num_held_bits = num_total_bits % 8;
 
-  /* form a byte aligned word (write_bits), by concatenating any held bits
-   * with the new bits, discarding the bits that will form the next_held_bits.
-   * eg: H = held bits, V = n new bits        /---- next_held_bits
-   * len(H)=7, len(V)=1: ... ---- HHHH HHHV . 0000 0000, next_num_held_bits=0
-   * len(H)=7, len(V)=2: ... ---- HHHH HHHV . V000 0000, next_num_held_bits=1
-   * if total_bits < 8, the value of v_ is not used */
-  UChar next_held_bits = uiBits << (8 - next_num_held_bits);
-
   if (!(num_total_bits >> 3))
   {
     /* insufficient bits accumulated to write out, append new_held_bits to
      * current held_bits */
     /* NB, this requires that v only contains 0 in bit positions {31..n} */
-    m_held_bits |= next_held_bits;
+    m_held_bits |= uiBits << (8 - next_num_held_bits);
     m_num_held_bits = next_num_held_bits;
     return;
   }
 
-  /* topword serves to justify held_bits to align with the msb of uiBits */
-  UInt topword = (uiNumberOfBits - next_num_held_bits) & ~((1 << 3) -1);
-  UInt write_bits = (m_held_bits << topword) | (uiBits >> next_num_held_bits);
-
-  switch (num_total_bits >> 3)
+  /* form a msb-aligned 64-bit word by concatenating the held bits with the
+   * new bits (at most 7+32 bits), append its whole bytes in one go and keep
+   * the remainder as the next held bits.
+   * eg: H = held bits, V = n new bits
+   * len(H)=7, len(V)=2: HHHH HHHV . V000 0000 ..., 1 byte written, next_num_held_bits=1 */
+  const UInt64 word = (UInt64(m_held_bits) << 56) | (UInt64(uiBits) << (64 - num_total_bits));
+  const UInt num_bytes = num_total_bits >> 3;
+
+  const size_t size = m_fifo->size();
+  m_fifo->resize(size + num_bytes);
+  uint8_t *dst = &(*m_fifo)[size];
+  for (UInt i = 0; i < num_bytes; i++)
   {
-  case 4: m_fifo->push_back(write_bits >> 24);
-  case 3: m_fifo->push_back(write_bits >> 16);
-  case 2: m_fifo->push_back(write_bits >> 8);
-  case 1: m_fifo->push_back(write_bits);
+    dst[i] = uint8_t(word >> (56 - 8 * i));
   }
 
-  m_held_bits = next_held_bits;
+  m_held_bits = UChar(word >> (56 - 8 * num_bytes));
   m_num_held_bits = next_num_held_bits;
 }
 
@@ -167,9 +261,25 @@ Void   TComOutputBitstream::addSubstream( TComOutputBitstream* pcSubstream )
   UInt uiNumBits = pcSubstream->getNumberOfWrittenBits();
 
   const vector<uint8_t>& rbsp = pcSubstream->getFIFO();
-  for (vector<uint8_t>::const_iterator it = rbsp.begin(); it != rbsp.end();)
+  if (m_num_held_bits == 0)
+  {
+    m_fifo->insert(m_fifo->end(), rbsp.begin(), rbsp.end());
+  }
+  else if (!rbsp.empty())
   {
-    write(*it++, 8);
+    /* not byte aligned: each appended byte is the held bits followed by the
+     * msbs of a substream byte, whose lsbs become the next held bits */
+    const UInt shift = m_num_held_bits;
+    const size_t size = m_fifo->size();
+    m_fifo->resize(size + rbsp.size());
+    uint8_t *dst = &(*m_fifo)[size];
+    UChar held_bits = m_held_bits;
+    for (size_t i = 0; i < rbsp.size(); i++)
+    {
+      dst[i] = held_bits | (rbsp[i] >> shift);
+      held_bits = UChar(rbsp[i] << (8 - shift));
+    }
+    m_held_bits = held_bits;
   }
   if (uiNumBits&0x7)
   {
@@ -187,27 +297,21 @@ Int TComOutputBitstream::countStartCodeEmulations()
 {
   UInt cnt = 0;
   vector<uint8_t>& rbsp   = getFIFO();
-  for (vector<uint8_t>::iterator it = rbsp.begin(); it != rbsp.end();)
+  if (rbsp.empty())
   {
-    vector<uint8_t>::iterator found = it;
-    do
+    return 0;
+  }
+  const UChar* pucEnd = &rbsp[0] + rbsp.size();
+  for (const UChar* p = &rbsp[0]; p < pucEnd; )
+  {
+    // find the next emulated 00 00 {00,01,02,03}
+    p = findZeroBytePair(p, pucEnd);
+    if (pucEnd - p <= 2)
     {
-      // find the next emulated 00 00 {00,01,02,03}
-      // NB, end()-1, prevents finding a trailing two byte sequence
-      found = search_n(found, rbsp.end()-1, 2, 0);
-      found++;
-      // if not found, found == end, otherwise found = second zero byte
-      if (found == rbsp.end())
-      {
-        break;
-      }
-      if (*(++found) <= 3)
-      {
-        break;
-      }
-    } while (true);
-    it = found;
-    if (found != rbsp.end())
+      break;
+    }
+    p += 2;
+    if (*p <= 3)
     {
       cnt++;
     }
@@ -226,7 +330,7 @@ Int TComOutputBitstream::countStartCodeEmulations()
 Void TComInputBitstream::pseudoRead ( UInt uiNumberOfBits, UInt& ruiBits )
 {
   UInt saved_num_held_bits = m_num_held_bits;
-  UChar saved_held_bits = m_held_bits;
+  UInt64 saved_held_bits = m_held_bits;
   UInt saved_fifo_idx = m_fifo_idx;
 
   UInt num_bits_to_read = min(uiNumberOfBits, getNumBitsLeft());
@@ -245,60 +349,47 @@ Void TComInputBitstream::read (UInt uiNumberOfBits, UInt& ruiBits)
   
   m_numBitsRead += uiNumberOfBits;
 
-  /* NB, bits are extracted from the MSB of each byte. */
-  UInt retval = 0;
-  if (uiNumberOfBits <= m_num_held_bits)
+  if (uiNumberOfBits == 0)
   {
-    /* n=1, len(H)=7:   -VHH HHHH, shift_down=6, mask=0xfe
-     * n=3, len(H)=7:   -VVV HHHH, shift_down=4, mask=0xf8
-     */
-    retval = m_held_bits >> (m_num_held_bits - uiNumberOfBits);
-    retval &= ~(0xff << uiNumberOfBits);
-    m_num_held_bits -= uiNumberOfBits;
-    ruiBits = retval;
+    ruiBits = 0;
     return;
   }
-
-  /* all num_held_bits will go into retval
-   *   => need to mask leftover bits from previous extractions
-   *   => align retval with top of extracted word */
-  /* n=5, len(H)=3: ---- -VVV, mask=0x07, shift_up=5-3=2,
-   * n=9, len(H)=3: ---- -VVV, mask=0x07, shift_up=9-3=6 */
-  uiNumberOfBits -= m_num_held_bits;
-  retval = m_held_bits & ~(0xff << m_num_held_bits);
-  retval <<= uiNumberOfBits;
-
-  /* number of whole bytes that need to be loaded to form retval */
-  /* n=32, len(H)=0, load 4bytes, shift_down=0
-   * n=32, len(H)=1, load 4bytes, shift_down=1
-   * n=31, len(H)=1, load 4bytes, shift_down=1+1
-   * n=8,  len(H)=0, load 1byte,  shift_down=0
-   * n=8,  len(H)=3, load 1byte,  shift_down=3
-   * n=5,  len(H)=1, load 1byte,  shift_down=1+3
-   */
-  UInt aligned_word = 0;
-  UInt num_bytes_to_load = (uiNumberOfBits - 1) >> 3;
-  assert(m_fifo_idx + num_bytes_to_load < m_fifo->size());
-
-  switch (num_bytes_to_load)
+  if (uiNumberOfBits > m_num_held_bits)
   {
-  case 3: aligned_word  = (*m_fifo)[m_fifo_idx++] << 24;
-  case 2: aligned_word |= (*m_fifo)[m_fifo_idx++] << 16;
-  case 1: aligned_word |= (*m_fifo)[m_fifo_idx++] <<  8;
-  case 0: aligned_word |= (*m_fifo)[m_fifo_idx++];
+    xLoadCache();
+    assert(uiNumberOfBits <= m_num_held_bits);
   }
 
-  /* resolve remainder bits */
-  UInt next_num_held_bits = (32 - uiNumberOfBits) % 8;
-
-  /* copy required part of aligned_word into retval */
-  retval |= aligned_word >> next_num_held_bits;
+  /* NB, bits are extracted from the MSB of each byte: the next bits to be
+   * read are the most significant of the m_num_held_bits lsbs of the cache */
+  m_num_held_bits -= uiNumberOfBits;
+  ruiBits = UInt((m_held_bits >> m_num_held_bits) & ((UInt64(1) << uiNumberOfBits) - 1));
+}
 
-  /* store held bits */
-  m_num_held_bits = next_num_held_bits;
-  m_held_bits = aligned_word;
+/**
+ * Top up the cache with whole bytes from the FIFO, keeping the unread held
+ * bits. While at least 8 bytes remain this is a single unchecked word load;
+ * near the end of the FIFO the bytes are loaded one by one.
+ */
+Void TComInputBitstream::xLoadCache()
+{
+  UInt num_bytes = (64 - m_num_held_bits) >> 3;
 
-  ruiBits = retval;
+  if (m_fifo_idx + 8 <= m_fifo_end)
+  {
+    const UInt64 word = readBigEndian64(&(*m_fifo)[m_fifo_idx]);
+    m_held_bits = num_bytes == 8 ? word : (m_held_bits << (num_bytes << 3)) | (word >> (64 - (num_bytes << 3)));
+  }
+  else
+  {
+    num_bytes = min<UInt>(num_bytes, m_fifo_end - m_fifo_idx);
+    for (UInt i = 0; i < num_bytes; i++)
+    {
+      m_held_bits = (m_held_bits << 8) | (*m_fifo)[m_fifo_idx + i];
+    }
+  }
+  m_fifo_idx += num_bytes;
+  m_num_held_bits += num_bytes << 3;
 }
 
 /**
@@ -341,18 +432,55 @@ TComOutputBitstream& TComOutputBitstream::operator= (const TComOutputBitstream&
 /**
  - extract substream from the current bitstream
  .
- \param  pcBitstream  bitstream which contains substreams
+ The substream is a view into the bytes of the current bitstream when it starts byte aligned and has a whole number
+ of bytes, otherwise it is a copy. A view must be deleted before the current bitstream.
  \param  uiNumBits    number of bits to transfer
  */
 TComInputBitstream *TComInputBitstream::extractSubstream( UInt uiNumBits )
+{
+  if (getNumBitsUntilByteAligned() != 0 || (uiNumBits&0x7) != 0)
+  {
+    return copySubstream(uiNumBits);
+  }
+
+  const UInt uiStart    = getByteLocation();
+  const UInt uiNumBytes = uiNumBits >> 3;
+  assert(uiStart + uiNumBytes <= getByteBufferSize());
+
+  TComInputBitstream *pcSubstream = new TComInputBitstream(m_fifo, m_fifo_begin + uiStart, m_fifo_begin + uiStart + uiNumBytes);
+  setByteLocation(uiStart + uiNumBytes);
+  m_numBitsRead += uiNumBits;
+  return pcSubstream;
+}
+
+/**
+ - copy substream from the current bitstream
+ .
+ \param  uiNumBits    number of bits to transfer
+ */
+TComInputBitstream *TComInputBitstream::copySubstream( UInt uiNumBits )
 {
   UInt uiNumBytes = uiNumBits/8;
   std::vector<uint8_t>* buf = new std::vector<uint8_t>;
   UInt uiByte;
-  for (UInt ui = 0; ui < uiNumBytes; ui++)
+  const Bool bAligned = getNumBitsUntilByteAligned() == 0;
+  const UInt uiByteLocation = getByteLocation();
+  if (bAligned)
   {
-    read(8, uiByte);
-    buf->push_back(uiByte);
+    // byte aligned: copy the whole bytes in one go
+    assert(uiByteLocation + uiNumBytes <= getByteBufferSize());
+    buf->assign(m_fifo->begin() + m_fifo_begin + uiByteLocation, m_fifo->begin() + m_fifo_begin + uiByteLocation + uiNumBytes);
+    setByteLocation(uiByteLocation + uiNumBytes);
+    m_numBitsRead += uiNumBytes << 3;
+  }
+  else
+  {
+    buf->reserve(uiNumBytes + 1);
+    for (UInt ui = 0; ui < uiNumBytes; ui++)
+    {
+      read(8, uiByte);
+      buf->push_back(uiByte);
+    }
   }
   if (uiNumBits&0x7)
   {
@@ -369,7 +497,10 @@ TComInputBitstream *TComInputBitstream::extractSubstream( UInt uiNumBits )
  */
 Void TComInputBitstream::deleteFifo()
 {
-  delete m_fifo;
+  if (!m_bView)
+  {
+    delete m_fifo;
+  }
   m_fifo = NULL;
 }
 
@@ -46,11 +46,32 @@
 #include <vector>
 #include <stdio.h>
 #include <assert.h>
+#include <string.h>
 #include "CommonDef.h"
 
 //! \ingroup TLibCommon
 //! \{
 
+/// load 8 bytes as a big-endian word
+static inline UInt64 readBigEndian64( const UChar* pucData )
+{
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  UInt64 uiWord;
+  memcpy( &uiWord, pucData, sizeof(uiWord) );
+  return __builtin_bswap64( uiWord );
+#else
+  UInt64 uiWord = 0;
+  for ( Int i = 0; i < 8; i++ )
+  {
+    uiWord = ( uiWord << 8 ) | pucData[i];
+  }
+  return uiWord;
+#endif
+}
+
+/// find the first byte-aligned pair of zero bytes in [pucBegin, pucEnd), returns pucEnd if there is none
+const UChar* findZeroBytePair( const UChar* pucBegin, const UChar* pucEnd );
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -166,14 +187,21 @@ class TComInputBitstream
 {
   std::vector<uint8_t> *m_fifo; /// FIFO for storage of complete bytes
   std::vector<UInt> m_emulationPreventionByteLocation;
+  Bool m_bView; /// the bytes are a range of the FIFO of another bitstream, which owns them
+
+  TComInputBitstream(std::vector<uint8_t>* buf, UInt uiBegin, UInt uiEnd);
 
 protected:
-  UInt m_fifo_idx; /// Read index into m_fifo
+  UInt m_fifo_begin; /// index of the first byte of the bitstream in m_fifo
+  UInt m_fifo_end;   /// index past the last byte of the bitstream in m_fifo
+  UInt m_fifo_idx; /// Read index into m_fifo: the next byte to be loaded into m_held_bits
 
-  UInt m_num_held_bits;
-  UChar m_held_bits;
+  UInt m_num_held_bits; /// number of bits of m_held_bits not read yet (0..64)
+  UInt64 m_held_bits;   /// cache of the bytes loaded last, the unread bits are the m_num_held_bits lsbs
   UInt  m_numBitsRead;
 
+  Void        xLoadCache      ();
+
 public:
   /**
    * Create a new bitstream reader object that reads from #buf#.  Ownership
@@ -188,20 +216,32 @@ public:
   Void        read            ( UInt uiNumberOfBits, UInt& ruiBits );
   Void        readByte        ( UInt &ruiBits )
   {
-    assert(m_fifo_idx < m_fifo->size());
+    assert((m_num_held_bits & 0x7) == 0);
+    if (m_num_held_bits)
+    {
+      m_num_held_bits -= 8;
+      ruiBits = UChar(m_held_bits >> m_num_held_bits);
+      return;
+    }
+    assert(m_fifo_idx < m_fifo_end);
     ruiBits = (*m_fifo)[m_fifo_idx++];
   }
   
   Void        peekPreviousByte( UInt &byte )
   {
-    assert(m_fifo_idx > 0);
-    byte = (*m_fifo)[m_fifo_idx - 1];
+    assert(getByteLocation() > 0);
+    byte = (*m_fifo)[m_fifo_begin + getByteLocation() - 1];
   }
   
   UInt        readOutTrailingBits (); // NOTE: RExt - now returns the number of bits read.
-  UChar getHeldBits  ()          { return m_held_bits;          }
+  UChar getHeldBits  ()          { return UChar(m_held_bits);   }
   TComOutputBitstream& operator= (const TComOutputBitstream& src);
-  UInt  getByteLocation              ( )                     { return m_fifo_idx                    ; }
+  UInt  getByteLocation              ( )                     { return m_fifo_idx - m_fifo_begin - (m_num_held_bits >> 3); }
+
+  // Byte-level access for readers that load ahead of the current location (CABAC) and hand the final location back.
+  const UChar* getByteBuffer         ( )                     { return m_fifo_end == m_fifo_begin ? NULL : &(*m_fifo)[m_fifo_begin]; }
+  UInt  getByteBufferSize            ( )                     { return m_fifo_end - m_fifo_begin     ; }
+  Void  setByteLocation              ( UInt uiLocation )     { assert((m_num_held_bits & 0x7) == 0 && uiLocation <= getByteBufferSize()); m_fifo_idx = m_fifo_begin + uiLocation; m_num_held_bits = 0; }
 
   // Peek at bits in word-storage. Used in determining if we have completed reading of current bitstream and therefore slice in LCEC.
   UInt        peekBits (UInt uiBits) { UInt tmp; pseudoRead(uiBits, tmp); return tmp; }
@@ -210,9 +250,11 @@ public:
   UInt read(UInt numberOfBits) { UInt tmp; read(numberOfBits, tmp); return tmp; }
   UInt     readByte() { UInt tmp; readByte( tmp ); return tmp; }
   UInt getNumBitsUntilByteAligned() { return m_num_held_bits & (0x7); }
-  UInt getNumBitsLeft() { return 8*((UInt)m_fifo->size() - m_fifo_idx) + m_num_held_bits; }
-  TComInputBitstream *extractSubstream( UInt uiNumBits ); // Read the nominated number of bits, and return as a bitstream.
-  Void                deleteFifo(); // Delete internal fifo of bitstream.
+  UInt getNumBitsLeft() { return 8*(m_fifo_end - m_fifo_idx) + m_num_held_bits; }
+  TComInputBitstream *extractSubstream( UInt uiNumBits ); // Read the nominated number of bits, and return as a bitstream. Aligned whole bytes are returned as a view into this bitstream.
+  TComInputBitstream *copySubstream   ( UInt uiNumBits ); // Read the nominated number of bits, and return as a bitstream that owns a copy of them.
+  Void                deleteFifo(); // Delete internal fifo of bitstream (a view does not own its fifo).
+  Bool                isView() const { return m_bView; }
   UInt  getNumBitsRead() { return m_numBitsRead; }
   UInt readByteAlignment(); // NOTE: RExt - now returns the number of bits read.
 
@@ -43,10 +43,6 @@
 //! \ingroup TLibCommon
 //! \{
 
-#if ADAPTIVE_QP_SELECTION
-  TCoeff * TComDataCU::m_pcGlbArlCoeff[MAX_NUM_COMPONENT] = { NULL, NULL, NULL };
-#endif
-
 // ====================================================================================================================
 // Constructor / destructor / create / destroy
 // ====================================================================================================================
@@ -89,9 +85,6 @@ TComDataCU::TComDataCU()
 #endif
 
   }
-#if ADAPTIVE_QP_SELECTION
-  m_ArlCoeffIsAliasedAllocation = false;
-#endif
   m_pbIPCMFlag         = NULL;
 
   m_pcCUAboveLeft      = NULL;
@@ -117,7 +110,7 @@ TComDataCU::~TComDataCU()
 
 Void TComDataCU::create( ChromaFormat chromaFormatIDC, UInt uiNumPartition, UInt uiWidth, UInt uiHeight, Bool bDecSubCu, Int unitSize
 #if ADAPTIVE_QP_SELECTION
-                        , Bool bGlobalRMARLBuffer
+                        , Bool bArlBuffer
 #endif
                         )
 {
@@ -178,17 +171,8 @@ Void TComDataCU::create( ChromaFormat chromaFormatIDC, UInt uiNumPartition, UInt
       memset( m_pcTrCoeff[compID], 0, (totalSize * sizeof( TCoeff )) );
 
 #if ADAPTIVE_QP_SELECTION
-      if( bGlobalRMARLBuffer )
-      {
-        if (m_pcGlbArlCoeff[compID] == NULL) m_pcGlbArlCoeff[compID] = (TCoeff*)xMalloc(TCoeff, totalSize);
-
-        m_pcArlCoeff[compID] = m_pcGlbArlCoeff[compID];
-        m_ArlCoeffIsAliasedAllocation = true;
-      }
-      else
-      {
-         m_pcArlCoeff[compID] = (TCoeff*)xMalloc(TCoeff, totalSize);
-      }
+      // the CTUs of a picture have no ARL buffer, the encoder collects the ARL statistics from its own CUs
+      m_pcArlCoeff[compID] = bArlBuffer ? (TCoeff*)xMalloc(TCoeff, totalSize) : NULL;
 #endif
       m_pcIPCMSample[compID] = (Pel*   )xMalloc(Pel , totalSize);
     }
@@ -270,12 +254,7 @@ Void TComDataCU::destroy()
 #endif
 
 #if ADAPTIVE_QP_SELECTION
-      if (!m_ArlCoeffIsAliasedAllocation)
-      {
-        if ( m_pcArlCoeff[comp]     ) { xFree(m_pcArlCoeff[comp]);      m_pcArlCoeff[comp]    = NULL; }
-      }
-
-      if ( m_pcGlbArlCoeff[comp]  ) { xFree(m_pcGlbArlCoeff[comp]);   m_pcGlbArlCoeff[comp] = NULL; }
+      if ( m_pcArlCoeff[comp]     ) { xFree(m_pcArlCoeff[comp]);      m_pcArlCoeff[comp]    = NULL; }
 #endif
 
       if ( m_pcIPCMSample[comp]   ) { xFree(m_pcIPCMSample[comp]);    m_pcIPCMSample[comp]  = NULL; }
@@ -488,7 +467,10 @@ Void TComDataCU::initCU( TComPic* pcPic, UInt iCUAddr )
       const UInt componentShift = m_pcPic->getComponentScaleX(ComponentID(comp)) + m_pcPic->getComponentScaleY(ComponentID(comp));
       memset( m_pcTrCoeff[comp], 0, sizeof(TCoeff)* numCoeffY>>componentShift );
 #if ADAPTIVE_QP_SELECTION
-      memset( m_pcArlCoeff[comp], 0, sizeof(TCoeff)* numCoeffY>>componentShift );
+      if ( m_pcArlCoeff[comp] )
+      {
+        memset( m_pcArlCoeff[comp], 0, sizeof(TCoeff)* numCoeffY>>componentShift );
+      }
 #endif
     }
 
@@ -521,7 +503,10 @@ Void TComDataCU::initCU( TComPic* pcPic, UInt iCUAddr )
       {
         m_pcTrCoeff[comp][coeff]=pcFrom->m_pcTrCoeff[comp][coeff];
 #if ADAPTIVE_QP_SELECTION
-        m_pcArlCoeff[comp][coeff]=pcFrom->m_pcArlCoeff[comp][coeff];
+        if ( m_pcArlCoeff[comp] && pcFrom->m_pcArlCoeff[comp] )
+        {
+          m_pcArlCoeff[comp][coeff]=pcFrom->m_pcArlCoeff[comp][coeff];
+        }
 #endif
         m_pcIPCMSample[comp][coeff]=pcFrom->m_pcIPCMSample[comp][coeff];
       }
@@ -806,7 +791,10 @@ Void TComDataCU::initSubCU( TComDataCU* pcCU, UInt uiPartUnitIdx, UInt uiDepth,
         const UInt offset = uiCoffOffset>>componentShift;
         m_pcTrCoeff[ch][coeff]=bigCU->m_pcTrCoeff[ch][coeff + offset];
 #if ADAPTIVE_QP_SELECTION
-        m_pcArlCoeff[ch][coeff]=bigCU->m_pcArlCoeff[ch][coeff + offset];
+        if ( bigCU->m_pcArlCoeff[ch] )
+        {
+          m_pcArlCoeff[ch][coeff]=bigCU->m_pcArlCoeff[ch][coeff + offset];
+        }
 #endif
         m_pcIPCMSample[ch][coeff]=bigCU->m_pcIPCMSample[ch][coeff + offset];
       }
@@ -919,7 +907,7 @@ Void TComDataCU::copySubCU( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiDepth )
     const UInt offset           = uiCoffOffset >> componentShift;
     m_pcTrCoeff[ch] = pcCU->getCoeff(component) + offset;
 #if ADAPTIVE_QP_SELECTION
-    m_pcArlCoeff[ch] = pcCU->getArlCoeff(component) + offset;
+    m_pcArlCoeff[ch] = pcCU->getArlCoeff(component) ? pcCU->getArlCoeff(component) + offset : NULL;
 #endif
     m_pcIPCMSample[ch] = pcCU->getPCMSample(component) + offset;
   }
@@ -1134,7 +1122,10 @@ Void TComDataCU::copyToPic( UChar uhDepth )
     const UInt componentShift   = m_pcPic->getComponentScaleX(component) + m_pcPic->getComponentScaleY(component);
     memcpy( rpcCU->getCoeff(component)   + (offsetY>>componentShift), m_pcTrCoeff[component], sizeof(TCoeff)*(numCoeffY>>componentShift) );
 #if ADAPTIVE_QP_SELECTION
-    memcpy( rpcCU->getArlCoeff(component) + (offsetY>>componentShift), m_pcArlCoeff[component], sizeof(TCoeff)*(numCoeffY>>componentShift) );
+    if ( rpcCU->getArlCoeff(component) )
+    {
+      memcpy( rpcCU->getArlCoeff(component) + (offsetY>>componentShift), m_pcArlCoeff[component], sizeof(TCoeff)*(numCoeffY>>componentShift) );
+    }
 #endif
     memcpy( rpcCU->getPCMSample(component) + (offsetY>>componentShift), m_pcIPCMSample[component], sizeof(Pel)*(numCoeffY>>componentShift) );
   }
@@ -1216,7 +1207,10 @@ Void TComDataCU::copyToPic( UChar uhDepth, UInt uiPartIdx, UInt uiPartDepth )
     UInt componentShift = m_pcPic->getComponentScaleX(ComponentID(comp)) + m_pcPic->getComponentScaleY(ComponentID(comp));
     memcpy( rpcCU->getCoeff(ComponentID(comp)) + (offsetY>>componentShift), m_pcTrCoeff[comp], sizeof(TCoeff)*(numCoeffY>>componentShift) );
 #if ADAPTIVE_QP_SELECTION
-    memcpy( rpcCU->getArlCoeff(ComponentID(comp)) + (offsetY>>componentShift), m_pcArlCoeff[comp], sizeof(TCoeff)*(numCoeffY>>componentShift) );
+    if ( rpcCU->getArlCoeff(ComponentID(comp)) )
+    {
+      memcpy( rpcCU->getArlCoeff(ComponentID(comp)) + (offsetY>>componentShift), m_pcArlCoeff[comp], sizeof(TCoeff)*(numCoeffY>>componentShift) );
+    }
 #endif
     memcpy( rpcCU->getPCMSample(ComponentID(comp)) + (offsetY>>componentShift), m_pcIPCMSample[comp], sizeof(Pel)*(numCoeffY>>componentShift) );
   }
@@ -2050,7 +2044,7 @@ Void TComDataCU::setQPSubCUs( Int qp, TComDataCU* pcCU, UInt absPartIdx, UInt de
 Void TComDataCU::setQPSubParts( Int qp, UInt uiAbsPartIdx, UInt uiDepth )
 {
   UInt uiCurrPartNumb = m_pcPic->getNumPartInCU() >> (uiDepth << 1);
-  TComSlice * pcSlice = getPic()->getSlice(getPic()->getCurrSliceIdx());
+  TComSlice * pcSlice = getSlice();
 
   for(UInt uiSCUIdx = uiAbsPartIdx; uiSCUIdx < uiAbsPartIdx+uiCurrPartNumb; uiSCUIdx++)
   {
@@ -42,7 +42,9 @@
 
 #include "TComRom.h"
 #include "TComInterpolationFilter.h"
+#include "TComSimd.h"
 #include <assert.h>
+#include <string.h>
 
 #include "TComChromaFormat.h"
 
@@ -74,6 +76,282 @@ const TFilterCoeff TComInterpolationFilter::m_chromaFilter[CHROMA_INTERPOLATION_
   { -2, 10, 58, -2 }
 };
 
+#if SIMD_X86
+// ====================================================================================================================
+// SIMD kernels
+// ====================================================================================================================
+
+// The sums are formed in 32-bit lanes like the scalar Int sums. With 16-bit samples, the results are truncated to
+// 16 bits before they are clipped, as the conversion to Pel of the scalar code does.
+
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+/// round, shift and convert eight 32-bit sums to Pel, clipping them to [0, maxVal] for the last filtering operation
+template<Bool isLast>
+static inline SIMD_TARGET_SSE41 __m128i xShiftPackSSE41( __m128i vLo, __m128i vHi, __m128i vOffset, __m128i vShift, __m128i vMax )
+{
+  vLo = _mm_sra_epi32( _mm_add_epi32( vLo, vOffset ), vShift );
+  vHi = _mm_sra_epi32( _mm_add_epi32( vHi, vOffset ), vShift );
+  vLo = _mm_srai_epi32( _mm_slli_epi32( vLo, 16 ), 16 );
+  vHi = _mm_srai_epi32( _mm_slli_epi32( vHi, 16 ), 16 );
+  __m128i vVal = _mm_packs_epi32( vLo, vHi );
+  if ( isLast )
+  {
+    vVal = _mm_min_epi16( _mm_max_epi16( vVal, _mm_setzero_si128() ), vMax );
+  }
+  return vVal;
+}
+#endif
+
+/** FIR filter with SSE4.1, equal to TComInterpolationFilter::filter().
+ * \param src        pointer to the first tap of the first sample
+ * \param cStride    distance between the taps (1 or srcStride)
+ * \param offset     rounding offset of filter()
+ * \param shift      shift of filter()
+ * \param maxVal     maximum output value of the last filtering operation
+ */
+template<Int N, Bool isFirst, Bool isLast>
+static SIMD_TARGET_SSE41 Void xFilterSSE41( const Pel* src, Int srcStride, Int cStride, Pel* dst, Int dstStride, Int width, Int height, const TFilterCoeff* coeff, Int offset, Int shift, Int maxVal )
+{
+  const __m128i vOffset = _mm_set1_epi32( offset );
+  const __m128i vShift  = _mm_cvtsi32_si128( shift );
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  const __m128i vMax    = _mm_set1_epi32( maxVal );
+  __m128i vCoeff[N];
+  for ( Int k = 0; k < N; k++ )
+  {
+    vCoeff[k] = _mm_set1_epi32( coeff[k] );
+  }
+#else
+  const __m128i vMax    = _mm_set1_epi16( (Short)maxVal );
+  __m128i vCoeff[N/2];
+  for ( Int k = 0; k < N/2; k++ )
+  {
+    vCoeff[k] = _mm_set1_epi32( ( coeff[2*k] & 0xffff ) | ( coeff[2*k+1] << 16 ) );
+  }
+#endif
+
+  for ( Int row = 0; row < height; row++ )
+  {
+    Int col = 0;
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+    for ( ; col + 4 <= width; col += 4 )
+    {
+      __m128i vSum = _mm_setzero_si128();
+      for ( Int k = 0; k < N; k++ )
+      {
+        vSum = _mm_add_epi32( vSum, _mm_mullo_epi32( _mm_loadu_si128( (const __m128i*)( src + col + k * cStride ) ), vCoeff[k] ) );
+      }
+      vSum = _mm_sra_epi32( _mm_add_epi32( vSum, vOffset ), vShift );
+      if ( isLast )
+      {
+        vSum = _mm_min_epi32( _mm_max_epi32( vSum, _mm_setzero_si128() ), vMax );
+      }
+      _mm_storeu_si128( (__m128i*)( dst + col ), vSum );
+    }
+#else
+    for ( ; col + 8 <= width; col += 8 )
+    {
+      __m128i vLo = _mm_setzero_si128();
+      __m128i vHi = _mm_setzero_si128();
+      for ( Int k = 0; k < N/2; k++ )
+      {
+        const __m128i vA = _mm_loadu_si128( (const __m128i*)( src + col + 2*k     * cStride ) );
+        const __m128i vB = _mm_loadu_si128( (const __m128i*)( src + col + (2*k+1) * cStride ) );
+        vLo = _mm_add_epi32( vLo, _mm_madd_epi16( _mm_unpacklo_epi16( vA, vB ), vCoeff[k] ) );
+        vHi = _mm_add_epi32( vHi, _mm_madd_epi16( _mm_unpackhi_epi16( vA, vB ), vCoeff[k] ) );
+      }
+      _mm_storeu_si128( (__m128i*)( dst + col ), xShiftPackSSE41<isLast>( vLo, vHi, vOffset, vShift, vMax ) );
+    }
+    if ( col + 4 <= width )
+    {
+      __m128i vLo = _mm_setzero_si128();
+      for ( Int k = 0; k < N/2; k++ )
+      {
+        const __m128i vA = _mm_loadl_epi64( (const __m128i*)( src + col + 2*k     * cStride ) );
+        const __m128i vB = _mm_loadl_epi64( (const __m128i*)( src + col + (2*k+1) * cStride ) );
+        vLo = _mm_add_epi32( vLo, _mm_madd_epi16( _mm_unpacklo_epi16( vA, vB ), vCoeff[k] ) );
+      }
+      _mm_storel_epi64( (__m128i*)( dst + col ), xShiftPackSSE41<isLast>( vLo, vLo, vOffset, vShift, vMax ) );
+      col += 4;
+    }
+#endif
+    for ( ; col < width; col++ )
+    {
+      Int sum = 0;
+      for ( Int k = 0; k < N; k++ )
+      {
+        sum += src[col + k * cStride] * coeff[k];
+      }
+      Pel val = ( sum + offset ) >> shift;
+      if ( isLast )
+      {
+        val = ( val < 0 ) ? 0 : val;
+        val = ( val > maxVal ) ? maxVal : val;
+      }
+      dst[col] = val;
+    }
+
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+/** FIR filter with AVX2, see xFilterSSE41().
+ */
+template<Int N, Bool isFirst, Bool isLast>
+static SIMD_TARGET_AVX2 Void xFilterAVX2( const Pel* src, Int srcStride, Int cStride, Pel* dst, Int dstStride, Int width, Int height, const TFilterCoeff* coeff, Int offset, Int shift, Int maxVal )
+{
+  // columns per iteration
+  const Int step = RExt__HIGH_BIT_DEPTH_SUPPORT ? 8 : 16;
+  const Int wide = width - width % step;
+
+  if ( wide > 0 )
+  {
+    const __m256i vOffset = _mm256_set1_epi32( offset );
+    const __m128i vShift  = _mm_cvtsi32_si128( shift );
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+    const __m256i vMax    = _mm256_set1_epi32( maxVal );
+    __m256i vCoeff[N];
+    for ( Int k = 0; k < N; k++ )
+    {
+      vCoeff[k] = _mm256_set1_epi32( coeff[k] );
+    }
+#else
+    const __m256i vMax    = _mm256_set1_epi16( (Short)maxVal );
+    __m256i vCoeff[N/2];
+    for ( Int k = 0; k < N/2; k++ )
+    {
+      vCoeff[k] = _mm256_set1_epi32( ( coeff[2*k] & 0xffff ) | ( coeff[2*k+1] << 16 ) );
+    }
+#endif
+    const Pel* srcRow = src;
+    Pel*       dstRow = dst;
+    for ( Int row = 0; row < height; row++ )
+    {
+      for ( Int col = 0; col < wide; col += step )
+      {
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+        __m256i vSum = _mm256_setzero_si256();
+        for ( Int k = 0; k < N; k++ )
+        {
+          vSum = _mm256_add_epi32( vSum, _mm256_mullo_epi32( _mm256_loadu_si256( (const __m256i*)( srcRow + col + k * cStride ) ), vCoeff[k] ) );
+        }
+        vSum = _mm256_sra_epi32( _mm256_add_epi32( vSum, vOffset ), vShift );
+        if ( isLast )
+        {
+          vSum = _mm256_min_epi32( _mm256_max_epi32( vSum, _mm256_setzero_si256() ), vMax );
+        }
+        _mm256_storeu_si256( (__m256i*)( dstRow + col ), vSum );
+#else
+        // the in-lane unpacks and packs keep the samples in order
+        __m256i vLo = _mm256_setzero_si256();
+        __m256i vHi = _mm256_setzero_si256();
+        for ( Int k = 0; k < N/2; k++ )
+        {
+          const __m256i vA = _mm256_loadu_si256( (const __m256i*)( srcRow + col + 2*k     * cStride ) );
+          const __m256i vB = _mm256_loadu_si256( (const __m256i*)( srcRow + col + (2*k+1) * cStride ) );
+          vLo = _mm256_add_epi32( vLo, _mm256_madd_epi16( _mm256_unpacklo_epi16( vA, vB ), vCoeff[k] ) );
+          vHi = _mm256_add_epi32( vHi, _mm256_madd_epi16( _mm256_unpackhi_epi16( vA, vB ), vCoeff[k] ) );
+        }
+        vLo = _mm256_sra_epi32( _mm256_add_epi32( vLo, vOffset ), vShift );
+        vHi = _mm256_sra_epi32( _mm256_add_epi32( vHi, vOffset ), vShift );
+        vLo = _mm256_srai_epi32( _mm256_slli_epi32( vLo, 16 ), 16 );
+        vHi = _mm256_srai_epi32( _mm256_slli_epi32( vHi, 16 ), 16 );
+        __m256i vVal = _mm256_packs_epi32( vLo, vHi );
+        if ( isLast )
+        {
+          vVal = _mm256_min_epi16( _mm256_max_epi16( vVal, _mm256_setzero_si256() ), vMax );
+        }
+        _mm256_storeu_si256( (__m256i*)( dstRow + col ), vVal );
+#endif
+      }
+      srcRow += srcStride;
+      dstRow += dstStride;
+    }
+  }
+  if ( wide < width )
+  {
+    xFilterSSE41<N, isFirst, isLast>( src + wide, srcStride, cStride, dst + wide, dstStride, width - wide, height, coeff, offset, shift, maxVal );
+  }
+}
+
+/** Copy of filterCopy() for the first (bIsFirst) or last filtering operation with SSE4.1.
+ * \param shift  shift of filterCopy(), at least 1
+ */
+static SIMD_TARGET_SSE41 Void xFilterCopySSE41( Int bitDepth, const Pel* src, Int srcStride, Pel* dst, Int dstStride, Int width, Int height, Bool bIsFirst, Int shift )
+{
+  const __m128i vShift = _mm_cvtsi32_si128( shift );
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  const __m128i vOffs  = _mm_set1_epi32( bIsFirst ? IF_INTERNAL_OFFS : IF_INTERNAL_OFFS + ( 1 << ( shift - 1 ) ) );
+  const __m128i vMax   = _mm_set1_epi32( ( 1 << bitDepth ) - 1 );
+#else
+  const __m128i vOffs  = _mm_set1_epi16( (Short)IF_INTERNAL_OFFS );
+  const __m128i vRound = _mm_set1_epi32( IF_INTERNAL_OFFS + ( 1 << ( shift - 1 ) ) );
+  const __m128i vMax   = _mm_set1_epi16( (Short)( ( 1 << bitDepth ) - 1 ) );
+#endif
+
+  for ( Int row = 0; row < height; row++ )
+  {
+    Int col = 0;
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+    for ( ; col + 4 <= width; col += 4 )
+    {
+      const __m128i vSrc = _mm_loadu_si128( (const __m128i*)( src + col ) );
+      __m128i vVal;
+      if ( bIsFirst )
+      {
+        vVal = _mm_sub_epi32( _mm_sll_epi32( vSrc, vShift ), vOffs );
+      }
+      else
+      {
+        vVal = _mm_sra_epi32( _mm_add_epi32( vSrc, vOffs ), vShift );
+        vVal = _mm_min_epi32( _mm_max_epi32( vVal, _mm_setzero_si128() ), vMax );
+      }
+      _mm_storeu_si128( (__m128i*)( dst + col ), vVal );
+    }
+#else
+    for ( ; col + 8 <= width; col += 8 )
+    {
+      const __m128i vSrc = _mm_loadu_si128( (const __m128i*)( src + col ) );
+      __m128i vVal;
+      if ( bIsFirst )
+      {
+        vVal = _mm_sub_epi16( _mm_sll_epi16( vSrc, vShift ), vOffs );
+      }
+      else
+      {
+        __m128i vLo = _mm_sra_epi32( _mm_add_epi32( _mm_cvtepi16_epi32( vSrc ), vRound ), vShift );
+        __m128i vHi = _mm_sra_epi32( _mm_add_epi32( _mm_cvtepi16_epi32( _mm_unpackhi_epi64( vSrc, vSrc ) ), vRound ), vShift );
+        vLo  = _mm_srai_epi32( _mm_slli_epi32( vLo, 16 ), 16 );
+        vHi  = _mm_srai_epi32( _mm_slli_epi32( vHi, 16 ), 16 );
+        vVal = _mm_packs_epi32( vLo, vHi );
+        vVal = _mm_min_epi16( _mm_max_epi16( vVal, _mm_setzero_si128() ), vMax );
+      }
+      _mm_storeu_si128( (__m128i*)( dst + col ), vVal );
+    }
+#endif
+    for ( ; col < width; col++ )
+    {
+      if ( bIsFirst )
+      {
+        Pel val = leftShift_round( src[col], shift );
+        dst[col] = val - (Pel)IF_INTERNAL_OFFS;
+      }
+      else
+      {
+        Pel val = rightShift_round( ( src[col] + IF_INTERNAL_OFFS ), shift );
+        val = ( val < 0 ) ? 0 : val;
+        val = ( val > ( 1 << bitDepth ) - 1 ) ? ( 1 << bitDepth ) - 1 : val;
+        dst[col] = val;
+      }
+    }
+
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+#endif
+
 // ====================================================================================================================
 // Private member functions
 // ====================================================================================================================
@@ -99,16 +377,31 @@ Void TComInterpolationFilter::filterCopy(Int bitDepth, const Pel *src, Int srcSt
   {
     for (row = 0; row < height; row++)
     {
-      for (col = 0; col < width; col++)
-      {
-        dst[col] = src[col];
-      }
+      memcpy( dst, src, width * sizeof(Pel) );
       
       src += srcStride;
       dst += dstStride;
     }              
+    return;
+  }
+
+#if SIMD_X86
+  if ( TComSimd::getLevel() != SIMD_SCALAR )
+  {
+#if RExt__N0188_EXTENDED_PRECISION_PROCESSING
+    const Int shift = std::max<Int>(2, (IF_INTERNAL_PREC - bitDepth));
+#else
+    const Int shift = IF_INTERNAL_PREC - bitDepth;
+#endif
+    if ( shift > 0 )
+    {
+      xFilterCopySSE41( bitDepth, src, srcStride, dst, dstStride, width, height, isFirst, shift );
+      return;
+    }
   }
-  else if ( isFirst )
+#endif
+
+  if ( isFirst )
   {
 #if RExt__N0188_EXTENDED_PRECISION_PROCESSING
     const Int shift = std::max<Int>(2, (IF_INTERNAL_PREC - bitDepth));
@@ -223,6 +516,20 @@ Void TComInterpolationFilter::filter(Int bitDepth, Pel const *src, Int srcStride
     offset = (isFirst) ? -IF_INTERNAL_OFFS << shift : 0;
     maxVal = 0;
   }
+
+#if SIMD_X86
+  switch ( TComSimd::getLevel() )
+  {
+    case SIMD_AVX2:
+      xFilterAVX2 <N, isFirst, isLast>( src, srcStride, cStride, dst, dstStride, width, height, coeff, offset, shift, maxVal );
+      return;
+    case SIMD_SSE41:
+      xFilterSSE41<N, isFirst, isLast>( src, srcStride, cStride, dst, dstStride, width, height, coeff, offset, shift, maxVal );
+      return;
+    default:
+      break;
+  }
+#endif
   
   for (row = 0; row < height; row++)
   {
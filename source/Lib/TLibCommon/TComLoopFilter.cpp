@@ -39,6 +39,8 @@
 #include "TComSlice.h"
 #include "TComMv.h"
 #include "TComTU.h"
+#include "TComSimd.h"
+#include <string.h>
 
 //! \ingroup TLibCommon
 //! \{
@@ -66,6 +68,328 @@ const UChar TComLoopFilter::sm_betaTable[MAX_QP + 1] =
   0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,6,7,8,9,10,11,12,13,14,15,16,17,18,20,22,24,26,28,30,32,34,36,38,40,42,44,46,48,50,52,54,56,58,60,62,64
 };
 
+#if SIMD_X86
+// ====================================================================================================================
+// SIMD functions
+// ====================================================================================================================
+
+// The edge samples of four lines are held in 32-bit lanes, one line per lane: v[k] holds sample k of the lines, with
+// the edge between v[n/2-1] and v[n/2]. The arithmetic is that of the scalar Int code.
+
+/** load n (4 or 8) samples across the edge of four lines into v[0..n-1]
+ *  \param piSrc    pointer to sample 0 of the first line
+ *  \param iOffset  offset between the samples of a line
+ *  \param iSrcStep offset between the lines
+ *  \param numLines number of lines present (2 or 4); absent lines are zero
+ */
+static inline SIMD_TARGET_SSE41 Void xLoadEdgeSSE41( const Pel* piSrc, Int iOffset, Int iSrcStep, Int n, Int numLines, __m128i* v )
+{
+  if ( iOffset != 1 )
+  {
+    // the lines are consecutive samples
+    for ( Int k = 0; k < n; k++ )
+    {
+      const Pel* p = piSrc + k * iOffset;
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+      v[k] = ( numLines == 4 ) ? _mm_loadu_si128( (const __m128i*)p ) : _mm_loadl_epi64( (const __m128i*)p );
+#else
+      Int pair;
+      memcpy( &pair, p, sizeof(pair) );
+      v[k] = _mm_cvtepi16_epi32( ( numLines == 4 ) ? _mm_loadl_epi64( (const __m128i*)p ) : _mm_cvtsi32_si128( pair ) );
+#endif
+    }
+    return;
+  }
+
+  // the lines are rows: transpose
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  for ( Int k = 0; k < n; k++ )
+  {
+    v[k] = _mm_setr_epi32( piSrc[k], piSrc[iSrcStep + k], ( numLines == 4 ) ? piSrc[2 * iSrcStep + k] : 0, ( numLines == 4 ) ? piSrc[3 * iSrcStep + k] : 0 );
+  }
+#else
+  __m128i r[4];
+  for ( Int l = 0; l < 4; l++ )
+  {
+    const Pel* p = piSrc + l * iSrcStep;
+    r[l] = ( l >= numLines ) ? _mm_setzero_si128() : ( n == 8 ) ? _mm_loadu_si128( (const __m128i*)p ) : _mm_loadl_epi64( (const __m128i*)p );
+  }
+  const __m128i t0 = _mm_unpacklo_epi16( r[0], r[1] );
+  const __m128i t1 = _mm_unpackhi_epi16( r[0], r[1] );
+  const __m128i t2 = _mm_unpacklo_epi16( r[2], r[3] );
+  const __m128i t3 = _mm_unpackhi_epi16( r[2], r[3] );
+  __m128i u[4];
+  u[0] = _mm_unpacklo_epi32( t0, t2 );
+  u[1] = _mm_unpackhi_epi32( t0, t2 );
+  u[2] = _mm_unpacklo_epi32( t1, t3 );
+  u[3] = _mm_unpackhi_epi32( t1, t3 );
+  for ( Int k = 0; k < n; k += 2 )
+  {
+    v[k]     = _mm_cvtepi16_epi32( u[k >> 1] );
+    v[k + 1] = _mm_cvtepi16_epi32( _mm_srli_si128( u[k >> 1], 8 ) );
+  }
+#endif
+}
+
+/** store v[first..last] back to the samples loaded with xLoadEdgeSSE41()
+ */
+static inline SIMD_TARGET_SSE41 Void xStoreEdgeSSE41( Pel* piSrc, Int iOffset, Int iSrcStep, Int n, Int numLines, const __m128i* v, Int first, Int last )
+{
+  if ( iOffset != 1 )
+  {
+    for ( Int k = first; k <= last; k++ )
+    {
+      Pel* p = piSrc + k * iOffset;
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+      if ( numLines == 4 )
+      {
+        _mm_storeu_si128( (__m128i*)p, v[k] );
+      }
+      else
+      {
+        _mm_storel_epi64( (__m128i*)p, v[k] );
+      }
+#else
+      const __m128i vPel = _mm_packs_epi32( v[k], v[k] );
+      if ( numLines == 4 )
+      {
+        _mm_storel_epi64( (__m128i*)p, vPel );
+      }
+      else
+      {
+        const Int pair = _mm_cvtsi128_si32( vPel );
+        memcpy( p, &pair, sizeof(pair) );
+      }
+#endif
+    }
+    return;
+  }
+
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  Int line[8][4];
+  for ( Int k = first; k <= last; k++ )
+  {
+    _mm_storeu_si128( (__m128i*)line[k], v[k] );
+  }
+  for ( Int l = 0; l < numLines; l++ )
+  {
+    for ( Int k = first; k <= last; k++ )
+    {
+      piSrc[l * iSrcStep + k] = line[k][l];
+    }
+  }
+#else
+  // transpose back and store whole rows, the samples outside [first, last] are unchanged
+  const __m128i vZero = _mm_setzero_si128();
+  const __m128i a  = _mm_packs_epi32( v[0], v[1] );
+  const __m128i b  = _mm_packs_epi32( v[2], v[3] );
+  const __m128i c  = ( n == 8 ) ? _mm_packs_epi32( v[4], v[5] ) : vZero;
+  const __m128i d  = ( n == 8 ) ? _mm_packs_epi32( v[6], v[7] ) : vZero;
+  const __m128i t0 = _mm_unpacklo_epi16( a, b );
+  const __m128i t1 = _mm_unpackhi_epi16( a, b );
+  const __m128i t2 = _mm_unpacklo_epi16( c, d );
+  const __m128i t3 = _mm_unpackhi_epi16( c, d );
+  const __m128i u0 = _mm_unpacklo_epi16( t0, t1 );
+  const __m128i u1 = _mm_unpackhi_epi16( t0, t1 );
+  const __m128i u2 = _mm_unpacklo_epi16( t2, t3 );
+  const __m128i u3 = _mm_unpackhi_epi16( t2, t3 );
+  __m128i r[4];
+  r[0] = _mm_unpacklo_epi64( u0, u2 );
+  r[1] = _mm_unpackhi_epi64( u0, u2 );
+  r[2] = _mm_unpacklo_epi64( u1, u3 );
+  r[3] = _mm_unpackhi_epi64( u1, u3 );
+  for ( Int l = 0; l < numLines; l++ )
+  {
+    Pel* p = piSrc + l * iSrcStep;
+    if ( n == 8 )
+    {
+      _mm_storeu_si128( (__m128i*)p, r[l] );
+    }
+    else
+    {
+      _mm_storel_epi64( (__m128i*)p, r[l] );
+    }
+  }
+#endif
+}
+
+static inline SIMD_TARGET_SSE41 __m128i xClip3SSE41( __m128i vMin, __m128i vMax, __m128i v )
+{
+  return _mm_min_epi32( _mm_max_epi32( v, vMin ), vMax );
+}
+
+/** decide and filter one luma edge segment of four lines, equal to the decisions of
+ *  TComLoopFilter::xEdgeFilterLuma() and TComLoopFilter::xPelFilterLuma()
+ *  \param piSrc    pointer to the first sample of the Q side of the first line
+ *  \param iOffset  offset between the samples of a line
+ *  \param iSrcStep offset between the lines
+ */
+static SIMD_TARGET_SSE41 Void xFilterLumaSegmentSSE41( Pel* piSrc, Int iOffset, Int iSrcStep, Int iTc, Int iBeta, Bool bPartPNoFilter, Bool bPartQNoFilter, Int maxVal )
+{
+  Pel* piEdge = piSrc - 4 * iOffset;
+  __m128i m[8];
+  xLoadEdgeSSE41( piEdge, iOffset, iSrcStep, 8, 4, m );
+
+  // decisions, from lines 0 and 3
+  const __m128i vDP = _mm_abs_epi32( _mm_sub_epi32( _mm_add_epi32( m[1], m[3] ), _mm_add_epi32( m[2], m[2] ) ) );
+  const __m128i vDQ = _mm_abs_epi32( _mm_sub_epi32( _mm_add_epi32( m[4], m[6] ), _mm_add_epi32( m[5], m[5] ) ) );
+  const Int dp0 = _mm_cvtsi128_si32( vDP );
+  const Int dq0 = _mm_cvtsi128_si32( vDQ );
+  const Int dp3 = _mm_extract_epi32( vDP, 3 );
+  const Int dq3 = _mm_extract_epi32( vDQ, 3 );
+  const Int d0  = dp0 + dq0;
+  const Int d3  = dp3 + dq3;
+
+  if ( d0 + d3 >= iBeta )
+  {
+    return;
+  }
+
+  const Int iSideThreshold = ( iBeta + ( iBeta >> 1 ) ) >> 3;
+  const Bool bFilterP = ( dp0 + dp3 < iSideThreshold );
+  const Bool bFilterQ = ( dq0 + dq3 < iSideThreshold );
+
+  const __m128i vStrong = _mm_add_epi32( _mm_abs_epi32( _mm_sub_epi32( m[0], m[3] ) ), _mm_abs_epi32( _mm_sub_epi32( m[7], m[4] ) ) );
+  const __m128i vStep   = _mm_abs_epi32( _mm_sub_epi32( m[3], m[4] ) );
+  const Int stepThreshold = ( iTc * 5 + 1 ) >> 1;
+  const Bool sw = ( _mm_cvtsi128_si32( vStrong )    < ( iBeta >> 3 ) ) && ( 2 * d0 < ( iBeta >> 2 ) ) && ( _mm_cvtsi128_si32( vStep )    < stepThreshold )
+               && ( _mm_extract_epi32( vStrong, 3 ) < ( iBeta >> 3 ) ) && ( 2 * d3 < ( iBeta >> 2 ) ) && ( _mm_extract_epi32( vStep, 3 ) < stepThreshold );
+
+  __m128i r[8];
+  for ( Int k = 0; k < 8; k++ )
+  {
+    r[k] = m[k];
+  }
+
+  if ( sw )
+  {
+    const __m128i vTc2  = _mm_set1_epi32( 2 * iTc );
+    const __m128i vTwo  = _mm_set1_epi32( 2 );
+    const __m128i vFour = _mm_set1_epi32( 4 );
+    const __m128i v34   = _mm_add_epi32( m[3], m[4] );
+    const __m128i v2345 = _mm_add_epi32( _mm_add_epi32( m[2], m[5] ), v34 );  // m2 + m3 + m4 + m5
+
+    // (m1 + 2*m2 + 2*m3 + 2*m4 + m5 + 4) >> 3
+    __m128i v = _mm_add_epi32( _mm_add_epi32( m[1], m[2] ), _mm_add_epi32( v2345, v34 ) );
+    v = _mm_srai_epi32( _mm_add_epi32( v, vFour ), 3 );
+    r[3] = xClip3SSE41( _mm_sub_epi32( m[3], vTc2 ), _mm_add_epi32( m[3], vTc2 ), v );
+    // (m2 + 2*m3 + 2*m4 + 2*m5 + m6 + 4) >> 3
+    v = _mm_add_epi32( _mm_add_epi32( m[5], m[6] ), _mm_add_epi32( v2345, v34 ) );
+    v = _mm_srai_epi32( _mm_add_epi32( v, vFour ), 3 );
+    r[4] = xClip3SSE41( _mm_sub_epi32( m[4], vTc2 ), _mm_add_epi32( m[4], vTc2 ), v );
+    // (m1 + m2 + m3 + m4 + 2) >> 2
+    const __m128i v1234 = _mm_add_epi32( _mm_add_epi32( m[1], m[2] ), v34 );
+    v = _mm_srai_epi32( _mm_add_epi32( v1234, vTwo ), 2 );
+    r[2] = xClip3SSE41( _mm_sub_epi32( m[2], vTc2 ), _mm_add_epi32( m[2], vTc2 ), v );
+    // (m3 + m4 + m5 + m6 + 2) >> 2
+    const __m128i v3456 = _mm_add_epi32( _mm_add_epi32( m[5], m[6] ), v34 );
+    v = _mm_srai_epi32( _mm_add_epi32( v3456, vTwo ), 2 );
+    r[5] = xClip3SSE41( _mm_sub_epi32( m[5], vTc2 ), _mm_add_epi32( m[5], vTc2 ), v );
+    // (2*m0 + 3*m1 + m2 + m3 + m4 + 4) >> 3
+    v = _mm_add_epi32( v1234, _mm_slli_epi32( _mm_add_epi32( m[0], m[1] ), 1 ) );
+    v = _mm_srai_epi32( _mm_add_epi32( v, vFour ), 3 );
+    r[1] = xClip3SSE41( _mm_sub_epi32( m[1], vTc2 ), _mm_add_epi32( m[1], vTc2 ), v );
+    // (m3 + m4 + m5 + 3*m6 + 2*m7 + 4) >> 3
+    v = _mm_add_epi32( v3456, _mm_slli_epi32( _mm_add_epi32( m[6], m[7] ), 1 ) );
+    v = _mm_srai_epi32( _mm_add_epi32( v, vFour ), 3 );
+    r[6] = xClip3SSE41( _mm_sub_epi32( m[6], vTc2 ), _mm_add_epi32( m[6], vTc2 ), v );
+  }
+  else
+  {
+    /* Weak filter */
+    const __m128i vTc    = _mm_set1_epi32( iTc );
+    const __m128i vNegTc = _mm_set1_epi32( -iTc );
+    const __m128i vZero  = _mm_setzero_si128();
+    const __m128i vMax   = _mm_set1_epi32( maxVal );
+    const __m128i vOne   = _mm_set1_epi32( 1 );
+
+    // (9*(m4-m3) - 3*(m5-m2) + 8) >> 4
+    const __m128i v43 = _mm_sub_epi32( m[4], m[3] );
+    const __m128i v52 = _mm_sub_epi32( m[5], m[2] );
+    __m128i vDelta = _mm_sub_epi32( _mm_add_epi32( _mm_slli_epi32( v43, 3 ), v43 ), _mm_add_epi32( _mm_slli_epi32( v52, 1 ), v52 ) );
+    vDelta = _mm_srai_epi32( _mm_add_epi32( vDelta, _mm_set1_epi32( 8 ) ), 4 );
+
+    const __m128i vFilter = _mm_cmplt_epi32( _mm_abs_epi32( vDelta ), _mm_set1_epi32( iTc * 10 ) );
+    if ( _mm_testz_si128( vFilter, vFilter ) )
+    {
+      return;
+    }
+
+    vDelta = xClip3SSE41( vNegTc, vTc, vDelta );
+    r[3] = xClip3SSE41( vZero, vMax, _mm_add_epi32( m[3], vDelta ) );
+    r[4] = xClip3SSE41( vZero, vMax, _mm_sub_epi32( m[4], vDelta ) );
+
+    const __m128i vTc2    = _mm_set1_epi32( iTc >> 1 );
+    const __m128i vNegTc2 = _mm_set1_epi32( -( iTc >> 1 ) );
+    if ( bFilterP )
+    {
+      // (((m1 + m3 + 1) >> 1) - m2 + delta) >> 1
+      __m128i vDelta1 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( m[1], m[3] ), vOne ), 1 );
+      vDelta1 = _mm_srai_epi32( _mm_add_epi32( _mm_sub_epi32( vDelta1, m[2] ), vDelta ), 1 );
+      vDelta1 = xClip3SSE41( vNegTc2, vTc2, vDelta1 );
+      r[2] = xClip3SSE41( vZero, vMax, _mm_add_epi32( m[2], vDelta1 ) );
+    }
+    if ( bFilterQ )
+    {
+      // (((m6 + m4 + 1) >> 1) - m5 - delta) >> 1
+      __m128i vDelta2 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( m[6], m[4] ), vOne ), 1 );
+      vDelta2 = _mm_srai_epi32( _mm_sub_epi32( _mm_sub_epi32( vDelta2, m[5] ), vDelta ), 1 );
+      vDelta2 = xClip3SSE41( vNegTc2, vTc2, vDelta2 );
+      r[5] = xClip3SSE41( vZero, vMax, _mm_add_epi32( m[5], vDelta2 ) );
+    }
+
+    // lines with a large delta are not filtered
+    for ( Int k = 2; k <= 5; k++ )
+    {
+      r[k] = _mm_blendv_epi8( m[k], r[k], vFilter );
+    }
+  }
+
+  if ( bPartPNoFilter )
+  {
+    r[1] = m[1];
+    r[2] = m[2];
+    r[3] = m[3];
+  }
+  if ( bPartQNoFilter )
+  {
+    r[4] = m[4];
+    r[5] = m[5];
+    r[6] = m[6];
+  }
+
+  xStoreEdgeSSE41( piEdge, iOffset, iSrcStep, 8, 4, r, sw ? 1 : 2, sw ? 6 : 5 );
+}
+
+/** filter numLines (2 or 4) lines of a chroma edge, equal to TComLoopFilter::xPelFilterChroma()
+ *  \param piSrc    pointer to the first sample of the Q side of the first line
+ *  \param iOffset  offset between the samples of a line
+ *  \param iSrcStep offset between the lines
+ */
+static SIMD_TARGET_SSE41 Void xFilterChromaSegmentSSE41( Pel* piSrc, Int iOffset, Int iSrcStep, Int numLines, Int iTc, Bool bPartPNoFilter, Bool bPartQNoFilter, Int maxVal )
+{
+  Pel* piEdge = piSrc - 2 * iOffset;
+  __m128i m[4];
+  xLoadEdgeSSE41( piEdge, iOffset, iSrcStep, 4, numLines, m );
+
+  const __m128i vZero = _mm_setzero_si128();
+  const __m128i vMax  = _mm_set1_epi32( maxVal );
+
+  // Clip3(-tc, tc, ((((m4 - m3) << 2) + m2 - m5 + 4) >> 3))
+  __m128i vDelta = _mm_add_epi32( _mm_slli_epi32( _mm_sub_epi32( m[2], m[1] ), 2 ), _mm_sub_epi32( m[0], m[3] ) );
+  vDelta = _mm_srai_epi32( _mm_add_epi32( vDelta, _mm_set1_epi32( 4 ) ), 3 );
+  vDelta = xClip3SSE41( _mm_set1_epi32( -iTc ), _mm_set1_epi32( iTc ), vDelta );
+
+  __m128i r[4];
+  r[0] = m[0];
+  r[3] = m[3];
+  r[1] = bPartPNoFilter ? m[1] : xClip3SSE41( vZero, vMax, _mm_add_epi32( m[1], vDelta ) );
+  r[2] = bPartQNoFilter ? m[2] : xClip3SSE41( vZero, vMax, _mm_sub_epi32( m[2], vDelta ) );
+
+  xStoreEdgeSSE41( piEdge, iOffset, iSrcStep, 4, numLines, r, 1, 2 );
+}
+#endif
+
 // ====================================================================================================================
 // Constructor / destructor / create / destroy
 // ====================================================================================================================
@@ -154,6 +478,45 @@ Void TComLoopFilter::loopFilterPic( TComPic* pcPic )
   }
 }
 
+/**
+ - call deblocking function for every CU of a CTU row
+ .
+ The horizontal edges of a row only modify the bottom samples of the row above and read the vertically filtered
+ samples of both rows, so filtering the rows one after the other gives the same result as loopFilterPic(). The
+ samples of the row and the bottom samples of the row above are modified, so the row below must be reconstructed.
+ \param  pcPic   picture class (TComPic) pointer
+ \param  uiRow   CTU row
+ */
+Void TComLoopFilter::loopFilterCTURow( TComPic* pcPic, UInt uiRow )
+{
+  const UInt uiFirstCUAddr = uiRow * pcPic->getFrameWidthInCU();
+  const UInt uiEndCUAddr   = uiFirstCUAddr + pcPic->getFrameWidthInCU();
+
+  // Horizontal filtering
+  for ( UInt uiCUAddr = uiFirstCUAddr; uiCUAddr < uiEndCUAddr; uiCUAddr++ )
+  {
+    TComDataCU* pcCU = pcPic->getCU( uiCUAddr );
+
+    ::memset( m_aapucBS       [EDGE_VER], 0, sizeof( UChar ) * m_uiNumPartitions );
+    ::memset( m_aapbEdgeFilter[EDGE_VER], 0, sizeof( Bool  ) * m_uiNumPartitions );
+
+    // CU-based deblocking
+    xDeblockCU( pcCU, 0, 0, EDGE_VER );
+  }
+
+  // Vertical filtering
+  for ( UInt uiCUAddr = uiFirstCUAddr; uiCUAddr < uiEndCUAddr; uiCUAddr++ )
+  {
+    TComDataCU* pcCU = pcPic->getCU( uiCUAddr );
+
+    ::memset( m_aapucBS       [EDGE_HOR], 0, sizeof( UChar ) * m_uiNumPartitions );
+    ::memset( m_aapbEdgeFilter[EDGE_HOR], 0, sizeof( Bool  ) * m_uiNumPartitions );
+
+    // CU-based deblocking
+    xDeblockCU( pcCU, 0, 0, EDGE_HOR );
+  }
+}
+
 
 // ====================================================================================================================
 // Protected member functions
@@ -614,17 +977,6 @@ Void TComLoopFilter::xEdgeFilterLuma( TComDataCU* pcCU, UInt uiAbsZorderIdx, UIn
       UInt  uiBlocksInPart = uiPelsInPart / 4 ? uiPelsInPart / 4 : 1;
       for (UInt iBlkIdx = 0; iBlkIdx<uiBlocksInPart; iBlkIdx ++)
       {
-        Int dp0 = xCalcDP( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+0), iOffset);
-        Int dq0 = xCalcDQ( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+0), iOffset);
-        Int dp3 = xCalcDP( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+3), iOffset);
-        Int dq3 = xCalcDQ( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+3), iOffset);
-        Int d0 = dp0 + dq0;
-        Int d3 = dp3 + dq3;
-
-        Int dp = dp0 + dp3;
-        Int dq = dq0 + dq3;
-        Int d =  d0 + d3;
-
         if (bPCMFilter || pcCU->getSlice()->getPPS()->getTransquantBypassEnableFlag())
         {
           // Check if each of PUs is I_PCM with LF disabling
@@ -636,6 +988,25 @@ Void TComLoopFilter::xEdgeFilterLuma( TComDataCU* pcCU, UInt uiAbsZorderIdx, UIn
           bPartQNoFilter = bPartQNoFilter || (pcCUQ->isLosslessCoded(uiPartQIdx) );
         }
 
+#if SIMD_X86
+        if (TComSimd::getLevel() != SIMD_SCALAR)
+        {
+          xFilterLumaSegmentSSE41( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4), iOffset, iSrcStep, iTc, iBeta, bPartPNoFilter, bPartQNoFilter, (1 << g_bitDepth[CHANNEL_TYPE_LUMA]) - 1 );
+          continue;
+        }
+#endif
+
+        Int dp0 = xCalcDP( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+0), iOffset);
+        Int dq0 = xCalcDQ( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+0), iOffset);
+        Int dp3 = xCalcDP( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+3), iOffset);
+        Int dq3 = xCalcDQ( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+3), iOffset);
+        Int d0 = dp0 + dq0;
+        Int d3 = dp3 + dq3;
+
+        Int dp = dp0 + dp3;
+        Int dq = dq0 + dq3;
+        Int d =  d0 + d3;
+
         if (d < iBeta)
         {
           Bool bFilterP = (dp < iSideThreshold);
@@ -770,6 +1141,17 @@ Void TComLoopFilter::xEdgeFilterChroma( TComDataCU* pcCU, UInt uiAbsZorderIdx, U
         Int iIndexTC = Clip3(0, MAX_QP+DEFAULT_INTRA_TC_OFFSET, iQP + DEFAULT_INTRA_TC_OFFSET*(ucBs - 1) + (tcOffsetDiv2 << 1));
         Int iTc =  sm_tcTable[iIndexTC]*iBitdepthScale;
 
+#if SIMD_X86
+        if (TComSimd::getLevel() != SIMD_SCALAR && (uiLoopLength % 2) == 0)
+        {
+          for ( UInt uiStep = 0; uiStep < uiLoopLength; uiStep += 4 )
+          {
+            xFilterChromaSegmentSSE41( piTmpSrcChroma + iSrcStep*(uiStep+iIdx*uiLoopLength), iOffset, iSrcStep, std::min<Int>(4, uiLoopLength - uiStep), iTc, bPartPNoFilter, bPartQNoFilter, (1 << g_bitDepth[CHANNEL_TYPE_CHROMA]) - 1 );
+          }
+          continue;
+        }
+#endif
+
         for ( UInt uiStep = 0; uiStep < uiLoopLength; uiStep++ )
         {
           xPelFilterChroma( piTmpSrcChroma + iSrcStep*(uiStep+iIdx*uiLoopLength), iOffset, iTc , bPartPNoFilter, bPartQNoFilter);
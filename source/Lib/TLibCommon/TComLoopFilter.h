@@ -131,6 +131,9 @@ public:
   /// picture-level deblocking filter
   Void loopFilterPic( TComPic* pcPic );
 
+  /// deblocking filter of one CTU row, after the rows above it
+  Void loopFilterCTURow( TComPic* pcPic, UInt uiRow );
+
   static Int getBeta( Int qp )
   {
     Int indexB = Clip3( 0, MAX_QP, qp );
@@ -41,10 +41,37 @@
 #include "TComTU.h"
 #include "Debug.h"
 #include "TComPrediction.h"
+#include "TComSimd.h"
 
 //! \ingroup TLibCommon
 //! \{
 
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+// ====================================================================================================================
+// SIMD functions
+// ====================================================================================================================
+
+/** [1 2 1] filter of n reference samples of a row, pDst[i] = (pSrc[i-1] + 2*pSrc[i] + pSrc[i+1] + 2) >> 2
+ *
+ * The filter is computed as avg(((pSrc[i-1] + pSrc[i+1]) >> 1), pSrc[i]), which cannot overflow 16 bits.
+ */
+static SIMD_TARGET_SSE41 Void xFilterReferenceRowSSE41( const Pel* pSrc, Pel* pDst, Int n )
+{
+  Int i = 0;
+  for (; i + 8 <= n; i += 8)
+  {
+    const __m128i l = _mm_loadu_si128( (const __m128i*)(pSrc + i - 1) );
+    const __m128i c = _mm_loadu_si128( (const __m128i*)(pSrc + i    ) );
+    const __m128i r = _mm_loadu_si128( (const __m128i*)(pSrc + i + 1) );
+    _mm_storeu_si128( (__m128i*)(pDst + i), _mm_avg_epu16( _mm_srli_epi16( _mm_add_epi16( l, r ), 1 ), c ) );
+  }
+  for (; i < n; i++)
+  {
+    pDst[i] = ( pSrc[i+1] + 2*pSrc[i] + pSrc[i-1] + 2 ) >> 2;
+  }
+}
+#endif
+
 // Forward declarations
 
 /// padding of unavailable reference samples for intra prediction
@@ -260,6 +287,14 @@ Void TComPrediction::initAdiPatternChType( TComTU &rTu, Bool& bAbove, Bool& bLef
 
         piSrcPtr += uiTuWidth2 - 1;
       }
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+      else if (TComSimd::getLevel() != SIMD_SCALAR)
+      {
+        xFilterReferenceRowSSE41(piSrcPtr, piDestPtr, uiTuWidth2 - 1);
+        piDestPtr += uiTuWidth2 - 1;
+        piSrcPtr  += uiTuWidth2 - 1;
+      }
+#endif
       else
       {
         for(UInt i=1; i<uiTuWidth2; i++, piDestPtr++, piSrcPtr++)
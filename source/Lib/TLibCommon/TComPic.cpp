@@ -86,6 +86,10 @@ Void TComPic::create( Int iWidth, Int iHeight, ChromaFormat chromaFormatIDC, UIn
   }
   m_apcPicYuv[PIC_YUV_REC]  = new TComPicYuv;  m_apcPicYuv[PIC_YUV_REC]->create( iWidth, iHeight, chromaFormatIDC, uiMaxWidth, uiMaxHeight, uiMaxDepth );
 
+  // a new picture is complete unless it is decoded in parallel with the pictures referencing it
+  m_cFilteredRows.create( 1 );
+  m_cFilteredRows.reset( getFrameHeightInCU() );
+
   // there are no SEI messages associated with this picture initially
   if (m_SEIs.size() > 0)
   {
@@ -124,6 +128,8 @@ Void TComPic::destroy()
     }
   }
 
+  m_cFilteredRows.destroy();
+
   deleteSEIs(m_SEIs);
 }
 
@@ -137,6 +143,19 @@ Void TComPic::compressMotion()
   }
 }
 
+/** Compress the motion of one CTU row
+ * \param uiRow CTU row, the motion of the row is no longer needed for the deblocking and the MV prediction of the picture
+ */
+Void TComPic::compressMotionCTURow( UInt uiRow )
+{
+  TComPicSym* pPicSym = getPicSym();
+  for ( UInt uiCUAddr = uiRow*pPicSym->getFrameWidthInCU(); uiCUAddr < (uiRow+1)*pPicSym->getFrameWidthInCU(); uiCUAddr++ )
+  {
+    TComDataCU* pcCU = pPicSym->getCU(uiCUAddr);
+    pcCU->compressMV();
+  }
+}
+
 /** Create non-deblocked filter information
  * \param pSliceStartAddress array for storing slice start addresses
  * \param numSlices number of slices in picture
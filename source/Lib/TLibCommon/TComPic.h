@@ -43,6 +43,7 @@
 #include "TComPicSym.h"
 #include "TComPicYuv.h"
 #include "TComBitStream.h"
+#include "TComThreadPool.h"
 
 //! \ingroup TLibCommon
 //! \{
@@ -95,6 +96,8 @@ private:
 
   SEIMessages  m_SEIs; ///< Any SEI messages that have been received.  If !NULL we own the object.
 
+  TComProgressCounters  m_cFilteredRows;      ///< number of CTU rows that are reconstructed and in-loop filtered (frame-parallel decoding)
+
 public:
   TComPic();
   virtual ~TComPic();
@@ -154,6 +157,13 @@ public:
   Int           getNumReorderPics(UInt tlayer)        { return m_numReorderPics[tlayer]; }
 
   Void          compressMotion();
+  Void          compressMotionCTURow( UInt uiRow );
+
+  /// frame-parallel decoding: a picture that references this picture waits until the CTU rows it reads are final
+  Void          resetFilteredRows()                    { m_cFilteredRows.reset( 0 );                 }
+  Void          setFilteredRows( Int iNumRows )        { m_cFilteredRows.set( 0, iNumRows );         }
+  Void          waitForFilteredRows( Int iNumRows )    { m_cFilteredRows.waitFor( 0, iNumRows );     }
+
   UInt          getCurrSliceIdx() const           { return m_uiCurrSliceIdx;                }
   Void          setCurrSliceIdx(UInt i)      { m_uiCurrSliceIdx = i;                   }
   UInt          getNumAllocatedSlice() const      {return m_apcPicSym->getNumAllocatedSlice();}
@@ -107,7 +107,7 @@ Void TComPicSym::create  ( ChromaFormat chromaFormatIDC, Int iPicWidth, Int iPic
     m_apcTComDataCU[i] = new TComDataCU;
     m_apcTComDataCU[i]->create( chromaFormatIDC, m_uiNumPartitions, m_uiMaxCUWidth, m_uiMaxCUHeight, false, m_uiMaxCUWidth >> m_uhTotalDepth
 #if ADAPTIVE_QP_SELECTION
-      , true
+      , false
 #endif     
       );
   }
@@ -46,11 +46,52 @@
 #endif
 
 #include "TComPicYuv.h"
+#include "TComSimd.h"
 #include "TLibVideoIO/TVideoIOYuv.h"
 
 //! \ingroup TLibCommon
 //! \{
 
+#if SIMD_X86
+// ====================================================================================================================
+// SIMD functions
+// ====================================================================================================================
+
+/** Fill the left and right margins of picture lines with the first and last sample of each line, with SSE4.1.
+ * \param pi       first sample of the first line
+ * \param iStride  picture stride
+ * \param iWidth   picture width
+ * \param iMarginX margin width
+ * \param iLines   number of lines
+ */
+static SIMD_TARGET_SSE41 Void extendMarginsSSE41( Pel* pi, Int iStride, Int iWidth, Int iMarginX, Int iLines )
+{
+  const Int iStep = Int(sizeof(__m128i) / sizeof(Pel));
+
+  for (Int y = 0; y < iLines; y++, pi += iStride)
+  {
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+    const __m128i vLeft  = _mm_set1_epi32( pi[0] );
+    const __m128i vRight = _mm_set1_epi32( pi[iWidth-1] );
+#else
+    const __m128i vLeft  = _mm_set1_epi16( pi[0] );
+    const __m128i vRight = _mm_set1_epi16( pi[iWidth-1] );
+#endif
+    Int x = 0;
+    for (; x + iStep <= iMarginX; x += iStep)
+    {
+      _mm_storeu_si128( (__m128i*)(pi - iMarginX + x), vLeft  );
+      _mm_storeu_si128( (__m128i*)(pi + iWidth   + x), vRight );
+    }
+    for (; x < iMarginX; x++)
+    {
+      pi[ -iMarginX + x ] = pi[0];
+      pi[    iWidth + x ] = pi[iWidth-1];
+    }
+  }
+}
+#endif
+
 TComPicYuv::TComPicYuv()
 {
   for(UInt i=0; i<MAX_NUM_COMPONENT; i++)
@@ -174,6 +215,18 @@ Void TComPicYuv::extendPicBorder ()
 {
   if ( m_bIsBorderExtended ) return;
 
+  extendPicBorderLines( 0, m_iPicHeight );
+
+  m_bIsBorderExtended = true;
+}
+
+/** Extend the left and right margins of a range of luma lines and of the corresponding chroma lines.
+ * The top margin is extended with the first line and the bottom margin with the last line of the picture.
+ * \param iFirstLine first luma line
+ * \param iEndLine   luma line following the last one
+ */
+Void TComPicYuv::extendPicBorderLines ( Int iFirstLine, Int iEndLine )
+{
   for(Int chan=0; chan<getNumberValidComponents(); chan++)
   {
     const ComponentID ch=ComponentID(chan);
@@ -183,10 +236,19 @@ Void TComPicYuv::extendPicBorder ()
     const Int iHeight=getHeight(ch);
     const Int iMarginX=getMarginX(ch);
     const Int iMarginY=getMarginY(ch);
+    const Int iFirstY=iFirstLine >> getComponentScaleY(ch);
+    const Int iEndY=iEndLine >> getComponentScaleY(ch);
 
-    Pel*  pi = piTxt;
+    Pel*  pi = piTxt + iFirstY * iStride;
     // do left and right margins
-    for (Int y = 0; y < iHeight; y++)
+#if SIMD_X86
+    if (TComSimd::getLevel() != SIMD_SCALAR)
+    {
+      extendMarginsSSE41( pi, iStride, iWidth, iMarginX, iEndY - iFirstY );
+    }
+    else
+#endif
+    for (Int y = iFirstY; y < iEndY; y++)
     {
       for (Int x = 0; x < iMarginX; x++ )
       {
@@ -196,24 +258,26 @@ Void TComPicYuv::extendPicBorder ()
       pi += iStride;
     }
 
-    // pi is now the (0,height) (bottom left of image within bigger picture
-    pi -= (iStride + iMarginX);
-    // pi is now the (-marginX, height-1)
-    for (Int y = 0; y < iMarginY; y++ )
+    if (iEndY == iHeight)
     {
-      ::memcpy( pi + (y+1)*iStride, pi, sizeof(Pel)*(iWidth + (iMarginX<<1)) );
+      pi = piTxt + (iHeight-1) * iStride - iMarginX;
+      // pi is now the (-marginX, height-1)
+      for (Int y = 0; y < iMarginY; y++ )
+      {
+        ::memcpy( pi + (y+1)*iStride, pi, sizeof(Pel)*(iWidth + (iMarginX<<1)) );
+      }
     }
 
-    // pi is still (-marginX, height-1)
-    pi -= ((iHeight-1) * iStride);
-    // pi is now (-marginX, 0)
-    for (Int y = 0; y < iMarginY; y++ )
+    if (iFirstY == 0)
     {
-      ::memcpy( pi - (y+1)*iStride, pi, sizeof(Pel)*(iWidth + (iMarginX<<1)) );
+      pi = piTxt - iMarginX;
+      // pi is now (-marginX, 0)
+      for (Int y = 0; y < iMarginY; y++ )
+      {
+        ::memcpy( pi - (y+1)*iStride, pi, sizeof(Pel)*(iWidth + (iMarginX<<1)) );
+      }
     }
   }
-  
-  m_bIsBorderExtended = true;
 }
 
 
@@ -150,6 +150,7 @@ public:
   
   //  Extend function of picture buffer
   Void          extendPicBorder   ();
+  Void          extendPicBorderLines ( Int iFirstLine, Int iEndLine );
   
   //  Dump picture
   Void          dump              (const Char* pFileName, Bool bAdd = false) const ;
@@ -38,6 +38,7 @@
 #include <memory.h>
 #include "TComPrediction.h"
 #include "TComTU.h"
+#include "TComSimd.h"
 
 //! \ingroup TLibCommon
 //! \{
@@ -65,6 +66,185 @@ const UChar TComPrediction::m_aucIntraFilter[MAX_NUM_CHANNEL_TYPE][MAX_INTRA_FIL
 
 };
 
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+// ====================================================================================================================
+// SIMD functions
+// ====================================================================================================================
+
+// All block dimensions are multiples of 4.
+
+/** sum of n samples, n a multiple of 4
+ */
+static SIMD_TARGET_SSE41 Int xSumSamplesSSE41( const Pel* pSrc, Int n )
+{
+  const __m128i one = _mm_set1_epi16( 1 );
+  __m128i sum = _mm_setzero_si128();
+  Int x = 0;
+  for (; x + 8 <= n; x += 8)
+  {
+    sum = _mm_add_epi32( sum, _mm_madd_epi16( _mm_loadu_si128( (const __m128i*)(pSrc + x) ), one ) );
+  }
+  if (x < n)
+  {
+    sum = _mm_add_epi32( sum, _mm_madd_epi16( _mm_loadl_epi64( (const __m128i*)(pSrc + x) ), one ) );
+  }
+  sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, 0x4e ) );
+  sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, 0xb1 ) );
+  return _mm_cvtsi128_si32( sum );
+}
+
+/** fill a block with one value
+ */
+static SIMD_TARGET_SSE41 Void xFillBlockSSE41( Pel* pDst, Int dstStride, Int width, Int height, Pel val )
+{
+  const __m128i v = _mm_set1_epi16( val );
+  for (Int y = 0; y < height; y++, pDst += dstStride)
+  {
+    Int x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+      _mm_storeu_si128( (__m128i*)(pDst + x), v );
+    }
+    if (x < width)
+    {
+      _mm_storel_epi64( (__m128i*)(pDst + x), v );
+    }
+  }
+}
+
+/** interpolate one row of an angular prediction, pDst[x] = ((32-deltaFract)*pRef[x] + deltaFract*pRef[x+1] + 16) >> 5
+ */
+static SIMD_TARGET_SSE41 Void xPredIntraAngRowSSE41( const Pel* pRef, Pel* pDst, Int width, Int deltaFract )
+{
+  const __m128i coeff  = _mm_set1_epi32( (deltaFract << 16) | (32 - deltaFract) );
+  const __m128i offset = _mm_set1_epi32( 16 );
+  Int x = 0;
+  for (; x + 8 <= width; x += 8)
+  {
+    const __m128i a  = _mm_loadu_si128( (const __m128i*)(pRef + x) );
+    const __m128i b  = _mm_loadu_si128( (const __m128i*)(pRef + x + 1) );
+    const __m128i lo = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( a, b ), coeff ), offset ), 5 );
+    const __m128i hi = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( a, b ), coeff ), offset ), 5 );
+    _mm_storeu_si128( (__m128i*)(pDst + x), _mm_packs_epi32( lo, hi ) );
+  }
+  if (x < width)
+  {
+    const __m128i a  = _mm_loadl_epi64( (const __m128i*)(pRef + x) );
+    const __m128i b  = _mm_loadl_epi64( (const __m128i*)(pRef + x + 1) );
+    const __m128i lo = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( a, b ), coeff ), offset ), 5 );
+    _mm_storel_epi64( (__m128i*)(pDst + x), _mm_packs_epi32( lo, lo ) );
+  }
+}
+
+/** AVX2 version of xPredIntraAngRowSSE41() for rows of at least 16 samples
+ */
+static SIMD_TARGET_AVX2 Void xPredIntraAngRowAVX2( const Pel* pRef, Pel* pDst, Int width, Int deltaFract )
+{
+  const __m256i coeff  = _mm256_set1_epi32( (deltaFract << 16) | (32 - deltaFract) );
+  const __m256i offset = _mm256_set1_epi32( 16 );
+  Int x = 0;
+  for (; x + 16 <= width; x += 16)
+  {
+    // the unpacks and the pack work within 128-bit lanes, so the sample order is preserved
+    const __m256i a  = _mm256_loadu_si256( (const __m256i*)(pRef + x) );
+    const __m256i b  = _mm256_loadu_si256( (const __m256i*)(pRef + x + 1) );
+    const __m256i lo = _mm256_srai_epi32( _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpacklo_epi16( a, b ), coeff ), offset ), 5 );
+    const __m256i hi = _mm256_srai_epi32( _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpackhi_epi16( a, b ), coeff ), offset ), 5 );
+    _mm256_storeu_si256( (__m256i*)(pDst + x), _mm256_packs_epi32( lo, hi ) );
+  }
+  if (x < width)
+  {
+    xPredIntraAngRowSSE41( pRef + x, pDst + x, width - x, deltaFract );
+  }
+}
+
+/** transpose a block, pDst[x*dstStride+y] = pSrc[y*srcStride+x], in 4x4 tiles
+ */
+static SIMD_TARGET_SSE41 Void xTransposeSSE41( const Pel* pSrc, Int srcStride, Pel* pDst, Int dstStride, Int width, Int height )
+{
+  for (Int y = 0; y < height; y += 4)
+  {
+    for (Int x = 0; x < width; x += 4)
+    {
+      const Pel* s = pSrc + y * srcStride + x;
+      Pel*       d = pDst + x * dstStride + y;
+      const __m128i r0 = _mm_loadl_epi64( (const __m128i*)(s                ) );
+      const __m128i r1 = _mm_loadl_epi64( (const __m128i*)(s +     srcStride) );
+      const __m128i r2 = _mm_loadl_epi64( (const __m128i*)(s + 2 * srcStride) );
+      const __m128i r3 = _mm_loadl_epi64( (const __m128i*)(s + 3 * srcStride) );
+      const __m128i t0 = _mm_unpacklo_epi16( r0, r1 );
+      const __m128i t1 = _mm_unpacklo_epi16( r2, r3 );
+      const __m128i c01 = _mm_unpacklo_epi32( t0, t1 );
+      const __m128i c23 = _mm_unpackhi_epi32( t0, t1 );
+      _mm_storel_epi64( (__m128i*)(d                ), c01 );
+      _mm_storel_epi64( (__m128i*)(d +     dstStride), _mm_unpackhi_epi64( c01, c01 ) );
+      _mm_storel_epi64( (__m128i*)(d + 2 * dstStride), c23 );
+      _mm_storel_epi64( (__m128i*)(d + 3 * dstStride), _mm_unpackhi_epi64( c23, c23 ) );
+    }
+  }
+}
+
+/** planar prediction, computing the same intermediate values as the scalar code of xPredIntraPlanar() in 32-bit lanes
+ */
+static SIMD_TARGET_SSE41 Void xPredIntraPlanarSSE41( const Pel* pSrc, Int srcStride, Pel* pDst, Int dstStride, Int width, Int height,
+                                                     Int shift1Dhor, Int shift1Dver, Int topRowShift )
+{
+  Int topRow[MAX_CU_SIZE], bottomRow[MAX_CU_SIZE];
+  const Int bottomLeft = pSrc[height * srcStride - 1];
+  const Int topRight   = pSrc[width - srcStride];
+
+  for (Int x = 0; x < width; x += 4)
+  {
+    const __m128i top = _mm_cvtepi16_epi32( _mm_loadl_epi64( (const __m128i*)(pSrc - srcStride + x) ) );
+    _mm_storeu_si128( (__m128i*)(topRow    + x), _mm_slli_epi32( top, shift1Dver ) );
+    _mm_storeu_si128( (__m128i*)(bottomRow + x), _mm_sub_epi32( _mm_set1_epi32( bottomLeft ), top ) );
+  }
+
+  const __m128i vTopRowShift = _mm_cvtsi32_si128( topRowShift );
+  const __m128i vTopRowRound = _mm_set1_epi32( topRowShift );
+  const __m128i vShift       = _mm_cvtsi32_si128( shift1Dhor + 1 );
+  const __m128i steps        = _mm_setr_epi32( 1, 2, 3, 4 );
+
+  for (Int y = 0; y < height; y++, pDst += dstStride)
+  {
+    const Int left  = pSrc[y * srcStride - 1];
+    const Int right = topRight - left;
+    __m128i horPred = _mm_add_epi32( _mm_set1_epi32( (left << shift1Dhor) + width ), _mm_mullo_epi32( steps, _mm_set1_epi32( right ) ) );
+    const __m128i horStep = _mm_set1_epi32( 4 * right );
+
+    for (Int x = 0; x < width; x += 4)
+    {
+      const __m128i top = _mm_add_epi32( _mm_loadu_si128( (const __m128i*)(topRow + x) ), _mm_loadu_si128( (const __m128i*)(bottomRow + x) ) );
+      _mm_storeu_si128( (__m128i*)(topRow + x), top );
+
+      const __m128i vertPred = _mm_sra_epi32( _mm_add_epi32( top, vTopRowRound ), vTopRowShift );
+      const __m128i pred     = _mm_sra_epi32( _mm_add_epi32( horPred, vertPred ), vShift );
+      _mm_storel_epi64( (__m128i*)(pDst + x), _mm_packs_epi32( pred, pred ) );
+      horPred = _mm_add_epi32( horPred, horStep );
+    }
+  }
+}
+
+/** filter the top row of a DC prediction, pDst[x] = (pAbove[x] + 3*pDst[x] + 2) >> 2, for n samples
+ *
+ * (a + 3*b + 2) >> 2 is computed as avg(((a + b) >> 1), b), which cannot overflow 16 bits.
+ */
+static SIMD_TARGET_SSE41 Void xDCPredFilterRowSSE41( const Pel* pAbove, Pel* pDst, Int n )
+{
+  Int x = 0;
+  for (; x + 8 <= n; x += 8)
+  {
+    const __m128i a = _mm_loadu_si128( (const __m128i*)(pAbove + x) );
+    const __m128i b = _mm_loadu_si128( (const __m128i*)(pDst + x) );
+    _mm_storeu_si128( (__m128i*)(pDst + x), _mm_avg_epu16( _mm_srli_epi16( _mm_add_epi16( a, b ), 1 ), b ) );
+  }
+  for (; x < n; x++)
+  {
+    pDst[x] = (Pel)((pAbove[x] + 3 * pDst[x] + 2) >> 2);
+  }
+}
+#endif
+
 // ====================================================================================================================
 // Constructor / destructor / initialize
 // ====================================================================================================================
@@ -173,9 +353,18 @@ Pel TComPrediction::predIntraGetPredValDC( const Pel* pSrc, Int iSrcStride, UInt
 
   if (bAbove)
   {
-    for (iInd = 0;iInd < iWidth;iInd++)
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+    if (TComSimd::getLevel() != SIMD_SCALAR)
+    {
+      iSum += xSumSamplesSSE41(pSrc-iSrcStride, iWidth);
+    }
+    else
+#endif
     {
-      iSum += pSrc[iInd-iSrcStride];
+      for (iInd = 0;iInd < iWidth;iInd++)
+      {
+        iSum += pSrc[iInd-iSrcStride];
+      }
     }
   }
   if (bLeft)
@@ -246,6 +435,13 @@ Void TComPrediction::xPredIntraAng(       Int bitDepth,
   {
     const Pel dcval = predIntraGetPredValDC(pSrc, srcStride, width, height, channelType, format, blkAboveAvailable, blkLeftAvailable);
 
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+    if (TComSimd::getLevel() != SIMD_SCALAR)
+    {
+      xFillBlockSSE41(pTrueDst, dstStrideTrue, width, height, dcval);
+      return;
+    }
+#endif
     for (Int y=height;y>0;y--, pTrueDst+=dstStrideTrue)
     {
       for (Int x=0; x<width;) // width is always a multiple of 4.
@@ -271,6 +467,9 @@ Void TComPrediction::xPredIntraAng(       Int bitDepth,
 
     Pel* refMain;
     Pel* refSide;
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+    const SimdLevel simdLevel = TComSimd::getLevel();
+#endif
 
     Pel  refAbove[2*MAX_CU_SIZE+1];
     Pel  refLeft[2*MAX_CU_SIZE+1];
@@ -326,10 +525,7 @@ Void TComPrediction::xPredIntraAng(       Int bitDepth,
     {
       for (Int y=0;y<height;y++)
       {
-        for (Int x=0;x<width;x++)
-        {
-          pDst[y*dstStride+x] = refMain[x+1];
-        }
+        memcpy(pDst+y*dstStride, refMain+1, width*sizeof(Pel));
       }
 
       if (edgeFilter)
@@ -349,6 +545,17 @@ Void TComPrediction::xPredIntraAng(       Int bitDepth,
         const Int deltaInt   = deltaPos >> 5;
         const Int deltaFract = deltaPos & (32 - 1);
 
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+        if (deltaFract && simdLevel == SIMD_AVX2 && width >= 16)
+        {
+          xPredIntraAngRowAVX2(refMain+deltaInt+1, pDsty, width, deltaFract);
+        }
+        else if (deltaFract && simdLevel != SIMD_SCALAR)
+        {
+          xPredIntraAngRowSSE41(refMain+deltaInt+1, pDsty, width, deltaFract);
+        }
+        else
+#endif
         if (deltaFract)
         {
           // Do linear filtering
@@ -364,15 +571,19 @@ Void TComPrediction::xPredIntraAng(       Int bitDepth,
         else
         {
           // Just copy the integer samples
-          for (Int x=0;x<width; x++)
-          {
-            pDsty[x] = refMain[x+deltaInt+1];
-          }
+          memcpy(pDsty, refMain+deltaInt+1, width*sizeof(Pel));
         }
       }
     }
 
     // Flip the block if this is the horizontal mode
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+    if (!bIsModeVer && simdLevel != SIMD_SCALAR)
+    {
+      xTransposeSSE41(pDst, dstStride, pTrueDst, dstStrideTrue, width, height);
+    }
+    else
+#endif
     if (!bIsModeVer)
     {
       for (Int y=0; y<height; y++)
@@ -777,6 +988,20 @@ Void TComPrediction::xPredIntraPlanar( const Pel* pSrc, Int srcStride, Pel* rpDs
   UInt shift1Dhor = g_aucConvertToBit[ width ] + 2;
   UInt shift1Dver = g_aucConvertToBit[ height ] + 2;
 
+#if (RExt__SQUARE_TRANSFORM_CHROMA_422 != 0)
+  const UInt topRowShift = 0;
+#else
+  const UInt topRowShift = (isChroma(channelType) && (format == CHROMA_422)) ? 1 : 0;
+#endif
+
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+  if (TComSimd::getLevel() != SIMD_SCALAR)
+  {
+    xPredIntraPlanarSSE41(pSrc, srcStride, rpDst, dstStride, width, height, shift1Dhor, shift1Dver, topRowShift);
+    return;
+  }
+#endif
+
   // Get left and above reference column and row
   for(Int k=0;k<width+1;k++)
   {
@@ -804,12 +1029,6 @@ Void TComPrediction::xPredIntraPlanar( const Pel* pSrc, Int srcStride, Pel* rpDs
     leftColumn[k]   <<= shift1Dhor;
   }
 
-#if (RExt__SQUARE_TRANSFORM_CHROMA_422 != 0)
-  const UInt topRowShift = 0;
-#else
-  const UInt topRowShift = (isChroma(channelType) && (format == CHROMA_422)) ? 1 : 0;
-#endif
-
   // Generate prediction signal
   for (Int y=0;y<height;y++)
   {
@@ -849,9 +1068,18 @@ Void TComPrediction::xDCPredFiltering( const Pel* pSrc, Int iSrcStride, Pel*& rp
     pDst[0] = (Pel)((pSrc[-iSrcStride] + pSrc[-1] + 2 * pDst[0] + 2) >> 2);
 
     //top row (vertical filter)
-    for ( x = 1; x < iWidth; x++ )
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+    if (TComSimd::getLevel() != SIMD_SCALAR)
     {
-      pDst[x] = (Pel)((pSrc[x - iSrcStride] +  3 * pDst[x] + 2) >> 2);
+      xDCPredFilterRowSSE41(pSrc + 1 - iSrcStride, pDst + 1, iWidth - 1);
+    }
+    else
+#endif
+    {
+      for ( x = 1; x < iWidth; x++ )
+      {
+        pDst[x] = (Pel)((pSrc[x - iSrcStride] +  3 * pDst[x] + 2) >> 2);
+      }
     }
 
     //left column (horizontal filter)
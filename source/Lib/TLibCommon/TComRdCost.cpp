@@ -342,6 +342,15 @@ Void TComRdCost::init()
   m_afpDistortFunc[DF_HADS64 ] = TComRdCost::xGetHADs;
   m_afpDistortFunc[DF_HADS16N] = TComRdCost::xGetHADs;
 
+#if SIMD_X86
+  switch ( TComSimd::getLevel() )
+  {
+    case SIMD_AVX2:  xSetSimdDistortionFunctions<SIMD_AVX2>();  break;
+    case SIMD_SSE41: xSetSimdDistortionFunctions<SIMD_SSE41>(); break;
+    default:         break;
+  }
+#endif
+
 #if RExt__LOSSLESS_AND_MIXED_LOSSLESS_RD_COST_EVALUATION
   m_costMode                = COST_STANDARD_LOSSY;
 #endif
@@ -535,47 +544,17 @@ TComRdCost::setDistParam( DistParam& rcDP, Int bitDepth, Pel* p1, Int iStride1,
 
 Distortion TComRdCost::calcHAD( Int bitDepth, Pel* pi0, Int iStride0, Pel* pi1, Int iStride1, Int iWidth, Int iHeight )
 {
-  Distortion uiSum = 0;
-  Int x, y;
-  
-  if ( ( (iWidth % 8) == 0 ) && ( (iHeight % 8) == 0 ) )
-  {
-    for ( y=0; y<iHeight; y+= 8 )
-    {
-      for ( x=0; x<iWidth; x+= 8 )
-      {
-        uiSum += xCalcHADs8x8( &pi0[x], &pi1[x], iStride0, iStride1, 1 );
-      }
-      pi0 += iStride0*8;
-      pi1 += iStride1*8;
-    }
-  }
-  else if ( ( (iWidth % 4) == 0 ) && ( (iHeight % 4) == 0 ) )
-  {
-    for ( y=0; y<iHeight; y+= 4 )
-    {
-      for ( x=0; x<iWidth; x+= 4 )
-      {
-        uiSum += xCalcHADs4x4( &pi0[x], &pi1[x], iStride0, iStride1, 1 );
-      }
-      pi0 += iStride0*4;
-      pi1 += iStride1*4;
-    }
-  }
-  else
-  {
-    for ( y=0; y<iHeight; y+= 2 )
-    {
-      for ( x=0; x<iWidth; x+= 2 )
-      {
-        uiSum += xCalcHADs2x2( &pi0[x], &pi1[x], iStride0, iStride1, 1 );
-      }
-      pi0 += iStride0*2;
-      pi1 += iStride1*2;
-    }
-  }
-  
-  return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT(bitDepth-8) );
+  // same as the general size Hadamard function of the motion search
+  DistParam cDtParam;
+  cDtParam.pOrg         = pi0;
+  cDtParam.pCur         = pi1;
+  cDtParam.iStrideOrg   = iStride0;
+  cDtParam.iStrideCur   = iStride1;
+  cDtParam.iCols        = iWidth;
+  cDtParam.iRows        = iHeight;
+  cDtParam.bitDepth     = bitDepth;
+  cDtParam.bApplyWeight = false;
+  return m_afpDistortFunc[DF_HADS]( &cDtParam );
 }
 
 #if WEIGHTED_CHROMA_DISTORTION
@@ -2124,4 +2103,620 @@ Distortion TComRdCost::xGetHADs( DistParam* pcDtParam )
   return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8) );
 }
 
+#if SIMD_X86
+// ====================================================================================================================
+// SIMD distortion functions
+// ====================================================================================================================
+
+// The sums are formed in 32-bit lanes. With 16-bit samples the sums of a block wrap around exactly as the scalar
+// 32-bit sums do; with RExt__HIGH_BIT_DEPTH_SUPPORT the sums of each row are widened into 64-bit lanes.
+
+/// sum of the absolute differences of 8 samples, in four 32-bit lanes
+static inline SIMD_TARGET_SSE41 __m128i xAbsDiff8SSE41( const Pel* piOrg, const Pel* piCur )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  const __m128i vLo = _mm_abs_epi32( _mm_sub_epi32( _mm_loadu_si128( (const __m128i*)piOrg ),     _mm_loadu_si128( (const __m128i*)piCur ) ) );
+  const __m128i vHi = _mm_abs_epi32( _mm_sub_epi32( _mm_loadu_si128( (const __m128i*)(piOrg+4) ), _mm_loadu_si128( (const __m128i*)(piCur+4) ) ) );
+  return _mm_add_epi32( vLo, vHi );
+#else
+  const __m128i vDiff = _mm_sub_epi16( _mm_loadu_si128( (const __m128i*)piOrg ), _mm_loadu_si128( (const __m128i*)piCur ) );
+  return _mm_madd_epi16( _mm_abs_epi16( vDiff ), _mm_set1_epi16( 1 ) );
+#endif
+}
+
+/// sum of the absolute differences of 4 samples, in four 32-bit lanes
+static inline SIMD_TARGET_SSE41 __m128i xAbsDiff4SSE41( const Pel* piOrg, const Pel* piCur )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  return _mm_abs_epi32( _mm_sub_epi32( _mm_loadu_si128( (const __m128i*)piOrg ), _mm_loadu_si128( (const __m128i*)piCur ) ) );
+#else
+  const __m128i vDiff = _mm_sub_epi16( _mm_loadl_epi64( (const __m128i*)piOrg ), _mm_loadl_epi64( (const __m128i*)piCur ) );
+  return _mm_madd_epi16( _mm_abs_epi16( vDiff ), _mm_set1_epi16( 1 ) );
+#endif
+}
+
+/// add the sums of one row to the block sums
+static inline SIMD_TARGET_SSE41 __m128i xAddRowSumSSE41( __m128i vSum, __m128i vRow )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  return _mm_add_epi64( vSum, _mm_add_epi64( _mm_cvtepu32_epi64( vRow ), _mm_cvtepu32_epi64( _mm_unpackhi_epi64( vRow, vRow ) ) ) );
+#else
+  return _mm_add_epi32( vSum, vRow );
+#endif
+}
+
+/// horizontal sum of the block sums
+static inline SIMD_TARGET_SSE41 Distortion xHorizontalSumSSE41( __m128i vSum )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  vSum = _mm_add_epi64( vSum, _mm_unpackhi_epi64( vSum, vSum ) );
+  Distortion uiSum;
+  _mm_storel_epi64( (__m128i*)&uiSum, vSum );
+  return uiSum;
+#else
+  vSum = _mm_add_epi32( vSum, _mm_unpackhi_epi64( vSum, vSum ) );
+  vSum = _mm_add_epi32( vSum, _mm_shuffle_epi32( vSum, 0x55 ) );
+  return (Distortion)_mm_cvtsi128_si32( vSum );
+#endif
+}
+
+/// differences of 8 samples of two rows, in two vectors of four 32-bit lanes
+static inline SIMD_TARGET_SSE41 Void xLoadDiff8SSE41( const Pel* piOrg, const Pel* piCur, __m128i& rvLo, __m128i& rvHi )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  rvLo = _mm_sub_epi32( _mm_loadu_si128( (const __m128i*)piOrg ),     _mm_loadu_si128( (const __m128i*)piCur ) );
+  rvHi = _mm_sub_epi32( _mm_loadu_si128( (const __m128i*)(piOrg+4) ), _mm_loadu_si128( (const __m128i*)(piCur+4) ) );
+#else
+  const __m128i vDiff = _mm_sub_epi16( _mm_loadu_si128( (const __m128i*)piOrg ), _mm_loadu_si128( (const __m128i*)piCur ) );
+  rvLo = _mm_cvtepi16_epi32( vDiff );
+  rvHi = _mm_cvtepi16_epi32( _mm_unpackhi_epi64( vDiff, vDiff ) );
+#endif
+}
+
+/// differences of 4 samples of two rows, in four 32-bit lanes
+static inline SIMD_TARGET_SSE41 __m128i xLoadDiff4SSE41( const Pel* piOrg, const Pel* piCur )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  return _mm_sub_epi32( _mm_loadu_si128( (const __m128i*)piOrg ), _mm_loadu_si128( (const __m128i*)piCur ) );
+#else
+  return _mm_cvtepi16_epi32( _mm_sub_epi16( _mm_loadl_epi64( (const __m128i*)piOrg ), _mm_loadl_epi64( (const __m128i*)piCur ) ) );
+#endif
+}
+
+/// transpose a 4x4 block of 32-bit values
+static inline SIMD_TARGET_SSE41 Void xTranspose4x4SSE41( __m128i& rv0, __m128i& rv1, __m128i& rv2, __m128i& rv3 )
+{
+  const __m128i vT0 = _mm_unpacklo_epi32( rv0, rv1 );
+  const __m128i vT1 = _mm_unpacklo_epi32( rv2, rv3 );
+  const __m128i vT2 = _mm_unpackhi_epi32( rv0, rv1 );
+  const __m128i vT3 = _mm_unpackhi_epi32( rv2, rv3 );
+  rv0 = _mm_unpacklo_epi64( vT0, vT1 );
+  rv1 = _mm_unpackhi_epi64( vT0, vT1 );
+  rv2 = _mm_unpacklo_epi64( vT2, vT3 );
+  rv3 = _mm_unpackhi_epi64( vT2, vT3 );
+}
+
+/// 4-point Hadamard transform across four vectors (same rows as xCalcHADs4x4() up to order and sign)
+static inline SIMD_TARGET_SSE41 Void xHadamard4SSE41( __m128i* pv )
+{
+  const __m128i vA0 = _mm_add_epi32( pv[0], pv[2] );
+  const __m128i vA1 = _mm_add_epi32( pv[1], pv[3] );
+  const __m128i vA2 = _mm_sub_epi32( pv[0], pv[2] );
+  const __m128i vA3 = _mm_sub_epi32( pv[1], pv[3] );
+  pv[0] = _mm_add_epi32( vA0, vA1 );
+  pv[1] = _mm_sub_epi32( vA0, vA1 );
+  pv[2] = _mm_add_epi32( vA2, vA3 );
+  pv[3] = _mm_sub_epi32( vA2, vA3 );
+}
+
+/// 8-point Hadamard transform across eight vectors (same rows as xCalcHADs8x8() up to order and sign)
+#define HADAMARD8( pv, ADD, SUB )                                                                                    \
+{                                                                                                                     \
+  for ( Int k = 0; k < 4; k++ )                                                                                       \
+  {                                                                                                                   \
+    vA[k]   = ADD( pv[k], pv[k+4] );                                                                                  \
+    vA[k+4] = SUB( pv[k], pv[k+4] );                                                                                  \
+  }                                                                                                                   \
+  for ( Int k = 0; k < 8; k += 4 )                                                                                    \
+  {                                                                                                                   \
+    vB[k]   = ADD( vA[k],   vA[k+2] );                                                                                \
+    vB[k+1] = ADD( vA[k+1], vA[k+3] );                                                                                \
+    vB[k+2] = SUB( vA[k],   vA[k+2] );                                                                                \
+    vB[k+3] = SUB( vA[k+1], vA[k+3] );                                                                                \
+  }                                                                                                                   \
+  for ( Int k = 0; k < 8; k += 2 )                                                                                    \
+  {                                                                                                                   \
+    pv[k]   = ADD( vB[k], vB[k+1] );                                                                                  \
+    pv[k+1] = SUB( vB[k], vB[k+1] );                                                                                  \
+  }                                                                                                                   \
+}
+
+/** SAD of a block with SSE4.1.
+ * \returns sum of the absolute differences of the rows 0, 1<<iSubShift, 2<<iSubShift, ..., before scaling
+ */
+static SIMD_TARGET_SSE41 Distortion xSADSSE41( const Pel* piOrg, Int iStrideOrg, const Pel* piCur, Int iStrideCur, Int iCols, Int iRows, Int iSubShift )
+{
+  const Int iSubStep = 1 << iSubShift;
+  __m128i vSum = _mm_setzero_si128();
+  Distortion uiTail = 0;
+
+  for ( Int y = 0; y < iRows; y += iSubStep )
+  {
+    __m128i vRow = _mm_setzero_si128();
+    Int x = 0;
+    for ( ; x + 8 <= iCols; x += 8 )
+    {
+      vRow = _mm_add_epi32( vRow, xAbsDiff8SSE41( piOrg+x, piCur+x ) );
+    }
+    if ( x + 4 <= iCols )
+    {
+      vRow = _mm_add_epi32( vRow, xAbsDiff4SSE41( piOrg+x, piCur+x ) );
+      x += 4;
+    }
+    for ( ; x < iCols; x++ )
+    {
+      uiTail += abs( piOrg[x] - piCur[x] );
+    }
+    vSum = xAddRowSumSSE41( vSum, vRow );
+    piOrg += iStrideOrg * iSubStep;
+    piCur += iStrideCur * iSubStep;
+  }
+  return xHorizontalSumSSE41( vSum ) + uiTail;
+}
+
+/** SAD of a block with AVX2, see xSADSSE41().
+ */
+static SIMD_TARGET_AVX2 Distortion xSADAVX2( const Pel* piOrg, Int iStrideOrg, const Pel* piCur, Int iStrideCur, Int iCols, Int iRows, Int iSubShift )
+{
+  if ( iCols < 16 )
+  {
+    return xSADSSE41( piOrg, iStrideOrg, piCur, iStrideCur, iCols, iRows, iSubShift );
+  }
+
+  const Int iSubStep = 1 << iSubShift;
+  __m128i vSum = _mm_setzero_si128();
+  Distortion uiTail = 0;
+
+  for ( Int y = 0; y < iRows; y += iSubStep )
+  {
+    __m256i vRow256 = _mm256_setzero_si256();
+    Int x = 0;
+    for ( ; x + 16 <= iCols; x += 16 )
+    {
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+      const __m256i vLo = _mm256_abs_epi32( _mm256_sub_epi32( _mm256_loadu_si256( (const __m256i*)(piOrg+x) ),   _mm256_loadu_si256( (const __m256i*)(piCur+x) ) ) );
+      const __m256i vHi = _mm256_abs_epi32( _mm256_sub_epi32( _mm256_loadu_si256( (const __m256i*)(piOrg+x+8) ), _mm256_loadu_si256( (const __m256i*)(piCur+x+8) ) ) );
+      vRow256 = _mm256_add_epi32( vRow256, _mm256_add_epi32( vLo, vHi ) );
+#else
+      const __m256i vDiff = _mm256_sub_epi16( _mm256_loadu_si256( (const __m256i*)(piOrg+x) ), _mm256_loadu_si256( (const __m256i*)(piCur+x) ) );
+      vRow256 = _mm256_add_epi32( vRow256, _mm256_madd_epi16( _mm256_abs_epi16( vDiff ), _mm256_set1_epi16( 1 ) ) );
+#endif
+    }
+    __m128i vRow = _mm_add_epi32( _mm256_castsi256_si128( vRow256 ), _mm256_extracti128_si256( vRow256, 1 ) );
+    if ( x + 8 <= iCols )
+    {
+      vRow = _mm_add_epi32( vRow, xAbsDiff8SSE41( piOrg+x, piCur+x ) );
+      x += 8;
+    }
+    if ( x + 4 <= iCols )
+    {
+      vRow = _mm_add_epi32( vRow, xAbsDiff4SSE41( piOrg+x, piCur+x ) );
+      x += 4;
+    }
+    for ( ; x < iCols; x++ )
+    {
+      uiTail += abs( piOrg[x] - piCur[x] );
+    }
+    vSum = xAddRowSumSSE41( vSum, vRow );
+    piOrg += iStrideOrg * iSubStep;
+    piCur += iStrideCur * iSubStep;
+  }
+  return xHorizontalSumSSE41( vSum ) + uiTail;
+}
+
+/// add squared differences to the block sums, in 32-bit lanes (64-bit lanes with RExt__HIGH_BIT_DEPTH_SUPPORT)
+static inline SIMD_TARGET_SSE41 __m128i xAddSqSumSSE41( __m128i vSum, __m128i vSq )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  return _mm_add_epi64( vSum, vSq );
+#else
+  return _mm_add_epi32( vSum, vSq );
+#endif
+}
+
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+/// squares of four 32-bit differences, each shifted right by vShift, summed into two 64-bit lanes
+static inline SIMD_TARGET_SSE41 __m128i xSquare4SSE41( __m128i vDiff, __m128i vShift )
+{
+  const __m128i vOdd = _mm_srli_epi64( vDiff, 32 );
+  return _mm_add_epi64( _mm_srl_epi64( _mm_mul_epi32( vDiff, vDiff ), vShift ), _mm_srl_epi64( _mm_mul_epi32( vOdd, vOdd ), vShift ) );
+}
+#endif
+
+/// squared differences of 8 samples, each shifted right by vShift, summed into the lanes of xAddSqSumSSE41()
+static inline SIMD_TARGET_SSE41 __m128i xSqDiff8SSE41( const Pel* piOrg, const Pel* piCur, __m128i vShift )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  __m128i vLo, vHi;
+  xLoadDiff8SSE41( piOrg, piCur, vLo, vHi );
+  return _mm_add_epi64( xSquare4SSE41( vLo, vShift ), xSquare4SSE41( vHi, vShift ) );
+#else
+  const __m128i vDiff = _mm_sub_epi16( _mm_loadu_si128( (const __m128i*)piOrg ), _mm_loadu_si128( (const __m128i*)piCur ) );
+  const __m128i vLo   = _mm_unpacklo_epi16( vDiff, _mm_setzero_si128() );
+  const __m128i vHi   = _mm_unpackhi_epi16( vDiff, _mm_setzero_si128() );
+  return _mm_add_epi32( _mm_srl_epi32( _mm_madd_epi16( vLo, vLo ), vShift ), _mm_srl_epi32( _mm_madd_epi16( vHi, vHi ), vShift ) );
+#endif
+}
+
+/// squared differences of 4 samples, each shifted right by vShift, summed into the lanes of xAddSqSumSSE41()
+static inline SIMD_TARGET_SSE41 __m128i xSqDiff4SSE41( const Pel* piOrg, const Pel* piCur, __m128i vShift )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  return xSquare4SSE41( xLoadDiff4SSE41( piOrg, piCur ), vShift );
+#else
+  const __m128i vDiff = _mm_sub_epi16( _mm_loadl_epi64( (const __m128i*)piOrg ), _mm_loadl_epi64( (const __m128i*)piCur ) );
+  const __m128i vLo   = _mm_unpacklo_epi16( vDiff, _mm_setzero_si128() );
+  return _mm_srl_epi32( _mm_madd_epi16( vLo, vLo ), vShift );
+#endif
+}
+
+/** SSE of a block with SSE4.1, equal to xGetSSE().
+ * Each squared difference is shifted right by uiShift before it is added, as in the C++ version.
+ */
+static SIMD_TARGET_SSE41 Distortion xSSESSE41( const Pel* piOrg, Int iStrideOrg, const Pel* piCur, Int iStrideCur, Int iCols, Int iRows, UInt uiShift )
+{
+  const __m128i vShift = _mm_cvtsi32_si128( uiShift );
+  __m128i vSum = _mm_setzero_si128();
+  Distortion uiTail = 0;
+
+  for ( Int y = 0; y < iRows; y++ )
+  {
+    Int x = 0;
+    for ( ; x + 8 <= iCols; x += 8 )
+    {
+      vSum = xAddSqSumSSE41( vSum, xSqDiff8SSE41( piOrg+x, piCur+x, vShift ) );
+    }
+    if ( x + 4 <= iCols )
+    {
+      vSum = xAddSqSumSSE41( vSum, xSqDiff4SSE41( piOrg+x, piCur+x, vShift ) );
+      x += 4;
+    }
+    for ( ; x < iCols; x++ )
+    {
+      const Intermediate_Int iTemp = piOrg[x] - piCur[x];
+      uiTail += Distortion(( iTemp * iTemp ) >> uiShift);
+    }
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+  }
+  return xHorizontalSumSSE41( vSum ) + uiTail;
+}
+
+/** SSE of a block with AVX2, see xSSESSE41().
+ */
+static SIMD_TARGET_AVX2 Distortion xSSEAVX2( const Pel* piOrg, Int iStrideOrg, const Pel* piCur, Int iStrideCur, Int iCols, Int iRows, UInt uiShift )
+{
+  if ( iCols < 16 )
+  {
+    return xSSESSE41( piOrg, iStrideOrg, piCur, iStrideCur, iCols, iRows, uiShift );
+  }
+
+  const __m128i vShift = _mm_cvtsi32_si128( uiShift );
+  __m256i vSum256 = _mm256_setzero_si256();
+  __m128i vSum    = _mm_setzero_si128();
+  Distortion uiTail = 0;
+
+  for ( Int y = 0; y < iRows; y++ )
+  {
+    Int x = 0;
+    for ( ; x + 16 <= iCols; x += 16 )
+    {
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+      for ( Int k = 0; k < 16; k += 8 )
+      {
+        const __m256i vDiff = _mm256_sub_epi32( _mm256_loadu_si256( (const __m256i*)(piOrg+x+k) ), _mm256_loadu_si256( (const __m256i*)(piCur+x+k) ) );
+        const __m256i vOdd  = _mm256_srli_epi64( vDiff, 32 );
+        vSum256 = _mm256_add_epi64( vSum256, _mm256_srl_epi64( _mm256_mul_epi32( vDiff, vDiff ), vShift ) );
+        vSum256 = _mm256_add_epi64( vSum256, _mm256_srl_epi64( _mm256_mul_epi32( vOdd, vOdd ), vShift ) );
+      }
+#else
+      const __m256i vDiff = _mm256_sub_epi16( _mm256_loadu_si256( (const __m256i*)(piOrg+x) ), _mm256_loadu_si256( (const __m256i*)(piCur+x) ) );
+      const __m256i vLo   = _mm256_unpacklo_epi16( vDiff, _mm256_setzero_si256() );
+      const __m256i vHi   = _mm256_unpackhi_epi16( vDiff, _mm256_setzero_si256() );
+      vSum256 = _mm256_add_epi32( vSum256, _mm256_srl_epi32( _mm256_madd_epi16( vLo, vLo ), vShift ) );
+      vSum256 = _mm256_add_epi32( vSum256, _mm256_srl_epi32( _mm256_madd_epi16( vHi, vHi ), vShift ) );
+#endif
+    }
+    if ( x + 8 <= iCols )
+    {
+      vSum = xAddSqSumSSE41( vSum, xSqDiff8SSE41( piOrg+x, piCur+x, vShift ) );
+      x += 8;
+    }
+    if ( x + 4 <= iCols )
+    {
+      vSum = xAddSqSumSSE41( vSum, xSqDiff4SSE41( piOrg+x, piCur+x, vShift ) );
+      x += 4;
+    }
+    for ( ; x < iCols; x++ )
+    {
+      const Intermediate_Int iTemp = piOrg[x] - piCur[x];
+      uiTail += Distortion(( iTemp * iTemp ) >> uiShift);
+    }
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+  }
+  vSum = xAddSqSumSSE41( vSum, _mm256_castsi256_si128( vSum256 ) );
+  vSum = xAddSqSumSSE41( vSum, _mm256_extracti128_si256( vSum256, 1 ) );
+  return xHorizontalSumSSE41( vSum ) + uiTail;
+}
+
+/** 4x4 Hadamard SATD with SSE4.1, equal to xCalcHADs4x4().
+ */
+static SIMD_TARGET_SSE41 Distortion xHAD4x4SSE41( const Pel* piOrg, Int iStrideOrg, const Pel* piCur, Int iStrideCur )
+{
+  __m128i v[4];
+  for ( Int k = 0; k < 4; k++ )
+  {
+    v[k] = xLoadDiff4SSE41( piOrg + k*iStrideOrg, piCur + k*iStrideCur );
+  }
+  xHadamard4SSE41( v );
+  xTranspose4x4SSE41( v[0], v[1], v[2], v[3] );
+  xHadamard4SSE41( v );
+
+  __m128i vSum = _mm_add_epi32( _mm_add_epi32( _mm_abs_epi32( v[0] ), _mm_abs_epi32( v[1] ) ),
+                                _mm_add_epi32( _mm_abs_epi32( v[2] ), _mm_abs_epi32( v[3] ) ) );
+  vSum = _mm_add_epi32( vSum, _mm_unpackhi_epi64( vSum, vSum ) );
+  vSum = _mm_add_epi32( vSum, _mm_shuffle_epi32( vSum, 0x55 ) );
+  const Distortion satd = (Distortion)_mm_cvtsi128_si32( vSum );
+  return ( satd + 1 ) >> 1;
+}
+
+/** 8x8 Hadamard SATD with SSE4.1, equal to xCalcHADs8x8().
+ * The left and right halves of the rows are held in separate vectors.
+ */
+static SIMD_TARGET_SSE41 Distortion xHAD8x8SSE41( const Pel* piOrg, Int iStrideOrg, const Pel* piCur, Int iStrideCur )
+{
+  __m128i vLo[8], vHi[8], vA[8], vB[8];
+  for ( Int k = 0; k < 8; k++ )
+  {
+    xLoadDiff8SSE41( piOrg + k*iStrideOrg, piCur + k*iStrideCur, vLo[k], vHi[k] );
+  }
+  // vertical
+  HADAMARD8( vLo, _mm_add_epi32, _mm_sub_epi32 );
+  HADAMARD8( vHi, _mm_add_epi32, _mm_sub_epi32 );
+
+  // transpose: the left half of row k becomes column k in vLo[0..3]/vHi[0..3] etc.
+  xTranspose4x4SSE41( vLo[0], vLo[1], vLo[2], vLo[3] );
+  xTranspose4x4SSE41( vLo[4], vLo[5], vLo[6], vLo[7] );
+  xTranspose4x4SSE41( vHi[0], vHi[1], vHi[2], vHi[3] );
+  xTranspose4x4SSE41( vHi[4], vHi[5], vHi[6], vHi[7] );
+  __m128i vCol[8], vColHi[8];
+  for ( Int k = 0; k < 4; k++ )
+  {
+    vCol[k]     = vLo[k];
+    vColHi[k]   = vLo[k+4];
+    vCol[k+4]   = vHi[k];
+    vColHi[k+4] = vHi[k+4];
+  }
+
+  // horizontal
+  HADAMARD8( vCol, _mm_add_epi32, _mm_sub_epi32 );
+  HADAMARD8( vColHi, _mm_add_epi32, _mm_sub_epi32 );
+
+  __m128i vSum = _mm_setzero_si128();
+  for ( Int k = 0; k < 8; k++ )
+  {
+    vSum = _mm_add_epi32( vSum, _mm_add_epi32( _mm_abs_epi32( vCol[k] ), _mm_abs_epi32( vColHi[k] ) ) );
+  }
+  vSum = _mm_add_epi32( vSum, _mm_unpackhi_epi64( vSum, vSum ) );
+  vSum = _mm_add_epi32( vSum, _mm_shuffle_epi32( vSum, 0x55 ) );
+  const Distortion sad = (Distortion)_mm_cvtsi128_si32( vSum );
+  return ( sad + 2 ) >> 2;
+}
+
+/** 8x8 Hadamard SATD with AVX2, equal to xCalcHADs8x8().
+ */
+static SIMD_TARGET_AVX2 Distortion xHAD8x8AVX2( const Pel* piOrg, Int iStrideOrg, const Pel* piCur, Int iStrideCur )
+{
+  __m256i v[8], vA[8], vB[8];
+  for ( Int k = 0; k < 8; k++ )
+  {
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+    v[k] = _mm256_sub_epi32( _mm256_loadu_si256( (const __m256i*)(piOrg + k*iStrideOrg) ), _mm256_loadu_si256( (const __m256i*)(piCur + k*iStrideCur) ) );
+#else
+    v[k] = _mm256_cvtepi16_epi32( _mm_sub_epi16( _mm_loadu_si128( (const __m128i*)(piOrg + k*iStrideOrg) ), _mm_loadu_si128( (const __m128i*)(piCur + k*iStrideCur) ) ) );
+#endif
+  }
+  // vertical
+  HADAMARD8( v, _mm256_add_epi32, _mm256_sub_epi32 );
+
+  // transpose
+  __m256i vT[8], vU[8];
+  for ( Int k = 0; k < 8; k += 2 )
+  {
+    vT[k]   = _mm256_unpacklo_epi32( v[k], v[k+1] );
+    vT[k+1] = _mm256_unpackhi_epi32( v[k], v[k+1] );
+  }
+  for ( Int k = 0; k < 8; k += 4 )
+  {
+    vU[k]   = _mm256_unpacklo_epi64( vT[k],   vT[k+2] );
+    vU[k+1] = _mm256_unpackhi_epi64( vT[k],   vT[k+2] );
+    vU[k+2] = _mm256_unpacklo_epi64( vT[k+1], vT[k+3] );
+    vU[k+3] = _mm256_unpackhi_epi64( vT[k+1], vT[k+3] );
+  }
+  for ( Int k = 0; k < 4; k++ )
+  {
+    v[k]   = _mm256_permute2x128_si256( vU[k], vU[k+4], 0x20 );
+    v[k+4] = _mm256_permute2x128_si256( vU[k], vU[k+4], 0x31 );
+  }
+
+  // horizontal
+  HADAMARD8( v, _mm256_add_epi32, _mm256_sub_epi32 );
+
+  __m256i vSum = _mm256_setzero_si256();
+  for ( Int k = 0; k < 8; k++ )
+  {
+    vSum = _mm256_add_epi32( vSum, _mm256_abs_epi32( v[k] ) );
+  }
+  __m128i vSum128 = _mm_add_epi32( _mm256_castsi256_si128( vSum ), _mm256_extracti128_si256( vSum, 1 ) );
+  vSum128 = _mm_add_epi32( vSum128, _mm_unpackhi_epi64( vSum128, vSum128 ) );
+  vSum128 = _mm_add_epi32( vSum128, _mm_shuffle_epi32( vSum128, 0x55 ) );
+  const Distortion sad = (Distortion)_mm_cvtsi128_si32( vSum128 );
+  return ( sad + 2 ) >> 2;
+}
+
+#undef HADAMARD8
+
+/** Set the SSE, SAD and Hadamard functions of a SIMD level.
+ * The sizes without dedicated SIMD code keep their C++ versions.
+ */
+template<SimdLevel eLevel>
+Void TComRdCost::xSetSimdDistortionFunctions()
+{
+  for ( Int i = 0; i <= 6; i++ )
+  {
+    m_afpDistortFunc[DF_SSE  + i] = TComRdCost::xGetSSESimd<eLevel>;          // any, 4 .. 64, 16N
+  }
+  m_afpDistortFunc[DF_SAD    ] = TComRdCost::xGetSADSimd<eLevel, false>;
+  m_afpDistortFunc[DF_SADS   ] = TComRdCost::xGetSADSimd<eLevel, false>;
+  for ( Int i = 1; i <= 5; i++ )
+  {
+    m_afpDistortFunc[DF_SAD  + i] = TComRdCost::xGetSADSimd<eLevel, true>;    // 4 .. 64
+    m_afpDistortFunc[DF_SADS + i] = TComRdCost::xGetSADSimd<eLevel, true>;
+  }
+#if AMP_SAD
+  m_afpDistortFunc[DF_SAD12  ] = TComRdCost::xGetSADSimd<eLevel, true>;
+  m_afpDistortFunc[DF_SAD24  ] = TComRdCost::xGetSADSimd<eLevel, true>;
+  m_afpDistortFunc[DF_SAD48  ] = TComRdCost::xGetSADSimd<eLevel, true>;
+  m_afpDistortFunc[DF_SADS12 ] = TComRdCost::xGetSADSimd<eLevel, true>;
+  m_afpDistortFunc[DF_SADS24 ] = TComRdCost::xGetSADSimd<eLevel, true>;
+  m_afpDistortFunc[DF_SADS48 ] = TComRdCost::xGetSADSimd<eLevel, true>;
+#endif
+  for ( Int i = 0; i <= 6; i++ )
+  {
+    m_afpDistortFunc[DF_HADS + i] = TComRdCost::xGetHADsSimd<eLevel>;         // any, 4 .. 64, 16N
+  }
+}
+
+/** SSE with SIMD, equal to xGetSSE() and to the fixed width functions xGetSSE4() to xGetSSE64() and xGetSSE16N().
+ * \param pcDtParam distortion parameters
+ * \returns distortion
+ */
+template<SimdLevel eLevel>
+Distortion TComRdCost::xGetSSESimd( DistParam* pcDtParam )
+{
+  if ( pcDtParam->bApplyWeight )
+  {
+    return xGetSSEw( pcDtParam );
+  }
+  const UInt uiShift = DISTORTION_PRECISION_ADJUSTMENT((pcDtParam->bitDepth-8) << 1);
+
+  if ( eLevel == SIMD_AVX2 )
+  {
+    return xSSEAVX2 ( pcDtParam->pOrg, pcDtParam->iStrideOrg, pcDtParam->pCur, pcDtParam->iStrideCur, pcDtParam->iCols, pcDtParam->iRows, uiShift );
+  }
+  return xSSESSE41( pcDtParam->pOrg, pcDtParam->iStrideOrg, pcDtParam->pCur, pcDtParam->iStrideCur, pcDtParam->iCols, pcDtParam->iRows, uiShift );
+}
+
+/** SAD with SIMD, equal to xGetSAD() (bSubShift false) or to the fixed width functions xGetSAD4() to xGetSAD64().
+ * \param pcDtParam distortion parameters
+ * \returns distortion
+ */
+template<SimdLevel eLevel, Bool bSubShift>
+Distortion TComRdCost::xGetSADSimd( DistParam* pcDtParam )
+{
+  if ( pcDtParam->bApplyWeight )
+  {
+    return xGetSADw( pcDtParam );
+  }
+  const Int iSubShift = bSubShift ? pcDtParam->iSubShift : 0;
+
+  Distortion uiSum;
+  if ( eLevel == SIMD_AVX2 )
+  {
+    uiSum = xSADAVX2 ( pcDtParam->pOrg, pcDtParam->iStrideOrg, pcDtParam->pCur, pcDtParam->iStrideCur, pcDtParam->iCols, pcDtParam->iRows, iSubShift );
+  }
+  else
+  {
+    uiSum = xSADSSE41( pcDtParam->pOrg, pcDtParam->iStrideOrg, pcDtParam->pCur, pcDtParam->iStrideCur, pcDtParam->iCols, pcDtParam->iRows, iSubShift );
+  }
+
+  uiSum <<= iSubShift;
+  return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8) );
+}
+
+/** Hadamard SATD with SIMD, equal to xGetHADs().
+ * \param pcDtParam distortion parameters
+ * \returns distortion
+ */
+template<SimdLevel eLevel>
+Distortion TComRdCost::xGetHADsSimd( DistParam* pcDtParam )
+{
+  if ( pcDtParam->bApplyWeight )
+  {
+    return xGetHADsw( pcDtParam );
+  }
+#if NS_HAD
+  if ( pcDtParam->bUseNSHAD )
+  {
+    return xGetHADs( pcDtParam );
+  }
+#endif
+  Pel* piOrg      = pcDtParam->pOrg;
+  Pel* piCur      = pcDtParam->pCur;
+  Int  iRows      = pcDtParam->iRows;
+  Int  iCols      = pcDtParam->iCols;
+  Int  iStrideCur = pcDtParam->iStrideCur;
+  Int  iStrideOrg = pcDtParam->iStrideOrg;
+
+  assert( pcDtParam->iStep == 1 );
+
+  Distortion uiSum = 0;
+
+  if( ( iRows % 8 == 0) && (iCols % 8 == 0) )
+  {
+    for ( Int y=0; y<iRows; y+= 8 )
+    {
+      for ( Int x=0; x<iCols; x+= 8 )
+      {
+        uiSum += eLevel == SIMD_AVX2 ? xHAD8x8AVX2 ( &piOrg[x], iStrideOrg, &piCur[x], iStrideCur )
+                                     : xHAD8x8SSE41( &piOrg[x], iStrideOrg, &piCur[x], iStrideCur );
+      }
+      piOrg += iStrideOrg<<3;
+      piCur += iStrideCur<<3;
+    }
+  }
+  else if( ( iRows % 4 == 0) && (iCols % 4 == 0) )
+  {
+    for ( Int y=0; y<iRows; y+= 4 )
+    {
+      for ( Int x=0; x<iCols; x+= 4 )
+      {
+        uiSum += xHAD4x4SSE41( &piOrg[x], iStrideOrg, &piCur[x], iStrideCur );
+      }
+      piOrg += iStrideOrg<<2;
+      piCur += iStrideCur<<2;
+    }
+  }
+  else if( ( iRows % 2 == 0) && (iCols % 2 == 0) )
+  {
+    for ( Int y=0; y<iRows; y+=2 )
+    {
+      for ( Int x=0; x<iCols; x+=2 )
+      {
+        uiSum += xCalcHADs2x2( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur, 1 );
+      }
+      piOrg += iStrideOrg<<1;
+      piCur += iStrideCur<<1;
+    }
+  }
+  else
+  {
+    assert(false);
+  }
+
+  return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8) );
+}
+#endif
+
 //! \}
@@ -45,6 +45,7 @@
 
 #include "TComSlice.h"
 #include "TComRdCostWeightPrediction.h"
+#include "TComSimd.h"
 
 //! \ingroup TLibCommon
 //! \{
@@ -301,6 +302,14 @@ private:
   static Distortion xCalcHADs16x4     ( Pel *piOrg, Pel *piCurr, Int iStrideOrg, Int iStrideCur, Int iStep );
   static Distortion xCalcHADs4x16     ( Pel *piOrg, Pel *piCurr, Int iStrideOrg, Int iStrideCur, Int iStep );
 #endif
+
+#if SIMD_X86
+  // SIMD versions of the functions above, giving identical results
+  template<SimdLevel eLevel> Void xSetSimdDistortionFunctions();
+  template<SimdLevel eLevel>                 static Distortion xGetSSESimd  ( DistParam* pcDtParam );
+  template<SimdLevel eLevel, Bool bSubShift> static Distortion xGetSADSimd  ( DistParam* pcDtParam );
+  template<SimdLevel eLevel>                 static Distortion xGetHADsSimd ( DistParam* pcDtParam );
+#endif
   
 public:
 #if WEIGHTED_CHROMA_DISTORTION
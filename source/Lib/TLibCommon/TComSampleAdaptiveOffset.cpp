@@ -36,6 +36,7 @@
 */
 
 #include "TComSampleAdaptiveOffset.h"
+#include "TComSimd.h"
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -73,10 +74,19 @@ TComSampleAdaptiveOffset::TComSampleAdaptiveOffset()
   m_iUpBufft = NULL;
   ipSwap = NULL;
 
-  m_pTmpU1 = NULL;
-  m_pTmpU2 = NULL;
+  for(UInt comp=0; comp<MAX_NUM_COMPONENT; comp++)
+  {
+    m_pTmpU1[comp] = NULL;
+    m_pTmpU2[comp] = NULL;
+  }
   m_pTmpL1 = NULL;
   m_pTmpL2 = NULL;
+
+  m_pcThreadPool  = NULL;
+  m_pcSaoWorkers  = NULL;
+  m_pcYuvCopy     = NULL;
+  m_pcJobYuvDec   = NULL;
+  m_pcJobSaoParam = NULL;
 }
 
 TComSampleAdaptiveOffset::~TComSampleAdaptiveOffset()
@@ -221,8 +231,11 @@ Void TComSampleAdaptiveOffset::create( UInt uiSourceWidth, UInt uiSourceHeight,
 
   m_pTmpL1 = new Pel [m_uiMaxCUHeight+1];
   m_pTmpL2 = new Pel [m_uiMaxCUHeight+1];
-  m_pTmpU1 = new Pel [m_iPicWidth];
-  m_pTmpU2 = new Pel [m_iPicWidth];
+  for(UInt comp=0; comp<MAX_NUM_COMPONENT; comp++)
+  {
+    m_pTmpU1[comp] = new Pel [m_iPicWidth];
+    m_pTmpU2[comp] = new Pel [m_iPicWidth];
+  }
 }
 
 /** destroy SampleAdaptiveOffset memory.
@@ -269,13 +282,48 @@ Void TComSampleAdaptiveOffset::destroy()
   {
     delete [] m_pTmpL2; m_pTmpL2 = NULL;
   }
-  if (m_pTmpU1)
+  for(UInt comp=0; comp<MAX_NUM_COMPONENT; comp++)
+  {
+    if (m_pTmpU1[comp])
+    {
+      delete [] m_pTmpU1[comp]; m_pTmpU1[comp] = NULL;
+    }
+    if (m_pTmpU2[comp])
+    {
+      delete [] m_pTmpU2[comp]; m_pTmpU2[comp] = NULL;
+    }
+  }
+  setThreadPool(NULL);
+}
+
+/** set the worker threads used to apply the offsets, NULL for single-threaded processing
+ * \param pcThreadPool thread pool, the buffers of its threads are allocated with the sizes of this object
+ */
+Void TComSampleAdaptiveOffset::setThreadPool(TComThreadPool* pcThreadPool)
+{
+  if (m_pcSaoWorkers)
+  {
+    for (Int i = 0; i < m_pcThreadPool->getNumThreads(); i++)
+    {
+      m_pcSaoWorkers[i].destroy();
+    }
+    delete [] m_pcSaoWorkers; m_pcSaoWorkers = NULL;
+  }
+  if (m_pcYuvCopy)
   {
-    delete [] m_pTmpU1; m_pTmpU1 = NULL;
+    m_pcYuvCopy->destroy();
+    delete m_pcYuvCopy; m_pcYuvCopy = NULL;
   }
-  if (m_pTmpU2)
+
+  m_pcThreadPool = (pcThreadPool != NULL && pcThreadPool->getNumThreads() > 1) ? pcThreadPool : NULL;
+
+  if (m_pcThreadPool)
   {
-    delete [] m_pTmpU2; m_pTmpU2 = NULL;
+    m_pcSaoWorkers = new TComSampleAdaptiveOffset[m_pcThreadPool->getNumThreads()];
+    for (Int i = 0; i < m_pcThreadPool->getNumThreads(); i++)
+    {
+      m_pcSaoWorkers[i].create(m_iPicWidth, m_iPicHeight, m_uiMaxCUWidth, m_uiMaxCUHeight);
+    }
   }
 }
 
@@ -461,6 +509,227 @@ inline Int xSign(Int x)
   return ((x >> shift) | ((Int)( (((UInt) -x)) >> shift)));
 }
 
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+// ====================================================================================================================
+// SIMD functions
+// ====================================================================================================================
+
+// Eight samples are processed at a time in 16-bit lanes. The offsets are looked up with pshufb from a table of signed
+// bytes, so the kernels are only used when all offsets of the unit fit in a byte.
+
+/** pack offsets into a table of signed bytes
+ * \param piOffset offsets
+ * \param num      number of offsets, at most 32
+ * \param pcTable  byte table of 32 entries, the entries past num are set to zero
+ * \returns false if an offset does not fit in a signed byte
+ */
+static Bool xPackSaoOffsets( const Int* piOffset, Int num, Char* pcTable )
+{
+  memset( pcTable, 0, 32 );
+  for (Int i = 0; i < num; i++)
+  {
+    if (piOffset[i] < -128 || piOffset[i] > 127)
+    {
+      return false;
+    }
+    pcTable[i] = (Char)piOffset[i];
+  }
+  return true;
+}
+
+/** apply edge offsets to a rectangle of samples
+ * \param pDec       top-left sample of the rectangle before SAO
+ * \param pRest      top-left sample of the rectangle after SAO
+ * \param stride     picture buffer stride
+ * \param width      rectangle width
+ * \param height     rectangle height
+ * \param upOffset   offset of the first neighbour of the edge class
+ * \param downOffset offset of the second neighbour of the edge class
+ * \param pcTable    offsets indexed by edge type
+ * \param maxVal     maximum sample value
+ */
+static SIMD_TARGET_SSE41 Void xSaoEdgeSSE41( const Pel* pDec, Pel* pRest, Int stride, Int width, Int height, Int upOffset, Int downOffset, const Char* pcTable, Int maxVal )
+{
+  const __m128i table  = _mm_loadu_si128( (const __m128i*)pcTable );
+  const __m128i two    = _mm_set1_epi16( 2 );
+  const __m128i zero   = _mm_setzero_si128();
+  const __m128i vMax   = _mm_set1_epi16( maxVal );
+  const Int     width8 = width & ~7;
+
+  for (Int y = 0; y < height; y++)
+  {
+    Int x = 0;
+    for (; x < width8; x += 8)
+    {
+      const __m128i c = _mm_loadu_si128( (const __m128i*)(pDec + x) );
+      const __m128i u = _mm_loadu_si128( (const __m128i*)(pDec + x + upOffset) );
+      const __m128i d = _mm_loadu_si128( (const __m128i*)(pDec + x + downOffset) );
+
+      // edge type = sign(c-u) + sign(c-d) + 2, with sign(a-b) = (a>b) - (a<b) from the all-ones compare masks
+      __m128i e = _mm_sub_epi16( _mm_cmpgt_epi16( u, c ), _mm_cmpgt_epi16( c, u ) );
+      e = _mm_add_epi16( e, _mm_sub_epi16( _mm_cmpgt_epi16( d, c ), _mm_cmpgt_epi16( c, d ) ) );
+      e = _mm_add_epi16( e, two );
+
+      const __m128i offset = _mm_cvtepi8_epi16( _mm_shuffle_epi8( table, _mm_packs_epi16( e, e ) ) );
+      const __m128i r      = _mm_min_epi16( _mm_max_epi16( _mm_adds_epi16( c, offset ), zero ), vMax );
+      _mm_storeu_si128( (__m128i*)(pRest + x), r );
+    }
+    for (; x < width; x++)
+    {
+      const Int edgeType = xSign( pDec[x] - pDec[x+upOffset] ) + xSign( pDec[x] - pDec[x+downOffset] ) + 2;
+      pRest[x] = Clip3( 0, maxVal, pDec[x] + pcTable[edgeType] );
+    }
+    pDec  += stride;
+    pRest += stride;
+  }
+}
+
+/** apply band offsets to a rectangle of samples
+ * \param pDec    top-left sample of the rectangle before SAO
+ * \param pRest   top-left sample of the rectangle after SAO
+ * \param stride  picture buffer stride
+ * \param width   rectangle width
+ * \param height  rectangle height
+ * \param shift   shift from a sample value to its band
+ * \param pcTable offsets indexed by band
+ * \param maxVal  maximum sample value
+ */
+static SIMD_TARGET_SSE41 Void xSaoBandSSE41( const Pel* pDec, Pel* pRest, Int stride, Int width, Int height, Int shift, const Char* pcTable, Int maxVal )
+{
+  const __m128i tableLo = _mm_loadu_si128( (const __m128i*)pcTable );
+  const __m128i tableHi = _mm_loadu_si128( (const __m128i*)(pcTable + 16) );
+  const __m128i fifteen = _mm_set1_epi8( 15 );
+  const __m128i zero    = _mm_setzero_si128();
+  const __m128i vMax    = _mm_set1_epi16( maxVal );
+  const __m128i vShift  = _mm_cvtsi32_si128( shift );
+  const Int     width8  = width & ~7;
+
+  for (Int y = 0; y < height; y++)
+  {
+    Int x = 0;
+    for (; x < width8; x += 8)
+    {
+      const __m128i c    = _mm_loadu_si128( (const __m128i*)(pDec + x) );
+      const __m128i band = _mm_packus_epi16( _mm_srl_epi16( c, vShift ), zero );
+
+      // pshufb only uses the low four bits of the band, so the two halves of the table are looked up separately
+      const __m128i lo     = _mm_shuffle_epi8( tableLo, band );
+      const __m128i hi     = _mm_shuffle_epi8( tableHi, band );
+      const __m128i offset = _mm_cvtepi8_epi16( _mm_blendv_epi8( lo, hi, _mm_cmpgt_epi8( band, fifteen ) ) );
+      const __m128i r      = _mm_min_epi16( _mm_max_epi16( _mm_adds_epi16( c, offset ), zero ), vMax );
+      _mm_storeu_si128( (__m128i*)(pRest + x), r );
+    }
+    for (; x < width; x++)
+    {
+      pRest[x] = Clip3( 0, maxVal, pDec[x] + pcTable[pDec[x] >> shift] );
+    }
+    pDec  += stride;
+    pRest += stride;
+  }
+}
+
+/** apply the offsets of an SAO unit to a block, covering the same samples as the scalar code of processSaoBlock()
+ * \param pDec          to-be-filtered block buffer pointer
+ * \param pRest         filtered block buffer pointer
+ * \param stride        picture buffer stride
+ * \param saoType       SAO offset type
+ * \param width         block width
+ * \param height        block height, at least 2
+ * \param pbBorderAvail availabilities of block border pixels
+ * \param piOffsetEo    edge offsets indexed by edge type
+ * \param piOffsetBand  band offsets indexed by band
+ * \param bitDepth      sample bit depth
+ * \returns false if the offsets do not fit the kernels, in which case nothing is written
+ */
+static Bool xSaoBlockSSE41( const Pel* pDec, Pel* pRest, Int stride, Int saoType, Int width, Int height, const Bool* pbBorderAvail,
+                            const Int* piOffsetEo, const Int* piOffsetBand, Int bitDepth )
+{
+  Char table[32];
+  const Int maxVal = (1 << bitDepth) - 1;
+
+  if (saoType == SAO_BO)
+  {
+    if (!xPackSaoOffsets( piOffsetBand, SAO_MAX_BO_CLASSES, table ))
+    {
+      return false;
+    }
+    xSaoBandSSE41( pDec, pRest, stride, width, height, bitDepth - SAO_BO_BITS, table, maxVal );
+    return true;
+  }
+
+  if (!xPackSaoOffsets( piOffsetEo, SAO_EO_LEN + 1, table ))
+  {
+    return false;
+  }
+
+  const Int startX = (pbBorderAvail[SGU_L]) ? 0 : 1;
+  const Int endX   = (pbBorderAvail[SGU_R]) ? width : (width - 1);
+  const Int last   = (height - 1) * stride;
+
+  switch (saoType)
+  {
+  case SAO_EO_0: // dir: -
+    {
+      xSaoEdgeSSE41( pDec + startX, pRest + startX, stride, endX - startX, height, -1, 1, table, maxVal );
+      break;
+    }
+  case SAO_EO_1: // dir: |
+    {
+      const Int startY = (pbBorderAvail[SGU_T]) ? 0 : 1;
+      const Int endY   = (pbBorderAvail[SGU_B]) ? height : (height - 1);
+      xSaoEdgeSSE41( pDec + startY * stride, pRest + startY * stride, stride, width, endY - startY, -stride, stride, table, maxVal );
+      break;
+    }
+  case SAO_EO_2: // dir: 135
+    {
+      const Int up = -stride - 1;
+      if (pbBorderAvail[SGU_TL])
+      {
+        xSaoEdgeSSE41( pDec, pRest, stride, 1, 1, up, -up, table, maxVal );
+      }
+      if (pbBorderAvail[SGU_T])
+      {
+        xSaoEdgeSSE41( pDec + 1, pRest + 1, stride, endX - 1, 1, up, -up, table, maxVal );
+      }
+      xSaoEdgeSSE41( pDec + stride + startX, pRest + stride + startX, stride, endX - startX, height - 2, up, -up, table, maxVal );
+      if (pbBorderAvail[SGU_B])
+      {
+        xSaoEdgeSSE41( pDec + last + startX, pRest + last + startX, stride, width - 1 - startX, 1, up, -up, table, maxVal );
+      }
+      if (pbBorderAvail[SGU_BR])
+      {
+        xSaoEdgeSSE41( pDec + last + width - 1, pRest + last + width - 1, stride, 1, 1, up, -up, table, maxVal );
+      }
+      break;
+    }
+  case SAO_EO_3: // dir: 45
+    {
+      const Int up = -stride + 1;
+      if (pbBorderAvail[SGU_T])
+      {
+        xSaoEdgeSSE41( pDec + startX, pRest + startX, stride, width - 1 - startX, 1, up, -up, table, maxVal );
+      }
+      if (pbBorderAvail[SGU_TR])
+      {
+        xSaoEdgeSSE41( pDec + width - 1, pRest + width - 1, stride, 1, 1, up, -up, table, maxVal );
+      }
+      xSaoEdgeSSE41( pDec + stride + startX, pRest + stride + startX, stride, endX - startX, height - 2, up, -up, table, maxVal );
+      if (pbBorderAvail[SGU_BL])
+      {
+        xSaoEdgeSSE41( pDec + last, pRest + last, stride, 1, 1, up, -up, table, maxVal );
+      }
+      if (pbBorderAvail[SGU_B])
+      {
+        xSaoEdgeSSE41( pDec + last + 1, pRest + last + 1, stride, endX - 1, 1, up, -up, table, maxVal );
+      }
+      break;
+    }
+  default: break;
+  }
+  return true;
+}
+#endif
+
 /** initialize variables for SAO process
  * \param  pcPic picture data pointer
  */
@@ -490,32 +759,43 @@ Void TComSampleAdaptiveOffset::processSaoCu(Int iAddr, Int iSaoType, ComponentID
   }
   else
   {
-    Int  stride   = m_pcPic->getStride(ch);
-    Pel* pPicRest = getPicYuvAddr(m_pcPic->getPicYuvRec(), ch);
-    Pel* pPicDec  = getPicYuvAddr(m_pcYuvTmp, ch);
+    xProcessSaoFilterBlocks(iAddr, iSaoType, ch, m_pcYuvTmp);
+  }
+}
+
+/** sample adaptive offset process for the filter blocks of one LCU
+ * \param iAddr LCU address
+ * \param iSaoType SAO type
+ * \param ch component
+ * \param pcPicYuvDec picture before SAO
+ */
+Void TComSampleAdaptiveOffset::xProcessSaoFilterBlocks(Int iAddr, Int iSaoType, ComponentID ch, TComPicYuv* pcPicYuvDec)
+{
+  Int  stride   = m_pcPic->getStride(ch);
+  Pel* pPicRest = getPicYuvAddr(m_pcPic->getPicYuvRec(), ch);
+  Pel* pPicDec  = getPicYuvAddr(pcPicYuvDec, ch);
 
-    std::vector<NDBFBlockInfo>& vFilterBlocks = *(m_pcPic->getCU(iAddr)->getNDBFilterBlocks());
+  std::vector<NDBFBlockInfo>& vFilterBlocks = *(m_pcPic->getCU(iAddr)->getNDBFilterBlocks());
 
-    //variables
-    UInt  xPos, yPos, width, height;
-    Bool* pbBorderAvail;
-    UInt  posOffset;
+  //variables
+  UInt  xPos, yPos, width, height;
+  Bool* pbBorderAvail;
+  UInt  posOffset;
 
-    UInt csx = m_pcPic->getComponentScaleX(ch);
-    UInt csy = m_pcPic->getComponentScaleY(ch);
+  UInt csx = m_pcPic->getComponentScaleX(ch);
+  UInt csy = m_pcPic->getComponentScaleY(ch);
 
-    for(Int i=0; i< vFilterBlocks.size(); i++)
-    {
-      xPos        = vFilterBlocks[i].posX   >> csx;
-      yPos        = vFilterBlocks[i].posY   >> csy;
-      width       = vFilterBlocks[i].width  >> csx;
-      height      = vFilterBlocks[i].height >> csy;
-      pbBorderAvail = vFilterBlocks[i].isBorderAvailable;
+  for(Int i=0; i< vFilterBlocks.size(); i++)
+  {
+    xPos        = vFilterBlocks[i].posX   >> csx;
+    yPos        = vFilterBlocks[i].posY   >> csy;
+    width       = vFilterBlocks[i].width  >> csx;
+    height      = vFilterBlocks[i].height >> csy;
+    pbBorderAvail = vFilterBlocks[i].isBorderAvailable;
 
-      posOffset = (yPos* stride) + xPos;
+    posOffset = (yPos* stride) + xPos;
 
-      processSaoBlock(pPicDec+ posOffset, pPicRest+ posOffset, stride, iSaoType, width, height, pbBorderAvail, ch);
-    }
+    processSaoBlock(pPicDec+ posOffset, pPicRest+ posOffset, stride, iSaoType, width, height, pbBorderAvail, ch);
   }
 }
 
@@ -539,6 +819,16 @@ Void TComSampleAdaptiveOffset::processSaoBlock(Pel* pDec, Pel* pRest, Int stride
   Pel *pClipTbl  = m_apClipTable[toChannelType(compID)];
   Int *pOffsetBo = m_aiOffsetBo[toChannelType(compID)];
 
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+  if (TComSimd::getLevel() != SIMD_SCALAR && height > 1)
+  {
+    if (xSaoBlockSSE41(pDec, pRest, stride, saoType, width, height, pbBorderAvail, m_iOffsetEo, m_iOffsetBand, g_bitDepth[toChannelType(compID)]))
+    {
+      return;
+    }
+  }
+#endif
+
   switch (saoType)
   {
   case SAO_EO_0: // dir: -
@@ -818,7 +1108,7 @@ Void TComSampleAdaptiveOffset::processSaoCuOrg(Int iAddr, Int iSaoType, Componen
     pRec -= (iStride*(iCuHeightTmp+1));
 
     pTmpL = m_pTmpL1;
-    pTmpU = &(m_pTmpU1[uiLPelX]);
+    pTmpU = &(m_pTmpU1[ch][uiLPelX]);
   }
 
   switch (iSaoType)
@@ -996,12 +1286,73 @@ Void TComSampleAdaptiveOffset::SAOProcess(SAOParam* pcSaoParam)
   m_pcPic = NULL;
 }
 
+/** Sample adaptive offset process of one CTU row
+ * \param pcSaoParam SAO parameters
+ * \param iRow CTU row, the rows of the picture are processed in increasing order
+ *
+ * \note The row below must be deblocked. The samples of the row above may already be final.
+ */
+Void TComSampleAdaptiveOffset::SAOProcessCTURow(SAOParam* pcSaoParam, Int iRow)
+{
+  if (iRow == 0)
+  {
+    for(UInt ch = 0; ch < MAX_NUM_CHANNEL_TYPE; ch++)
+    {
+      m_auiSaoBitIncrease[ch] = max(g_bitDepth[ch] - 10, 0);
+    }
+
+    if (m_saoLcuBasedOptimization)
+    {
+      for(UInt i=0; i<MAX_NUM_COMPONENT; i++)
+      {
+        pcSaoParam->oneUnitFlag[i] = 0;
+      }
+    }
+  }
+
+  if(m_bUseNIF)
+  {
+    // the lines of the row and the first line of the row below, the last line of the row above was copied with that row
+    TComPicYuv* pcPicYuvRec = m_pcPic->getPicYuvRec();
+    for(UInt chan=0; chan<m_pcPic->getNumberValidComponents(); chan++)
+    {
+      const ComponentID ch=ComponentID(chan);
+      const UInt sy = m_pcPic->getComponentScaleY(ch);
+      const Int  stride    = m_pcPic->getStride(ch);
+      const Int  firstLine = (iRow * m_uiMaxCUHeight) >> sy;
+      const Int  endLine   = min((Int)(((iRow+1) * m_uiMaxCUHeight) >> sy) + 1, m_iPicHeight >> sy);
+
+      memcpy(m_pcYuvTmp->getAddr(ch) + firstLine*stride, pcPicYuvRec->getAddr(ch) + firstLine*stride, sizeof(Pel)*stride*(endLine-firstLine));
+    }
+  }
+
+  for(UInt chan=0; chan<m_pcPic->getNumberValidComponents(); chan++)
+  {
+    const ComponentID ch=ComponentID(chan);
+    processSaoUnitRow( pcSaoParam->saoLcuParam[ch], pcSaoParam->oneUnitFlag[ch], ch, iRow);
+  }
+}
+
 /** Process SAO all units
  * \param saoLcuParam SAO LCU parameters
  * \param oneUnitFlag one unit flag
  * \param yCbCr color componet index
  */
 Void TComSampleAdaptiveOffset::processSaoUnitAll(SaoLcuParam* saoLcuParam, Bool oneUnitFlag, ComponentID ch)
+{
+  for (Int idxY = 0; idxY < m_pcPic->getFrameHeightInCU(); idxY++)
+  {
+    processSaoUnitRow(saoLcuParam, oneUnitFlag, ch, idxY);
+  }
+}
+
+/** Process the SAO units of one CTU row
+ * \param saoLcuParam SAO LCU parameters
+ * \param oneUnitFlag one unit flag
+ * \param yCbCr color componet index
+ * \param idxY CTU row, the rows of a component are processed in increasing order
+ */
+Void TComSampleAdaptiveOffset::processSaoUnitRow(SaoLcuParam* saoLcuParam, Bool oneUnitFlag, ComponentID ch, Int idxY)
 {
 
   const UInt sx=m_pcPic->getComponentScaleX(ch);
@@ -1009,28 +1360,21 @@ Void TComSampleAdaptiveOffset::processSaoUnitAll(SaoLcuParam* saoLcuParam, Bool
   const Int picWidthTmp = m_iPicWidth>>sx;
   const Int stride = m_pcPic->getStride(ch);
 
+  if (idxY == 0)
   {
     Pel *pRec        = m_pcPic->getPicYuvRec()->getAddr(ch);
-    memcpy(m_pTmpU1, pRec, sizeof(Pel)*picWidthTmp);
+    memcpy(m_pTmpU1[ch], pRec, sizeof(Pel)*picWidthTmp);
   }
 
   Int  i;
-  UInt edgeType;
-  Int* pOffsetBo = m_aiOffsetBo[toChannelType(ch)];
   Int  typeIdx;
 
-  Int offset[LUMA_GROUP_NUM+1];
   Int idxX;
-  Int idxY;
   Int addr;
   Int frameWidthInCU = m_pcPic->getFrameWidthInCU();
-  Int frameHeightInCU = m_pcPic->getFrameHeightInCU();
   Pel *tmpUSwap;
   Bool mergeLeftFlag;
-  Int saoBitIncrease = m_auiSaoBitIncrease[toChannelType(ch)];
 
-  offset[0] = 0;
-  for (idxY = 0; idxY< frameHeightInCU; idxY++)
   {
     addr = idxY * frameWidthInCU;
     Pel *pRec        = m_pcPic->getPicYuvRec()->getAddr(ch, addr);
@@ -1043,7 +1387,7 @@ Void TComSampleAdaptiveOffset::processSaoUnitAll(SaoLcuParam* saoLcuParam, Bool
     }
     pRec-=(stride<<1);
 
-    memcpy(m_pTmpU2, pRec, sizeof(Pel)*picWidthTmp);
+    memcpy(m_pTmpU2[ch], pRec, sizeof(Pel)*picWidthTmp);
 
     for (idxX = 0; idxX < frameWidthInCU; idxX++)
     {
@@ -1064,39 +1408,7 @@ Void TComSampleAdaptiveOffset::processSaoUnitAll(SaoLcuParam* saoLcuParam, Bool
       {
         if (!mergeLeftFlag)
         {
-
-          if (typeIdx == SAO_BO)
-          {
-            for (i=0; i<SAO_MAX_BO_CLASSES+1;i++)
-            {
-              offset[i] = 0;
-            }
-            for (i=0; i<saoLcuParam[addr].length; i++)
-            {
-              offset[ (saoLcuParam[addr].subTypeIdx +i)%SAO_MAX_BO_CLASSES  +1] = saoLcuParam[addr].offset[i] << saoBitIncrease;
-            }
-
-            Pel* ppTable = m_aTableBo[toChannelType(ch)];
-            Pel* pClipTable = m_apClipTable[toChannelType(ch)];
-            Int bitDepth = g_bitDepth[toChannelType(ch)];
-
-            for (i=0;i<(1<<bitDepth);i++)
-            {
-              pOffsetBo[i] = pClipTable[i + offset[ppTable[i]]];
-            }
-
-          }
-          if (typeIdx == SAO_EO_0 || typeIdx == SAO_EO_1 || typeIdx == SAO_EO_2 || typeIdx == SAO_EO_3)
-          {
-            for (i=0;i<saoLcuParam[addr].length;i++)
-            {
-              offset[i+1] = saoLcuParam[addr].offset[i] << saoBitIncrease;
-            }
-            for (edgeType=0;edgeType<6;edgeType++)
-            {
-              m_iOffsetEo[edgeType]= offset[m_auiEoTable[edgeType]];
-            }
-          }
+          xSetSaoUnitOffsets(&saoLcuParam[addr], ch);
         }
         processSaoCu(addr, typeIdx, ch);
       }
@@ -1114,12 +1426,184 @@ Void TComSampleAdaptiveOffset::processSaoUnitAll(SaoLcuParam* saoLcuParam, Bool
         }
       }
     }
-    tmpUSwap = m_pTmpU1;
-    m_pTmpU1 = m_pTmpU2;
-    m_pTmpU2 = tmpUSwap;
+    tmpUSwap = m_pTmpU1[ch];
+    m_pTmpU1[ch] = m_pTmpU2[ch];
+    m_pTmpU2[ch] = tmpUSwap;
   }
 
 }
+/** Set the offset tables of an SAO unit
+ * \param saoUnit SAO parameters of the unit
+ * \param ch color component index
+ */
+Void TComSampleAdaptiveOffset::xSetSaoUnitOffsets(SaoLcuParam* saoUnit, ComponentID ch)
+{
+  Int  i;
+  UInt edgeType;
+  Int* pOffsetBo = m_aiOffsetBo[toChannelType(ch)];
+  Int  typeIdx   = saoUnit->typeIdx;
+  Int  saoBitIncrease = m_auiSaoBitIncrease[toChannelType(ch)];
+  Int  offset[LUMA_GROUP_NUM+1];
+
+  for (i=0; i<LUMA_GROUP_NUM+1; i++)
+  {
+    offset[i] = 0;
+  }
+
+  if (typeIdx == SAO_BO)
+  {
+    for (i=0; i<saoUnit->length; i++)
+    {
+      offset[ (saoUnit->subTypeIdx +i)%SAO_MAX_BO_CLASSES  +1] = saoUnit->offset[i] << saoBitIncrease;
+    }
+    for (i=0; i<SAO_MAX_BO_CLASSES; i++)
+    {
+      m_iOffsetBand[i] = offset[i+1];
+    }
+
+    Pel* ppTable = m_aTableBo[toChannelType(ch)];
+    Pel* pClipTable = m_apClipTable[toChannelType(ch)];
+    Int bitDepth = g_bitDepth[toChannelType(ch)];
+
+    for (i=0;i<(1<<bitDepth);i++)
+    {
+      pOffsetBo[i] = pClipTable[i + offset[ppTable[i]]];
+    }
+  }
+  if (typeIdx == SAO_EO_0 || typeIdx == SAO_EO_1 || typeIdx == SAO_EO_2 || typeIdx == SAO_EO_3)
+  {
+    for (i=0;i<saoUnit->length;i++)
+    {
+      offset[i+1] = saoUnit->offset[i] << saoBitIncrease;
+    }
+    for (edgeType=0;edgeType<6;edgeType++)
+    {
+      m_iOffsetEo[edgeType]= offset[m_auiEoTable[edgeType]];
+    }
+  }
+}
+
+/** Process the SAO unit of one CTU, reading the samples before SAO from a copy of the picture
+ * \param saoLcuParam SAO LCU parameters
+ * \param oneUnitFlag one unit flag
+ * \param ch color component index
+ * \param iAddr CTU address
+ * \param pcPicYuvDec picture before SAO
+ *
+ * \note Unlike processSaoUnitRow(), the CTUs can be processed in any order. A merged unit holds a copy of the
+ *       parameters it is merged with, so the offsets are set up for every CTU.
+ */
+Void TComSampleAdaptiveOffset::processSaoCtu(SaoLcuParam* saoLcuParam, Bool oneUnitFlag, ComponentID ch, Int iAddr, TComPicYuv* pcPicYuvDec)
+{
+  SaoLcuParam* saoUnit = &saoLcuParam[oneUnitFlag ? 0 : iAddr];
+  const Int typeIdx = saoUnit->typeIdx;
+
+  if (typeIdx < 0)
+  {
+    return;
+  }
+
+  xSetSaoUnitOffsets(saoUnit, ch);
+
+  if (m_bUseNIF)
+  {
+    xProcessSaoFilterBlocks(iAddr, typeIdx, ch, pcPicYuvDec);
+    return;
+  }
+
+  const UInt csx = m_pcPic->getComponentScaleX(ch);
+  const UInt csy = m_pcPic->getComponentScaleY(ch);
+  const Int  picWidthTmp  = m_iPicWidth  >> csx;
+  const Int  picHeightTmp = m_iPicHeight >> csy;
+  TComDataCU* pcCU = m_pcPic->getCU(iAddr);
+  const Int  xPos   = pcCU->getCUPelX() >> csx;
+  const Int  yPos   = pcCU->getCUPelY() >> csy;
+  const Int  width  = min((Int)(m_uiMaxCUWidth  >> csx), picWidthTmp  - xPos);
+  const Int  height = min((Int)(m_uiMaxCUHeight >> csy), picHeightTmp - yPos);
+  const Int  stride = m_pcPic->getStride(ch);
+  const Int  posOffset = (yPos * stride) + xPos;
+
+  // without independent slices and tiles, only the picture boundaries limit the neighbourhood
+  Bool borderAvail[NUM_SGU_BORDER];
+  borderAvail[SGU_L]  = (xPos > 0);
+  borderAvail[SGU_R]  = (xPos + width  < picWidthTmp);
+  borderAvail[SGU_T]  = (yPos > 0);
+  borderAvail[SGU_B]  = (yPos + height < picHeightTmp);
+  borderAvail[SGU_TL] = borderAvail[SGU_T] && borderAvail[SGU_L];
+  borderAvail[SGU_TR] = borderAvail[SGU_T] && borderAvail[SGU_R];
+  borderAvail[SGU_BL] = borderAvail[SGU_B] && borderAvail[SGU_L];
+  borderAvail[SGU_BR] = borderAvail[SGU_B] && borderAvail[SGU_R];
+
+  processSaoBlock(getPicYuvAddr(pcPicYuvDec, ch) + posOffset, getPicYuvAddr(m_pcPic->getPicYuvRec(), ch) + posOffset, stride, typeIdx, width, height, borderAvail, ch);
+}
+
+/** Process SAO all units of all components on the threads set with setThreadPool()
+ * \param pcSaoParam SAO parameters, the components whose SAO flag is not set are left untouched
+ *
+ * \note The reconstruction is copied first (m_pcYuvTmp already holds the copy with independent slice or tile boundaries),
+ *       so that each CTU reads its own area from the unfiltered copy. The result is identical to processSaoUnitAll().
+ */
+Void TComSampleAdaptiveOffset::processSaoUnitAllParallel(SAOParam* pcSaoParam)
+{
+  TComPicYuv* pcPicYuvRec = m_pcPic->getPicYuvRec();
+
+  if (m_bUseNIF)
+  {
+    m_pcJobYuvDec = m_pcYuvTmp;
+  }
+  else
+  {
+    if (m_pcYuvCopy == NULL)
+    {
+      m_pcYuvCopy = new TComPicYuv;
+      m_pcYuvCopy->create(pcPicYuvRec->getWidth(COMPONENT_Y), pcPicYuvRec->getHeight(COMPONENT_Y), pcPicYuvRec->getChromaFormat(), m_uiMaxCUWidth, m_uiMaxCUHeight, g_uiMaxCUDepth);
+    }
+    pcPicYuvRec->copyToPic(m_pcYuvCopy);
+    m_pcJobYuvDec = m_pcYuvCopy;
+  }
+  m_pcJobSaoParam = pcSaoParam;
+
+  for (Int i = 0; i < m_pcThreadPool->getNumThreads(); i++)
+  {
+    TComSampleAdaptiveOffset& rcWorker = m_pcSaoWorkers[i];
+    rcWorker.m_pcPic   = m_pcPic;
+    rcWorker.m_bUseNIF = m_bUseNIF;
+    for (UInt ch = 0; ch < MAX_NUM_CHANNEL_TYPE; ch++)
+    {
+      rcWorker.m_auiSaoBitIncrease[ch] = m_auiSaoBitIncrease[ch];
+    }
+  }
+
+  TComMemberJob<TComSampleAdaptiveOffset> cRowJob(this, &TComSampleAdaptiveOffset::xProcessSaoCTURowJob);
+  m_pcThreadPool->execute(&cRowJob, m_pcPic->getFrameHeightInCU());
+
+  m_pcJobSaoParam = NULL;
+  m_pcJobYuvDec   = NULL;
+}
+
+/** Process the SAO units of one CTU row on a thread of the pool
+ * \param iRow CTU row
+ * \param iThreadIdx index of the executing thread
+ */
+Void TComSampleAdaptiveOffset::xProcessSaoCTURowJob(Int iRow, Int iThreadIdx)
+{
+  TComSampleAdaptiveOffset& rcWorker = m_pcSaoWorkers[iThreadIdx];
+  const Int frameWidthInCU = m_pcPic->getFrameWidthInCU();
+
+  for (UInt chan = 0; chan < m_pcPic->getNumberValidComponents(); chan++)
+  {
+    const ComponentID ch = ComponentID(chan);
+    if (!m_pcJobSaoParam->bSaoFlag[toChannelType(ch)])
+    {
+      continue;
+    }
+    for (Int idxX = 0; idxX < frameWidthInCU; idxX++)
+    {
+      rcWorker.processSaoCtu(m_pcJobSaoParam->saoLcuParam[ch], m_pcJobSaoParam->oneUnitFlag[ch], ch, iRow * frameWidthInCU + idxX, m_pcJobYuvDec);
+    }
+  }
+}
+
 /** Reset SAO LCU part
  * \param saoLcuParam
  */
@@ -1245,20 +1729,32 @@ Void TComSampleAdaptiveOffset::copySaoUnit(SaoLcuParam* saoUnitDst, SaoLcuParam*
  */
 Void TComSampleAdaptiveOffset::PCMLFDisableProcess (TComPic* pcPic)
 {
-  xPCMRestoration(pcPic);
+  xPCMRestoration(pcPic, 0, pcPic->getNumCUsInFrame());
+}
+
+/** PCM LF disable process of one CTU row.
+ * \param pcPic picture (TComPic) pointer
+ * \param uiRow CTU row
+ * \returns Void
+ */
+Void TComSampleAdaptiveOffset::PCMLFDisableProcessCTURow (TComPic* pcPic, UInt uiRow)
+{
+  xPCMRestoration(pcPic, uiRow * pcPic->getFrameWidthInCU(), (uiRow + 1) * pcPic->getFrameWidthInCU());
 }
 
-/** Picture-level PCM restoration.
+/** PCM restoration of a range of CUs.
  * \param pcPic picture (TComPic) pointer
+ * \param uiFirstCUAddr first CU
+ * \param uiEndCUAddr CU following the last one
  * \returns Void
  */
-Void TComSampleAdaptiveOffset::xPCMRestoration(TComPic* pcPic)
+Void TComSampleAdaptiveOffset::xPCMRestoration(TComPic* pcPic, UInt uiFirstCUAddr, UInt uiEndCUAddr)
 {
   Bool  bPCMFilter = (pcPic->getSlice(0)->getSPS()->getUsePCM() && pcPic->getSlice(0)->getSPS()->getPCMFilterDisableFlag())? true : false;
 
   if(bPCMFilter || pcPic->getSlice(0)->getPPS()->getTransquantBypassEnableFlag())
   {
-    for( UInt uiCUAddr = 0; uiCUAddr < pcPic->getNumCUsInFrame() ; uiCUAddr++ )
+    for( UInt uiCUAddr = uiFirstCUAddr; uiCUAddr < uiEndCUAddr ; uiCUAddr++ )
     {
       TComDataCU* pcCU = pcPic->getCU(uiCUAddr);
 
@@ -40,6 +40,7 @@
 
 #include "CommonDef.h"
 #include "TComPic.h"
+#include "TComThreadPool.h"
 
 //! \ingroup TLibCommon
 //! \{
@@ -69,6 +70,7 @@ protected:
   static const UInt m_auiEoTable[SAO_EO_TABLE_SIZE]; //NOTE: RExt - This table appears to be larger than needed.
   Int *m_aiOffsetBo[MAX_NUM_CHANNEL_TYPE];
   Int  m_iOffsetEo[LUMA_GROUP_NUM];                  //NOTE: RExt - This table appears to be larger than needed.
+  Int  m_iOffsetBand[SAO_MAX_BO_CLASSES];            ///< band offsets of the current unit, indexed by band
   Int  m_iPicWidth;
   Int  m_iPicHeight;
   UInt m_uiMaxSplitLevel;
@@ -92,15 +94,24 @@ protected:
   Bool  m_bUseNIF;       //!< true for performing non-cross slice boundary ALF
   TComPicYuv* m_pcYuvTmp;    //!< temporary picture buffer pointer when non-across slice/tile boundary SAO is enabled
 
-  Pel* m_pTmpU1;
-  Pel* m_pTmpU2;
+  Pel* m_pTmpU1[MAX_NUM_COMPONENT];  //!< bottom line of the previous CTU row before SAO
+  Pel* m_pTmpU2[MAX_NUM_COMPONENT];
   Pel* m_pTmpL1;
   Pel* m_pTmpL2;
   Int     m_maxNumOffsetsPerPic;
   Bool    m_saoLcuBoundary;
   Bool    m_saoLcuBasedOptimization;
 
-  Void xPCMRestoration        (TComPic* pcPic);
+  TComThreadPool*           m_pcThreadPool;    //!< worker threads processing the CTUs of a picture, NULL when single-threaded
+  TComSampleAdaptiveOffset* m_pcSaoWorkers;    //!< offset tables and line buffers of each thread of m_pcThreadPool
+  TComPicYuv*               m_pcYuvCopy;       //!< copy of the picture before SAO read by the threads when m_pcYuvTmp is not used
+  TComPicYuv*               m_pcJobYuvDec;     //!< picture before SAO of the running job
+  SAOParam*                 m_pcJobSaoParam;   //!< SAO parameters of the running job
+
+  Void xSetSaoUnitOffsets     (SaoLcuParam* saoUnit, ComponentID ch);
+  Void xProcessSaoFilterBlocks(Int iAddr, Int iSaoType, ComponentID ch, TComPicYuv* pcPicYuvDec);
+  Void xProcessSaoCTURowJob   (Int iRow, Int iThreadIdx);
+  Void xPCMRestoration        (TComPic* pcPic, UInt uiFirstCUAddr, UInt uiEndCUAddr);
   Void xPCMCURestoration      (TComDataCU* pcCU, UInt uiAbsZorderIdx, UInt uiDepth);
   Void xPCMSampleRestoration  (TComDataCU* pcCU, UInt uiAbsZorderIdx, UInt uiDepth, const ComponentID compID);
 public:
@@ -118,6 +129,7 @@ public:
   static Void freeSaoParam   (SAOParam *pcSaoParam);
 
   Void SAOProcess(SAOParam* pcSaoParam);
+  Void SAOProcessCTURow(SAOParam* pcSaoParam, Int iRow);
   Void processSaoCu(Int iAddr, Int iSaoType, ComponentID ch);
   Pel* getPicYuvAddr(TComPicYuv* pcPicYuv, ComponentID ch,Int iAddr = 0) { return pcPicYuv->getAddr(ch, iAddr); }
 
@@ -131,6 +143,11 @@ public:
   Void convertQT2SaoUnit(SAOParam* saoParam, UInt partIdx, ComponentID ch);
   Void convertOnePart2SaoUnit(SAOParam *saoParam, UInt partIdx, ComponentID ch);
   Void processSaoUnitAll(SaoLcuParam* saoLcuParam, Bool oneUnitFlag, ComponentID ch);
+  Void processSaoUnitRow(SaoLcuParam* saoLcuParam, Bool oneUnitFlag, ComponentID ch, Int idxY);
+  Void processSaoCtu(SaoLcuParam* saoLcuParam, Bool oneUnitFlag, ComponentID ch, Int iAddr, TComPicYuv* pcPicYuvDec);
+  Void processSaoUnitAllParallel(SAOParam* pcSaoParam);
+  Void setThreadPool     (TComThreadPool* pcThreadPool);
+  TComThreadPool* getThreadPool () { return m_pcThreadPool; }
   Void setSaoLcuBoundary (Bool bVal)  {m_saoLcuBoundary = bVal;}
   Bool getSaoLcuBoundary ()           {return m_saoLcuBoundary;}
   Void setSaoLcuBasedOptimization (Bool bVal)  {m_saoLcuBasedOptimization = bVal;}
@@ -139,6 +156,7 @@ public:
   Void resetSaoUnit(SaoLcuParam* saoUnit);
   Void copySaoUnit(SaoLcuParam* saoUnitDst, SaoLcuParam* saoUnitSrc );
   Void PCMLFDisableProcess    ( TComPic* pcPic);                        ///< interface function for ALF process
+  Void PCMLFDisableProcessCTURow ( TComPic* pcPic, UInt uiRow );        ///< PCM restoration of one CTU row
 };
 
 //! \}
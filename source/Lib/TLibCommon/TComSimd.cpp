@@ -0,0 +1,215 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.  
+ *
+ * Copyright (c) 2010-2013, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComSimd.cpp
+    \brief    run-time selection of the SIMD kernels
+*/
+
+#include <stdlib.h>
+#include <algorithm>
+#include "TComSimd.h"
+
+#if SIMD_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+//! \ingroup TLibCommon
+//! \{
+
+Bool      TComSimd::m_bInitialised = false;
+SimdLevel TComSimd::m_eCpuLevel    = SIMD_SCALAR;
+SimdLevel TComSimd::m_eLevel       = SIMD_SCALAR;
+
+#if SIMD_X86
+/** Execute the cpuid instruction.
+ * \param uiLeaf     leaf (eax)
+ * \param uiSubLeaf  sub-leaf (ecx)
+ * \param auiRegs    returns eax, ebx, ecx and edx
+ */
+static Void xCpuId( UInt uiLeaf, UInt uiSubLeaf, UInt auiRegs[4] )
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  Int aiRegs[4];
+  __cpuidex( aiRegs, (Int)uiLeaf, (Int)uiSubLeaf );
+  for ( Int i = 0; i < 4; i++ )
+  {
+    auiRegs[i] = (UInt)aiRegs[i];
+  }
+#else
+  __cpuid_count( uiLeaf, uiSubLeaf, auiRegs[0], auiRegs[1], auiRegs[2], auiRegs[3] );
+#endif
+}
+
+/** Read the register state enabled by the operating system (xgetbv, XCR0).
+ */
+static UInt xGetXcr0()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  return (UInt)_xgetbv( 0 );
+#else
+  UInt uiEax, uiEdx;
+  __asm__ __volatile__ ( "xgetbv" : "=a" (uiEax), "=d" (uiEdx) : "c" (0) );
+  return uiEax;
+#endif
+}
+#endif
+
+/** Determine the highest level supported by the processor and the operating system.
+ * \returns level
+ */
+SimdLevel TComSimd::xDetectCpuLevel()
+{
+  SimdLevel eLevel = SIMD_SCALAR;
+#if SIMD_X86
+  UInt auiRegs[4];
+  xCpuId( 0, 0, auiRegs );
+  const UInt uiMaxLeaf = auiRegs[0];
+  if ( uiMaxLeaf < 1 )
+  {
+    return eLevel;
+  }
+  xCpuId( 1, 0, auiRegs );
+  const Bool bSSE41   = ( auiRegs[2] & ( 1 << 19 ) ) != 0;
+  const Bool bOSXSave = ( auiRegs[2] & ( 1 << 27 ) ) != 0;
+  const Bool bAVX     = ( auiRegs[2] & ( 1 << 28 ) ) != 0;
+  if ( !bSSE41 )
+  {
+    return eLevel;
+  }
+  eLevel = SIMD_SSE41;
+
+  // AVX2 requires the operating system to save the YMM registers
+  if ( bOSXSave && bAVX && uiMaxLeaf >= 7 && ( xGetXcr0() & 6 ) == 6 )
+  {
+    xCpuId( 7, 0, auiRegs );
+    if ( auiRegs[1] & ( 1 << 5 ) )
+    {
+      eLevel = SIMD_AVX2;
+    }
+  }
+#endif
+  return eLevel;
+}
+
+/** Convert a level name to a level.
+ * \param sName    "scalar", "sse41", "avx2" or "auto" (the level of the processor)
+ * \param reLevel  returns the level
+ * \returns false if the name is not known
+ */
+Bool TComSimd::xParseLevel( const std::string& sName, SimdLevel& reLevel )
+{
+  if ( sName == "scalar" || sName == "0" )
+  {
+    reLevel = SIMD_SCALAR;
+  }
+  else if ( sName == "sse41" || sName == "1" )
+  {
+    reLevel = SIMD_SSE41;
+  }
+  else if ( sName == "avx2" || sName == "2" )
+  {
+    reLevel = SIMD_AVX2;
+  }
+  else if ( sName == "auto" || sName.empty() )
+  {
+    reLevel = m_eCpuLevel;
+  }
+  else
+  {
+    return false;
+  }
+  return true;
+}
+
+/** Detect the processor level and apply the HM_SIMD environment variable, once.
+ */
+Void TComSimd::xInit()
+{
+  if ( m_bInitialised )
+  {
+    return;
+  }
+  m_bInitialised = true;
+  m_eCpuLevel    = xDetectCpuLevel();
+  m_eLevel       = m_eCpuLevel;
+
+  const Char* pcEnv = getenv( "HM_SIMD" );
+  if ( pcEnv != NULL )
+  {
+    SimdLevel eLevel;
+    if ( xParseLevel( pcEnv, eLevel ) )
+    {
+      m_eLevel = std::min( eLevel, m_eCpuLevel );
+    }
+  }
+}
+
+/** Set the level used by the kernels, limited to the level of the processor.
+ * \param sName  level name, see xParseLevel(); an empty name keeps the level from the environment
+ * \returns false if the name is not known
+ */
+Bool TComSimd::setLevel( const std::string& sName )
+{
+  xInit();
+  if ( sName.empty() )
+  {
+    return true;
+  }
+  SimdLevel eLevel;
+  if ( !xParseLevel( sName, eLevel ) )
+  {
+    return false;
+  }
+  m_eLevel = std::min( eLevel, m_eCpuLevel );
+  return true;
+}
+
+/** Get the name of a level.
+ * \param eLevel  level
+ * \returns name
+ */
+const Char* TComSimd::getLevelName( SimdLevel eLevel )
+{
+  switch ( eLevel )
+  {
+    case SIMD_SSE41: return "sse41";
+    case SIMD_AVX2:  return "avx2";
+    default:         return "scalar";
+  }
+}
+
+//! \}
@@ -0,0 +1,112 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.  
+ *
+ * Copyright (c) 2010-2013, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComSimd.h
+    \brief    run-time selection of the SIMD kernels (header)
+*/
+
+#ifndef __TCOMSIMD__
+#define __TCOMSIMD__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <string>
+#include "TypeDef.h"
+
+// x86 kernels are built with function-level target attributes, so that the rest of the code is compiled for the
+// baseline instruction set and the kernels are only called on processors that support them
+#if SIMD_KERNELS && ( defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86) ) \
+    && ( defined(_MSC_VER) || defined(__clang__) || ( defined(__GNUC__) && ( __GNUC__ > 4 || ( __GNUC__ == 4 && __GNUC_MINOR__ >= 9 ) ) ) )
+#define SIMD_X86 1
+#else
+#define SIMD_X86 0
+#endif
+
+#if SIMD_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#define SIMD_TARGET_SSE41
+#define SIMD_TARGET_AVX2
+#else
+#define SIMD_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define SIMD_TARGET_AVX2  __attribute__((target("avx2")))
+#endif
+#endif
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Enumeration
+// ====================================================================================================================
+
+/// instruction set extensions usable by the kernels, in increasing order
+enum SimdLevel
+{
+  SIMD_SCALAR = 0,  ///< C++ kernels only
+  SIMD_SSE41  = 1,  ///< SSE2 to SSE4.1
+  SIMD_AVX2   = 2   ///< AVX2
+};
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/** Run-time selection of the SIMD kernels.
+ * The level is the highest one supported by the processor, limited by the HM_SIMD environment variable or by the
+ * --SIMD option of the applications ("scalar", "sse41", "avx2" or "auto"). It has to be chosen before the coding
+ * tools are initialised, which pick their kernels from it. All the levels give identical results.
+ */
+class TComSimd
+{
+private:
+  static Bool       m_bInitialised;
+  static SimdLevel  m_eCpuLevel;
+  static SimdLevel  m_eLevel;
+
+  static Void       xInit();
+  static SimdLevel  xDetectCpuLevel();
+  static Bool       xParseLevel( const std::string& sName, SimdLevel& reLevel );
+
+public:
+  static SimdLevel  getCpuLevel ()  { xInit(); return m_eCpuLevel; }
+  static SimdLevel  getLevel    ()  { xInit(); return m_eLevel;    }
+  static Bool       setLevel    ( const std::string& sName );
+  static const Char* getLevelName( SimdLevel eLevel );
+};
+
+//! \}
+
+#endif // __TCOMSIMD__
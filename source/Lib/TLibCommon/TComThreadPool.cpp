@@ -0,0 +1,462 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.  
+ *
+ * Copyright (c) 2010-2013, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComThreadPool.cpp
+    \brief    portable threading primitives and thread pool
+*/
+
+#include <assert.h>
+#include "TComThreadPool.h"
+
+#ifdef _WIN32
+#if !defined(_WIN32_WINNT) || _WIN32_WINNT < 0x0600
+#undef  _WIN32_WINNT
+#define _WIN32_WINNT 0x0600   // condition variables require Windows Vista or later
+#endif
+#include <windows.h>
+#include <process.h>
+#else
+#include <pthread.h>
+#endif
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// TComMutex / TComCondition
+// ====================================================================================================================
+
+#ifdef _WIN32
+
+TComMutex::TComMutex()
+{
+  CRITICAL_SECTION* pcCS = new CRITICAL_SECTION;
+  InitializeCriticalSection( pcCS );
+  m_pcHandle = pcCS;
+}
+
+TComMutex::~TComMutex()
+{
+  DeleteCriticalSection( (CRITICAL_SECTION*)m_pcHandle );
+  delete (CRITICAL_SECTION*)m_pcHandle;
+}
+
+Void TComMutex::lock()
+{
+  EnterCriticalSection( (CRITICAL_SECTION*)m_pcHandle );
+}
+
+Void TComMutex::unlock()
+{
+  LeaveCriticalSection( (CRITICAL_SECTION*)m_pcHandle );
+}
+
+TComCondition::TComCondition()
+{
+  CONDITION_VARIABLE* pcCV = new CONDITION_VARIABLE;
+  InitializeConditionVariable( pcCV );
+  m_pcHandle = pcCV;
+}
+
+TComCondition::~TComCondition()
+{
+  delete (CONDITION_VARIABLE*)m_pcHandle;
+}
+
+Void TComCondition::wait( TComMutex& rcMutex )
+{
+  SleepConditionVariableCS( (CONDITION_VARIABLE*)m_pcHandle, (CRITICAL_SECTION*)rcMutex.getHandle(), INFINITE );
+}
+
+Void TComCondition::broadcast()
+{
+  WakeAllConditionVariable( (CONDITION_VARIABLE*)m_pcHandle );
+}
+
+#else
+
+TComMutex::TComMutex()
+{
+  pthread_mutex_t* pcMutex = new pthread_mutex_t;
+  pthread_mutex_init( pcMutex, NULL );
+  m_pcHandle = pcMutex;
+}
+
+TComMutex::~TComMutex()
+{
+  pthread_mutex_destroy( (pthread_mutex_t*)m_pcHandle );
+  delete (pthread_mutex_t*)m_pcHandle;
+}
+
+Void TComMutex::lock()
+{
+  pthread_mutex_lock( (pthread_mutex_t*)m_pcHandle );
+}
+
+Void TComMutex::unlock()
+{
+  pthread_mutex_unlock( (pthread_mutex_t*)m_pcHandle );
+}
+
+TComCondition::TComCondition()
+{
+  pthread_cond_t* pcCond = new pthread_cond_t;
+  pthread_cond_init( pcCond, NULL );
+  m_pcHandle = pcCond;
+}
+
+TComCondition::~TComCondition()
+{
+  pthread_cond_destroy( (pthread_cond_t*)m_pcHandle );
+  delete (pthread_cond_t*)m_pcHandle;
+}
+
+Void TComCondition::wait( TComMutex& rcMutex )
+{
+  pthread_cond_wait( (pthread_cond_t*)m_pcHandle, (pthread_mutex_t*)rcMutex.getHandle() );
+}
+
+Void TComCondition::broadcast()
+{
+  pthread_cond_broadcast( (pthread_cond_t*)m_pcHandle );
+}
+
+#endif
+
+// ====================================================================================================================
+// TComProgressCounters
+// ====================================================================================================================
+
+TComProgressCounters::TComProgressCounters()
+: m_piCounters   ( NULL )
+, m_iNumCounters ( 0 )
+{
+}
+
+TComProgressCounters::~TComProgressCounters()
+{
+  destroy();
+}
+
+Void TComProgressCounters::create( Int iNumCounters )
+{
+  destroy();
+  m_iNumCounters = iNumCounters;
+  m_piCounters   = new Int[iNumCounters];
+  reset();
+}
+
+Void TComProgressCounters::destroy()
+{
+  delete [] m_piCounters;
+  m_piCounters   = NULL;
+  m_iNumCounters = 0;
+}
+
+Void TComProgressCounters::reset( Int iValue )
+{
+  TComMutexLock cLock( m_cMutex );
+  for ( Int i = 0; i < m_iNumCounters; i++ )
+  {
+    m_piCounters[i] = iValue;
+  }
+}
+
+Void TComProgressCounters::set( Int iIdx, Int iValue )
+{
+  assert( iIdx >= 0 && iIdx < m_iNumCounters );
+  TComMutexLock cLock( m_cMutex );
+  m_piCounters[iIdx] = iValue;
+  m_cCondition.broadcast();
+}
+
+Int TComProgressCounters::get( Int iIdx )
+{
+  assert( iIdx >= 0 && iIdx < m_iNumCounters );
+  TComMutexLock cLock( m_cMutex );
+  return m_piCounters[iIdx];
+}
+
+Void TComProgressCounters::waitFor( Int iIdx, Int iValue )
+{
+  assert( iIdx >= 0 && iIdx < m_iNumCounters );
+  TComMutexLock cLock( m_cMutex );
+  while ( m_piCounters[iIdx] < iValue )
+  {
+    m_cCondition.wait( m_cMutex );
+  }
+}
+
+// ====================================================================================================================
+// TComWorkQueue
+// ====================================================================================================================
+
+Void TComWorkQueue::reset( Int iFirst, Int iStep, Int iEnd, UInt uiGeneration )
+{
+  TComMutexLock cLock( m_cMutex );
+  m_iNext        = iFirst;
+  m_iStep        = iStep;
+  m_iEnd         = iEnd;
+  m_uiGeneration = uiGeneration;
+}
+
+Int TComWorkQueue::front( UInt uiGeneration )
+{
+  TComMutexLock cLock( m_cMutex );
+  return ( m_uiGeneration == uiGeneration && m_iNext < m_iEnd ) ? m_iNext : -1;
+}
+
+Int TComWorkQueue::take( UInt uiGeneration )
+{
+  TComMutexLock cLock( m_cMutex );
+  if ( m_uiGeneration != uiGeneration || m_iNext >= m_iEnd )
+  {
+    return -1;
+  }
+  Int iItem = m_iNext;
+  m_iNext  += m_iStep;
+  return iItem;
+}
+
+// ====================================================================================================================
+// TComThreadPool
+// ====================================================================================================================
+
+struct TComThreadPoolArg
+{
+  TComThreadPool* pcPool;
+  Int             iThreadIdx;
+};
+
+#ifdef _WIN32
+static unsigned __stdcall xThreadPoolEntry( Void* pArg )
+#else
+static Void* xThreadPoolEntry( Void* pArg )
+#endif
+{
+  TComThreadPoolArg* pcArg = (TComThreadPoolArg*)pArg;
+  TComThreadPool::workerEntry( pcArg->pcPool, pcArg->iThreadIdx );
+  delete pcArg;
+  return 0;
+}
+
+TComThreadPool::TComThreadPool()
+: m_iNumThreads  ( 1 )
+, m_ppcThreads   ( NULL )
+, m_pcQueues     ( NULL )
+, m_pcJob        ( NULL )
+, m_iNumItems    ( 0 )
+, m_iNumFinished ( 0 )
+, m_uiGeneration ( 0 )
+, m_bTerminate   ( false )
+{
+}
+
+TComThreadPool::~TComThreadPool()
+{
+  destroy();
+}
+
+Void TComThreadPool::create( Int iNumThreads )
+{
+  destroy();
+  m_iNumThreads = iNumThreads > 1 ? iNumThreads : 1;
+  m_bTerminate  = false;
+  if ( m_iNumThreads == 1 )
+  {
+    return;
+  }
+
+  m_pcQueues   = new TComWorkQueue[m_iNumThreads];
+  m_ppcThreads = new Void*[m_iNumThreads];
+  m_ppcThreads[0] = NULL;
+  for ( Int i = 1; i < m_iNumThreads; i++ )
+  {
+    TComThreadPoolArg* pcArg = new TComThreadPoolArg;
+    pcArg->pcPool     = this;
+    pcArg->iThreadIdx = i;
+#ifdef _WIN32
+    m_ppcThreads[i] = (Void*)_beginthreadex( NULL, 0, xThreadPoolEntry, pcArg, 0, NULL );
+#else
+    pthread_t* pcThread = new pthread_t;
+    pthread_create( pcThread, NULL, xThreadPoolEntry, pcArg );
+    m_ppcThreads[i] = pcThread;
+#endif
+  }
+}
+
+Void TComThreadPool::destroy()
+{
+  if ( m_ppcThreads != NULL )
+  {
+    {
+      TComMutexLock cLock( m_cMutex );
+      m_bTerminate = true;
+      m_cWakeUp.broadcast();
+    }
+    for ( Int i = 1; i < m_iNumThreads; i++ )
+    {
+#ifdef _WIN32
+      WaitForSingleObject( (HANDLE)m_ppcThreads[i], INFINITE );
+      CloseHandle( (HANDLE)m_ppcThreads[i] );
+#else
+      pthread_join( *(pthread_t*)m_ppcThreads[i], NULL );
+      delete (pthread_t*)m_ppcThreads[i];
+#endif
+    }
+    delete [] m_ppcThreads;
+    m_ppcThreads = NULL;
+  }
+  delete [] m_pcQueues;
+  m_pcQueues    = NULL;
+  m_iNumThreads = 1;
+}
+
+Void TComThreadPool::workerEntry( TComThreadPool* pcPool, Int iThreadIdx )
+{
+  pcPool->xWorkerLoop( iThreadIdx );
+}
+
+Void TComThreadPool::xWorkerLoop( Int iThreadIdx )
+{
+  UInt uiSeenGeneration = 0;
+  for (;;)
+  {
+    TComJob* pcJob;
+    {
+      TComMutexLock cLock( m_cMutex );
+      while ( !m_bTerminate && ( m_uiGeneration == uiSeenGeneration || m_pcJob == NULL ) )
+      {
+        m_cWakeUp.wait( m_cMutex );
+      }
+      if ( m_bTerminate )
+      {
+        return;
+      }
+      uiSeenGeneration = m_uiGeneration;
+      pcJob            = m_pcJob;
+    }
+    xProcessItems( pcJob, iThreadIdx, uiSeenGeneration );
+  }
+}
+
+/** Take the next item of the own queue, or steal the lowest item left in the queues of the other threads.
+ * \returns the item, -1 when all items of the job have been taken
+ */
+Int TComThreadPool::xTakeItem( Int iThreadIdx, UInt uiGeneration )
+{
+  Int iItem = m_pcQueues[iThreadIdx].take( uiGeneration );
+
+  while ( iItem < 0 )
+  {
+    Int iVictim = -1;
+    Int iLowest = -1;
+    for ( Int i = 1; i < m_iNumThreads; i++ )
+    {
+      const Int iQueue = ( iThreadIdx + i ) % m_iNumThreads;
+      const Int iFront = m_pcQueues[iQueue].front( uiGeneration );
+      if ( iFront >= 0 && ( iLowest < 0 || iFront < iLowest ) )
+      {
+        iLowest = iFront;
+        iVictim = iQueue;
+      }
+    }
+    if ( iVictim < 0 )
+    {
+      return -1;
+    }
+    iItem = m_pcQueues[iVictim].take( uiGeneration );
+  }
+  return iItem;
+}
+
+/** Process items of a job until all of them have been taken.
+ */
+Void TComThreadPool::xProcessItems( TComJob* pcJob, Int iThreadIdx, UInt uiGeneration )
+{
+  for (;;)
+  {
+    const Int iItem = xTakeItem( iThreadIdx, uiGeneration );
+    if ( iItem < 0 )
+    {
+      return;
+    }
+
+    pcJob->run( iItem, iThreadIdx );
+
+    TComMutexLock cLock( m_cMutex );
+    if ( ++m_iNumFinished == m_iNumItems )
+    {
+      m_cDone.broadcast();
+    }
+  }
+}
+
+Void TComThreadPool::execute( TComJob* pcJob, Int iNumItems )
+{
+  if ( m_iNumThreads == 1 || iNumItems <= 1 )
+  {
+    for ( Int i = 0; i < iNumItems; i++ )
+    {
+      pcJob->run( i, 0 );
+    }
+    return;
+  }
+
+  UInt uiGeneration;
+  {
+    TComMutexLock cLock( m_cMutex );
+    assert( m_pcJob == NULL );
+    uiGeneration   = m_uiGeneration + 1;
+    for ( Int i = 0; i < m_iNumThreads; i++ )
+    {
+      m_pcQueues[i].reset( i, m_iNumThreads, iNumItems, uiGeneration );
+    }
+    m_pcJob        = pcJob;
+    m_iNumItems    = iNumItems;
+    m_iNumFinished = 0;
+    m_uiGeneration = uiGeneration;
+    m_cWakeUp.broadcast();
+  }
+
+  xProcessItems( pcJob, 0, uiGeneration );
+
+  TComMutexLock cLock( m_cMutex );
+  while ( m_iNumFinished < m_iNumItems )
+  {
+    m_cDone.wait( m_cMutex );
+  }
+  m_pcJob = NULL;
+}
+
+//! \}
@@ -0,0 +1,229 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.  
+ *
+ * Copyright (c) 2010-2013, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComThreadPool.h
+    \brief    portable threading primitives and thread pool (header)
+*/
+
+#ifndef __TCOMTHREADPOOL__
+#define __TCOMTHREADPOOL__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "TypeDef.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// mutual exclusion lock (pthread / Win32 critical section)
+class TComMutex
+{
+private:
+  Void*   m_pcHandle;
+
+  TComMutex( const TComMutex& );
+  TComMutex& operator= ( const TComMutex& );
+
+public:
+  TComMutex();
+  ~TComMutex();
+
+  Void    lock      ();
+  Void    unlock    ();
+
+  Void*   getHandle () { return m_pcHandle; }
+};
+
+/// scoped lock of a TComMutex
+class TComMutexLock
+{
+private:
+  TComMutex& m_rcMutex;
+
+  TComMutexLock( const TComMutexLock& );
+  TComMutexLock& operator= ( const TComMutexLock& );
+
+public:
+  TComMutexLock( TComMutex& rcMutex ) : m_rcMutex( rcMutex ) { m_rcMutex.lock();   }
+  ~TComMutexLock()                                            { m_rcMutex.unlock(); }
+};
+
+/// condition variable, used together with a locked TComMutex
+class TComCondition
+{
+private:
+  Void*   m_pcHandle;
+
+  TComCondition( const TComCondition& );
+  TComCondition& operator= ( const TComCondition& );
+
+public:
+  TComCondition();
+  ~TComCondition();
+
+  Void    wait      ( TComMutex& rcMutex );   ///< rcMutex must be locked by the caller
+  Void    broadcast ();
+};
+
+/// set of monotonically increasing counters that threads can wait on (e.g. number of finished CTUs of each CTU row)
+class TComProgressCounters
+{
+private:
+  Int*          m_piCounters;
+  Int           m_iNumCounters;
+  TComMutex     m_cMutex;
+  TComCondition m_cCondition;
+
+  TComProgressCounters( const TComProgressCounters& );
+  TComProgressCounters& operator= ( const TComProgressCounters& );
+
+public:
+  TComProgressCounters();
+  ~TComProgressCounters();
+
+  Void    create    ( Int iNumCounters );
+  Void    destroy   ();
+  Void    reset     ( Int iValue = 0 );
+  Int     getNumCounters() const { return m_iNumCounters; }
+
+  Void    set       ( Int iIdx, Int iValue );   ///< publish a new value and wake up the waiting threads
+  Int     get       ( Int iIdx );
+  Void    waitFor   ( Int iIdx, Int iValue );   ///< block until counter iIdx has reached iValue
+};
+
+/// work item interface executed by TComThreadPool
+class TComJob
+{
+public:
+  virtual ~TComJob() {}
+
+  /// process item iItem; iThreadIdx identifies the executing thread (0 is the thread calling TComThreadPool::execute)
+  virtual Void run( Int iItem, Int iThreadIdx ) = 0;
+};
+
+/// adapter dispatching the items of a job to a member function
+template <class T>
+class TComMemberJob : public TComJob
+{
+private:
+  T*    m_pcObject;
+  Void  (T::*m_pfnRun)( Int, Int );
+
+public:
+  TComMemberJob( T* pcObject, Void (T::*pfnRun)( Int, Int ) ) : m_pcObject( pcObject ), m_pfnRun( pfnRun ) {}
+
+  Void run( Int iItem, Int iThreadIdx ) { (m_pcObject->*m_pfnRun)( iItem, iThreadIdx ); }
+};
+
+/// items of the current job queued on one thread of a TComThreadPool
+/** The items of thread t are t, t+n, t+2n, ... for n threads. They are taken in increasing order from the front, by
+    the owner and by idle threads stealing work. The owner only steals once its queue is empty, so it always gets
+    to its own front item.
+ */
+class TComWorkQueue
+{
+private:
+  TComMutex     m_cMutex;
+  Int           m_iNext;
+  Int           m_iStep;
+  Int           m_iEnd;
+  UInt          m_uiGeneration;
+
+  TComWorkQueue( const TComWorkQueue& );
+  TComWorkQueue& operator= ( const TComWorkQueue& );
+
+public:
+  TComWorkQueue() : m_iNext( 0 ), m_iStep( 1 ), m_iEnd( 0 ), m_uiGeneration( 0 ) {}
+
+  Void    reset     ( Int iFirst, Int iStep, Int iEnd, UInt uiGeneration );
+  Int     front     ( UInt uiGeneration );   ///< next item of the job uiGeneration, -1 when there is none
+  Int     take      ( UInt uiGeneration );   ///< remove the next item of the job uiGeneration, -1 when there is none
+};
+
+/// fixed-size work-stealing pool of worker threads
+/** The calling thread takes part in the processing of each job (fork/join). The items are spread over per-thread
+    queues; a thread whose queue is empty steals the lowest item left in the other queues. The items do not start in
+    increasing order overall, but an item may still safely wait for the completion of an item with a lower index (e.g.
+    the CTU row above in wavefront processing, see TComProgressCounters): every queue owner eventually runs its own
+    front item, and until then it only runs lower items of its queue. So an item that is waited for either runs, or
+    is queued behind lower items only, and the lowest waiting item always makes progress.
+    The thread an item runs on must not change its result (the per-thread tools are interchangeable), so that the
+    output does not depend on the number of threads.
+ */
+class TComThreadPool
+{
+private:
+  Int           m_iNumThreads;
+  Void**        m_ppcThreads;
+  TComWorkQueue* m_pcQueues;              ///< items of the current job, one queue per thread
+  TComMutex     m_cMutex;
+  TComCondition m_cWakeUp;
+  TComCondition m_cDone;
+
+  // current job, guarded by m_cMutex
+  TComJob*      m_pcJob;
+  Int           m_iNumItems;
+  Int           m_iNumFinished;
+  UInt          m_uiGeneration;
+  Bool          m_bTerminate;
+
+  TComThreadPool( const TComThreadPool& );
+  TComThreadPool& operator= ( const TComThreadPool& );
+
+  Int     xTakeItem     ( Int iThreadIdx, UInt uiGeneration );
+  Void    xProcessItems ( TComJob* pcJob, Int iThreadIdx, UInt uiGeneration );
+  Void    xWorkerLoop   ( Int iThreadIdx );
+
+public:
+  TComThreadPool();
+  ~TComThreadPool();
+
+  Void    create        ( Int iNumThreads );    ///< iNumThreads includes the calling thread
+  Void    destroy       ();
+  Int     getNumThreads () const { return m_iNumThreads; }
+
+  /// run pcJob for items 0..iNumItems-1 and return when all of them are finished
+  Void    execute       ( TComJob* pcJob, Int iNumItems );
+
+  static  Void  workerEntry ( TComThreadPool* pcPool, Int iThreadIdx );
+};
+
+//! \}
+
+#endif // __TCOMTHREADPOOL__
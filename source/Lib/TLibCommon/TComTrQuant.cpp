@@ -43,6 +43,7 @@
 #include "TComPic.h"
 #include "ContextTables.h"
 #include "TComTU.h"
+#include "TComSimd.h"
 #include "Debug.h"
 
 typedef struct
@@ -993,6 +994,359 @@ void partialButterflyInverse32(TCoeff *src, TCoeff *dst, Int shift, Int line)
   }
 }
 
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+// ====================================================================================================================
+// SIMD transforms
+// ====================================================================================================================
+
+// The 1D transforms are evaluated as matrix products in 32-bit lanes. The butterflies compute the same integer sums,
+// and the 32-bit wrap-around of the vector arithmetic is that of the scalar TCoeff arithmetic, so the results match.
+
+#if RExt__INDEPENDENT_FORWARD_AND_INVERSE_TRANSFORMS
+#define TRANSFORM_MATRIX(table, direction) (&table[direction][0][0])
+#else
+#define TRANSFORM_MATRIX(table, direction) (&table[0][0])
+#endif
+
+/** get the transform matrix of a 1D transform (row k holds basis function k)
+ *  \param size      transform size
+ *  \param useDST    use the 4x4 DST instead of the DCT
+ *  \param bInverse  matrix of the inverse transform
+ */
+static const TMatrixCoeff* getTransformMatrix(Int size, Bool useDST, Bool bInverse)
+{
+#if RExt__INDEPENDENT_FORWARD_AND_INVERSE_TRANSFORMS
+  const Int direction = bInverse ? TRANSFORM_INVERSE : TRANSFORM_FORWARD;
+#endif
+  switch (size)
+  {
+    case  4: return useDST ? TRANSFORM_MATRIX(g_as_DST_MAT_4, direction) : TRANSFORM_MATRIX(g_aiT4, direction);
+    case  8: return TRANSFORM_MATRIX(g_aiT8,  direction);
+    case 16: return TRANSFORM_MATRIX(g_aiT16, direction);
+    case 32: return TRANSFORM_MATRIX(g_aiT32, direction);
+    default:
+      assert(0); exit (1); return NULL;
+  }
+}
+
+#undef TRANSFORM_MATRIX
+
+/** transpose a 4x4 block of 32-bit values held in four rows
+ */
+static inline SIMD_TARGET_SSE41 Void transpose4x4SSE41(__m128i *r)
+{
+  const __m128i t0 = _mm_unpacklo_epi32(r[0], r[1]);
+  const __m128i t1 = _mm_unpacklo_epi32(r[2], r[3]);
+  const __m128i t2 = _mm_unpackhi_epi32(r[0], r[1]);
+  const __m128i t3 = _mm_unpackhi_epi32(r[2], r[3]);
+  r[0] = _mm_unpacklo_epi64(t0, t1);
+  r[1] = _mm_unpackhi_epi64(t0, t1);
+  r[2] = _mm_unpacklo_epi64(t2, t3);
+  r[3] = _mm_unpackhi_epi64(t2, t3);
+}
+
+/** 4x4 forward DCT or DST (2D) with SSE4.1, as matrix multiplications
+ *  \param block input data (residual)
+ *  \param coeff output data (transform coefficients)
+ *  \param mat   transform matrix
+ */
+static SIMD_TARGET_SSE41 Void forwardTransform4x4SSE41(const TCoeff *block, TCoeff *coeff, const TMatrixCoeff *mat, Int shift_1st, Int shift_2nd)
+{
+  __m128i r[4], t[4];
+  for (Int j = 0; j < 4; j++)
+  {
+    r[j] = _mm_loadu_si128((const __m128i*)(block + j * 4));
+  }
+
+  for (Int pass = 0; pass < 2; pass++)
+  {
+    const Int     shift  = pass ? shift_2nd : shift_1st;
+    const __m128i vAdd   = _mm_set1_epi32((shift > 0) ? (1 << (shift - 1)) : 0);
+    const __m128i vShift = _mm_cvtsi32_si128(shift);
+
+    transpose4x4SSE41(r);
+    for (Int k = 0; k < 4; k++)
+    {
+      __m128i sum = vAdd;
+      for (Int n = 0; n < 4; n++)
+      {
+        sum = _mm_add_epi32(sum, _mm_mullo_epi32(r[n], _mm_set1_epi32(mat[k * 4 + n])));
+      }
+      t[k] = _mm_sra_epi32(sum, vShift);
+    }
+    for (Int k = 0; k < 4; k++)
+    {
+      r[k] = t[k];
+    }
+  }
+
+  for (Int k = 0; k < 4; k++)
+  {
+    _mm_storeu_si128((__m128i*)(coeff + k * 4), r[k]);
+  }
+}
+
+/** 4x4 inverse DCT or DST (2D) with SSE4.1, as matrix multiplications
+ *  \param coeff input data (transform coefficients)
+ *  \param block output data (residual)
+ *  \param mat   transform matrix
+ */
+static SIMD_TARGET_SSE41 Void inverseTransform4x4SSE41(const TCoeff *coeff, TCoeff *block, const TMatrixCoeff *mat, Int shift_1st, Int shift_2nd,
+                                                       const TCoeff minimum_1st, const TCoeff maximum_1st, const TCoeff minimum_2nd, const TCoeff maximum_2nd)
+{
+  __m128i r[4], t[4];
+  for (Int k = 0; k < 4; k++)
+  {
+    r[k] = _mm_loadu_si128((const __m128i*)(coeff + k * 4));
+  }
+
+  for (Int pass = 0; pass < 2; pass++)
+  {
+    const Int     shift  = pass ? shift_2nd : shift_1st;
+    const __m128i vAdd   = _mm_set1_epi32((shift > 0) ? (1 << (shift - 1)) : 0);
+    const __m128i vShift = _mm_cvtsi32_si128(shift);
+    const __m128i vMin   = _mm_set1_epi32(pass ? minimum_2nd : minimum_1st);
+    const __m128i vMax   = _mm_set1_epi32(pass ? maximum_2nd : maximum_1st);
+
+    for (Int n = 0; n < 4; n++)
+    {
+      __m128i sum = vAdd;
+      for (Int k = 0; k < 4; k++)
+      {
+        sum = _mm_add_epi32(sum, _mm_mullo_epi32(r[k], _mm_set1_epi32(mat[k * 4 + n])));
+      }
+      t[n] = _mm_min_epi32(_mm_max_epi32(_mm_sra_epi32(sum, vShift), vMin), vMax);
+    }
+    for (Int n = 0; n < 4; n++)
+    {
+      r[n] = t[n];
+    }
+    transpose4x4SSE41(r);
+  }
+
+  for (Int j = 0; j < 4; j++)
+  {
+    _mm_storeu_si128((__m128i*)(block + j * 4), r[j]);
+  }
+}
+
+/** transpose an 8x8 block of 32-bit values held in eight rows
+ */
+static inline SIMD_TARGET_AVX2 Void transpose8x8AVX2(__m256i *r)
+{
+  __m256i t[8], u[8];
+  for (Int i = 0; i < 8; i += 2)
+  {
+    t[i  ] = _mm256_unpacklo_epi32(r[i], r[i+1]);
+    t[i+1] = _mm256_unpackhi_epi32(r[i], r[i+1]);
+  }
+  for (Int i = 0; i < 8; i += 4)
+  {
+    u[i  ] = _mm256_unpacklo_epi64(t[i  ], t[i+2]);
+    u[i+1] = _mm256_unpackhi_epi64(t[i  ], t[i+2]);
+    u[i+2] = _mm256_unpacklo_epi64(t[i+1], t[i+3]);
+    u[i+3] = _mm256_unpackhi_epi64(t[i+1], t[i+3]);
+  }
+  for (Int i = 0; i < 4; i++)
+  {
+    r[i  ] = _mm256_permute2x128_si256(u[i], u[i+4], 0x20);
+    r[i+4] = _mm256_permute2x128_si256(u[i], u[i+4], 0x31);
+  }
+}
+
+/** forward 1D transform with AVX2, equal to partialButterfly*()
+ *  Eight lines are transformed at a time, with one line per 32-bit lane.
+ *  \param src    input data, line rows of size samples
+ *  \param dst    output data, size rows of line coefficients
+ *  \param mat    transform matrix
+ *  \param shift  specifies right shift after 1D transform
+ */
+static SIMD_TARGET_AVX2 Void forwardTransformAVX2(const TCoeff *src, TCoeff *dst, const TMatrixCoeff *mat, Int size, Int shift, Int line)
+{
+  const __m256i vAdd   = _mm256_set1_epi32((shift > 0) ? (1 << (shift - 1)) : 0);
+  const __m128i vShift = _mm_cvtsi32_si128(shift);
+  const Int     lines  = std::min(line, 8);
+
+  __m256i x[MAX_TU_SIZE], E[MAX_TU_SIZE / 2], O[MAX_TU_SIZE / 2], out[MAX_TU_SIZE];
+
+  for (Int j = 0; j < line; j += 8)
+  {
+    /* x[n] holds sample n of the eight lines */
+    if (size == 4)
+    {
+      TCoeff buf[4][8] = { { 0 } };
+      for (Int l = 0; l < lines; l++)
+      {
+        for (Int n = 0; n < 4; n++)
+        {
+          buf[n][l] = src[(j + l) * 4 + n];
+        }
+      }
+      for (Int n = 0; n < 4; n++)
+      {
+        x[n] = _mm256_loadu_si256((const __m256i*)buf[n]);
+      }
+    }
+    else
+    {
+      for (Int c = 0; c < size; c += 8)
+      {
+        for (Int l = 0; l < 8; l++)
+        {
+          x[c + l] = (l < lines) ? _mm256_loadu_si256((const __m256i*)(src + (j + l) * size + c)) : _mm256_setzero_si256();
+        }
+        transpose8x8AVX2(x + c);
+      }
+    }
+
+    /* E and O, down to two even terms, as in partialButterfly*() */
+    Int len     = size;
+    Int rowStep = 1;
+    while (len > 2)
+    {
+      const Int half = len >> 1;
+      for (Int k = 0; k < half; k++)
+      {
+        E[k] = _mm256_add_epi32(x[k], x[len - 1 - k]);
+        O[k] = _mm256_sub_epi32(x[k], x[len - 1 - k]);
+      }
+      for (Int i = 0; i < half; i++)
+      {
+        const TMatrixCoeff *row = mat + rowStep * (2 * i + 1) * size;
+        __m256i sum = _mm256_setzero_si256();
+        for (Int k = 0; k < half; k++)
+        {
+          sum = _mm256_add_epi32(sum, _mm256_mullo_epi32(O[k], _mm256_set1_epi32(row[k])));
+        }
+        out[rowStep * (2 * i + 1)] = sum;
+      }
+      for (Int k = 0; k < half; k++)
+      {
+        x[k] = E[k];
+      }
+      len      = half;
+      rowStep <<= 1;
+    }
+    for (Int i = 0; i < 2; i++)
+    {
+      const TMatrixCoeff *row = mat + rowStep * i * size;
+      out[rowStep * i] = _mm256_add_epi32(_mm256_mullo_epi32(x[0], _mm256_set1_epi32(row[0])),
+                                          _mm256_mullo_epi32(x[1], _mm256_set1_epi32(row[1])));
+    }
+
+    for (Int m = 0; m < size; m++)
+    {
+      const __m256i vVal = _mm256_sra_epi32(_mm256_add_epi32(out[m], vAdd), vShift);
+      if (lines == 8)
+      {
+        _mm256_storeu_si256((__m256i*)(dst + m * line + j), vVal);
+      }
+      else
+      {
+        _mm_storeu_si128((__m128i*)(dst + m * line + j), _mm256_castsi256_si128(vVal));
+      }
+    }
+  }
+}
+
+/** inverse 1D transform with AVX2, equal to partialButterflyInverse*()
+ *  Eight lines are transformed at a time, with one line per 32-bit lane.
+ *  \param src    input data, size rows of line coefficients
+ *  \param dst    output data, line rows of size samples
+ *  \param mat    transform matrix
+ *  \param shift  specifies right shift after 1D transform
+ */
+static SIMD_TARGET_AVX2 Void inverseTransformAVX2(const TCoeff *src, TCoeff *dst, const TMatrixCoeff *mat, Int size, Int shift, Int line, const TCoeff outputMinimum, const TCoeff outputMaximum)
+{
+  const __m256i vAdd   = _mm256_set1_epi32((shift > 0) ? (1 << (shift - 1)) : 0);
+  const __m128i vShift = _mm_cvtsi32_si128(shift);
+  const __m256i vMin   = _mm256_set1_epi32(outputMinimum);
+  const __m256i vMax   = _mm256_set1_epi32(outputMaximum);
+  const Int     lines  = std::min(line, 8);
+
+  __m256i y[MAX_TU_SIZE], E[MAX_TU_SIZE], O[MAX_TU_SIZE / 2], out[MAX_TU_SIZE];
+  Bool    nonZero[MAX_TU_SIZE];
+
+  for (Int j = 0; j < line; j += 8)
+  {
+    /* y[k] holds coefficient k of the eight lines */
+    for (Int k = 0; k < size; k++)
+    {
+      y[k] = (lines == 8) ? _mm256_loadu_si256((const __m256i*)(src + k * line + j))
+                          : _mm256_inserti128_si256(_mm256_setzero_si256(), _mm_loadu_si128((const __m128i*)(src + k * line + j)), 0);
+      nonZero[k] = !_mm256_testz_si256(y[k], y[k]); // most high frequency coefficients are zero
+    }
+
+    /* the two lowest even terms, then combine even and odd terms at each hierarchy level */
+    Int rowStep = size >> 1;
+    for (Int k = 0; k < 2; k++)
+    {
+      E[k] = _mm256_add_epi32(_mm256_mullo_epi32(y[0],       _mm256_set1_epi32(mat[k])),
+                              _mm256_mullo_epi32(y[rowStep], _mm256_set1_epi32(mat[rowStep * size + k])));
+    }
+    for (Int len = 4; len <= size; len <<= 1)
+    {
+      const Int half = len >> 1;
+      rowStep >>= 1;
+      for (Int k = 0; k < half; k++)
+      {
+        O[k] = _mm256_setzero_si256();
+      }
+      for (Int i = 0; i < half; i++)
+      {
+        const Int m = rowStep * (2 * i + 1);
+        if (nonZero[m])
+        {
+          for (Int k = 0; k < half; k++)
+          {
+            O[k] = _mm256_add_epi32(O[k], _mm256_mullo_epi32(y[m], _mm256_set1_epi32(mat[m * size + k])));
+          }
+        }
+      }
+      __m256i *next = (len == size) ? out : E;
+      for (Int k = half - 1; k >= 0; k--)
+      {
+        const __m256i vEven = E[k];
+        next[len - 1 - k] = _mm256_sub_epi32(vEven, O[k]);
+        next[k]           = _mm256_add_epi32(vEven, O[k]);
+      }
+    }
+
+    for (Int n = 0; n < size; n++)
+    {
+      out[n] = _mm256_min_epi32(_mm256_max_epi32(_mm256_sra_epi32(_mm256_add_epi32(out[n], vAdd), vShift), vMin), vMax);
+    }
+
+    if (size == 4)
+    {
+      TCoeff buf[4][8];
+      for (Int n = 0; n < 4; n++)
+      {
+        _mm256_storeu_si256((__m256i*)buf[n], out[n]);
+      }
+      for (Int l = 0; l < lines; l++)
+      {
+        for (Int n = 0; n < 4; n++)
+        {
+          dst[(j + l) * 4 + n] = buf[n][l];
+        }
+      }
+    }
+    else
+    {
+      for (Int c = 0; c < size; c += 8)
+      {
+        transpose8x8AVX2(out + c);
+        for (Int l = 0; l < lines; l++)
+        {
+          _mm256_storeu_si256((__m256i*)(dst + (j + l) * size + c), out[c + l]);
+        }
+      }
+    }
+  }
+}
+#endif
+
 /** MxN forward transform (2D)
 *  \param block input data (residual)
 *  \param coeff output data (transform coefficients)
@@ -1020,6 +1374,23 @@ void xTrMxN(Int bitDepth, TCoeff *block, TCoeff *coeff, Int iWidth, Int iHeight,
 
   TCoeff tmp[ MAX_TU_SIZE * MAX_TU_SIZE ];
 
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+  if ((iWidth == 4) && (iHeight == 4))
+  {
+    if (TComSimd::getLevel() >= SIMD_SSE41)
+    {
+      forwardTransform4x4SSE41( block, coeff, getTransformMatrix(4, useDST, false), shift_1st, shift_2nd );
+      return;
+    }
+  }
+  else if (TComSimd::getLevel() == SIMD_AVX2)
+  {
+    forwardTransformAVX2( block, tmp,   getTransformMatrix(iWidth,  false, false), iWidth,  shift_1st, iHeight );
+    forwardTransformAVX2( tmp,   coeff, getTransformMatrix(iHeight, false, false), iHeight, shift_2nd, iWidth  );
+    return;
+  }
+#endif
+
   switch (iWidth)
   {
     case 4:
@@ -1089,6 +1460,34 @@ void xITrMxN(Int bitDepth, TCoeff *coeff, TCoeff *block, Int iWidth, Int iHeight
 
   TCoeff tmp[MAX_TU_SIZE * MAX_TU_SIZE];
 
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+#if RExt__N0188_EXTENDED_PRECISION_PROCESSING
+  const TCoeff minimum_1st = clipMinimum;
+  const TCoeff maximum_1st = clipMaximum;
+  const TCoeff minimum_2nd = std::numeric_limits<Pel>::min();
+  const TCoeff maximum_2nd = std::numeric_limits<Pel>::max();
+#else
+  const TCoeff minimum_1st = TRANSFORM_MINIMUM;
+  const TCoeff maximum_1st = TRANSFORM_MAXIMUM;
+  const TCoeff minimum_2nd = TRANSFORM_MINIMUM;
+  const TCoeff maximum_2nd = TRANSFORM_MAXIMUM;
+#endif
+  if ((iWidth == 4) && (iHeight == 4))
+  {
+    if (TComSimd::getLevel() >= SIMD_SSE41)
+    {
+      inverseTransform4x4SSE41( coeff, block, getTransformMatrix(4, useDST, true), shift_1st, shift_2nd, minimum_1st, maximum_1st, minimum_2nd, maximum_2nd );
+      return;
+    }
+  }
+  else if (TComSimd::getLevel() == SIMD_AVX2)
+  {
+    inverseTransformAVX2( coeff, tmp,   getTransformMatrix(iHeight, false, true), iHeight, shift_1st, iWidth,  minimum_1st, maximum_1st );
+    inverseTransformAVX2( tmp,   block, getTransformMatrix(iWidth,  false, true), iWidth,  shift_2nd, iHeight, minimum_2nd, maximum_2nd );
+    return;
+  }
+#endif
+
   switch (iHeight)
   {
 #if RExt__N0188_EXTENDED_PRECISION_PROCESSING
@@ -1308,6 +1707,94 @@ Void TComTrQuant::signBitHidingHDQ( TCoeff* pQCoef, TCoeff* pCoef, TCoeff* delta
 }
 
 
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+// ====================================================================================================================
+// SIMD quantisation
+// ====================================================================================================================
+
+// The quantiser products |coeff| * quantCoeff need more than 32 bits; they are formed with mul_epu32 in 64-bit lanes,
+// two coefficients per vector, and the levels are packed back into 32-bit lanes. (iLevel << iQBits) is evaluated in
+// 32 bits and sign-extended, as in the scalar code, and the shifts by qBits8 and iQBitsC keep the low 32 bits of the
+// 64-bit result, which are the same for logical and arithmetic shifts at these shift amounts.
+// The quantisation and scaling list coefficients are read at the coefficient position, which requires square TUs
+// (RExt__SQUARE_TRANSFORM_CHROMA_422).
+
+/// low 32 bits of the 64-bit lanes of two vectors, in order
+static inline SIMD_TARGET_SSE41 __m128i packLow32SSE41(__m128i lo, __m128i hi)
+{
+  return _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+/** scalar quantisation of a block without RDOQ, as the loop in xQuant()
+ * \param piArlCCoef adaptive reconstruction level output, or NULL when adaptive QP selection is not used
+ * \returns sum of the absolute levels
+ */
+static SIMD_TARGET_SSE41 TCoeff quantSSE41(const TCoeff *piCoef, TCoeff *piQCoef, TCoeff *deltaU, TCoeff *piArlCCoef, const Int *piQuantCoeff, Int numSamples,
+                                           Int iQBits, Int iAdd, Int iQBitsC, Int iAddC, const TCoeff minimum, const TCoeff maximum)
+{
+  const __m128i vAdd     = _mm_set1_epi64x(iAdd);
+  const __m128i vAddC    = _mm_set1_epi64x(piArlCCoef != NULL ? iAddC : 0);
+  const __m128i vQBits   = _mm_cvtsi32_si128(iQBits);
+  const __m128i vQBits8  = _mm_cvtsi32_si128(iQBits - 8);
+  const __m128i vQBitsC  = _mm_cvtsi32_si128(piArlCCoef != NULL ? iQBitsC : 0);
+  const __m128i vMinimum = _mm_set1_epi32(minimum);
+  const __m128i vMaximum = _mm_set1_epi32(maximum);
+  __m128i       vAcSum   = _mm_setzero_si128();
+
+  for (Int n = 0; n < numSamples; n += 4)
+  {
+    const __m128i coef  = _mm_loadu_si128((const __m128i*)(piCoef + n));
+    const __m128i absC  = _mm_abs_epi32(coef);
+    const __m128i scale = _mm_loadu_si128((const __m128i*)(piQuantCoeff + n));
+
+    const __m128i tmpLo = _mm_mul_epu32(_mm_cvtepu32_epi64(absC), _mm_cvtepu32_epi64(scale));
+    const __m128i tmpHi = _mm_mul_epu32(_mm_cvtepu32_epi64(_mm_unpackhi_epi64(absC, absC)), _mm_cvtepu32_epi64(_mm_unpackhi_epi64(scale, scale)));
+
+    if (piArlCCoef != NULL)
+    {
+      _mm_storeu_si128((__m128i*)(piArlCCoef + n), packLow32SSE41(_mm_srl_epi64(_mm_add_epi64(tmpLo, vAddC), vQBitsC),
+                                                                  _mm_srl_epi64(_mm_add_epi64(tmpHi, vAddC), vQBitsC)));
+    }
+
+    const __m128i level   = packLow32SSE41(_mm_srl_epi64(_mm_add_epi64(tmpLo, vAdd), vQBits), _mm_srl_epi64(_mm_add_epi64(tmpHi, vAdd), vQBits));
+    const __m128i rounded = _mm_sll_epi32(level, vQBits);
+    const __m128i deltaLo = _mm_srl_epi64(_mm_sub_epi64(tmpLo, _mm_cvtepi32_epi64(rounded)), vQBits8);
+    const __m128i deltaHi = _mm_srl_epi64(_mm_sub_epi64(tmpHi, _mm_cvtepi32_epi64(_mm_unpackhi_epi64(rounded, rounded))), vQBits8);
+    _mm_storeu_si128((__m128i*)(deltaU + n), packLow32SSE41(deltaLo, deltaHi));
+
+    vAcSum = _mm_add_epi32(vAcSum, level);
+    _mm_storeu_si128((__m128i*)(piQCoef + n), _mm_min_epi32(_mm_max_epi32(_mm_sign_epi32(level, coef), vMinimum), vMaximum));
+  }
+
+  vAcSum = _mm_add_epi32(vAcSum, _mm_unpackhi_epi64(vAcSum, vAcSum));
+  vAcSum = _mm_add_epi32(vAcSum, _mm_shuffle_epi32(vAcSum, 0x55));
+  return _mm_cvtsi128_si32(vAcSum);
+}
+
+/** dequantisation of a block, as the loops in xDeQuant()
+ * \param piDequantCoef scaling list dequantisation coefficients, or NULL to use the flat scale
+ */
+static SIMD_TARGET_SSE41 Void deQuantSSE41(const TCoeff *piQCoef, TCoeff *piCoef, const Int *piDequantCoef, Int scale, Int numSamples, Int rightShift,
+                                           const TCoeff inputMinimum, const TCoeff inputMaximum, const TCoeff outputMinimum, const TCoeff outputMaximum)
+{
+  const __m128i vInMin  = _mm_set1_epi32(inputMinimum);
+  const __m128i vInMax  = _mm_set1_epi32(inputMaximum);
+  const __m128i vOutMin = _mm_set1_epi32(outputMinimum);
+  const __m128i vOutMax = _mm_set1_epi32(outputMaximum);
+  const __m128i vScale  = _mm_set1_epi32(scale);
+  const __m128i vAdd    = _mm_set1_epi32(rightShift > 0 ? (1 << (rightShift - 1)) : 0);
+  const __m128i vShift  = _mm_cvtsi32_si128(rightShift > 0 ? rightShift : -rightShift);
+
+  for (Int n = 0; n < numSamples; n += 4)
+  {
+    const __m128i clipQCoef = _mm_min_epi32(_mm_max_epi32(_mm_loadu_si128((const __m128i*)(piQCoef + n)), vInMin), vInMax);
+    const __m128i product   = _mm_mullo_epi32(clipQCoef, piDequantCoef != NULL ? _mm_loadu_si128((const __m128i*)(piDequantCoef + n)) : vScale);
+    const __m128i coeffQ    = rightShift > 0 ? _mm_sra_epi32(_mm_add_epi32(product, vAdd), vShift) : _mm_sll_epi32(product, vShift);
+    _mm_storeu_si128((__m128i*)(piCoef + n), _mm_min_epi32(_mm_max_epi32(coeffQ, vOutMin), vOutMax));
+  }
+}
+#endif
+
 Void TComTrQuant::xQuant(       TComTU       &rTu,
                                 TCoeff      * pSrc,
                                 TCoeff      * pDes,
@@ -1404,6 +1891,24 @@ Void TComTrQuant::xQuant(       TComTU       &rTu,
 
     Int qBits8 = iQBits-8;
 
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT && RExt__SQUARE_TRANSFORM_CHROMA_422
+    if (TComSimd::getLevel() != SIMD_SCALAR)
+    {
+#if ADAPTIVE_QP_SELECTION
+      TCoeff *piArlOut = m_bUseAdaptQpSelect ? piArlCCoef : NULL;
+#else
+      TCoeff *piArlOut = NULL;
+      const Int iQBitsC = 0;
+      const Int iAddC   = 0;
+#endif
+#if RExt__N0188_EXTENDED_PRECISION_PROCESSING
+      uiAcSum += quantSSE41( piCoef, piQCoef, deltaU, piArlOut, piQuantCoeff, uiWidth*uiHeight, iQBits, iAdd, iQBitsC, iAddC, entropyCodingMinimum, entropyCodingMaximum );
+#else
+      uiAcSum += quantSSE41( piCoef, piQCoef, deltaU, piArlOut, piQuantCoeff, uiWidth*uiHeight, iQBits, iAdd, iQBitsC, iAddC, TRANSFORM_MINIMUM, TRANSFORM_MAXIMUM );
+#endif
+    }
+    else
+#endif
     for( Int uiBlockPos = 0; uiBlockPos < uiWidth*uiHeight; uiBlockPos++ )
     {
       TCoeff iLevel;
@@ -1520,6 +2025,16 @@ Void TComTrQuant::xDeQuant(       TComTU        &rTu,
   TCoeff clipQCoef;
   Intermediate_Int iCoeffQ;
 
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+#if RExt__N0188_EXTENDED_PRECISION_PROCESSING
+  const TCoeff outputMinimum = transformMinimum;
+  const TCoeff outputMaximum = transformMaximum;
+#else
+  const TCoeff outputMinimum = TRANSFORM_MINIMUM;
+  const TCoeff outputMaximum = TRANSFORM_MAXIMUM;
+#endif
+#endif
+
   if(getUseScalingList())
   {
     //from the dequantisation equation:
@@ -1536,6 +2051,13 @@ Void TComTrQuant::xDeQuant(       TComTU        &rTu,
 
     Int *piDequantCoef = getDequantCoeff(scalingListType,QP_rem,uiLog2TrSize-2);
 
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT && RExt__SQUARE_TRANSFORM_CHROMA_422
+    if (TComSimd::getLevel() != SIMD_SCALAR)
+    {
+      deQuantSSE41( piQCoef, piCoef, piDequantCoef, 0, numSamplesInBlock, rightShift, inputMinimum, inputMaximum, outputMinimum, outputMaximum );
+    }
+    else
+#endif
     if(rightShift > 0)
     {
       const Intermediate_Int iAdd = 1 << (rightShift - 1);
@@ -1595,6 +2117,13 @@ Void TComTrQuant::xDeQuant(       TComTU        &rTu,
     const Intermediate_Int inputMinimum        = -(1 << (targetInputBitDepth - 1));
     const Intermediate_Int inputMaximum        =  (1 << (targetInputBitDepth - 1)) - 1;
 
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+    if (TComSimd::getLevel() != SIMD_SCALAR)
+    {
+      deQuantSSE41( piQCoef, piCoef, NULL, scale, numSamplesInBlock, rightShift, inputMinimum, inputMaximum, outputMinimum, outputMaximum );
+    }
+    else
+#endif
     if (rightShift > 0)
     {
       const Intermediate_Int iAdd = 1 << (rightShift - 1);
@@ -3503,6 +4032,45 @@ Void TComTrQuant::destroyScalingList()
   }
 }
 
+/** copy the slice-level settings (lambdas, RDOQ offset and quantization matrices) from another instance
+ * \param pcSrc instance that has been set up for the current slice
+ */
+Void TComTrQuant::copySliceSettings( const TComTrQuant* pcSrc )
+{
+#if RDOQ_CHROMA_LAMBDA
+#if RExt__BACKWARDS_COMPATIBILITY_HM_TICKET_990
+  m_dLambdaLuma   = pcSrc->m_dLambdaLuma;
+  m_dLambdaChroma = pcSrc->m_dLambdaChroma;
+#else
+  for(UInt i=0; i<MAX_NUM_COMPONENT; i++)
+  {
+    m_dLambdas[i] = pcSrc->m_dLambdas[i];
+  }
+#endif
+#endif
+  m_dLambda                = pcSrc->m_dLambda;
+  m_uiRDOQOffset           = pcSrc->m_uiRDOQOffset;
+  m_scalingListEnabledFlag = pcSrc->m_scalingListEnabledFlag;
+
+  for(UInt sizeId = 0; sizeId < SCALING_LIST_SIZE_NUM; sizeId++)
+  {
+    const UInt size = g_scalingListSize[sizeId];
+#if RExt__N0192_DERIVED_CHROMA_32x32_SCALING_LISTS
+    for(UInt listId = 0; listId < SCALING_LIST_NUM; listId++)
+#else
+    for(UInt listId = 0; listId < g_scalingListNum[sizeId]; listId++)
+#endif
+    {
+      for(UInt qp = 0; qp < SCALING_LIST_REM_NUM; qp++)
+      {
+        memcpy( m_quantCoef  [sizeId][listId][qp], pcSrc->m_quantCoef  [sizeId][listId][qp], sizeof(Int)    * size );
+        memcpy( m_dequantCoef[sizeId][listId][qp], pcSrc->m_dequantCoef[sizeId][listId][qp], sizeof(Int)    * size );
+        memcpy( m_errScale   [sizeId][listId][qp], pcSrc->m_errScale   [sizeId][listId][qp], sizeof(Double) * size );
+      }
+    }
+  }
+}
+
 #if RExt__NRCE2_RESIDUAL_DPCM
 Void TComTrQuant::transformSkipQuantOneSample(TComTU &rTu, ComponentID compID, Int resiDiff, TCoeff* pcCoeff, UInt uiPos, const QpParam &cQP )
 {
@@ -171,6 +171,7 @@ public:
   Void setLambda(Double dLambda) { m_dLambda = dLambda;}
 #endif
   Void setRDOQOffset( UInt uiRDOQOffset ) { m_uiRDOQOffset = uiRDOQOffset; }
+  Void copySliceSettings( const TComTrQuant* pcSrc );
 
   estBitsSbacStruct* m_pcEstBitsSbac;
 
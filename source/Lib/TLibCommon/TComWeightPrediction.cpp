@@ -39,6 +39,7 @@
 #include "TComSlice.h"
 #include "TComWeightPrediction.h"
 #include "TComInterpolationFilter.h"
+#include "TComSimd.h"
 
 static inline Pel weightBidir( Int w0, Pel P0, Int w1, Pel P1, Int round, Int shift, Int offset, Int clipBD)
 {
@@ -50,6 +51,96 @@ static inline Pel weightUnidir( Int w0, Pel P0, Int round, Int shift, Int offset
   return ClipBD( ( (w0*(P0 + IF_INTERNAL_OFFS) + round) >> shift ) + offset, clipBD );
 }
 
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+// ====================================================================================================================
+// SIMD functions
+// ====================================================================================================================
+
+// The weighted sums are formed with madd in 32-bit lanes; w*(P + IF_INTERNAL_OFFS) is split into w*P and the constant
+// w*IF_INTERNAL_OFFS, so that the 16-bit inputs are used as they are. Eight samples are processed per step, followed by
+// a step of four and a scalar tail.
+
+/** weights must fit the signed 16-bit operands of madd
+ */
+static inline Bool xFitsWeightedSIMD( Int w0, Int w1, Int shift )
+{
+  return w0 >= -32768 && w0 <= 32767 && w1 >= -32768 && w1 <= 32767 && shift > 0;
+}
+
+/** bi-directional weighted prediction of a block, as weightBidir()
+ */
+static SIMD_TARGET_SSE41 Void xWeightBidirSSE41( const Pel* pSrc0, Int iSrc0Stride, const Pel* pSrc1, Int iSrc1Stride, Pel* pDst, Int iDstStride,
+                                                 Int iWidth, Int iHeight, Int w0, Int w1, Int round, Int shift, Int offset, Int clipBD )
+{
+  const __m128i weights = _mm_set1_epi32( (w1 << 16) | (w0 & 0xffff) );
+  const __m128i vAdd    = _mm_set1_epi32( (w0 + w1) * IF_INTERNAL_OFFS + round + (offset << (shift-1)) );
+  const __m128i vShift  = _mm_cvtsi32_si128( shift );
+  const __m128i zero    = _mm_setzero_si128();
+  const __m128i vMax    = _mm_set1_epi16( (1 << clipBD) - 1 );
+
+  for (Int y = 0; y < iHeight; y++, pSrc0 += iSrc0Stride, pSrc1 += iSrc1Stride, pDst += iDstStride)
+  {
+    Int x = 0;
+    for (; x + 8 <= iWidth; x += 8)
+    {
+      const __m128i a  = _mm_loadu_si128( (const __m128i*)(pSrc0 + x) );
+      const __m128i b  = _mm_loadu_si128( (const __m128i*)(pSrc1 + x) );
+      const __m128i lo = _mm_sra_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( a, b ), weights ), vAdd ), vShift );
+      const __m128i hi = _mm_sra_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( a, b ), weights ), vAdd ), vShift );
+      _mm_storeu_si128( (__m128i*)(pDst + x), _mm_min_epi16( _mm_max_epi16( _mm_packs_epi32( lo, hi ), zero ), vMax ) );
+    }
+    if (x + 4 <= iWidth)
+    {
+      const __m128i a  = _mm_loadl_epi64( (const __m128i*)(pSrc0 + x) );
+      const __m128i b  = _mm_loadl_epi64( (const __m128i*)(pSrc1 + x) );
+      const __m128i lo = _mm_sra_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( a, b ), weights ), vAdd ), vShift );
+      _mm_storel_epi64( (__m128i*)(pDst + x), _mm_min_epi16( _mm_max_epi16( _mm_packs_epi32( lo, lo ), zero ), vMax ) );
+      x += 4;
+    }
+    for (; x < iWidth; x++)
+    {
+      pDst[x] = weightBidir( w0, pSrc0[x], w1, pSrc1[x], round, shift, offset, clipBD );
+    }
+  }
+}
+
+/** uni-directional weighted prediction of a block, as weightUnidir()
+ */
+static SIMD_TARGET_SSE41 Void xWeightUnidirSSE41( const Pel* pSrc0, Int iSrc0Stride, Pel* pDst, Int iDstStride,
+                                                  Int iWidth, Int iHeight, Int w0, Int round, Int shift, Int offset, Int clipBD )
+{
+  const __m128i weights = _mm_set1_epi32( w0 & 0xffff );
+  const __m128i vAdd    = _mm_set1_epi32( w0 * IF_INTERNAL_OFFS + round );
+  const __m128i vOffset = _mm_set1_epi32( offset );
+  const __m128i vShift  = _mm_cvtsi32_si128( shift );
+  const __m128i zero    = _mm_setzero_si128();
+  const __m128i vMax    = _mm_set1_epi16( (1 << clipBD) - 1 );
+
+  for (Int y = 0; y < iHeight; y++, pSrc0 += iSrc0Stride, pDst += iDstStride)
+  {
+    Int x = 0;
+    for (; x + 8 <= iWidth; x += 8)
+    {
+      const __m128i a  = _mm_loadu_si128( (const __m128i*)(pSrc0 + x) );
+      const __m128i lo = _mm_add_epi32( _mm_sra_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( a, zero ), weights ), vAdd ), vShift ), vOffset );
+      const __m128i hi = _mm_add_epi32( _mm_sra_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( a, zero ), weights ), vAdd ), vShift ), vOffset );
+      _mm_storeu_si128( (__m128i*)(pDst + x), _mm_min_epi16( _mm_max_epi16( _mm_packs_epi32( lo, hi ), zero ), vMax ) );
+    }
+    if (x + 4 <= iWidth)
+    {
+      const __m128i a  = _mm_loadl_epi64( (const __m128i*)(pSrc0 + x) );
+      const __m128i lo = _mm_add_epi32( _mm_sra_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( a, zero ), weights ), vAdd ), vShift ), vOffset );
+      _mm_storel_epi64( (__m128i*)(pDst + x), _mm_min_epi16( _mm_max_epi16( _mm_packs_epi32( lo, lo ), zero ), vMax ) );
+      x += 4;
+    }
+    for (; x < iWidth; x++)
+    {
+      pDst[x] = weightUnidir( w0, pSrc0[x], round, shift, offset, clipBD );
+    }
+  }
+}
+#endif
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -105,6 +196,15 @@ Void TComWeightPrediction::addWeightBi( const TComYuv* pcYuvSrc0, const TComYuv*
     const UInt  iSrc0Stride = pcYuvSrc0->getStride(compID);
     const UInt  iSrc1Stride = pcYuvSrc1->getStride(compID);
     const UInt  iDstStride  = rpcYuvDst->getStride(compID);
+
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+    if (TComSimd::getLevel() != SIMD_SCALAR && xFitsWeightedSIMD( w0, w1, shift ))
+    {
+      xWeightBidirSSE41( pSrc0, iSrc0Stride, pSrc1, iSrc1Stride, pDst, iDstStride, iWidth, iHeight, w0, w1, round, shift, offset, clipBD );
+      continue;
+    }
+#endif
+
     for ( Int y = iHeight-1; y >= 0; y-- )
     {
       // do it in batches of 4 (partial unroll)
@@ -164,6 +264,14 @@ Void TComWeightPrediction::addWeightUni( const TComYuv* pcYuvSrc0, const UInt iP
     const UInt csy         = pcYuvSrc0->getComponentScaleY(compID);
     const Int  iHeight     = uiHeight>>csx;
     const Int  iWidth      = uiWidth>>csy;
+
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+    if (TComSimd::getLevel() != SIMD_SCALAR && xFitsWeightedSIMD( w0, 0, shift ))
+    {
+      xWeightUnidirSSE41( pSrc0, iSrc0Stride, pDst, iDstStride, iWidth, iHeight, w0, round, shift, offset, clipBD );
+      continue;
+    }
+#endif
   
     for (Int y = iHeight-1; y >= 0; y-- )
     {
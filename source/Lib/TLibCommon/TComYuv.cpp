@@ -44,10 +44,132 @@
 #include "CommonDef.h"
 #include "TComYuv.h"
 #include "TComInterpolationFilter.h"
+#include "TComSimd.h"
 
 //! \ingroup TLibCommon
 //! \{
 
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+// ====================================================================================================================
+// SIMD functions
+// ====================================================================================================================
+
+// Block widths are multiples of 2: eight samples are processed per step, followed by a step of four and a scalar tail.
+
+/** pDst = Clip(pSrc0 + pSrc1); the saturating add does not change the clipped result
+ */
+static SIMD_TARGET_SSE41 Void xAddClipSSE41( const Pel* pSrc0, Int iSrc0Stride, const Pel* pSrc1, Int iSrc1Stride, Pel* pDst, Int iDstStride,
+                                             Int iWidth, Int iHeight, Int maxVal )
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i vMax = _mm_set1_epi16( maxVal );
+  for (Int y = 0; y < iHeight; y++, pSrc0 += iSrc0Stride, pSrc1 += iSrc1Stride, pDst += iDstStride)
+  {
+    Int x = 0;
+    for (; x + 8 <= iWidth; x += 8)
+    {
+      const __m128i sum = _mm_adds_epi16( _mm_loadu_si128( (const __m128i*)(pSrc0 + x) ), _mm_loadu_si128( (const __m128i*)(pSrc1 + x) ) );
+      _mm_storeu_si128( (__m128i*)(pDst + x), _mm_min_epi16( _mm_max_epi16( sum, zero ), vMax ) );
+    }
+    if (x + 4 <= iWidth)
+    {
+      const __m128i sum = _mm_adds_epi16( _mm_loadl_epi64( (const __m128i*)(pSrc0 + x) ), _mm_loadl_epi64( (const __m128i*)(pSrc1 + x) ) );
+      _mm_storel_epi64( (__m128i*)(pDst + x), _mm_min_epi16( _mm_max_epi16( sum, zero ), vMax ) );
+      x += 4;
+    }
+    for (; x < iWidth; x++)
+    {
+      pDst[x] = Pel(Clip3( 0, maxVal, Int(pSrc0[x]) + Int(pSrc1[x]) ));
+    }
+  }
+}
+
+/** pDst = pSrc0 - pSrc1
+ */
+static SIMD_TARGET_SSE41 Void xSubtractSSE41( const Pel* pSrc0, Int iSrc0Stride, const Pel* pSrc1, Int iSrc1Stride, Pel* pDst, Int iDstStride,
+                                              Int iWidth, Int iHeight )
+{
+  for (Int y = 0; y < iHeight; y++, pSrc0 += iSrc0Stride, pSrc1 += iSrc1Stride, pDst += iDstStride)
+  {
+    Int x = 0;
+    for (; x + 8 <= iWidth; x += 8)
+    {
+      _mm_storeu_si128( (__m128i*)(pDst + x), _mm_sub_epi16( _mm_loadu_si128( (const __m128i*)(pSrc0 + x) ), _mm_loadu_si128( (const __m128i*)(pSrc1 + x) ) ) );
+    }
+    if (x + 4 <= iWidth)
+    {
+      _mm_storel_epi64( (__m128i*)(pDst + x), _mm_sub_epi16( _mm_loadl_epi64( (const __m128i*)(pSrc0 + x) ), _mm_loadl_epi64( (const __m128i*)(pSrc1 + x) ) ) );
+      x += 4;
+    }
+    for (; x < iWidth; x++)
+    {
+      pDst[x] = pSrc0[x] - pSrc1[x];
+    }
+  }
+}
+
+/** pDst = Clip((pSrc0 + pSrc1 + offset) >> shiftNum), summed in 32-bit lanes; shiftNum must be positive
+ */
+static SIMD_TARGET_SSE41 Void xAddAvgSSE41( const Pel* pSrc0, Int iSrc0Stride, const Pel* pSrc1, Int iSrc1Stride, Pel* pDst, Int iDstStride,
+                                            Int iWidth, Int iHeight, Int offset, Int shiftNum, Int maxVal )
+{
+  const __m128i one     = _mm_set1_epi16( 1 );
+  const __m128i vOffset = _mm_set1_epi32( offset );
+  const __m128i vShift  = _mm_cvtsi32_si128( shiftNum );
+  const __m128i zero    = _mm_setzero_si128();
+  const __m128i vMax    = _mm_set1_epi16( maxVal );
+  for (Int y = 0; y < iHeight; y++, pSrc0 += iSrc0Stride, pSrc1 += iSrc1Stride, pDst += iDstStride)
+  {
+    Int x = 0;
+    for (; x + 8 <= iWidth; x += 8)
+    {
+      const __m128i a  = _mm_loadu_si128( (const __m128i*)(pSrc0 + x) );
+      const __m128i b  = _mm_loadu_si128( (const __m128i*)(pSrc1 + x) );
+      const __m128i lo = _mm_sra_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( a, b ), one ), vOffset ), vShift );
+      const __m128i hi = _mm_sra_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( a, b ), one ), vOffset ), vShift );
+      _mm_storeu_si128( (__m128i*)(pDst + x), _mm_min_epi16( _mm_max_epi16( _mm_packs_epi32( lo, hi ), zero ), vMax ) );
+    }
+    if (x + 4 <= iWidth)
+    {
+      const __m128i a  = _mm_loadl_epi64( (const __m128i*)(pSrc0 + x) );
+      const __m128i b  = _mm_loadl_epi64( (const __m128i*)(pSrc1 + x) );
+      const __m128i lo = _mm_sra_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( a, b ), one ), vOffset ), vShift );
+      _mm_storel_epi64( (__m128i*)(pDst + x), _mm_min_epi16( _mm_max_epi16( _mm_packs_epi32( lo, lo ), zero ), vMax ) );
+      x += 4;
+    }
+    for (; x < iWidth; x++)
+    {
+      pDst[x] = Pel(Clip3( 0, maxVal, (pSrc0[x] + pSrc1[x] + offset) >> shiftNum ));
+    }
+  }
+}
+
+/** pDst = (pDst << 1) - pSrc
+ */
+static SIMD_TARGET_SSE41 Void xRemoveHighFreqSSE41( const Pel* pSrc, Int iSrcStride, Pel* pDst, Int iDstStride, Int iWidth, Int iHeight )
+{
+  for (Int y = 0; y < iHeight; y++, pSrc += iSrcStride, pDst += iDstStride)
+  {
+    Int x = 0;
+    for (; x + 8 <= iWidth; x += 8)
+    {
+      const __m128i d = _mm_loadu_si128( (const __m128i*)(pDst + x) );
+      _mm_storeu_si128( (__m128i*)(pDst + x), _mm_sub_epi16( _mm_slli_epi16( d, 1 ), _mm_loadu_si128( (const __m128i*)(pSrc + x) ) ) );
+    }
+    if (x + 4 <= iWidth)
+    {
+      const __m128i d = _mm_loadl_epi64( (const __m128i*)(pDst + x) );
+      _mm_storel_epi64( (__m128i*)(pDst + x), _mm_sub_epi16( _mm_slli_epi16( d, 1 ), _mm_loadl_epi64( (const __m128i*)(pSrc + x) ) ) );
+      x += 4;
+    }
+    for (; x < iWidth; x++)
+    {
+      pDst[x] = (pDst[x]<<1) - pSrc[x];
+    }
+  }
+}
+#endif
+
 TComYuv::TComYuv()
 {
   for(Int comp=0; comp<MAX_NUM_COMPONENT; comp++)
@@ -278,6 +400,14 @@ Void TComYuv::addClip( const TComYuv* pcYuvSrc0, const TComYuv* pcYuvSrc1, const
     const UInt iDstStride  = getStride(ch);
     const Int clipbd = g_bitDepth[toChannelType(ch)];
 
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+    if (TComSimd::getLevel() != SIMD_SCALAR)
+    {
+      xAddClipSSE41( pSrc0, iSrc0Stride, pSrc1, iSrc1Stride, pDst, iDstStride, uiPartWidth, uiPartHeight, (1 << clipbd) - 1 );
+      continue;
+    }
+#endif
+
     for ( Int y = uiPartHeight-1; y >= 0; y-- )
     {
       for ( Int x = uiPartWidth-1; x >= 0; x-- )
@@ -310,6 +440,14 @@ Void TComYuv::subtract( const TComYuv* pcYuvSrc0, const TComYuv* pcYuvSrc1, cons
     const Int  iSrc1Stride = pcYuvSrc1->getStride(ch);
     const Int  iDstStride  = getStride(ch);
 
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+    if (TComSimd::getLevel() != SIMD_SCALAR)
+    {
+      xSubtractSSE41( pSrc0, iSrc0Stride, pSrc1, iSrc1Stride, pDst, iDstStride, uiPartWidth, uiPartHeight );
+      continue;
+    }
+#endif
+
     for (Int y = uiPartHeight-1; y >= 0; y-- )
     {
       for (Int x = uiPartWidth-1; x >= 0; x-- )
@@ -355,6 +493,12 @@ Void TComYuv::addAvg( const TComYuv* pcYuvSrc0, const TComYuv* pcYuvSrc1, const
       assert(0);
       exit(-1);
     }
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+    else if (TComSimd::getLevel() != SIMD_SCALAR && shiftNum > 0)
+    {
+      xAddAvgSSE41( pSrc0, iSrc0Stride, pSrc1, iSrc1Stride, pDst, iDstStride, iWidth, iHeight, offset, shiftNum, (1 << clipbd) - 1 );
+    }
+#endif
     else if (iWidth&2)
     {
       for ( Int y = 0; y < iHeight; y++ )
@@ -401,6 +545,14 @@ Void TComYuv::removeHighFreq( const TComYuv* pcYuvSrc, const UInt uiPartIdx, con
     const Int iDstStride = getStride(ch);
     const Int iWidth  = uiWidth >>getComponentScaleX(ch);
     const Int iHeight = uiHeight>>getComponentScaleY(ch);
+
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT && DISABLING_CLIP_FOR_BIPREDME
+    if (TComSimd::getLevel() != SIMD_SCALAR)
+    {
+      xRemoveHighFreqSSE41( pSrc, iSrcStride, pDst, iDstStride, iWidth, iHeight );
+      continue;
+    }
+#endif
   
     for ( Int y = iHeight-1; y >= 0; y-- )
     {
@@ -108,6 +108,8 @@
 #define RC_FIX                                      1  /// suggested fix for M0036
 #define RATE_CONTROL_INTRA                          1  ///< JCTVC-M0257, rate control for intra 
 
+#define SIMD_KERNELS                                1  ///< x86 SSE4.1/AVX2 versions of the sample processing kernels, selected at run time (0: C++ kernels only)
+
 #define MAXIMUM_INTRA_FILTERED_WIDTH                     16
 #define MAXIMUM_INTRA_FILTERED_HEIGHT                    16
 
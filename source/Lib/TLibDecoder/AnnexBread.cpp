@@ -39,6 +39,7 @@
 
 #include <stdint.h>
 #include <cassert>
+#include <string.h>
 #include <vector>
 #include "AnnexBread.h"
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
@@ -50,6 +51,81 @@ using namespace std;
 //! \ingroup TLibDecoder
 //! \{
 
+/**
+ * Move the unread bytes to the start of the buffer and fill the rest
+ * of the buffer from the input.
+ */
+void
+InputByteStream::xFill()
+{
+  if (m_BufferPos > 0)
+  {
+    memmove(&m_Buffer[0], &m_Buffer[0] + m_BufferPos, m_BufferEnd - m_BufferPos);
+    m_BufferOffset += m_BufferPos;
+    m_BufferEnd -= m_BufferPos;
+    m_BufferPos = 0;
+  }
+  if (m_BufferEnd < BUFFER_SIZE)
+  {
+    m_Input.read(reinterpret_cast<char*>(&m_Buffer[0] + m_BufferEnd), BUFFER_SIZE - m_BufferEnd);
+    m_BufferEnd += UInt(m_Input.gcount());
+  }
+}
+
+void
+InputByteStream::setPosition(std::streamoff pos)
+{
+  if (pos >= m_BufferOffset && pos <= m_BufferOffset + m_BufferEnd)
+  {
+    m_BufferPos = UInt(pos - m_BufferOffset);
+  }
+  else
+  {
+    m_Input.clear();
+    m_Input.seekg(pos);
+    m_BufferOffset = pos;
+    m_BufferPos = 0;
+    m_BufferEnd = 0;
+  }
+  m_Eof = false;
+}
+
+/**
+ * Find the first byte-aligned three-byte sequence 0x000000, 0x000001
+ * or 0x000002 in [start, end), that ends a NAL unit.  Zero bytes are
+ * located with memchr and only they are tested further.
+ *
+ * Returns the location of the sequence, or end-2 if there is none:
+ * the last two bytes can not be tested without further input.
+ */
+static const uint8_t*
+findNALUnitEnd(const uint8_t* start, const uint8_t* end)
+{
+  const uint8_t* last = end - 2;
+  const uint8_t* p = start;
+  while (p < last)
+  {
+    p = static_cast<const uint8_t*>(memchr(p, 0, last - p));
+    if (p == NULL)
+    {
+      return last;
+    }
+    if (p[1] != 0)
+    {
+      p += 2;
+    }
+    else if (p[2] <= 2)
+    {
+      return p;
+    }
+    else
+    {
+      p += 3;
+    }
+  }
+  return last;
+}
+
 /**
  * Parse an AVC AnnexB Bytestream bs to extract a single nalUnit
  * while accumulating bytestream statistics into stats.
@@ -130,18 +206,39 @@ _byteStreamNALUnit(
    * bytes. This sequence of bytes is nal_unit( NumBytesInNALunit ) and is
    * decoded using the NAL unit decoding process
    */
-  /* NB, (unsigned)x > 2 implies n!=0 && n!=1 */
+  /* NB, the payload is copied to nalUnit in blocks: the scan stops at
+   * the first three-byte sequence <= 0x000002, or reads the remaining
+   * bytes if there are fewer than three (step c) */
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   TComCodingStatistics::SStat &bodyStats=TComCodingStatistics::GetStatisticEP(STATS__NAL_UNIT_TOTAL_BODY);
 #endif
-  while (bs.eofBeforeNBytes(24/8) || bs.peekBytes(24/8) > 2) 
+  while (true)
   {
+    const UInt num_available = bs.prefetch(24/8);
+    if (num_available < 24/8)
+    {
+      while (true)
+      {
+        /* throws at the end of the byte stream */
+        nalUnit.push_back(bs.readByte());
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+        bodyStats.bits+=8; bodyStats.count++;
+#endif
+      }
+    }
+
+    const uint8_t* bytes = bs.getBufferedBytes();
+    const uint8_t* nal_unit_end = findNALUnitEnd(bytes, bytes + num_available);
+    const UInt num_bytes = UInt(nal_unit_end - bytes);
+    nalUnit.insert(nalUnit.end(), bytes, nal_unit_end);
+    bs.skipBytes(num_bytes);
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-    uint8_t thebyte=bs.readByte();bodyStats.bits+=8;bodyStats.count++;
-    nalUnit.push_back(thebyte);
-#else
-    nalUnit.push_back(bs.readByte());
+    bodyStats.bits+=8*num_bytes; bodyStats.count+=num_bytes;
 #endif
+    if (num_bytes + 2 < num_available)
+    {
+      break;
+    }
   }
   
   /* 5. When the current position in the byte stream is:
@@ -42,6 +42,8 @@
 #define __ANNEXBREAD__
 
 #include <stdint.h>
+#include <assert.h>
+#include <algorithm>
 #include <istream>
 #include <vector>
 
@@ -55,19 +57,22 @@ class InputByteStream
 public:
   /**
    * Create a bytestream reader that will extract bytes from
-   * istream.
+   * istream.  The bytes are read from istream in large blocks and
+   * buffered.
    *
    * NB, it isn't safe to access istream while in use by a
    * InputByteStream.
-   *
-   * Side-effects: the exception mask of istream is set to eofbit
    */
   InputByteStream(std::istream& istream)
-  : m_NumFutureBytes(0)
-  , m_FutureBytes(0)
+  : m_Buffer(BUFFER_SIZE)
+  , m_BufferPos(0)
+  , m_BufferEnd(0)
+  , m_BufferOffset(0)
+  , m_Eof(false)
   , m_Input(istream)
   {
-    istream.exceptions(std::istream::eofbit);
+    std::streamoff offset = istream.tellg();
+    m_BufferOffset = offset > 0 ? offset : 0;
   }
 
   /**
@@ -76,8 +81,56 @@ public:
    */
   void reset()
   {
-    m_NumFutureBytes = 0;
-    m_FutureBytes = 0;
+    std::streamoff offset = m_Input.tellg();
+    m_BufferPos = 0;
+    m_BufferEnd = 0;
+    m_BufferOffset = offset > 0 ? offset : 0;
+    m_Eof = false;
+  }
+
+  /**
+   * returns the location in the input of the next byte to be read.
+   */
+  std::streamoff getPosition() const { return m_BufferOffset + m_BufferPos; }
+
+  /**
+   * move to location pos in the input, within the buffer if it still
+   * holds the location, and clear the end of file state.
+   */
+  void setPosition(std::streamoff pos);
+
+  /**
+   * returns true if an attempt was made to read past the end of the
+   * input (since the last setPosition()).
+   */
+  Bool eof() const { return m_Eof; }
+
+  /**
+   * make at least n bytes available in the buffer if the input has
+   * them, returns the number of bytes available.
+   */
+  UInt prefetch(UInt n)
+  {
+    if (m_BufferEnd - m_BufferPos < n)
+    {
+      xFill();
+    }
+    return m_BufferEnd - m_BufferPos;
+  }
+
+  /**
+   * return a pointer to the available bytes, valid until the next
+   * prefetch() or read.
+   */
+  const uint8_t* getBufferedBytes() const { return &m_Buffer[0] + m_BufferPos; }
+
+  /**
+   * consume n available bytes.
+   */
+  void skipBytes(UInt n)
+  {
+    assert(n <= m_BufferEnd - m_BufferPos);
+    m_BufferPos += n;
   }
 
   /**
@@ -87,23 +140,11 @@ public:
   Bool eofBeforeNBytes(UInt n)
   {
     assert(n <= 4);
-    if (m_NumFutureBytes >= n)
+    if (prefetch(n) >= n)
       return false;
 
-    n -= m_NumFutureBytes;
-    try
-    {
-      for (UInt i = 0; i < n; i++)
-      {
-        m_FutureBytes = (m_FutureBytes << 8) | m_Input.get();
-        m_NumFutureBytes++;
-      }
-    }
-    catch (...)
-    {
-      return true;
-    }
-    return false;
+    m_Eof = true;
+    return true;
   }
 
   /**
@@ -121,7 +162,11 @@ public:
   uint32_t peekBytes(UInt n)
   {
     eofBeforeNBytes(n);
-    return m_FutureBytes >> 8*(m_NumFutureBytes - n);
+    const UInt num_bytes = std::min(n, m_BufferEnd - m_BufferPos);
+    uint32_t val = 0;
+    for (UInt i = 0; i < num_bytes; i++)
+      val = (val << 8) | m_Buffer[m_BufferPos + i];
+    return val << 8*(n - num_bytes);
   }
 
   /**
@@ -132,15 +177,12 @@ public:
    */
   uint8_t readByte()
   {
-    if (!m_NumFutureBytes)
+    if (prefetch(1) == 0)
     {
-      uint8_t byte = m_Input.get();
-      return byte;
+      m_Eof = true;
+      throw std::ios_base::failure("end of bytestream");
     }
-    m_NumFutureBytes--;
-    uint8_t wanted_byte = m_FutureBytes >> 8*m_NumFutureBytes;
-    m_FutureBytes &= ~(0xff << 8*m_NumFutureBytes);
-    return wanted_byte;
+    return m_Buffer[m_BufferPos++];
   }
 
   /**
@@ -156,13 +198,16 @@ public:
     return val;
   }
 
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-  UInt GetNumBufferedBytes() const { return m_NumFutureBytes; }
-#endif
-
 private:
-  UInt m_NumFutureBytes; /* number of valid bytes in m_FutureBytes */
-  uint32_t m_FutureBytes; /* bytes that have been peeked */
+  static const UInt BUFFER_SIZE = 1 << 18;
+
+  void xFill();
+
+  std::vector<uint8_t> m_Buffer; /* bytes read from the input */
+  UInt m_BufferPos; /* next byte to be consumed */
+  UInt m_BufferEnd; /* number of valid bytes in m_Buffer */
+  std::streamoff m_BufferOffset; /* location in the input of m_Buffer[0] */
+  Bool m_Eof; /* a read past the end of the input was attempted */
   std::istream& m_Input; /* Input stream to read from */
 };
 
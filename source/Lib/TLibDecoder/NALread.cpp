@@ -40,6 +40,7 @@
 #include <vector>
 #include <algorithm>
 #include <ostream>
+#include <string.h>
 
 #include "NALread.h"
 #include "TLibCommon/NAL.h"
@@ -54,41 +55,49 @@ using namespace std;
 //! \{
 static void convertPayloadToRBSP(vector<uint8_t>& nalUnitBuf, TComInputBitstream *bitstream, Bool isVclNalUnit)
 {
-  UInt zeroCount = 0;
-  vector<uint8_t>::iterator it_read, it_write;
+  assert(!nalUnitBuf.empty());
+  UChar* const       buf     = &nalUnitBuf[0];
+  const UChar* const buf_end = buf + nalUnitBuf.size();
+  UInt read_pos  = 0; // first byte of the run that has not been moved yet
+  UInt write_pos = 0;
 
-  UInt pos = 0;
   bitstream->clearEmulationPreventionByteLocation();
-  for (it_read = it_write = nalUnitBuf.begin(); it_read != nalUnitBuf.end(); it_read++, it_write++, pos++)
+  /* an emulation_prevention_three_byte can only follow a pair of zero
+   * bytes, the runs of bytes in between are moved down as a whole */
+  for (const UChar* p = buf; ; )
   {
-    assert(zeroCount < 2 || *it_read >= 0x03);
-    if (zeroCount == 2 && *it_read == 0x03)
+    p = findZeroBytePair(p, buf_end);
+    if (buf_end - p <= 2)
+    {
+      break;
+    }
+    const UInt pos = UInt(p - buf) + 2;
+    assert(buf[pos] >= 0x03);
+    if (buf[pos] == 0x03)
     {
       bitstream->pushEmulationPreventionByteLocation( pos );
-      pos++;
-      it_read++;
-      zeroCount = 0;
+      memmove(buf + write_pos, buf + read_pos, pos - read_pos);
+      write_pos += pos - read_pos;
+      read_pos   = pos + 1;
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
       TComCodingStatistics::IncrementStatisticEP(STATS__EMULATION_PREVENTION_3_BYTES, 8, 0);
 #endif
-      if (it_read == nalUnitBuf.end())
-      {
-        break;
-      }
     }
-    zeroCount = (*it_read == 0x00) ? zeroCount+1 : 0;
-    *it_write = *it_read;
+    p = buf + pos + 1;
   }
-  assert(zeroCount == 0);
-  
+  const UInt size = UInt(nalUnitBuf.size());
+  memmove(buf + write_pos, buf + read_pos, size - read_pos);
+  write_pos += size - read_pos;
+  assert(buf[size - 1] != 0x00);
+
   if (isVclNalUnit)
   {
     // Remove cabac_zero_word from payload if present
     Int n = 0;
     
-    while (it_write[-1] == 0x00)
+    while (write_pos > 0 && buf[write_pos - 1] == 0x00)
     {
-      it_write--;
+      write_pos--;
       n++;
     }
     
@@ -98,7 +107,7 @@ static void convertPayloadToRBSP(vector<uint8_t>& nalUnitBuf, TComInputBitstream
     }
   }
 
-  nalUnitBuf.resize(it_write - nalUnitBuf.begin());
+  nalUnitBuf.resize(write_pos);
 }
 
 Void readNalUnitHeader(InputNALUnit& nalu)
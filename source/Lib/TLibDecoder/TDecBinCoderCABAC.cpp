@@ -36,6 +36,9 @@
 */
 
 #include "TDecBinCoderCABAC.h"
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 #include "TLibCommon/Debug.h"
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
 #include "TLibCommon/TComCodingStatistics.h"
@@ -44,8 +47,42 @@
 //! \ingroup TLibDecoder
 //! \{
 
+// ====================================================================================================================
+// Local helpers
+// ====================================================================================================================
+
+/// number of leading zero bits of a non-zero 32-bit value
+static inline Int countLeadingZeros( UInt uiValue )
+{
+#if defined(__GNUC__)
+  return __builtin_clz( uiValue );
+#elif defined(_MSC_VER)
+  unsigned long uiIdx;
+  _BitScanReverse( &uiIdx, uiValue );
+  return 31 - Int(uiIdx);
+#else
+  Int iCount = 0;
+  while ( !( uiValue & 0x80000000 ) )
+  {
+    uiValue <<= 1;
+    iCount++;
+  }
+  return iCount;
+#endif
+}
+
+// ====================================================================================================================
+// Constructor / destructor / create / destroy
+// ====================================================================================================================
+
 TDecBinCABAC::TDecBinCABAC()
 : m_pcTComBitstream( 0 )
+, m_pucBuffer      ( 0 )
+, m_uiBufferSize   ( 0 )
+, m_uiBufferPos    ( 0 )
+, m_uiRange        ( 0 )
+, m_uiValue        ( 0 )
+, m_bitsAvailable  ( 0 )
 {
 }
 
@@ -65,6 +102,12 @@ TDecBinCABAC::uninit()
   m_pcTComBitstream = 0;
 }
 
+/** Start decoding at the current (byte aligned) location of the bitstream.
+ *
+ * The engine keeps its own read location while decoding: the value window is refilled from the bytes of the
+ * bitstream and the location of the bitstream is only updated when a terminating bin equal to 1 ends the arithmetic
+ * decoding (end of slice segment / substream or PCM samples).
+ */
 Void
 TDecBinCABAC::start()
 {
@@ -72,10 +115,15 @@ TDecBinCABAC::start()
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   TComCodingStatistics::UpdateCABACStat(STATS__CABAC_INITIALISATION, 512, 510, 0);
 #endif
-  m_uiRange    = 510;
-  m_bitsNeeded = -8;
-  m_uiValue    = (m_pcTComBitstream->readByte() << 8);
-  m_uiValue   |= m_pcTComBitstream->readByte();
+  m_pucBuffer     = m_pcTComBitstream->getByteBuffer();
+  m_uiBufferSize  = m_pcTComBitstream->getByteBufferSize();
+  m_uiBufferPos   = m_pcTComBitstream->getByteLocation();
+  assert( m_uiBufferPos + 2 <= m_uiBufferSize );
+
+  m_uiRange       = 510;
+  m_uiValue       = 0;
+  m_bitsAvailable = -CABAC_OFFSET_BITS;
+  xReadBytes();
 }
 
 Void
@@ -85,7 +133,7 @@ TDecBinCABAC::finish()
   
   m_pcTComBitstream->peekPreviousByte( lastByte );
   // Check for proper stop/alignment pattern
-  assert( ((lastByte << (8 + m_bitsNeeded)) & 0xff) == 0x80 );
+  assert( ((lastByte << (8 + xGetBitsNeeded())) & 0xff) == 0x80 );
 }
 
 /**
@@ -97,9 +145,12 @@ Void
 TDecBinCABAC::copyState( TDecBinIf* pcTDecBinIf )
 {
   TDecBinCABAC* pcTDecBinCABAC = pcTDecBinIf->getTDecBinCABAC();
-  m_uiRange   = pcTDecBinCABAC->m_uiRange;
-  m_uiValue   = pcTDecBinCABAC->m_uiValue;
-  m_bitsNeeded= pcTDecBinCABAC->m_bitsNeeded;
+  m_pucBuffer     = pcTDecBinCABAC->m_pucBuffer;
+  m_uiBufferSize  = pcTDecBinCABAC->m_uiBufferSize;
+  m_uiBufferPos   = pcTDecBinCABAC->m_uiBufferPos;
+  m_uiRange       = pcTDecBinCABAC->m_uiRange;
+  m_uiValue       = pcTDecBinCABAC->m_uiValue;
+  m_bitsAvailable = pcTDecBinCABAC->m_bitsAvailable;
 }
 
 
@@ -114,50 +165,40 @@ Void TDecBinCABAC::decodeBin( UInt& ruiBin, ContextModel &rcCtxModel )
   const UInt startingRange = m_uiRange;
 #endif
 
-  UInt uiLPS = TComCABACTables::sm_aucLPSTable[ rcCtxModel.getState() ][ ( m_uiRange >> 6 ) - 4 ];
-  m_uiRange -= uiLPS;
-  UInt scaledRange = m_uiRange << 7;
-  
+  const UInt   uiLPS       = TComCABACTables::sm_aucLPSTable[ rcCtxModel.getState() ][ ( m_uiRange >> 6 ) - 4 ];
+  const UInt   uiMPSRange  = m_uiRange - uiLPS;
+  const UInt64 scaledRange = UInt64(uiMPSRange) << CABAC_WINDOW_SHIFT;
+
   if( m_uiValue < scaledRange )
   {
     // MPS path
-    ruiBin = rcCtxModel.getMps();
+    ruiBin    = rcCtxModel.getMps();
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-    TComCodingStatistics::UpdateCABACStat(whichStat, m_uiRange+uiLPS, m_uiRange, Int(ruiBin));
+    TComCodingStatistics::UpdateCABACStat(whichStat, m_uiRange, uiMPSRange, Int(ruiBin));
 #endif
     rcCtxModel.updateMPS();
-    
-    if ( scaledRange < ( 256 << 7 ) )
-    {
-      m_uiRange = scaledRange >> 6;
-      m_uiValue += m_uiValue;
-      
-      if ( ++m_bitsNeeded == 0 )
-      {
-        m_bitsNeeded = -8;
-        m_uiValue += m_pcTComBitstream->readByte();      
-      }
-    }
+    m_uiRange = uiMPSRange;
   }
   else
   {
     // LPS path
-    ruiBin      = 1 - rcCtxModel.getMps();
+    ruiBin     = 1 - rcCtxModel.getMps();
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-    TComCodingStatistics::UpdateCABACStat(whichStat, m_uiRange+uiLPS, uiLPS, Int(ruiBin));
+    TComCodingStatistics::UpdateCABACStat(whichStat, m_uiRange, uiLPS, Int(ruiBin));
 #endif
-    Int numBits = TComCABACTables::sm_aucRenormTable[ uiLPS >> 3 ];
-    m_uiValue   = ( m_uiValue - scaledRange ) << numBits;
-    m_uiRange   = uiLPS << numBits;
     rcCtxModel.updateLPS();
-    
-    m_bitsNeeded += numBits;
-    
-    if ( m_bitsNeeded >= 0 )
-    {
-      m_uiValue += m_pcTComBitstream->readByte() << m_bitsNeeded;
-      m_bitsNeeded -= 8;
-    }
+    m_uiValue -= scaledRange;
+    m_uiRange  = uiLPS;
+  }
+
+  // renormalise the range back to 9 bits: 0 or 1 bit after an MPS, up to 6 bits after an LPS
+  const Int numBits = countLeadingZeros( m_uiRange ) - ( 32 - CABAC_OFFSET_BITS );
+  m_uiRange       <<= numBits;
+  m_uiValue       <<= numBits;
+  m_bitsAvailable  -= numBits;
+  if ( m_bitsAvailable < 0 )
+  {
+    xReadBytes();
   }
 
 #ifdef DEBUG_CABAC_BINS
@@ -181,16 +222,15 @@ Void TDecBinCABAC::decodeBinEP( UInt& ruiBin, const TComCodingStatisticsClassTyp
 Void TDecBinCABAC::decodeBinEP( UInt& ruiBin )
 #endif
 {
-  m_uiValue += m_uiValue;
-  
-  if ( ++m_bitsNeeded >= 0 )
+  if ( m_bitsAvailable == 0 )
   {
-    m_bitsNeeded = -8;
-    m_uiValue += m_pcTComBitstream->readByte();
+    xReadBytes();
   }
-  
+  m_uiValue += m_uiValue;
+  m_bitsAvailable--;
+
+  const UInt64 scaledRange = UInt64(m_uiRange) << CABAC_WINDOW_SHIFT;
   ruiBin = 0;
-  UInt scaledRange = m_uiRange << 7;
   if ( m_uiValue >= scaledRange )
   {
     ruiBin = 1;
@@ -201,6 +241,14 @@ Void TDecBinCABAC::decodeBinEP( UInt& ruiBin )
 #endif
 }
 
+/** Decode a run of bypass bins, most significant first.
+ *
+ * The bins are decoded from the look-ahead bits of the window without touching the bitstream: bin i compares the
+ * window with the range scaled to the position of the i-th look-ahead bit, and the window is shifted once for the
+ * whole run.
+ * \param ruiBin  decoded bins
+ * \param numBins number of bins, at most 32
+ */
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
 Void TDecBinCABAC::decodeBinsEP( UInt& ruiBin, Int numBins, const TComCodingStatisticsClassType &whichStat )
 #else
@@ -211,45 +259,28 @@ Void TDecBinCABAC::decodeBinsEP( UInt& ruiBin, Int numBins )
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   Int origNumBins=numBins;
 #endif
-  while ( numBins > 8 )
-  {
-    m_uiValue = ( m_uiValue << 8 ) + ( m_pcTComBitstream->readByte() << ( 8 + m_bitsNeeded ) );
-    
-    UInt scaledRange = m_uiRange << 15;
-    for ( Int i = 0; i < 8; i++ )
-    {
-      bins += bins;
-      scaledRange >>= 1;
-      if ( m_uiValue >= scaledRange )
-      {
-        bins++;
-        m_uiValue -= scaledRange;
-      }
-    }
-    numBins -= 8;
-  }
-  
-  m_bitsNeeded += numBins;
-  m_uiValue <<= numBins;
-  
-  if ( m_bitsNeeded >= 0 )
+  assert( numBins <= 32 );
+
+  // a refill leaves at least 47 look-ahead bits, so the whole run is decoded from the window
+  if ( m_bitsAvailable < numBins )
   {
-    m_uiValue += m_pcTComBitstream->readByte() << m_bitsNeeded;
-    m_bitsNeeded -= 8;
+    xReadBytes();
   }
-  
-  UInt scaledRange = m_uiRange << ( numBins + 7 );
+
+  UInt64 scaledRange = UInt64(m_uiRange) << ( CABAC_WINDOW_SHIFT - 1 );
   for ( Int i = 0; i < numBins; i++ )
   {
     bins += bins;
-    scaledRange >>= 1;
     if ( m_uiValue >= scaledRange )
     {
       bins++;
       m_uiValue -= scaledRange;
     }
+    scaledRange >>= 1;
   }
-  
+  m_uiValue      <<= numBins;
+  m_bitsAvailable -= numBins;
+
   ruiBin = bins;
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   TComCodingStatistics::IncrementStatisticEP(whichStat, origNumBins, Int(ruiBin));
@@ -261,14 +292,16 @@ Void
 TDecBinCABAC::decodeBinTrm( UInt& ruiBin )
 {
   m_uiRange -= 2;
-  UInt scaledRange = m_uiRange << 7;
+  const UInt64 scaledRange = UInt64(m_uiRange) << CABAC_WINDOW_SHIFT;
   if( m_uiValue >= scaledRange )
   {
     ruiBin = 1;
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
     TComCodingStatistics::UpdateCABACStat(STATS__CABAC_TRM_BITS, m_uiRange+2, 2, ruiBin);
-    TComCodingStatistics::IncrementStatisticEP(STATS__BYTE_ALIGNMENT_BITS, -m_bitsNeeded, 0);
+    TComCodingStatistics::IncrementStatisticEP(STATS__BYTE_ALIGNMENT_BITS, -xGetBitsNeeded(), 0);
 #endif
+    // arithmetic decoding ends here: the caller continues with finish() or PCM samples from the bitstream
+    xSyncBitstream();
   }
   else
   {
@@ -276,15 +309,13 @@ TDecBinCABAC::decodeBinTrm( UInt& ruiBin )
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
     TComCodingStatistics::UpdateCABACStat(STATS__CABAC_TRM_BITS, m_uiRange+2, m_uiRange, ruiBin);
 #endif
-    if ( scaledRange < ( 256 << 7 ) )
+    if ( m_uiRange < 256 )
     {
-      m_uiRange = scaledRange >> 6;
+      m_uiRange += m_uiRange;
       m_uiValue += m_uiValue;
-      
-      if ( ++m_bitsNeeded == 0 )
+      if ( --m_bitsAvailable < 0 )
       {
-        m_bitsNeeded = -8;
-        m_uiValue += m_pcTComBitstream->readByte();      
+        xReadBytes();
       }
     }
   }
@@ -303,4 +334,39 @@ Void  TDecBinCABAC::xReadPCMCode(UInt uiLength, UInt& ruiCode)
   TComCodingStatistics::IncrementStatisticEP(STATS__CABAC_PCM_CODE_BITS, uiLength, ruiCode);
 #endif
 }
+
+/** Refill the value window with as many whole bytes as fit below the offset and the look-ahead bits.
+ * Bytes past the end of the bitstream are read as zero; a conforming stream terminates before using them.
+ */
+Void TDecBinCABAC::xReadBytes()
+{
+  const Int numBytes = ( CABAC_WINDOW_SHIFT - m_bitsAvailable ) >> 3;
+  const Int shift    = CABAC_WINDOW_SHIFT - m_bitsAvailable - ( numBytes << 3 );
+  assert( numBytes > 0 );
+
+  if ( m_uiBufferPos + 8 <= m_uiBufferSize )
+  {
+    m_uiValue |= ( readBigEndian64( m_pucBuffer + m_uiBufferPos ) >> ( 64 - ( numBytes << 3 ) ) ) << shift;
+  }
+  else
+  {
+    UInt64 uiBytes = 0;
+    for ( Int i = 0; i < numBytes; i++ )
+    {
+      uiBytes = ( uiBytes << 8 ) | ( m_uiBufferPos + i < m_uiBufferSize ? m_pucBuffer[m_uiBufferPos + i] : 0 );
+    }
+    m_uiValue |= uiBytes << shift;
+  }
+
+  m_uiBufferPos   += numBytes;
+  m_bitsAvailable += numBytes << 3;
+}
+
+/** Move the bitstream to the byte location the arithmetic decoder has consumed up to, i.e. the two initial bytes
+ * plus one byte per 8 renormalisation shifts, discarding the look-ahead bytes of the window.
+ */
+Void TDecBinCABAC::xSyncBitstream()
+{
+  m_pcTComBitstream->setByteLocation( xGetByteLocation() );
+}
 //! \}
@@ -74,10 +74,21 @@ public:
   TDecBinCABAC* getTDecBinCABAC()  { return this; }
 
 private:
+  Void  xReadBytes        ();
+  UInt  xGetByteLocation  () const { return m_uiBufferPos - ( m_bitsAvailable >> 3 ); }
+  Int   xGetBitsNeeded    () const { return ( ( -( m_bitsAvailable + CABAC_OFFSET_BITS ) ) & 7 ) - 8; }
+  Void  xSyncBitstream    ();
+
+  static const Int CABAC_OFFSET_BITS  = 9;  ///< bits of the arithmetic decoder offset
+  static const Int CABAC_WINDOW_SHIFT = 54; ///< position of the offset LSB in m_uiValue (one bit of headroom above it)
+
   TComInputBitstream* m_pcTComBitstream;
+  const UChar*        m_pucBuffer;          ///< bytes of the bitstream
+  UInt                m_uiBufferSize;
+  UInt                m_uiBufferPos;        ///< index of the next byte to be loaded into m_uiValue (may pass the end, zeros are loaded there)
   UInt                m_uiRange;
-  UInt                m_uiValue;
-  Int                 m_bitsNeeded;
+  UInt64              m_uiValue;            ///< offset in bits 62..54, followed by m_bitsAvailable look-ahead bits
+  Int                 m_bitsAvailable;
 };
 
 //! \}
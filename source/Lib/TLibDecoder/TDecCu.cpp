@@ -50,6 +50,7 @@ TDecCu::TDecCu()
   m_ppcYuvResi = NULL;
   m_ppcYuvReco = NULL;
   m_ppcCU      = NULL;
+  m_bWaitForReferences = false;
 }
 
 TDecCu::~TDecCu()
@@ -127,6 +128,11 @@ Void TDecCu::decodeCU( TComDataCU* pcCU, UInt& ruiIsLast )
     setdQPFlag(true);
   }
 
+  if ( m_bWaitForReferences )
+  {
+    xWaitForColocatedRow( pcCU );
+  }
+
   // start from the top level CU
   xDecodeCU( pcCU, 0, 0, ruiIsLast);
 }
@@ -152,7 +158,7 @@ Bool TDecCu::xDecodeSliceEnd( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiDepth)
 {
   UInt uiIsLast;
   TComPic* pcPic = pcCU->getPic();
-  TComSlice * pcSlice = pcPic->getSlice(pcPic->getCurrSliceIdx());
+  TComSlice * pcSlice = pcCU->getSlice();
   UInt uiCurNumParts    = pcPic->getNumPartInCU() >> (uiDepth<<1);
   UInt uiWidth = pcSlice->getSPS()->getPicWidthInLumaSamples();
   UInt uiHeight = pcSlice->getSPS()->getPicHeightInLumaSamples();
@@ -205,7 +211,7 @@ Void TDecCu::xDecodeCU( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiDepth, UInt&
   UInt uiTPelY   = pcCU->getCUPelY() + g_auiRasterToPelY[ g_auiZscanToRaster[uiAbsPartIdx] ];
   UInt uiBPelY   = uiTPelY + (g_uiMaxCUHeight>>uiDepth) - 1;
 
-  TComSlice * pcSlice = pcCU->getPic()->getSlice(pcCU->getPic()->getCurrSliceIdx());
+  TComSlice * pcSlice = pcCU->getSlice();
   Bool bStartInCU = pcCU->getSCUAddr()+uiAbsPartIdx+uiCurNumParts>pcSlice->getSliceSegmentCurStartCUAddr()&&pcCU->getSCUAddr()+uiAbsPartIdx<pcSlice->getSliceSegmentCurStartCUAddr();
   if((!bStartInCU) && ( uiRPelX < pcSlice->getSPS()->getPicWidthInLumaSamples() ) && ( uiBPelY < pcSlice->getSPS()->getPicHeightInLumaSamples() ) )
   {
@@ -377,7 +383,7 @@ Void TDecCu::xDecompressCU( TComDataCU* pcLCU, UInt uiAbsPartIdx,  UInt uiDepth
   UInt uiBPelY   = uiTPelY + (g_uiMaxCUHeight>>uiDepth) - 1;
 
   UInt uiCurNumParts    = pcPic->getNumPartInCU() >> (uiDepth<<1);
-  TComSlice * pcSlice = pcLCU->getPic()->getSlice(pcLCU->getPic()->getCurrSliceIdx());
+  TComSlice * pcSlice = pcLCU->getSlice();
   Bool bStartInCU = pcLCU->getSCUAddr()+uiAbsPartIdx+uiCurNumParts>pcSlice->getSliceSegmentCurStartCUAddr()&&pcLCU->getSCUAddr()+uiAbsPartIdx<pcSlice->getSliceSegmentCurStartCUAddr();
   if(bStartInCU||( uiRPelX >= pcSlice->getSPS()->getPicWidthInLumaSamples() ) || ( uiBPelY >= pcSlice->getSPS()->getPicHeightInLumaSamples() ) )
   {
@@ -438,6 +444,10 @@ Void TDecCu::xDecompressCU( TComDataCU* pcLCU, UInt uiAbsPartIdx,  UInt uiDepth
 
 Void TDecCu::xReconInter( TComDataCU* pcCU, UInt uiDepth )
 {
+  if ( m_bWaitForReferences )
+  {
+    xWaitForReferenceRows( pcCU );
+  }
 
   // inter prediction
   m_pcPrediction->motionCompensation( pcCU, m_ppcYuvReco[uiDepth] );
@@ -464,6 +474,55 @@ Void TDecCu::xReconInter( TComDataCU* pcCU, UInt uiDepth )
 
 }
 
+/** Wait until the CTU rows of the reference pictures that are read by the motion compensation of a CU are final.
+ * The lowest row read by a prediction unit follows from its vertical motion vector and the interpolation filter taps
+ * below the block.
+ * \param pcCU CU to be predicted
+ */
+Void TDecCu::xWaitForReferenceRows( TComDataCU* pcCU )
+{
+  TComSlice* pcSlice = pcCU->getSlice();
+  const Int  iMaxRow = (Int)pcCU->getPic()->getFrameHeightInCU() - 1;
+
+  for ( UInt uiPartIdx = 0; uiPartIdx < pcCU->getNumPartInter(); uiPartIdx++ )
+  {
+    UInt uiPartAddr;
+    Int  iWidth, iHeight;
+    pcCU->getPartIndexAndSize( uiPartIdx, uiPartAddr, iWidth, iHeight );
+    const Int iPartBottom = pcCU->getCUPelY() + g_auiRasterToPelY[ g_auiZscanToRaster[uiPartAddr] ] + iHeight - 1;
+
+    for ( Int iRefList = 0; iRefList < NUM_REF_PIC_LIST_01; iRefList++ )
+    {
+      const RefPicList eRefPicList = RefPicList( iRefList );
+      const Int        iRefIdx     = pcCU->getCUMvField( eRefPicList )->getRefIdx( uiPartAddr );
+      if ( iRefIdx < 0 )
+      {
+        continue;
+      }
+
+      const Int iBottom = iPartBottom + ( pcCU->getCUMvField( eRefPicList )->getMv( uiPartAddr ).getVer() >> 2 ) + ( NTAPS_LUMA >> 1 );
+      const Int iRow    = Clip3( 0, iMaxRow, iBottom / (Int)g_uiMaxCUHeight );
+      pcSlice->getRefPic( eRefPicList, iRefIdx )->waitForFilteredRows( iRow + 1 );
+    }
+  }
+}
+
+/** Wait until the motion of the collocated picture is available for the temporal motion vector prediction in a CTU.
+ * The collocated motion vectors used for a CTU lie in the same CTU row.
+ * \param pcCU CTU to be decoded
+ */
+Void TDecCu::xWaitForColocatedRow( TComDataCU* pcCU )
+{
+  TComSlice* pcSlice = pcCU->getSlice();
+  if ( pcSlice->isIntra() || !pcSlice->getEnableTMVPFlag() )
+  {
+    return;
+  }
+
+  TComPic* pcColPic = pcSlice->getRefPic( RefPicList( pcSlice->isInterB() ? 1-pcSlice->getColFromL0Flag() : 0 ), pcSlice->getColRefIdx() );
+  pcColPic->waitForFilteredRows( pcCU->getCUPelY() / g_uiMaxCUHeight + 1 );
+}
+
 #if RExt__N0256_INTRA_BLOCK_COPY
 Void TDecCu::xReconIntraBC( TComDataCU* pcCU, UInt uiDepth )
 {
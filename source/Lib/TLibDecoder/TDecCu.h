@@ -68,6 +68,7 @@ private:
   TDecEntropy*        m_pcEntropyDecoder;
 
   Bool                m_bDecodeDQP;
+  Bool                m_bWaitForReferences;   ///< frame-parallel decoding: wait for the reference picture rows that are read
   
 public:
   TDecCu();
@@ -88,6 +89,9 @@ public:
   /// reconstruct CU information
   Void  decompressCU            ( TComDataCU* pcCU );
   
+  /// enable waiting for reference pictures that are decoded at the same time
+  Void  setWaitForReferences    ( Bool b )                { m_bWaitForReferences = b;   }
+  
 protected:
   
   Void xDecodeCU                ( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiDepth, UInt &ruiIsLast);
@@ -96,6 +100,8 @@ protected:
   Void xDecompressCU            ( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiDepth );
   
   Void xReconInter              ( TComDataCU* pcCU, UInt uiDepth );
+  Void xWaitForReferenceRows    ( TComDataCU* pcCU );
+  Void xWaitForColocatedRow     ( TComDataCU* pcCU );
 #if RExt__N0256_INTRA_BLOCK_COPY
   Void  xReconIntraBC           ( TComDataCU* pcCU, UInt uiDepth );
 #endif
@@ -59,6 +59,10 @@ TDecGop::TDecGop()
   m_dDecTime = 0;
   m_pcSbacDecoders = NULL;
   m_pcBinCABACs = NULL;
+  m_pcThreadPool = NULL;
+  m_pcSliceWorkers = NULL;
+  m_pcParallelPics = NULL;
+  m_bLazyBorderExtension = false;
 }
 
 TDecGop::~TDecGop()
@@ -82,7 +86,9 @@ Void TDecGop::init( TDecEntropy*            pcEntropyDecoder,
                    TDecCavlc*              pcCavlcDecoder,
                    TDecSlice*              pcSliceDecoder,
                    TComLoopFilter*         pcLoopFilter,
-                   TComSampleAdaptiveOffset* pcSAO
+                   TComSampleAdaptiveOffset* pcSAO,
+                   TComThreadPool*         pcThreadPool,
+                   TDecSliceWorker*        pcSliceWorkers
                    )
 {
   m_pcEntropyDecoder      = pcEntropyDecoder;
@@ -92,6 +98,8 @@ Void TDecGop::init( TDecEntropy*            pcEntropyDecoder,
   m_pcSliceDecoder        = pcSliceDecoder;
   m_pcLoopFilter          = pcLoopFilter;
   m_pcSAO  = pcSAO;
+  m_pcThreadPool          = pcThreadPool;
+  m_pcSliceWorkers        = pcSliceWorkers;
 }
 
 
@@ -112,12 +120,11 @@ Void TDecGop::decompressSlice(TComInputBitstream* pcBitstream, TComPic*& rpcPic)
   //-- For time output for each slice
   long iBeforeTime = clock();
 
-  UInt uiStartCUAddr   = pcSlice->getSliceSegmentCurStartCUAddr();
-
-  UInt uiSliceStartCuAddr = pcSlice->getSliceCurStartCUAddr();
-  if(uiSliceStartCuAddr == uiStartCUAddr)
+  if ( m_pcSliceDecoder->canDeferSlice( pcSlice ) )
   {
-    m_sliceStartCUAddress.push_back(uiSliceStartCuAddr);
+    m_pcSliceDecoder->deferSlice( pcBitstream, rpcPic );
+    m_dDecTime += (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
+    return;
   }
 
   m_pcSbacDecoder->init( (TDecBinIf*)m_pcBinCABAC );
@@ -147,10 +154,6 @@ Void TDecGop::decompressSlice(TComInputBitstream* pcBitstream, TComPic*& rpcPic)
   m_pcEntropyDecoder->setBitstream      ( ppcSubstreams[0] );
   m_pcEntropyDecoder->resetEntropy      (pcSlice);
 
-  if(uiSliceStartCuAddr == uiStartCUAddr)
-  {
-    m_LFCrossSliceBoundaryFlag.push_back( pcSlice->getLFCrossSliceBoundaryFlag());
-  }
   m_pcSbacDecoders[0].load(m_pcSbacDecoder);
   m_pcSliceDecoder->decompressSlice( ppcSubstreams, rpcPic, m_pcSbacDecoder, m_pcSbacDecoders);
   m_pcEntropyDecoder->setBitstream(  ppcSubstreams[uiNumSubstreams-1] );
@@ -167,46 +170,73 @@ Void TDecGop::decompressSlice(TComInputBitstream* pcBitstream, TComPic*& rpcPic)
   m_dDecTime += (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
 }
 
-Void TDecGop::filterPicture(TComPic*& rpcPic)
+/** Decode the slices of the picture that were collected to be decoded in parallel. This starts the in-loop filtering
+ * of the picture, which the pipelined decoding applies to the CTU rows while the rows below are reconstructed.
+ * \param rpcPic picture being decoded, all of its slices are known
+ */
+Void TDecGop::decompressDeferredSlices(TComPic*& rpcPic)
 {
-  TComSlice*  pcSlice = rpcPic->getSlice(rpcPic->getCurrSliceIdx());
+  long iBeforeTime = clock();
 
-  //-- For time output for each slice
+  // a non-reference picture does not need its border, the border of a reference picture is extended row by row,
+  // or with lazy border extension by TComSlice::setRefPicList() when the picture is first used for prediction
+  const Bool bExtendBorder = rpcPic->getSlice(rpcPic->getCurrSliceIdx())->isReferenced() && !m_bLazyBorderExtension;
+  m_cRowFilter.init( rpcPic, m_pcLoopFilter, m_pcSAO, bExtendBorder );
+  m_pcSliceDecoder->decompressDeferredSlices( rpcPic, &m_cRowFilter );
+
+  m_dDecTime += (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
+}
+
+/** Decode the pictures collected for frame-parallel decoding with the thread pool, one picture per job, and finish
+ * them in decoding order.
+ * \param rcPics        pictures in decoding order, their slices have been collected by the slice decoder
+ * \param rcReferenced  reference marking of the pictures when they were collected
+ */
+Void TDecGop::decompressPictures( std::vector<TComPic*>& rcPics, const std::vector<Bool>& rcReferenced )
+{
   long iBeforeTime = clock();
 
-  // deblocking filter
-  Bool bLFCrossTileBoundary = pcSlice->getPPS()->getLoopFilterAcrossTilesEnabledFlag();
-  m_pcLoopFilter->setCfg(bLFCrossTileBoundary);
-  m_pcLoopFilter->loopFilterPic( rpcPic );
+  m_pcParallelPics = &rcPics;
+  TComMemberJob<TDecGop> cPictureJob( this, &TDecGop::xDecompressPicture );
+  m_pcThreadPool->execute( &cPictureJob, (Int)rcPics.size() );
+  m_pcParallelPics = NULL;
 
-  if(pcSlice->getSPS()->getUseSAO())
-  {
-    m_sliceStartCUAddress.push_back(rpcPic->getNumCUsInFrame()* rpcPic->getNumPartInCU());
-    rpcPic->createNonDBFilterInfo(m_sliceStartCUAddress, 0, &m_LFCrossSliceBoundaryFlag, rpcPic->getPicSym()->getNumTiles(), bLFCrossTileBoundary);
-  }
+  m_pcSliceDecoder->deleteDeferredSlices();
 
-  if( pcSlice->getSPS()->getUseSAO() )
-  {
-    {
-      SAOParam *saoParam = rpcPic->getPicSym()->getSaoParam();
-      saoParam->bSaoFlag[CHANNEL_TYPE_LUMA] = pcSlice->getSaoEnabledFlag();
-      saoParam->bSaoFlag[CHANNEL_TYPE_CHROMA] = pcSlice->getSaoEnabledFlagChroma();
-      m_pcSAO->setSaoLcuBasedOptimization(1);
-      m_pcSAO->createPicSaoInfo(rpcPic);
-      m_pcSAO->SAOProcess(saoParam);
-      m_pcSAO->PCMLFDisableProcess(rpcPic);
-      m_pcSAO->destroyPicSaoInfo();
-    }
-  }
+  m_dDecTime += (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
 
-  if(pcSlice->getSPS()->getUseSAO())
+  for ( UInt ui = 0; ui < rcPics.size(); ui++ )
   {
-    rpcPic->destroyNonDBFilterInfo();
+    finishPicture( rcPics[ui], rcReferenced[ui] );
   }
+}
+
+/** Apply the in-loop filters to the CTU rows of a decoded picture that are not filtered yet, and finish the picture.
+ * \param rpcPic decoded picture, decompressDeferredSlices() was called for it
+ */
+Void TDecGop::filterPicture(TComPic*& rpcPic)
+{
+  //-- For time output for each slice
+  long iBeforeTime = clock();
+
+  assert( m_cRowFilter.getPic() == rpcPic );
+  m_cRowFilter.finish();
+
+  m_dDecTime += (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
+
+  finishPicture( rpcPic, rpcPic->getSlice(rpcPic->getCurrSliceIdx())->isReferenced() );
+}
+
+/** Print the decoding information and the picture hash status of a filtered picture and mark it as decoded.
+ * \param rpcPic      decoded and filtered picture
+ * \param bReferenced the picture was marked as used for reference after its own decoding
+ */
+Void TDecGop::finishPicture(TComPic*& rpcPic, Bool bReferenced)
+{
+  TComSlice*  pcSlice = rpcPic->getSlice(rpcPic->getCurrSliceIdx());
 
-  rpcPic->compressMotion();
   Char c = (pcSlice->isIntra() ? 'I' : pcSlice->isInterP() ? 'P' : 'B');
-  if (!pcSlice->isReferenced()) c += 32;
+  if (!bReferenced) c += 32;
 
   //-- For time output for each slice
   printf("POC %4d TId: %1d ( %c-SLICE, QP%3d ) ", pcSlice->getPOC(),
@@ -214,7 +244,6 @@ Void TDecGop::filterPicture(TComPic*& rpcPic)
                                                   c,
                                                   pcSlice->getSliceQp() );
 
-  m_dDecTime += (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
   printf ("[DT %6.3f] ", m_dDecTime );
   m_dDecTime  = 0;
 
@@ -242,8 +271,23 @@ Void TDecGop::filterPicture(TComPic*& rpcPic)
 
   rpcPic->setOutputMark(true);
   rpcPic->setReconMark(true);
-  m_sliceStartCUAddress.clear();
-  m_LFCrossSliceBoundaryFlag.clear();
+}
+
+/** Decode and filter one of the collected pictures (thread pool job). The CTU rows of the picture are filtered while
+ * the rows below are decoded, and published when they are final, as the pictures referencing it wait for them.
+ * \param iPicIdx    index of the picture in decoding order
+ * \param iThreadIdx index of the executing thread, selects the decoding tools
+ */
+Void TDecGop::xDecompressPicture( Int iPicIdx, Int iThreadIdx )
+{
+  TComPic*          pcPic    = (*m_pcParallelPics)[iPicIdx];
+  TDecSliceWorker*  pcWorker = &m_pcSliceWorkers[iThreadIdx];
+  TDecRowFilter     cRowFilter;
+
+  // the border is extended with the rows, instead of when a later picture sets up its reference lists
+  cRowFilter.init( pcPic, pcWorker->getLoopFilter(), pcWorker->getSAO(), true );
+  m_pcSliceDecoder->decompressDeferredPicture( pcPic, iThreadIdx, &cRowFilter );
+  cRowFilter.finish();
 }
 
 /**
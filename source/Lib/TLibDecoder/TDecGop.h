@@ -49,11 +49,14 @@
 #include "TLibCommon/TComPic.h"
 #include "TLibCommon/TComLoopFilter.h"
 #include "TLibCommon/TComSampleAdaptiveOffset.h"
+#include "TLibCommon/TComThreadPool.h"
 
 #include "TDecEntropy.h"
 #include "TDecSlice.h"
 #include "TDecBinCoder.h"
 #include "TDecBinCoderCABAC.h"
+#include "TDecSliceWorker.h"
+#include "TDecRowFilter.h"
 
 //! \ingroup TLibDecoder
 //! \{
@@ -79,12 +82,15 @@ private:
   TComLoopFilter*       m_pcLoopFilter;
   
   TComSampleAdaptiveOffset*     m_pcSAO;
+  TDecRowFilter         m_cRowFilter;                     ///< in-loop filters of the picture being decoded
   Double                m_dDecTime;
   Int                   m_decodedPictureHashSEIEnabled;  ///< Checksum(3)/CRC(2)/MD5(1)/disable(0) acting on decoded picture hash SEI message
+  Bool                  m_bLazyBorderExtension;           ///< leave the border extension to the first use of a reference picture
 
-  //! list that contains the CU address of each slice plus the end address 
-  std::vector<Int> m_sliceStartCUAddress;
-  std::vector<Bool> m_LFCrossSliceBoundaryFlag;
+  // frame-parallel decoding
+  TComThreadPool*       m_pcThreadPool;                   ///< worker threads
+  TDecSliceWorker*      m_pcSliceWorkers;                 ///< decoding tools and in-loop filters of each thread
+  std::vector<TComPic*>* m_pcParallelPics;                ///< pictures being decoded
 
 public:
   TDecGop();
@@ -96,15 +102,24 @@ public:
                  TDecCavlc*              pcCavlcDecoder, 
                  TDecSlice*              pcSliceDecoder, 
                  TComLoopFilter*         pcLoopFilter,
-                 TComSampleAdaptiveOffset* pcSAO
+                 TComSampleAdaptiveOffset* pcSAO,
+                 TComThreadPool*         pcThreadPool = NULL,
+                 TDecSliceWorker*        pcSliceWorkers = NULL
                  );
   Void  create  ();
   Void  destroy ();
   Void  decompressSlice(TComInputBitstream* pcBitstream, TComPic*& rpcPic );
+  Void  decompressDeferredSlices(TComPic*& rpcPic );
   Void  filterPicture  (TComPic*& rpcPic );
+  Void  decompressPictures ( std::vector<TComPic*>& rcPics, const std::vector<Bool>& rcReferenced );
+
+  Void  finishPicture      ( TComPic*& rpcPic, Bool bReferenced );
 
   void setDecodedPictureHashSEIEnabled(Int enabled) { m_decodedPictureHashSEIEnabled = enabled; }
+  Void  setLazyBorderExtension ( Bool b ) { m_bLazyBorderExtension = b; }
 
+private:
+  Void  xDecompressPicture ( Int iPicIdx, Int iThreadIdx );
 };
 
 //! \}
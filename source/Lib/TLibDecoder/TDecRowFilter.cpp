@@ -0,0 +1,233 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.  
+ *
+ * Copyright (c) 2010-2013, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TDecRowFilter.cpp
+    \brief    CTU-row based in-loop filtering of a decoded picture
+*/
+
+#include "TDecRowFilter.h"
+
+//! \ingroup TLibDecoder
+//! \{
+
+// ====================================================================================================================
+// Constructor / destructor
+// ====================================================================================================================
+
+TDecRowFilter::TDecRowFilter()
+: m_pcPic             ( NULL )
+, m_pcLoopFilter      ( NULL )
+, m_pcSAO             ( NULL )
+, m_bSAO              ( false )
+, m_bExtendBorder     ( false )
+, m_bStarted          ( false )
+, m_iNumRows          ( 0 )
+, m_iNumDecodedRows   ( 0 )
+, m_iNumDeblockedRows ( 0 )
+, m_iNumFilteredRows  ( 0 )
+{
+}
+
+TDecRowFilter::~TDecRowFilter()
+{
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** Start the filtering of a picture. The rows that are published by the picture become available again one by one.
+ * \param pcPic        picture, its slices are all known, its CTUs need not be reconstructed yet
+ * \param pcLoopFilter deblocking filter to be used
+ * \param pcSAO        SAO to be used
+ * \param bExtendBorder extend the border of each row when it is final, otherwise this is left to the first picture
+ *                      that references the picture
+ */
+Void TDecRowFilter::init( TComPic* pcPic, TComLoopFilter* pcLoopFilter, TComSampleAdaptiveOffset* pcSAO, Bool bExtendBorder )
+{
+  m_pcPic             = pcPic;
+  m_pcLoopFilter      = pcLoopFilter;
+  m_pcSAO             = pcSAO;
+  m_bSAO              = pcPic->getSlice(0)->getSPS()->getUseSAO();
+  m_bExtendBorder     = bExtendBorder;
+  m_bStarted          = false;
+  m_iNumRows          = pcPic->getFrameHeightInCU();
+  m_iNumDecodedRows   = 0;
+  m_iNumDeblockedRows = 0;
+  m_iNumFilteredRows  = 0;
+  m_cNumDecodedCUs.assign( m_iNumRows, 0 );
+
+  pcPic->resetFilteredRows();
+}
+
+/** Count a reconstructed CTU. When this completes the CTU rows following the reconstructed ones, the rows that can be
+ * filtered are filtered.
+ * \param uiCUAddr raster address of the reconstructed CTU
+ */
+Void TDecRowFilter::setCUDecoded( UInt uiCUAddr )
+{
+  const UInt uiWidthInCUs = m_pcPic->getFrameWidthInCU();
+
+  if ( ++m_cNumDecodedCUs[uiCUAddr / uiWidthInCUs] < uiWidthInCUs )
+  {
+    return;
+  }
+
+  // with tiles, the rows are not completed in order
+  Int iNumDecodedRows = m_iNumDecodedRows;
+  while ( iNumDecodedRows < m_iNumRows && m_cNumDecodedCUs[iNumDecodedRows] == uiWidthInCUs )
+  {
+    iNumDecodedRows++;
+  }
+  filterRows( iNumDecodedRows );
+}
+
+/** Deblock the CTU rows whose row below is reconstructed, and apply SAO to the rows whose row below is deblocked.
+ * \param iNumDecodedRows number of CTU rows that are completely reconstructed
+ */
+Void TDecRowFilter::filterRows( Int iNumDecodedRows )
+{
+  if ( iNumDecodedRows <= m_iNumDecodedRows )
+  {
+    return;
+  }
+  m_iNumDecodedRows = iNumDecodedRows;
+
+  if ( !m_bStarted )
+  {
+    xStart();
+  }
+
+  // the deblocking of a row reads the unfiltered samples of the row below, which the intra prediction of that row
+  // needs as well
+  const Int iNumDeblockableRows = m_iNumDecodedRows == m_iNumRows ? m_iNumRows : m_iNumDecodedRows - 1;
+  while ( m_iNumDeblockedRows < iNumDeblockableRows )
+  {
+    m_pcLoopFilter->loopFilterCTURow( m_pcPic, m_iNumDeblockedRows );
+    m_iNumDeblockedRows++;
+  }
+
+  // the deblocking of a row modifies the bottom samples of the row above, and the SAO of a row reads the top samples
+  // of the row below
+  const Int iNumFinalRows = m_iNumDeblockedRows == m_iNumRows ? m_iNumRows : m_iNumDeblockedRows - 1;
+  while ( m_iNumFilteredRows < iNumFinalRows )
+  {
+    xFinishRow( m_iNumFilteredRows );
+    m_iNumFilteredRows++;
+    m_pcPic->setFilteredRows( m_iNumFilteredRows );
+  }
+}
+
+/** Filter the remaining rows once the picture is reconstructed, and release the picture-level data of the filters.
+ */
+Void TDecRowFilter::finish()
+{
+  filterRows( m_iNumRows );
+
+  if ( m_bSAO )
+  {
+    m_pcSAO->destroyPicSaoInfo();
+    m_pcPic->destroyNonDBFilterInfo();
+  }
+  if ( m_bExtendBorder )
+  {
+    m_pcPic->getPicYuvRec()->setBorderExtension( true );
+  }
+
+  m_pcPic = NULL;
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+/** Set up the deblocking filter and the SAO for the picture. This needs the CTUs of the picture to be initialized.
+ */
+Void TDecRowFilter::xStart()
+{
+  TComSlice*  pcSlice = m_pcPic->getSlice(m_pcPic->getCurrSliceIdx());
+
+  Bool bLFCrossTileBoundary = pcSlice->getPPS()->getLoopFilterAcrossTilesEnabledFlag();
+  m_pcLoopFilter->setCfg(bLFCrossTileBoundary);
+
+  if( m_bSAO )
+  {
+    //! list that contains the CU address of each slice plus the end address
+    std::vector<Int>  sliceStartCUAddress;
+    std::vector<Bool> LFCrossSliceBoundaryFlag;
+
+    for ( UInt uiSliceIdx = 0; uiSliceIdx < m_pcPic->getNumAllocatedSlice(); uiSliceIdx++ )
+    {
+      TComSlice* pcSliceSegment = m_pcPic->getSlice(uiSliceIdx);
+      if ( pcSliceSegment->getSliceCurStartCUAddr() == pcSliceSegment->getSliceSegmentCurStartCUAddr() )
+      {
+        sliceStartCUAddress.push_back( pcSliceSegment->getSliceCurStartCUAddr() );
+        LFCrossSliceBoundaryFlag.push_back( pcSliceSegment->getLFCrossSliceBoundaryFlag() );
+      }
+    }
+    sliceStartCUAddress.push_back(m_pcPic->getNumCUsInFrame()* m_pcPic->getNumPartInCU());
+    m_pcPic->createNonDBFilterInfo(sliceStartCUAddress, 0, &LFCrossSliceBoundaryFlag, m_pcPic->getPicSym()->getNumTiles(), bLFCrossTileBoundary);
+
+    SAOParam *saoParam = m_pcPic->getPicSym()->getSaoParam();
+    saoParam->bSaoFlag[CHANNEL_TYPE_LUMA] = pcSlice->getSaoEnabledFlag();
+    saoParam->bSaoFlag[CHANNEL_TYPE_CHROMA] = pcSlice->getSaoEnabledFlagChroma();
+    m_pcSAO->setSaoLcuBasedOptimization(1);
+    m_pcSAO->createPicSaoInfo(m_pcPic);
+  }
+
+  m_bStarted = true;
+}
+
+/** Apply SAO to a deblocked CTU row, compress its motion and extend the border of its lines if requested.
+ * \param iRow CTU row, the row below is deblocked
+ */
+Void TDecRowFilter::xFinishRow( Int iRow )
+{
+  if ( m_bSAO )
+  {
+    m_pcSAO->SAOProcessCTURow( m_pcPic->getPicSym()->getSaoParam(), iRow );
+    m_pcSAO->PCMLFDisableProcessCTURow( m_pcPic, iRow );
+  }
+
+  // the motion of the row was needed for the boundary strength of the row below
+  m_pcPic->compressMotionCTURow( iRow );
+
+  if ( m_bExtendBorder )
+  {
+    const Int iPicHeight = m_pcPic->getPicYuvRec()->getHeight( COMPONENT_Y );
+    m_pcPic->getPicYuvRec()->extendPicBorderLines( iRow * g_uiMaxCUHeight, min( (iRow + 1) * (Int)g_uiMaxCUHeight, iPicHeight ) );
+  }
+}
+
+//! \}
@@ -0,0 +1,100 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.  
+ *
+ * Copyright (c) 2010-2013, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TDecRowFilter.h
+    \brief    CTU-row based in-loop filtering of a decoded picture (header)
+*/
+
+#ifndef __TDECROWFILTER__
+#define __TDECROWFILTER__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "TLibCommon/CommonDef.h"
+#include "TLibCommon/TComPic.h"
+#include "TLibCommon/TComLoopFilter.h"
+#include "TLibCommon/TComSampleAdaptiveOffset.h"
+
+//! \ingroup TLibDecoder
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// deblocking, SAO, motion compression and border extension of a picture one CTU row after the other, lagging the
+/// reconstruction: a row is deblocked once the row below is reconstructed and gets SAO once the row below is deblocked
+class TDecRowFilter
+{
+private:
+  TComPic*                  m_pcPic;                      ///< picture being filtered
+  TComLoopFilter*           m_pcLoopFilter;               ///< deblocking filter
+  TComSampleAdaptiveOffset* m_pcSAO;                      ///< SAO
+  Bool                      m_bSAO;                       ///< the sequence uses SAO
+  Bool                      m_bExtendBorder;              ///< extend the border of the filtered rows
+  Bool                      m_bStarted;                   ///< the picture-level data of the filters is set up
+  Int                       m_iNumRows;                   ///< number of CTU rows of the picture
+  Int                       m_iNumDecodedRows;            ///< number of CTU rows that are reconstructed, as far as known
+  Int                       m_iNumDeblockedRows;          ///< number of CTU rows that are deblocked
+  Int                       m_iNumFilteredRows;           ///< number of CTU rows whose samples and motion are final
+  std::vector<UInt>         m_cNumDecodedCUs;             ///< number of reconstructed CTUs of each CTU row
+
+public:
+  TDecRowFilter();
+  virtual ~TDecRowFilter();
+
+  /// start the filtering of a picture whose slices are all known
+  Void      init          ( TComPic* pcPic, TComLoopFilter* pcLoopFilter, TComSampleAdaptiveOffset* pcSAO, Bool bExtendBorder );
+
+  /// count a reconstructed CTU and filter the rows that it completes
+  Void      setCUDecoded  ( UInt uiCUAddr );
+
+  /// filter as far as the given number of CTU rows is reconstructed
+  Void      filterRows    ( Int iNumDecodedRows );
+
+  /// filter the remaining rows of the completely reconstructed picture
+  Void      finish        ();
+
+  TComPic*  getPic        () { return m_pcPic; }
+
+private:
+  Void      xStart        ();
+  Void      xFinishRow    ( Int iRow );
+};
+
+//! \}
+
+#endif // __TDECROWFILTER__
@@ -1742,7 +1742,12 @@ Void TDecSbac::parseSaoOneLcuInterleaving(Int rx, Int ry, SAOParam* pSaoParam, T
 
   const Bool bChroma = isChromaEnabled(pcCU->getPic()->getChromaFormat());
 
-  if (pSaoParam->bSaoFlag[CHANNEL_TYPE_LUMA] || (bChroma && pSaoParam->bSaoFlag[CHANNEL_TYPE_CHROMA]) )
+  // the enable flags are taken from the slice of the CTU, as the slices of a picture may be parsed concurrently
+  Bool bSaoFlag[MAX_NUM_CHANNEL_TYPE];
+  bSaoFlag[CHANNEL_TYPE_LUMA]   = pcCU->getSlice()->getSaoEnabledFlag();
+  bSaoFlag[CHANNEL_TYPE_CHROMA] = pcCU->getSlice()->getSaoEnabledFlagChroma();
+
+  if (bSaoFlag[CHANNEL_TYPE_LUMA] || (bChroma && bSaoFlag[CHANNEL_TYPE_CHROMA]) )
   {
     if (rx>0 && iCUAddrInSlice!=0 && allowMergeLeft)
     {
@@ -1761,7 +1766,7 @@ Void TDecSbac::parseSaoOneLcuInterleaving(Int rx, Int ry, SAOParam* pSaoParam, T
 
   for (Int iCompIdx=0; iCompIdx<numValidComp; iCompIdx++)
   {
-    if (pSaoParam->bSaoFlag[toChannelType(ComponentID(iCompIdx))])
+    if (bSaoFlag[toChannelType(ComponentID(iCompIdx))])
     {
       if (rx>0 && iCUAddrInSlice!=0 && allowMergeLeft)
       {
@@ -50,6 +50,16 @@ TDecSlice::TDecSlice()
   m_pcBufferBinCABACs    = NULL;
   m_pcBufferLowLatSbacDecoders = NULL;
   m_pcBufferLowLatBinCABACs    = NULL;
+  m_pcThreadPool           = NULL;
+  m_pcSliceWorkers         = NULL;
+  m_pcRowSbacDecoders      = NULL;
+  m_pcRowBinCABACs         = NULL;
+  m_pcParallelPic          = NULL;
+  m_ppcParallelSubstreams  = NULL;
+  m_pcParallelSbacDecoders = NULL;
+  m_iParallelStartCUAddr   = 0;
+  m_bPipelineCTUs          = false;
+  m_pcRowFilter            = NULL;
 }
 
 TDecSlice::~TDecSlice()
@@ -97,12 +107,27 @@ Void TDecSlice::destroy()
     delete[] m_pcBufferLowLatBinCABACs;
     m_pcBufferLowLatBinCABACs = NULL;
   }
+  delete[] m_pcRowSbacDecoders;
+  delete[] m_pcRowBinCABACs;
+  m_pcRowSbacDecoders = NULL;
+  m_pcRowBinCABACs    = NULL;
+  m_cRowProgress.destroy();
+  m_cPipelineProgress.destroy();
+  deleteDeferredSlices();
 }
 
-Void TDecSlice::init(TDecEntropy* pcEntropyDecoder, TDecCu* pcCuDecoder)
+/**
+ \param pcEntropyDecoder entropy decoder of the sequential loop
+ \param pcCuDecoder      CU decoder of the sequential loop
+ \param pcThreadPool     worker threads, used for the CTU rows of wavefront slices and for the tiles of the other slices
+ \param pcSliceWorkers   decoding tools of each thread of the pool
+ */
+Void TDecSlice::init(TDecEntropy* pcEntropyDecoder, TDecCu* pcCuDecoder, TComThreadPool* pcThreadPool, TDecSliceWorker* pcSliceWorkers)
 {
   m_pcEntropyDecoder  = pcEntropyDecoder;
   m_pcCuDecoder       = pcCuDecoder;
+  m_pcThreadPool      = pcThreadPool;
+  m_pcSliceWorkers    = pcSliceWorkers;
 }
 
 Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic*& rpcPic, TDecSbac* pcSbacDecoder, TDecSbac* pcSbacDecoders)
@@ -216,6 +241,13 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic*& rp
       CTXMem[0]->loadContexts(pcSbacDecoder);
     }
   }
+
+  if( xUseParallelRows( rpcPic ) )
+  {
+    xDecompressSliceRows( ppcSubstreams, rpcPic, pcSbacDecoders, iStartCUAddr );
+    return;
+  }
+
   for( Int iCUAddr = iStartCUAddr; !uiIsLast && iCUAddr < rpcPic->getNumCUsInFrame(); iCUAddr = rpcPic->getPicSym()->xCalculateNxtCUAddr(iCUAddr) )
   {
     pcCU = rpcPic->getCU( iCUAddr );
@@ -309,57 +341,7 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic*& rp
 #if ENC_DEC_TRACE
     g_bJustDoIt = g_bEncDecTraceEnable;
 #endif
-    if ( pcSlice->getSPS()->getUseSAO() && (pcSlice->getSaoEnabledFlag()||pcSlice->getSaoEnabledFlagChroma()) )
-    {
-      SAOParam *saoParam = rpcPic->getPicSym()->getSaoParam();
-      saoParam->bSaoFlag[CHANNEL_TYPE_LUMA] = pcSlice->getSaoEnabledFlag();
-      if (iCUAddr == iStartCUAddr)
-      {
-        saoParam->bSaoFlag[CHANNEL_TYPE_CHROMA] = pcSlice->getSaoEnabledFlagChroma();
-      }
-      Int numCuInWidth     = saoParam->numCuInWidth;
-      Int cuAddrInSlice = iCUAddr - rpcPic->getPicSym()->getCUOrderMap(pcSlice->getSliceCurStartCUAddr()/rpcPic->getNumPartInCU());
-      Int cuAddrUpInSlice  = cuAddrInSlice - numCuInWidth;
-      Int rx = iCUAddr % numCuInWidth;
-      Int ry = iCUAddr / numCuInWidth;
-      Int allowMergeLeft = 1;
-      Int allowMergeUp   = 1;
-      if (rx!=0)
-      {
-        if (rpcPic->getPicSym()->getTileIdxMap(iCUAddr-1) != rpcPic->getPicSym()->getTileIdxMap(iCUAddr))
-        {
-          allowMergeLeft = 0;
-        }
-      }
-      if (ry!=0)
-      {
-        if (rpcPic->getPicSym()->getTileIdxMap(iCUAddr-numCuInWidth) != rpcPic->getPicSym()->getTileIdxMap(iCUAddr))
-        {
-          allowMergeUp = 0;
-        }
-      }
-      pcSbacDecoder->parseSaoOneLcuInterleaving(rx, ry, saoParam,pcCU, cuAddrInSlice, cuAddrUpInSlice, allowMergeLeft, allowMergeUp);
-    }
-    else if ( pcSlice->getSPS()->getUseSAO() )
-    {
-      Int addr = pcCU->getAddr();
-      SAOParam *saoParam = rpcPic->getPicSym()->getSaoParam();
-      for (Int cIdx=0; cIdx<3; cIdx++)
-      {
-        SaoLcuParam *saoLcuParam = &(saoParam->saoLcuParam[cIdx][addr]);
-        if ( ((cIdx == 0) && !pcSlice->getSaoEnabledFlag()) || ((cIdx == 1 || cIdx == 2) && !pcSlice->getSaoEnabledFlagChroma()))
-        {
-          saoLcuParam->mergeUpFlag   = 0;
-          saoLcuParam->mergeLeftFlag = 0;
-          saoLcuParam->subTypeIdx    = 0;
-          saoLcuParam->typeIdx       = -1;
-          saoLcuParam->offset[0]     = 0;
-          saoLcuParam->offset[1]     = 0;
-          saoLcuParam->offset[2]     = 0;
-          saoLcuParam->offset[3]     = 0;
-        }
-      }
-    }
+    xDecodeSaoParam( rpcPic, pcCU, pcSbacDecoder );
     m_pcCuDecoder->decodeCU     ( pcCU, uiIsLast );
     m_pcCuDecoder->decompressCU ( pcCU );
 
@@ -395,6 +377,615 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic*& rp
   }
 }
 
+/** Parse the SAO parameters of a CTU, or clear them for the components that do not use SAO in the slice.
+ * \param pcPic         picture being decoded
+ * \param pcCU          CTU being decoded
+ * \param pcSbacDecoder entropy decoder of the substream of the CTU
+ */
+Void TDecSlice::xDecodeSaoParam( TComPic* pcPic, TComDataCU* pcCU, TDecSbac* pcSbacDecoder )
+{
+  TComSlice* pcSlice = pcCU->getSlice();
+  Int        iCUAddr = pcCU->getAddr();
+
+  if ( pcSlice->getSPS()->getUseSAO() && (pcSlice->getSaoEnabledFlag()||pcSlice->getSaoEnabledFlagChroma()) )
+  {
+    SAOParam *saoParam = pcPic->getPicSym()->getSaoParam();
+    Int numCuInWidth     = saoParam->numCuInWidth;
+    Int cuAddrInSlice = iCUAddr - pcPic->getPicSym()->getCUOrderMap(pcSlice->getSliceCurStartCUAddr()/pcPic->getNumPartInCU());
+    Int cuAddrUpInSlice  = cuAddrInSlice - numCuInWidth;
+    Int rx = iCUAddr % numCuInWidth;
+    Int ry = iCUAddr / numCuInWidth;
+    Int allowMergeLeft = 1;
+    Int allowMergeUp   = 1;
+    if (rx!=0)
+    {
+      if (pcPic->getPicSym()->getTileIdxMap(iCUAddr-1) != pcPic->getPicSym()->getTileIdxMap(iCUAddr))
+      {
+        allowMergeLeft = 0;
+      }
+    }
+    if (ry!=0)
+    {
+      if (pcPic->getPicSym()->getTileIdxMap(iCUAddr-numCuInWidth) != pcPic->getPicSym()->getTileIdxMap(iCUAddr))
+      {
+        allowMergeUp = 0;
+      }
+    }
+    pcSbacDecoder->parseSaoOneLcuInterleaving(rx, ry, saoParam,pcCU, cuAddrInSlice, cuAddrUpInSlice, allowMergeLeft, allowMergeUp);
+  }
+  else if ( pcSlice->getSPS()->getUseSAO() )
+  {
+    SAOParam *saoParam = pcPic->getPicSym()->getSaoParam();
+    for (Int cIdx=0; cIdx<3; cIdx++)
+    {
+      SaoLcuParam *saoLcuParam = &(saoParam->saoLcuParam[cIdx][iCUAddr]);
+      if ( ((cIdx == 0) && !pcSlice->getSaoEnabledFlag()) || ((cIdx == 1 || cIdx == 2) && !pcSlice->getSaoEnabledFlagChroma()))
+      {
+        saoLcuParam->mergeUpFlag   = 0;
+        saoLcuParam->mergeLeftFlag = 0;
+        saoLcuParam->subTypeIdx    = 0;
+        saoLcuParam->typeIdx       = -1;
+        saoLcuParam->offset[0]     = 0;
+        saoLcuParam->offset[1]     = 0;
+        saoLcuParam->offset[2]     = 0;
+        saoLcuParam->offset[3]     = 0;
+      }
+    }
+  }
+}
+
+/** Check whether the CTU rows of the current slice can be decoded concurrently.
+ * This requires wavefront substreams in a single tile, without dependent slice segments, whose contexts are carried
+ * over from the previous slice segment.
+ * \param pcPic picture being decoded
+ * \returns true if the rows are decoded by the thread pool
+ */
+Bool TDecSlice::xUseParallelRows( TComPic* pcPic )
+{
+#if ENC_DEC_TRACE || RExt__DECODER_DEBUG_BIT_STATISTICS
+  // the trace and the bit statistics are written in decoding order
+  return false;
+#else
+  TComSlice* pcSlice = pcPic->getSlice(pcPic->getCurrSliceIdx());
+
+  return m_pcThreadPool != NULL
+      && m_pcThreadPool->getNumThreads() > 1
+      && pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag()
+      && pcSlice->getPPS()->getNumSubstreams() > 1
+      && pcSlice->getNumEntryPointOffsets() > 0
+      && pcPic->getPicSym()->getNumTiles() == 1
+      && !pcSlice->getPPS()->getDependentSliceSegmentsEnabledFlag();
+#endif
+}
+
+/** Decode the CTU rows of a wavefront slice with the thread pool.
+ * Each row is parsed from its own substream and reconstructed by one thread with its own decoding tools. A CTU is
+ * started once the CTU above-right of it is reconstructed, and the contexts are inherited from the row above after
+ * its second CTU, as in the sequential loop of decompressSlice().
+ * \param ppcSubstreams  substreams of the slice, one per CTU row
+ * \param pcPic          picture being decoded
+ * \param pcSbacDecoders entropy decoders of the substreams, initialized for the slice
+ * \param iStartCUAddr   first CTU of the slice segment
+ */
+Void TDecSlice::xDecompressSliceRows( TComInputBitstream** ppcSubstreams, TComPic* pcPic, TDecSbac* pcSbacDecoders, Int iStartCUAddr )
+{
+  TComSlice* pcSlice        = pcPic->getSlice(pcPic->getCurrSliceIdx());
+  const UInt uiWidthInLCUs  = pcPic->getFrameWidthInCU();
+  const UInt uiHeightInLCUs = pcPic->getFrameHeightInCU();
+
+  m_pcParallelPic          = pcPic;
+  m_ppcParallelSubstreams  = ppcSubstreams;
+  m_pcParallelSbacDecoders = pcSbacDecoders;
+  m_iParallelStartCUAddr   = iStartCUAddr;
+
+  if ( m_cRowProgress.getNumCounters() != uiHeightInLCUs )
+  {
+    delete[] m_pcRowSbacDecoders;
+    delete[] m_pcRowBinCABACs;
+    m_pcRowSbacDecoders = new TDecSbac    [uiHeightInLCUs];
+    m_pcRowBinCABACs    = new TDecBinCABAC[uiHeightInLCUs];
+    for ( UInt ui = 0; ui < uiHeightInLCUs; ui++ )
+    {
+      m_pcRowSbacDecoders[ui].init( &m_pcRowBinCABACs[ui] );
+    }
+    m_cRowProgress.create( uiHeightInLCUs );
+  }
+  // the CTUs of the first row that precede the slice are decoded
+  m_cRowProgress.reset();
+  m_cRowProgress.set( iStartCUAddr / uiWidthInLCUs, iStartCUAddr % uiWidthInLCUs );
+
+  TComMemberJob<TDecSlice> cRowJob( this, &TDecSlice::xDecompressCTURow );
+  m_pcThreadPool->execute( &cRowJob, pcSlice->getNumEntryPointOffsets()+1 );
+
+  m_pcParallelPic = NULL;
+}
+
+/** Decode the CTUs of one CTU row of the slice (thread pool job).
+ * \param iRowIdx    index of the row within the slice, selects the substream
+ * \param iThreadIdx index of the executing thread, selects the decoding tools
+ */
+Void TDecSlice::xDecompressCTURow( Int iRowIdx, Int iThreadIdx )
+{
+  TComPic*      pcPic            = m_pcParallelPic;
+  TComSlice*    pcSlice          = pcPic->getSlice(pcPic->getCurrSliceIdx());
+  TDecEntropy*  pcEntropyDecoder = m_pcSliceWorkers[iThreadIdx].getEntropyDecoder();
+  TDecCu*       pcCuDecoder      = m_pcSliceWorkers[iThreadIdx].getCuDecoder();
+  TDecSbac*     pcSbacDecoder    = &m_pcParallelSbacDecoders[iRowIdx];
+
+  const UInt uiWidthInLCUs = pcPic->getFrameWidthInCU();
+  const UInt uiMaxParts    = 1<<(pcSlice->getSPS()->getMaxCUDepth()<<1);
+  const UInt uiFirstRow    = m_iParallelStartCUAddr / uiWidthInLCUs;
+  const UInt uiLin         = uiFirstRow + iRowIdx;
+  const UInt uiRowStart    = max( (UInt)m_iParallelStartCUAddr, uiLin * uiWidthInLCUs );
+  const UInt uiRowEnd      = (uiLin + 1) * uiWidthInLCUs;
+  UInt       uiIsLast      = 0;
+
+  pcEntropyDecoder->setEntropyDecoder ( pcSbacDecoder );
+  pcEntropyDecoder->setBitstream      ( m_ppcParallelSubstreams[iRowIdx] );
+
+  for( UInt uiCUAddr = uiRowStart; !uiIsLast && uiCUAddr < uiRowEnd; uiCUAddr++ )
+  {
+    const UInt uiCol = uiCUAddr % uiWidthInLCUs;
+
+    // wait for the CTU above-right
+    if ( uiLin > uiFirstRow )
+    {
+      m_cRowProgress.waitFor( uiLin - 1, min( uiCol + 2, uiWidthInLCUs ) );
+    }
+
+    TComDataCU* pcCU = pcPic->getCU( uiCUAddr );
+    pcCU->initCU( pcPic, uiCUAddr );
+
+    // inherit from TR if it is available
+    if ( uiCol == 0 )
+    {
+      TComDataCU *pcCUTR = NULL;
+      if ( pcCU->getCUAbove() && (uiCol+1 < uiWidthInLCUs) )
+      {
+        pcCUTR = pcPic->getCU( uiCUAddr - uiWidthInLCUs + 1 );
+      }
+      if ( pcCUTR != NULL && pcCUTR->getSlice() != NULL && pcCUTR->getSCUAddr()+uiMaxParts-1 >= pcSlice->getSliceCurStartCUAddr() )
+      {
+        pcSbacDecoder->loadContexts( &m_pcRowSbacDecoders[uiLin-1] );
+      }
+    }
+
+    xDecodeSaoParam( pcPic, pcCU, pcSbacDecoder );
+    pcCuDecoder->decodeCU     ( pcCU, uiIsLast );
+    pcCuDecoder->decompressCU ( pcCU );
+
+    if ( uiCol == uiWidthInLCUs - 1 && !uiIsLast )
+    {
+      // Parse end_of_substream_one_bit for WPP case
+      UInt binVal;
+      pcSbacDecoder->parseTerminatingBit( binVal );
+      assert( binVal );
+    }
+
+    //Store probabilities of second LCU in line into buffer
+    if ( uiCol == 1 )
+    {
+      m_pcRowSbacDecoders[uiLin].loadContexts( pcSbacDecoder );
+    }
+
+    m_cRowProgress.set( uiLin, uiCol + 1 );
+  }
+
+  // do not block the row below if the slice ends inside the row
+  m_cRowProgress.set( uiLin, uiWidthInLCUs );
+}
+
+/** Check whether a slice is collected, to be decoded with the other slices of the picture when the picture is
+ * complete. Without wavefront substreams and dependent slice segments, the slices and the tiles of a picture are
+ * independent up to the loop filters.
+ * \param pcSlice slice being decoded
+ * \returns true if the slice is decoded by decompressDeferredSlices() or decompressDeferredPicture()
+ */
+Bool TDecSlice::canDeferSlice( TComSlice* pcSlice )
+{
+#if ENC_DEC_TRACE || RExt__DECODER_DEBUG_BIT_STATISTICS
+  // the trace and the bit statistics are written in decoding order
+  return false;
+#else
+  return m_pcThreadPool != NULL
+      && m_pcThreadPool->getNumThreads() > 1
+      && !pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag()
+      && !pcSlice->getPPS()->getDependentSliceSegmentsEnabledFlag();
+#endif
+}
+
+/** Collect the current slice, its data is split at the entry points into one substream per tile. The data is
+ * copied once as the NAL unit is released before the slice is decoded, the substreams are views into the copy.
+ * \param pcBitstream slice data, after the slice header
+ * \param pcPic       picture being decoded
+ */
+Void TDecSlice::deferSlice( TComInputBitstream* pcBitstream, TComPic* pcPic )
+{
+  TComSlice*  pcSlice          = pcPic->getSlice(pcPic->getCurrSliceIdx());
+  TComPicSym* pcPicSym         = pcPic->getPicSym();
+  Int         iStartCUEncOrder = max(pcSlice->getSliceCurStartCUAddr(), pcSlice->getSliceSegmentCurStartCUAddr())/pcPic->getNumPartInCU();
+  UInt        uiStartTileIdx   = pcPicSym->getTileIdxMap( pcPicSym->getCUOrderMap(iStartCUEncOrder) );
+  UInt        uiNumTiles       = pcSlice->getPPS()->getTilesEnabledFlag() ? pcSlice->getTileLocationCount()+1 : 1;
+  UInt        uiPrevLocation   = 0;
+
+  TComInputBitstream* pcSliceData = pcBitstream->copySubstream( pcBitstream->getNumBitsLeft() );
+  m_cDeferredSliceData.push_back( pcSliceData );
+
+  for ( UInt ui = 0; ui < uiNumTiles; ui++ )
+  {
+    TDecSliceTile cTile;
+    cTile.pcPic         = pcPic;
+    cTile.pcSlice       = pcSlice;
+    cTile.uiSliceIdx    = pcPic->getCurrSliceIdx();
+    cTile.uiStartCUAddr = ui == 0 ? pcPicSym->getCUOrderMap(iStartCUEncOrder) : pcPicSym->getTComTile(uiStartTileIdx+ui)->getFirstCUAddr();
+    cTile.uiNumCUs      = 0;
+    cTile.iProgressIdx  = 0;
+    if ( ui+1 < uiNumTiles )
+    {
+      cTile.pcSubstream = pcSliceData->extractSubstream( (pcSlice->getTileLocation(ui) - uiPrevLocation) << 3 );
+      uiPrevLocation    = pcSlice->getTileLocation(ui);
+    }
+    else
+    {
+      cTile.pcSubstream = pcSliceData->extractSubstream( pcSliceData->getNumBitsLeft() );
+    }
+    m_cDeferredTiles.push_back( cTile );
+  }
+}
+
+/** Decode the slices collected for a picture with the thread pool, one tile of a slice per job. If there are fewer
+ * tiles than threads, the parsing and the reconstruction of the CTUs are pipelined instead, and the in-loop filters
+ * are applied to the CTU rows while the rows below are reconstructed.
+ * \param pcPic       picture being decoded
+ * \param pcRowFilter in-loop filters of the picture, the rows that are not filtered here are left to the caller
+ */
+Void TDecSlice::decompressDeferredSlices( TComPic* pcPic, TDecRowFilter* pcRowFilter )
+{
+  if ( m_cDeferredTiles.empty() )
+  {
+    return;
+  }
+
+  const UInt uiNumTiles = (UInt)m_cDeferredTiles.size();
+
+  xInitDeferredCUs( pcPic, 0, uiNumTiles );
+
+  if ( m_bPipelineCTUs && uiNumTiles < (UInt)m_pcThreadPool->getNumThreads() )
+  {
+    m_pcRowFilter = pcRowFilter;
+    xDecompressPipelined( 0, uiNumTiles );
+    m_pcRowFilter = NULL;
+  }
+  else
+  {
+    TComMemberJob<TDecSlice> cTileJob( this, &TDecSlice::xDecompressSliceTile );
+    m_pcThreadPool->execute( &cTileJob, uiNumTiles );
+  }
+
+  deleteDeferredSlices();
+}
+
+/** Decode the slices collected for one of the pictures that are decoded at the same time (frame-parallel decoding).
+ * The tiles of the picture are decoded one after the other by the calling thread. The motion compensation waits for
+ * the rows of the reference pictures that are still being decoded by other threads. The CTU rows are filtered as soon
+ * as the rows below them are decoded.
+ * \param pcPic       picture being decoded
+ * \param iThreadIdx  index of the executing thread, selects the decoding tools
+ * \param pcRowFilter in-loop filters of the picture
+ */
+Void TDecSlice::decompressDeferredPicture( TComPic* pcPic, Int iThreadIdx, TDecRowFilter* pcRowFilter )
+{
+  UInt uiFirstTile = 0;
+  while ( uiFirstTile < m_cDeferredTiles.size() && m_cDeferredTiles[uiFirstTile].pcPic != pcPic )
+  {
+    uiFirstTile++;
+  }
+  UInt uiEndTile = uiFirstTile;
+  while ( uiEndTile < m_cDeferredTiles.size() && m_cDeferredTiles[uiEndTile].pcPic == pcPic )
+  {
+    uiEndTile++;
+  }
+
+  xInitDeferredCUs( pcPic, uiFirstTile, uiEndTile );
+
+  TDecCu* pcCuDecoder = m_pcSliceWorkers[iThreadIdx].getCuDecoder();
+  pcCuDecoder->setWaitForReferences( true );
+  for ( UInt ui = uiFirstTile; ui < uiEndTile; ui++ )
+  {
+    xDecodeSliceTile( ui, iThreadIdx, true, pcRowFilter );
+  }
+  pcCuDecoder->setWaitForReferences( false );
+}
+
+/** Release the substreams of the collected tiles and the data of the collected slices.
+ */
+Void TDecSlice::deleteDeferredSlices()
+{
+  for ( UInt ui = 0; ui < m_cDeferredTiles.size(); ui++ )
+  {
+    m_cDeferredTiles[ui].pcSubstream->deleteFifo();
+    delete m_cDeferredTiles[ui].pcSubstream;
+  }
+  m_cDeferredTiles.clear();
+  for ( UInt ui = 0; ui < m_cDeferredSliceData.size(); ui++ )
+  {
+    m_cDeferredSliceData[ui]->deleteFifo();
+    delete m_cDeferredSliceData[ui];
+  }
+  m_cDeferredSliceData.clear();
+}
+
+/** Initialize the CTUs of the collected tiles of a picture in decoding order, so that the slice of a CTU is set when
+ * the neighbouring tiles check its availability.
+ * \param pcPic       picture being decoded
+ * \param uiFirstTile first collected tile of the picture
+ * \param uiEndTile   end of the collected tiles of the picture
+ */
+Void TDecSlice::xInitDeferredCUs( TComPic* pcPic, UInt uiFirstTile, UInt uiEndTile )
+{
+  TComPicSym* pcPicSym       = pcPic->getPicSym();
+  const UInt  uiCurrSliceIdx = pcPic->getCurrSliceIdx();
+
+  // decoder don't need prediction & residual frame buffer
+  pcPic->setPicYuvPred( 0 );
+  pcPic->setPicYuvResi( 0 );
+
+  for ( UInt ui = uiFirstTile; ui < uiEndTile; ui++ )
+  {
+    UInt uiEndCUEncOrder = ui+1 < uiEndTile ? pcPicSym->getInverseCUOrderMap( m_cDeferredTiles[ui+1].uiStartCUAddr ) : pcPic->getNumCUsInFrame();
+
+    pcPic->setCurrSliceIdx( m_cDeferredTiles[ui].uiSliceIdx );
+    for ( UInt uiCUEncOrder = pcPicSym->getInverseCUOrderMap( m_cDeferredTiles[ui].uiStartCUAddr ); uiCUEncOrder < uiEndCUEncOrder; uiCUEncOrder++ )
+    {
+      UInt uiCUAddr = pcPicSym->getCUOrderMap( uiCUEncOrder );
+      pcPic->getCU( uiCUAddr )->initCU( pcPic, uiCUAddr );
+    }
+  }
+  pcPic->setCurrSliceIdx( uiCurrSliceIdx );
+}
+
+/** Decode the CTUs of a slice within one tile (thread pool job).
+ * \param iTileIdx   index of the collected tile
+ * \param iThreadIdx index of the executing thread, selects the decoding tools
+ */
+Void TDecSlice::xDecompressSliceTile( Int iTileIdx, Int iThreadIdx )
+{
+  xDecodeSliceTile( iTileIdx, iThreadIdx, true, NULL );
+}
+
+/** Parse the CTUs of a slice within one tile, and reconstruct them unless this is left to the pipeline.
+ * \param uiTileIdx    index of the collected tile
+ * \param iThreadIdx   index of the executing thread, selects the decoding tools
+ * \param bReconstruct reconstruct each CTU after parsing it, otherwise publish the number of parsed CTUs
+ * \param pcRowFilter  in-loop filters that are told about the reconstructed CTUs, or NULL
+ */
+Void TDecSlice::xDecodeSliceTile( UInt uiTileIdx, Int iThreadIdx, Bool bReconstruct, TDecRowFilter* pcRowFilter )
+{
+  TDecSliceTile&    rcTile           = m_cDeferredTiles[uiTileIdx];
+  TComPic*          pcPic            = rcTile.pcPic;
+  TComPicSym*       pcPicSym         = pcPic->getPicSym();
+  TDecSliceWorker*  pcWorker         = &m_pcSliceWorkers[iThreadIdx];
+  TDecEntropy*      pcEntropyDecoder = pcWorker->getEntropyDecoder();
+  TDecCu*           pcCuDecoder      = pcWorker->getCuDecoder();
+  TDecSbac*         pcSbacDecoder    = pcWorker->getSbacDecoder();
+  TComTile*         pcTile           = pcPicSym->getTComTile( pcPicSym->getTileIdxMap( rcTile.uiStartCUAddr ) );
+  const UInt        uiLastCUAddr     = pcTile->getBottomEdgePosInCU() * pcPic->getFrameWidthInCU() + pcTile->getRightEdgePosInCU();
+  UInt              uiIsLast         = 0;
+  UInt              uiNumParsedCUs   = 0;
+
+  if ( pcWorker->getSlice() != rcTile.pcSlice )
+  {
+    pcWorker->loadSliceSettings( rcTile.pcSlice );
+  }
+
+  pcEntropyDecoder->setEntropyDecoder ( pcSbacDecoder );
+  pcEntropyDecoder->setBitstream      ( rcTile.pcSubstream );
+  pcEntropyDecoder->resetEntropy      ( rcTile.pcSlice );
+
+  for( UInt uiCUAddr = rcTile.uiStartCUAddr; !uiIsLast; uiCUAddr = pcPicSym->xCalculateNxtCUAddr( uiCUAddr ) )
+  {
+    TComDataCU* pcCU = pcPic->getCU( uiCUAddr );
+
+    xDecodeSaoParam( pcPic, pcCU, pcSbacDecoder );
+    pcCuDecoder->decodeCU     ( pcCU, uiIsLast );
+    if ( bReconstruct )
+    {
+      pcCuDecoder->decompressCU ( pcCU );
+      if ( pcRowFilter )
+      {
+        pcRowFilter->setCUDecoded( uiCUAddr );
+      }
+    }
+    else
+    {
+      m_cPipelineProgress.set( rcTile.iProgressIdx, ++uiNumParsedCUs );
+    }
+
+    if ( uiCUAddr == uiLastCUAddr )
+    {
+      if ( !uiIsLast )
+      {
+        // Parse end_of_sub_stream_one_bit of the tile
+        UInt binVal;
+        pcSbacDecoder->parseTerminatingBit( binVal );
+        assert( binVal );
+      }
+      break;
+    }
+  }
+
+  if ( !bReconstruct )
+  {
+    // the end of the slice is known to the reconstruction once the counter is final
+    rcTile.uiNumCUs = uiNumParsedCUs;
+    m_cPipelineProgress.set( rcTile.iProgressIdx, MAX_INT );
+  }
+}
+
+/** Decode collected tiles with a two-stage pipeline. One thread parses the CTUs of a tile into the CU data of the
+ * picture, while other threads reconstruct the parsed CTUs, one CTU row of the tile per job item. As in wavefront
+ * decoding, a CTU is reconstructed once the CTU above-right of it is reconstructed. With in-loop filters to apply, a
+ * last item filters the CTU rows of the picture while the rows below are reconstructed.
+ * \param uiFirstTile first collected tile
+ * \param uiEndTile   end of the collected tiles
+ */
+Void TDecSlice::xDecompressPipelined( UInt uiFirstTile, UInt uiEndTile )
+{
+  Int iNumCounters = 0;
+
+  // the items of a tile are the parsing followed by the CTU rows, so that an item only waits for lower ones
+  m_cPipelineItems.clear();
+  for ( UInt ui = uiFirstTile; ui < uiEndTile; ui++ )
+  {
+    TDecSliceTile& rcTile    = m_cDeferredTiles[ui];
+    TComPicSym*    pcPicSym  = rcTile.pcPic->getPicSym();
+    TComTile*      pcTile    = pcPicSym->getTComTile( pcPicSym->getTileIdxMap( rcTile.uiStartCUAddr ) );
+    const Int      iNumRows  = pcTile->getBottomEdgePosInCU() - rcTile.uiStartCUAddr / rcTile.pcPic->getFrameWidthInCU() + 1;
+
+    rcTile.uiNumCUs     = 0;
+    rcTile.iProgressIdx = iNumCounters;
+    iNumCounters       += 1 + iNumRows;
+
+    for ( Int iRow = -1; iRow < iNumRows; iRow++ )
+    {
+      TDecPipelineItem cItem;
+      cItem.uiTileIdx = ui;
+      cItem.iRow      = iRow;
+      m_cPipelineItems.push_back( cItem );
+    }
+  }
+  if ( m_pcRowFilter != NULL )
+  {
+    // the filtering waits for the reconstruction of all tiles
+    TDecPipelineItem cItem;
+    cItem.uiTileIdx = uiFirstTile;
+    cItem.iRow      = -2;
+    m_cPipelineItems.push_back( cItem );
+  }
+
+  if ( m_cPipelineProgress.getNumCounters() < iNumCounters )
+  {
+    m_cPipelineProgress.create( iNumCounters );
+  }
+  m_cPipelineProgress.reset();
+  for ( UInt ui = uiFirstTile; ui < uiEndTile; ui++ )
+  {
+    // the CTUs of the first row that precede the tile belong to other slices
+    TDecSliceTile& rcTile    = m_cDeferredTiles[ui];
+    TComPicSym*    pcPicSym  = rcTile.pcPic->getPicSym();
+    TComTile*      pcTile    = pcPicSym->getTComTile( pcPicSym->getTileIdxMap( rcTile.uiStartCUAddr ) );
+    const Int      iTileLeft = pcTile->getRightEdgePosInCU() - pcTile->getTileWidth() + 1;
+    m_cPipelineProgress.set( rcTile.iProgressIdx + 1, rcTile.uiStartCUAddr % rcTile.pcPic->getFrameWidthInCU() - iTileLeft );
+  }
+
+  TComMemberJob<TDecSlice> cPipelineJob( this, &TDecSlice::xDecompressPipelineItem );
+  m_pcThreadPool->execute( &cPipelineJob, (Int)m_cPipelineItems.size() );
+}
+
+/** Parse a collected tile, reconstruct one of its CTU rows or filter the picture (thread pool job).
+ * \param iItem      index of the pipeline item
+ * \param iThreadIdx index of the executing thread, selects the decoding tools
+ */
+Void TDecSlice::xDecompressPipelineItem( Int iItem, Int iThreadIdx )
+{
+  const TDecPipelineItem& rcItem = m_cPipelineItems[iItem];
+
+  if ( rcItem.iRow == -2 )
+  {
+    xFilterPipelinedRows( rcItem.uiTileIdx, (UInt)m_cDeferredTiles.size() );
+  }
+  else if ( rcItem.iRow < 0 )
+  {
+    xDecodeSliceTile( rcItem.uiTileIdx, iThreadIdx, false, NULL );
+  }
+  else
+  {
+    xReconstructTileRow( rcItem.uiTileIdx, rcItem.iRow, iThreadIdx );
+  }
+}
+
+/** Reconstruct the CTUs of one CTU row of a collected tile as soon as they are parsed.
+ * \param uiTileIdx  index of the collected tile
+ * \param iRow       CTU row within the tile, 0 is the row of the first CTU
+ * \param iThreadIdx index of the executing thread, selects the decoding tools
+ */
+Void TDecSlice::xReconstructTileRow( UInt uiTileIdx, Int iRow, Int iThreadIdx )
+{
+  TDecSliceTile&    rcTile        = m_cDeferredTiles[uiTileIdx];
+  TComPic*          pcPic         = rcTile.pcPic;
+  TComPicSym*       pcPicSym      = pcPic->getPicSym();
+  TDecSliceWorker*  pcWorker      = &m_pcSliceWorkers[iThreadIdx];
+  TDecCu*           pcCuDecoder   = pcWorker->getCuDecoder();
+  TComTile*         pcTile        = pcPicSym->getTComTile( pcPicSym->getTileIdxMap( rcTile.uiStartCUAddr ) );
+  const Int         iWidthInLCUs  = pcPic->getFrameWidthInCU();
+  const Int         iTileWidth    = pcTile->getTileWidth();
+  const Int         iTileLeft     = pcTile->getRightEdgePosInCU() - iTileWidth + 1;
+  const Int         iStartCol     = rcTile.uiStartCUAddr % iWidthInLCUs;
+  const Int         iLin          = rcTile.uiStartCUAddr / iWidthInLCUs + iRow;
+  const Int         iParseIdx     = rcTile.iProgressIdx;
+  const Int         iRowIdx       = rcTile.iProgressIdx + 1 + iRow;
+
+  if ( pcWorker->getSlice() != rcTile.pcSlice )
+  {
+    pcWorker->loadSliceSettings( rcTile.pcSlice );
+  }
+
+  for ( Int iCol = iRow == 0 ? iStartCol : iTileLeft; iCol < iTileLeft + iTileWidth; iCol++ )
+  {
+    // index of the CTU in the decoding order of the tile
+    const Int iCUIdx = iRow * iTileWidth + iCol - iStartCol;
+
+    // wait until the CTU is parsed, or the slice ended before it
+    m_cPipelineProgress.waitFor( iParseIdx, iCUIdx + 1 );
+    if ( m_cPipelineProgress.get( iParseIdx ) == MAX_INT && iCUIdx >= (Int)rcTile.uiNumCUs )
+    {
+      break;
+    }
+
+    // wait for the CTU above-right
+    if ( iRow > 0 )
+    {
+      m_cPipelineProgress.waitFor( iRowIdx - 1, min( iCol - iTileLeft + 2, iTileWidth ) );
+    }
+
+    pcCuDecoder->decompressCU( pcPic->getCU( iLin * iWidthInLCUs + iCol ) );
+
+    m_cPipelineProgress.set( iRowIdx, iCol - iTileLeft + 1 );
+  }
+
+  // do not block the row below if the slice ends inside the row
+  m_cPipelineProgress.set( iRowIdx, iTileWidth );
+}
+
+/** Apply the in-loop filters to each CTU row of the picture as soon as the rows below it are reconstructed.
+ * \param uiFirstTile first collected tile of the picture
+ * \param uiEndTile   end of the collected tiles of the picture
+ */
+Void TDecSlice::xFilterPipelinedRows( UInt uiFirstTile, UInt uiEndTile )
+{
+  TComPic*    pcPic        = m_cDeferredTiles[uiFirstTile].pcPic;
+  TComPicSym* pcPicSym     = pcPic->getPicSym();
+  const Int   iWidthInLCUs = pcPic->getFrameWidthInCU();
+
+  for ( Int iLin = 0; iLin < (Int)pcPic->getFrameHeightInCU(); iLin++ )
+  {
+    // the CTUs of the picture row belong to the rows of the collected tiles that cover it
+    for ( UInt ui = uiFirstTile; ui < uiEndTile; ui++ )
+    {
+      const TDecSliceTile& rcTile    = m_cDeferredTiles[ui];
+      TComTile*            pcTile    = pcPicSym->getTComTile( pcPicSym->getTileIdxMap( rcTile.uiStartCUAddr ) );
+      const Int            iStartLin = rcTile.uiStartCUAddr / iWidthInLCUs;
+
+      if ( iLin >= iStartLin && iLin <= (Int)pcTile->getBottomEdgePosInCU() )
+      {
+        m_cPipelineProgress.waitFor( rcTile.iProgressIdx + 1 + iLin - iStartLin, pcTile->getTileWidth() );
+      }
+    }
+
+    m_pcRowFilter->filterRows( iLin + 1 );
+  }
+}
+
 ParameterSetManagerDecoder::ParameterSetManagerDecoder()
 : m_vpsBuffer(MAX_NUM_VPS)
 , m_spsBuffer(MAX_NUM_SPS)
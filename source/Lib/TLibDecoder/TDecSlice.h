@@ -45,10 +45,13 @@
 #include "TLibCommon/CommonDef.h"
 #include "TLibCommon/TComBitStream.h"
 #include "TLibCommon/TComPic.h"
+#include "TLibCommon/TComThreadPool.h"
 #include "TDecEntropy.h"
 #include "TDecCu.h"
 #include "TDecSbac.h"
 #include "TDecBinCoderCABAC.h"
+#include "TDecSliceWorker.h"
+#include "TDecRowFilter.h"
 
 //! \ingroup TLibDecoder
 //! \{
@@ -57,6 +60,26 @@
 // Class definition
 // ====================================================================================================================
 
+/// CTUs of a slice within one tile, decoded from their own substream
+struct TDecSliceTile
+{
+  TComPic*              pcPic;                            ///< picture of the CTUs
+  TComSlice*            pcSlice;                          ///< slice of the CTUs
+  UInt                  uiSliceIdx;                       ///< index of the slice in the picture
+  TComInputBitstream*   pcSubstream;                      ///< coded data of the CTUs
+  UInt                  uiStartCUAddr;                    ///< first CTU
+  UInt                  uiNumCUs;                         ///< number of CTUs, set once the tile is parsed (pipelined decoding)
+  Int                   iProgressIdx;                     ///< progress counter of the parsing, followed by those of the CTU rows
+};
+
+/// part of a collected tile processed by one item of the pipelined decoding
+struct TDecPipelineItem
+{
+  UInt                  uiTileIdx;                        ///< index of the collected tile
+  Int                   iRow;                             ///< CTU row within the tile that is reconstructed, -1: parsing,
+                                                          ///< -2: in-loop filtering of the picture
+};
+
 /// slice decoder class
 class TDecSlice
 {
@@ -70,12 +93,34 @@ private:
   TDecSbac*       m_pcBufferLowLatSbacDecoders;   ///< dependent tiles: line to store temporary contexts, one per column of tiles.
   TDecBinCABAC*   m_pcBufferLowLatBinCABACs;
   std::vector<TDecSbac*> CTXMem;
-  
+
+  // parallel wavefront
+  TComThreadPool*       m_pcThreadPool;                   ///< worker threads
+  TDecSliceWorker*      m_pcSliceWorkers;                 ///< CU-level decoding tools of each thread
+  TDecSbac*             m_pcRowSbacDecoders;              ///< contexts after the second CTU of each CTU row
+  TDecBinCABAC*         m_pcRowBinCABACs;
+  TComProgressCounters  m_cRowProgress;                   ///< number of finished CTUs of each CTU row
+  TComPic*              m_pcParallelPic;                  ///< picture being decoded
+  TComInputBitstream**  m_ppcParallelSubstreams;          ///< substreams of the slice
+  TDecSbac*             m_pcParallelSbacDecoders;         ///< entropy decoders of the substreams
+  Int                   m_iParallelStartCUAddr;           ///< first CTU of the slice segment
+
+  // parallel slices and tiles
+  std::vector<TDecSliceTile> m_cDeferredTiles;            ///< tiles of the slices collected for the pictures, in decoding order
+  std::vector<TComInputBitstream*> m_cDeferredSliceData;  ///< copies of the data of the collected slices, the substreams of the tiles are views into them
+
+  // pipelined parsing and reconstruction
+  Bool                  m_bPipelineCTUs;                  ///< parse and reconstruct the CTUs of a tile with different threads
+  std::vector<TDecPipelineItem> m_cPipelineItems;         ///< items of the pipelined decoding
+  TComProgressCounters  m_cPipelineProgress;              ///< number of parsed CTUs of each tile and of reconstructed CTUs of each row
+  TDecRowFilter*        m_pcRowFilter;                    ///< in-loop filters of the picture, applied by the last pipeline item
+
 public:
   TDecSlice();
   virtual ~TDecSlice();
   
-  Void  init              ( TDecEntropy* pcEntropyDecoder, TDecCu* pcMbDecoder );
+  Void  init              ( TDecEntropy* pcEntropyDecoder, TDecCu* pcMbDecoder, TComThreadPool* pcThreadPool = NULL, TDecSliceWorker* pcSliceWorkers = NULL );
+  Void  setPipelineCTUs   ( Bool b ) { m_bPipelineCTUs = b; }
   Void  create            ();
   Void  destroy           ();
   
@@ -83,6 +128,25 @@ public:
   Void      initCtxMem(  UInt i );
   Void      setCtxMem( TDecSbac* sb, Int b )   { CTXMem[b] = sb; }
   Int       getCtxMemSize( )                   { return (Int)CTXMem.size(); }
+
+  Bool  canDeferSlice             ( TComSlice* pcSlice );
+  Void  deferSlice                ( TComInputBitstream* pcBitstream, TComPic* pcPic );
+  Void  decompressDeferredSlices  ( TComPic* pcPic, TDecRowFilter* pcRowFilter );
+  Void  decompressDeferredPicture ( TComPic* pcPic, Int iThreadIdx, TDecRowFilter* pcRowFilter );
+  Void  deleteDeferredSlices      ();
+
+private:
+  Bool  xUseParallelRows      ( TComPic* pcPic );
+  Void  xDecompressSliceRows  ( TComInputBitstream** ppcSubstreams, TComPic* pcPic, TDecSbac* pcSbacDecoders, Int iStartCUAddr );
+  Void  xDecompressCTURow     ( Int iRowIdx, Int iThreadIdx );
+  Void  xInitDeferredCUs      ( TComPic* pcPic, UInt uiFirstTile, UInt uiEndTile );
+  Void  xDecompressSliceTile  ( Int iTileIdx, Int iThreadIdx );
+  Void  xDecodeSliceTile      ( UInt uiTileIdx, Int iThreadIdx, Bool bReconstruct, TDecRowFilter* pcRowFilter );
+  Void  xDecompressPipelined  ( UInt uiFirstTile, UInt uiEndTile );
+  Void  xDecompressPipelineItem ( Int iItem, Int iThreadIdx );
+  Void  xReconstructTileRow   ( UInt uiTileIdx, Int iRow, Int iThreadIdx );
+  Void  xFilterPipelinedRows  ( UInt uiFirstTile, UInt uiEndTile );
+  Void  xDecodeSaoParam       ( TComPic* pcPic, TComDataCU* pcCU, TDecSbac* pcSbacDecoder );
 };
 
 
@@ -0,0 +1,98 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.  
+ *
+ * Copyright (c) 2010-2013, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TDecSliceWorker.h
+    \brief    per-thread decoding tools for parallel slice and picture decoding (header)
+*/
+
+#ifndef __TDECSLICEWORKER__
+#define __TDECSLICEWORKER__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "TLibCommon/CommonDef.h"
+#include "TLibCommon/TComTrQuant.h"
+#include "TLibCommon/TComPrediction.h"
+#include "TLibCommon/TComLoopFilter.h"
+#include "TLibCommon/TComSampleAdaptiveOffset.h"
+#include "TDecEntropy.h"
+#include "TDecSbac.h"
+#include "TDecBinCoderCABAC.h"
+#include "TDecCu.h"
+
+//! \ingroup TLibDecoder
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// private copy of the CU-level decoding tools and of the in-loop filters, so that several CTUs of a slice or several
+/// pictures can be decoded at the same time
+class TDecSliceWorker
+{
+private:
+  TDecCu                  m_cCuDecoder;                   ///< CU decoder
+  TDecEntropy             m_cEntropyDecoder;              ///< entropy decoder, bound to the substream being decoded
+  TComTrQuant             m_cTrQuant;                     ///< transform & quantization class
+  TComPrediction          m_cPrediction;                  ///< prediction class
+  TDecSbac                m_cSbacDecoder;                 ///< entropy decoder of the tiles decoded by the thread
+  TDecBinCABAC            m_cBinCABAC;
+  TComSlice*              m_pcSlice;                      ///< slice whose settings are loaded
+  TComLoopFilter          m_cLoopFilter;                  ///< deblocking filter of the pictures decoded by the thread
+  TComSampleAdaptiveOffset m_cSAO;                        ///< SAO of the pictures decoded by the thread
+
+public:
+  TDecSliceWorker();
+  virtual ~TDecSliceWorker();
+
+  Void    create              ( TComSPS* pcSPS );
+  Void    destroy             ();
+
+  /// take over the quantization matrices of a slice
+  Void    loadSliceSettings   ( TComSlice* pcSlice );
+
+  TDecCu*                 getCuDecoder          () { return &m_cCuDecoder;          }
+  TDecEntropy*            getEntropyDecoder     () { return &m_cEntropyDecoder;     }
+  TDecSbac*               getSbacDecoder        () { return &m_cSbacDecoder;        }
+  TComSlice*              getSlice              () { return m_pcSlice;              }
+  TComLoopFilter*         getLoopFilter         () { return &m_cLoopFilter;         }
+  TComSampleAdaptiveOffset* getSAO              () { return &m_cSAO;                }
+};
+
+//! \}
+
+#endif // __TDECSLICEWORKER__
@@ -64,6 +64,11 @@ TDecTop::TDecTop()
   m_bFirstSliceInSequence   = true;
   m_prevSliceSkipped = false;
   m_skippedPOC = 0;
+  m_iNumThreads = 1;
+  m_pcSliceWorkers = NULL;
+  m_bSliceWorkersCreated = false;
+  m_iNumParallelFrames = 1;
+  m_bParameterSetsReceived = false;
 }
 
 TDecTop::~TDecTop()
@@ -81,6 +86,12 @@ Void TDecTop::create()
   m_cGopDecoder.create();
   m_apcSlicePilot = new TComSlice;
   m_uiSliceIdx = 0;
+
+  if ( m_iNumThreads > 1 )
+  {
+    m_cThreadPool.create( m_iNumThreads );
+    m_pcSliceWorkers = new TDecSliceWorker[m_iNumThreads];
+  }
 }
 
 Void TDecTop::destroy()
@@ -91,14 +102,22 @@ Void TDecTop::destroy()
   m_apcSlicePilot = NULL;
 
   m_cSliceDecoder.destroy();
+
+  m_cThreadPool.destroy();
+  xDestroySliceWorkers();
+  if ( m_pcSliceWorkers )
+  {
+    delete [] m_pcSliceWorkers;
+    m_pcSliceWorkers = NULL;
+  }
 }
 
 Void TDecTop::init()
 {
   // initialize ROM
   initROM();
-  m_cGopDecoder.init( &m_cEntropyDecoder, &m_cSbacDecoder, &m_cBinCABAC, &m_cCavlcDecoder, &m_cSliceDecoder, &m_cLoopFilter, &m_cSAO);
-  m_cSliceDecoder.init( &m_cEntropyDecoder, &m_cCuDecoder );
+  m_cGopDecoder.init( &m_cEntropyDecoder, &m_cSbacDecoder, &m_cBinCABAC, &m_cCavlcDecoder, &m_cSliceDecoder, &m_cLoopFilter, &m_cSAO, &m_cThreadPool, m_pcSliceWorkers );
+  m_cSliceDecoder.init( &m_cEntropyDecoder, &m_cCuDecoder, &m_cThreadPool, m_pcSliceWorkers );
   m_cEntropyDecoder.init(&m_cPrediction);
 }
 
@@ -153,6 +172,10 @@ Void TDecTop::xGetNewPicBuffer ( TComSlice* pcSlice, TComPic*& rpcPic )
   while (iterPic != m_cListPic.end())
   {
     rpcPic = *(iterPic++);
+    if ( xIsPictureInUse( rpcPic ) )
+    {
+      continue;
+    }
     if ( rpcPic->getReconMark() == false && rpcPic->getOutputMark() == false)
     {
       rpcPic->setOutputMark(false);
@@ -183,7 +206,15 @@ Void TDecTop::xGetNewPicBuffer ( TComSlice* pcSlice, TComPic*& rpcPic )
   rpcPic->getPicSym()->allocSaoParam(&m_cSAO);
 }
 
-Void TDecTop::executeLoopFilters(Int& poc, TComList<TComPic*>*& rpcListPic)
+/** Finish the decoding of the current picture.
+ * With frame-parallel decoding, the picture is collected and the collected pictures are decoded together when there
+ * are enough of them or when bFlushParallelFrames is set. The list of pictures can then be used for the output, the
+ * collected pictures are not marked for output yet.
+ * \param poc                  POC of the current picture
+ * \param rpcListPic           list of decoded pictures
+ * \param bFlushParallelFrames decode all collected pictures (end of the bitstream or flush of the output)
+ */
+Void TDecTop::executeLoopFilters(Int& poc, TComList<TComPic*>*& rpcListPic, Bool bFlushParallelFrames)
 {
   if (!m_pcPic)
   {
@@ -193,19 +224,115 @@ Void TDecTop::executeLoopFilters(Int& poc, TComList<TComPic*>*& rpcListPic)
 
   TComPic*&   pcPic         = m_pcPic;
 
-  // Execute Deblock + Cleanup
+  if ( m_iNumParallelFrames > 1 && m_cSliceDecoder.canDeferSlice( pcPic->getSlice(m_uiSliceIdx-1) ) )
+  {
+    // the border of the collected picture is extended row by row while it is decoded
+    pcPic->resetFilteredRows();
+    pcPic->getPicYuvRec()->setBorderExtension( true );
+    m_cParallelFrames.push_back( pcPic );
+    m_cParallelFramesReferenced.push_back( pcPic->getSlice(pcPic->getCurrSliceIdx())->isReferenced() );
 
-  m_cGopDecoder.filterPicture(pcPic);
+    if ( (Int)m_cParallelFrames.size() == m_iNumParallelFrames || bFlushParallelFrames )
+    {
+      xDecodeParallelFrames();
+    }
+  }
+  else
+  {
+    // decode the slices collected for parallel decoding
+    m_cGopDecoder.decompressDeferredSlices(pcPic);
+
+    // Execute Deblock + Cleanup
+
+    m_cGopDecoder.filterPicture(pcPic);
+  }
 
   TComSlice::sortPicList( m_cListPic ); // sorting for application output
   poc                 = pcPic->getSlice(m_uiSliceIdx-1)->getPOC();
   rpcListPic          = &m_cListPic;
   m_cCuDecoder.destroy();
+  if ( m_cParallelFrames.empty() )
+  {
+    xDestroySliceWorkers();
+  }
   m_bFirstSliceInPicture  = true;
 
   return;
 }
 
+/** Decode the pictures collected for frame-parallel decoding.
+ */
+Void TDecTop::xDecodeParallelFrames()
+{
+  if ( m_cParallelFrames.empty() )
+  {
+    return;
+  }
+
+  m_cGopDecoder.decompressPictures( m_cParallelFrames, m_cParallelFramesReferenced );
+  m_cParallelFrames.clear();
+  m_cParallelFramesReferenced.clear();
+  xDestroySliceWorkers();
+}
+
+/** Check whether a picture buffer is needed for the decoding of the collected pictures.
+ * \param pcPic picture buffer
+ * \returns true if the picture is collected or referenced by a collected picture
+ */
+Bool TDecTop::xIsPictureInUse( TComPic* pcPic )
+{
+  for ( UInt ui = 0; ui < m_cParallelFrames.size(); ui++ )
+  {
+    TComPic* pcCollectedPic = m_cParallelFrames[ui];
+    if ( pcCollectedPic == pcPic )
+    {
+      return true;
+    }
+    for ( UInt uiSliceIdx = 0; uiSliceIdx < pcCollectedPic->getNumAllocatedSlice(); uiSliceIdx++ )
+    {
+      TComSlice* pcSlice = pcCollectedPic->getSlice( uiSliceIdx );
+      for ( Int iRefList = 0; iRefList < NUM_REF_PIC_LIST_01; iRefList++ )
+      {
+        for ( Int iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx( RefPicList( iRefList ) ); iRefIdx++ )
+        {
+          if ( pcSlice->getRefPic( RefPicList( iRefList ), iRefIdx ) == pcPic )
+          {
+            return true;
+          }
+        }
+      }
+    }
+  }
+  return false;
+}
+
+/** Set up the decoding tools of the threads for the pictures of a sequence.
+ * \param pcSPS active sequence parameter set
+ */
+Void TDecTop::xCreateSliceWorkers( TComSPS* pcSPS )
+{
+  if ( m_pcSliceWorkers && !m_bSliceWorkersCreated )
+  {
+    for ( Int iThread = 0; iThread < m_iNumThreads; iThread++ )
+    {
+      m_pcSliceWorkers[iThread].create( pcSPS );
+    }
+    m_bSliceWorkersCreated = true;
+  }
+}
+
+Void TDecTop::xDestroySliceWorkers()
+{
+  if ( m_bSliceWorkersCreated )
+  {
+    for ( Int iThread = 0; iThread < m_iNumThreads; iThread++ )
+    {
+      m_pcSliceWorkers[iThread].destroy();
+    }
+    m_bSliceWorkersCreated = false;
+  }
+}
+
 Void TDecTop::xCreateLostPicture(Int iLostPoc)
 {
   printf("\ninserting lost poc : %d\n",iLostPoc);
@@ -258,6 +385,12 @@ Void TDecTop::xCreateLostPicture(Int iLostPoc)
 
 Void TDecTop::xActivateParameterSets()
 {
+  if ( m_bParameterSetsReceived )
+  {
+    // the parameter sets of the collected pictures may be replaced
+    xDecodeParallelFrames();
+    m_bParameterSetsReceived = false;
+  }
   m_parameterSetManagerDecoder.applyPrefetchedPS();
 
   TComPPS *pps = m_parameterSetManagerDecoder.getPPS(m_apcSlicePilot->getPPSId());
@@ -413,10 +546,19 @@ Bool TDecTop::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisp
   Int lostPoc;
   while((lostPoc=m_apcSlicePilot->checkThatAllRefPicsAreAvailable(m_cListPic, m_apcSlicePilot->getRPS(), true, m_pocRandomAccess)) > 0)
   {
+    // the lost picture is copied from a decoded one
+    xDecodeParallelFrames();
     xCreateLostPicture(lostPoc-1);
   }
   if (m_bFirstSliceInPicture)
   {
+    // a picture that is not collected for frame-parallel decoding is decoded after the collected ones
+    if ( !m_cParallelFrames.empty() && !m_cSliceDecoder.canDeferSlice( m_apcSlicePilot ) )
+    {
+      xDecodeParallelFrames();
+    }
+
+
     // Buffer initialize for prediction.
     m_cPrediction.initTempBuff(m_apcSlicePilot->getSPS()->getChromaFormatIdc());
     m_apcSlicePilot->applyReferencePictureSet(m_cListPic, m_apcSlicePilot->getRPS());
@@ -452,6 +594,8 @@ Bool TDecTop::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisp
     m_cTrQuant.init     ( g_uiMaxCUWidth, g_uiMaxCUHeight, m_apcSlicePilot->getSPS()->getMaxTrSize());
 
     m_cSliceDecoder.create();
+
+    xCreateSliceWorkers( m_apcSlicePilot->getSPS() );
   }
   else
   {
@@ -643,6 +787,13 @@ Bool TDecTop::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisp
     m_cTrQuant.setFlatScalingList(pcSlice->getSPS()->getChromaFormatIdc());
     m_cTrQuant.setUseScalingList(false);
   }
+  if ( m_pcSliceWorkers )
+  {
+    for ( Int iThread = 0; iThread < m_iNumThreads; iThread++ )
+    {
+      m_pcSliceWorkers[iThread].loadSliceSettings( pcSlice );
+    }
+  }
 
   //  Decode a picture
   m_cGopDecoder.decompressSlice(nalu.m_Bitstream, pcPic);
@@ -688,6 +839,7 @@ Void TDecTop::xDecodeSEI( TComInputBitstream* bs, const NalUnitType nalUnitType
     if (activeParamSets.size()>0)
     {
       SEIActiveParameterSets *seiAps = (SEIActiveParameterSets*)(*activeParamSets.begin());
+      xDecodeParallelFrames();
       m_parameterSetManagerDecoder.applyPrefetchedPS();
       assert(seiAps->activeSeqParamSetId.size()>0);
       if (! m_parameterSetManagerDecoder.activateSPSWithSEI(seiAps->activeSeqParamSetId[0] ))
@@ -708,6 +860,7 @@ Bool TDecTop::decode(InputNALUnit& nalu, Int& iSkipFrame, Int& iPOCLastDisplay)
   {
     case NAL_UNIT_VPS:
       xDecodeVPS();
+      m_bParameterSetsReceived = true;
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
       TComCodingStatistics::IncrementStatisticEP(STATS__BYTE_ALIGNMENT_BITS,nalu.m_Bitstream->readByteAlignment(),0);
 #endif
@@ -715,6 +868,7 @@ Bool TDecTop::decode(InputNALUnit& nalu, Int& iSkipFrame, Int& iPOCLastDisplay)
 
     case NAL_UNIT_SPS:
       xDecodeSPS();
+      m_bParameterSetsReceived = true;
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
       TComCodingStatistics::IncrementStatisticEP(STATS__BYTE_ALIGNMENT_BITS,nalu.m_Bitstream->readByteAlignment(),0);
 #endif
@@ -722,6 +876,7 @@ Bool TDecTop::decode(InputNALUnit& nalu, Int& iSkipFrame, Int& iPOCLastDisplay)
 
     case NAL_UNIT_PPS:
       xDecodePPS();
+      m_bParameterSetsReceived = true;
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
       TComCodingStatistics::IncrementStatisticEP(STATS__BYTE_ALIGNMENT_BITS,nalu.m_Bitstream->readByteAlignment(),0);
 #endif
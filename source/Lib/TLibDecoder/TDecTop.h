@@ -44,11 +44,13 @@
 #include "TLibCommon/TComPic.h"
 #include "TLibCommon/TComTrQuant.h"
 #include "TLibCommon/SEI.h"
+#include "TLibCommon/TComThreadPool.h"
 
 #include "TDecGop.h"
 #include "TDecEntropy.h"
 #include "TDecSbac.h"
 #include "TDecCAVLC.h"
+#include "TDecSliceWorker.h"
 #include "SEIread.h"
 
 struct InputNALUnit;
@@ -90,6 +92,18 @@ private:
   TComLoopFilter          m_cLoopFilter;
   TComSampleAdaptiveOffset m_cSAO;
 
+  // parallel decoding
+  Int                     m_iNumThreads;                  ///< number of decoder threads (0 or 1: single-threaded)
+  TComThreadPool          m_cThreadPool;                  ///< worker threads
+  TDecSliceWorker*        m_pcSliceWorkers;               ///< CU-level decoding tools, one set per thread
+  Bool                    m_bSliceWorkersCreated;         ///< the tools of the threads are set up for the active SPS
+
+  // frame-parallel decoding
+  Int                     m_iNumParallelFrames;           ///< maximum number of pictures decoded at the same time
+  std::vector<TComPic*>   m_cParallelFrames;              ///< pictures collected for decoding, in decoding order
+  std::vector<Bool>       m_cParallelFramesReferenced;    ///< reference marking of the collected pictures when they were collected
+  Bool                    m_bParameterSetsReceived;       ///< parameter sets that may replace the ones of the collected pictures
+
   Bool isSkipPictureForBLA(Int& iPOCLastDisplay);
   Bool isRandomAccessSkipPicture(Int& iSkipFrame,  Int& iPOCLastDisplay);
   TComPic*                m_pcPic;
@@ -108,17 +122,26 @@ public:
   Void  destroy ();
 
   void setDecodedPictureHashSEIEnabled(Int enabled) { m_cGopDecoder.setDecodedPictureHashSEIEnabled(enabled); }
+  Void  setNumThreads ( Int i ) { m_iNumThreads = i; }
+  Void  setNumParallelFrames ( Int i ) { m_iNumParallelFrames = i; }
+  Void  setPipelineCTUs ( Bool b ) { m_cSliceDecoder.setPipelineCTUs( b ); }
+  Void  setLazyBorderExtension ( Bool b ) { m_cGopDecoder.setLazyBorderExtension( b ); }
 
   Void  init();
   Bool  decode(InputNALUnit& nalu, Int& iSkipFrame, Int& iPOCLastDisplay);
   
   Void  deletePicBuffer();
 
-  Void executeLoopFilters(Int& poc, TComList<TComPic*>*& rpcListPic);
+  Void executeLoopFilters(Int& poc, TComList<TComPic*>*& rpcListPic, Bool bFlushParallelFrames);
 
 protected:
   Void  xGetNewPicBuffer  (TComSlice* pcSlice, TComPic*& rpcPic);
   Void  xCreateLostPicture (Int iLostPOC);
+  Bool  xIsPictureInUse    ( TComPic* pcPic );
+
+  Void  xCreateSliceWorkers  ( TComSPS* pcSPS );
+  Void  xDestroySliceWorkers ();
+  Void  xDecodeParallelFrames();
 
   Void      xActivateParameterSets();
   Bool      xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisplay);
@@ -90,29 +90,46 @@ void write(ostream& out, OutputNALUnit& nalu)
   // NOTE: RExt - New RBSP emulation prevention 3 method - the original method is OK, if the number of
   //              insertions is small, but very wasteful for long NAL units with lots of insertions.
   //              We'll just make a temporary work area.
+  //              An emulation_prevention_three_byte can only follow a pair of zero bytes, so the runs of bytes
+  //              in between are found with findZeroBytePair() and appended as a whole.
   vector<uint8_t> outputBuffer;
-  outputBuffer.resize(rbsp.size()*2+1); //there can never be enough emulation_prevention_three_bytes to require this much space
-  std::size_t outputAmount = 0;
-  int         zeroCount    = 0;
-  for (vector<uint8_t>::iterator it = rbsp.begin(); it != rbsp.end(); it++)
+  outputBuffer.reserve(rbsp.size() + rbsp.size()/2 + 1); //there can never be more than one emulation_prevention_three_byte per two bytes
+  if (!rbsp.empty())
   {
-    const uint8_t v=(*it);
-    if (zeroCount==2 && v<=3)
+    const UChar* const rbspBegin = &rbsp[0];
+    const UChar* const rbspEnd   = rbspBegin + rbsp.size();
+    const UChar*       runBegin  = rbspBegin;
+    for (const UChar* p = rbspBegin; ; )
     {
-      outputBuffer[outputAmount++]=emulation_prevention_three_byte[0];
-      zeroCount=0;
+      p = findZeroBytePair(p, rbspEnd);
+      if (rbspEnd - p <= 2)
+      {
+        break;
+      }
+      p += 2;
+      if (*p <= 3)
+      {
+        outputBuffer.insert(outputBuffer.end(), runBegin, p);
+        outputBuffer.push_back(emulation_prevention_three_byte[0]);
+        runBegin = p;
+      }
+    }
+    outputBuffer.insert(outputBuffer.end(), runBegin, rbspEnd);
+
+    /* 7.4.1.1
+     * ... when the last byte of the RBSP data is equal to 0x00 (which can
+     * only occur when the RBSP ends in a cabac_zero_word), a final byte equal
+     * to 0x03 is appended to the end of the data.
+     */
+    if (rbsp.back() == 0x00)
+    {
+      outputBuffer.push_back(emulation_prevention_three_byte[0]);
     }
-    if (v==0) zeroCount++; else zeroCount=0;
-    outputBuffer[outputAmount++]=v;
   }
-  
-  /* 7.4.1.1
-   * ... when the last byte of the RBSP data is equal to 0x00 (which can
-   * only occur when the RBSP ends in a cabac_zero_word), a final byte equal
-   * to 0x03 is appended to the end of the data.
-   */
-  if (zeroCount>0) outputBuffer[outputAmount++]=emulation_prevention_three_byte[0];
-  out.write((Char*)&(*outputBuffer.begin()), outputAmount);
+  if (!outputBuffer.empty())
+  {
+    out.write((Char*)&outputBuffer[0], outputBuffer.size());
+  }
 #else
 
   for (vector<uint8_t>::iterator it = rbsp.begin(); it != rbsp.end();)
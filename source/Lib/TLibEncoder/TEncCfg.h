@@ -247,6 +247,8 @@ protected:
 
   Int       m_iWaveFrontSynchro;
   Int       m_iWaveFrontSubstreams;
+  Int       m_iNumThreads;                               ///< number of encoder threads (0 or 1: single-threaded)
+  Int       m_iNumParallelFrames;                        ///< number of pictures of a GOP that may be compressed at the same time
 
   Int       m_decodedPictureHashSEIEnabled;              ///< Checksum(3)/CRC(2)/MD5(1)/disable(0) acting on decoded picture hash SEI message
   Int       m_bufferingPeriodSEIEnabled;
@@ -500,6 +502,7 @@ public:
   //==== Motion search ========
   Int       getFastSearch                   ()      { return  m_iFastSearch; }
   Int       getSearchRange                  ()      { return  m_iSearchRange; }
+  Int       getBipredSearchRange            ()      { return  m_bipredSearchRange; }
 
   //==== Quality control ========
   Int       getMaxDeltaQP                   ()      { return  m_iMaxDeltaQP; }
@@ -641,6 +644,10 @@ public:
   Int   getWaveFrontsynchro()                            { return m_iWaveFrontSynchro; }
   Void  setWaveFrontSubstreams(Int iWaveFrontSubstreams) { m_iWaveFrontSubstreams = iWaveFrontSubstreams; }
   Int   getWaveFrontSubstreams()                         { return m_iWaveFrontSubstreams; }
+  Void  setNumThreads(Int i)                             { m_iNumThreads = i; }
+  Int   getNumThreads()                                  { return m_iNumThreads; }
+  Void  setNumParallelFrames(Int i)                      { m_iNumParallelFrames = i; }
+  Int   getNumParallelFrames()                           { return m_iNumParallelFrames; }
   Void  setDecodedPictureHashSEIEnabled(Int b)           { m_decodedPictureHashSEIEnabled = b; }
   Int   getDecodedPictureHashSEIEnabled()                { return m_decodedPictureHashSEIEnabled; }
   Void  setBufferingPeriodSEIEnabled(Int b)              { m_bufferingPeriodSEIEnabled = b; }
@@ -205,23 +205,39 @@ Void TEncCu::destroy()
 /** \param    pcEncTop      pointer of encoder class
  */
 Void TEncCu::init( TEncTop* pcEncTop )
+{
+  init( pcEncTop, pcEncTop->getPredSearch(), pcEncTop->getTrQuant(), pcEncTop->getRdCost(),
+        pcEncTop->getEntropyCoder(), pcEncTop->getRDSbacCoder(), pcEncTop->getRDGoOnSbacCoder() );
+}
+
+/** \param    pcEncTop           pointer of encoder class
+ *  \param    pcPredSearch       encoder search class
+ *  \param    pcTrQuant          transform & quantization class
+ *  \param    pcRdCost           RD cost computation class
+ *  \param    pcEntropyCoder     entropy encoder
+ *  \param    pppcRDSbacCoder    storage for SBAC-based RD optimization
+ *  \param    pcRDGoOnSbacCoder  go-on SBAC encoder
+ */
+Void TEncCu::init( TEncTop* pcEncTop, TEncSearch* pcPredSearch, TComTrQuant* pcTrQuant, TComRdCost* pcRdCost,
+                   TEncEntropy* pcEntropyCoder, TEncSbac*** pppcRDSbacCoder, TEncSbac* pcRDGoOnSbacCoder )
 {
   m_pcEncCfg           = pcEncTop;
-  m_pcPredSearch       = pcEncTop->getPredSearch();
-  m_pcTrQuant          = pcEncTop->getTrQuant();
+  m_pcPredSearch       = pcPredSearch;
+  m_pcTrQuant          = pcTrQuant;
   m_pcBitCounter       = pcEncTop->getBitCounter();
-  m_pcRdCost           = pcEncTop->getRdCost();
+  m_pcRdCost           = pcRdCost;
 
-  m_pcEntropyCoder     = pcEncTop->getEntropyCoder();
+  m_pcEntropyCoder     = pcEntropyCoder;
   m_pcCavlcCoder       = pcEncTop->getCavlcCoder();
   m_pcSbacCoder        = pcEncTop->getSbacCoder();
   m_pcBinCABAC         = pcEncTop->getBinCABAC();
 
-  m_pppcRDSbacCoder    = pcEncTop->getRDSbacCoder();
-  m_pcRDGoOnSbacCoder  = pcEncTop->getRDGoOnSbacCoder();
+  m_pppcRDSbacCoder    = pppcRDSbacCoder;
+  m_pcRDGoOnSbacCoder  = pcRDGoOnSbacCoder;
 
   m_bUseSBACRD         = pcEncTop->getUseSBACRD();
   m_pcRateCtrl         = pcEncTop->getRateCtrl();
+  m_pcSliceBitsMutex   = NULL;
 }
 
 // ====================================================================================================================
@@ -253,7 +269,8 @@ Void TEncCu::compressCU( TComDataCU*& rpcCU )
   {
     if(rpcCU->getSlice()->getSliceType()!=I_SLICE) //IIII
     {
-      xLcuCollectARLStats( rpcCU);
+      // the best CU holds the same data as the CTU of the picture, which has no ARL buffer
+      xLcuCollectARLStats( m_ppcBestCU[0] );
     }
   }
 #endif
@@ -1064,8 +1081,16 @@ Void TEncCu::finishCU( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiDepth )
   }
   if(granularityBoundary)
   {
+    if (m_pcSliceBitsMutex)
+    {
+      m_pcSliceBitsMutex->lock();
+    }
     pcSlice->setSliceBits( (UInt)(pcSlice->getSliceBits() + numberOfWrittenBits) );
     pcSlice->setSliceSegmentBits(pcSlice->getSliceSegmentBits()+numberOfWrittenBits);
+    if (m_pcSliceBitsMutex)
+    {
+      m_pcSliceBitsMutex->unlock();
+    }
     if (m_pcBitCounter)
     {
       m_pcEntropyCoder->resetBits();
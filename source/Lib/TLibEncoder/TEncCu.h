@@ -45,6 +45,7 @@
 #include "TLibCommon/TComTrQuant.h"
 #include "TLibCommon/TComBitCounter.h"
 #include "TLibCommon/TComDataCU.h"
+#include "TLibCommon/TComThreadPool.h"
 
 #include "TEncEntropy.h"
 #include "TEncSearch.h"
@@ -98,6 +99,7 @@ private:
   TEncSbac*               m_pcRDGoOnSbacCoder;
   Bool                    m_bUseSBACRD;
   TEncRateCtrl*           m_pcRateCtrl;
+  TComMutex*              m_pcSliceBitsMutex; ///< guards the slice bit counts when CTUs are encoded concurrently
 #if RATE_CONTROL_LAMBDA_DOMAIN && !M0036_RC_IMPROVEMENT
   Distortion              m_LCUPredictionSAD;
   Int                     m_addSADDepth;
@@ -107,6 +109,10 @@ public:
   /// copy parameters from encoder class
   Void  init                ( TEncTop* pcEncTop );
 
+  /// set up with the given (e.g. per-thread) coding tools instead of the ones owned by the encoder class
+  Void  init                ( TEncTop* pcEncTop, TEncSearch* pcPredSearch, TComTrQuant* pcTrQuant, TComRdCost* pcRdCost,
+                              TEncEntropy* pcEntropyCoder, TEncSbac*** pppcRDSbacCoder, TEncSbac* pcRDGoOnSbacCoder );
+
   /// create internal buffers
   Void  create              ( UChar uhTotalDepth, UInt iMaxWidth, UInt iMaxHeight, ChromaFormat chromaFormat );
 
@@ -120,6 +126,7 @@ public:
   Void  encodeCU            ( TComDataCU*    pcCU );
 
   Void setBitCounter        ( TComBitCounter* pcBitCounter ) { m_pcBitCounter = pcBitCounter; }
+  Void setSliceBitsMutex    ( TComMutex* pcMutex ) { m_pcSliceBitsMutex = pcMutex; }
 #if RATE_CONTROL_LAMBDA_DOMAIN && !M0036_RC_IMPROVEMENT
   Distortion getLCUPredictionSAD() { return m_LCUPredictionSAD; }
 #endif
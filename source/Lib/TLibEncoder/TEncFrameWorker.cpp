@@ -0,0 +1,143 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.  
+ *
+ * Copyright (c) 2010-2013, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncFrameWorker.cpp
+    \brief    per-picture coding tools for parallel picture encoding
+*/
+
+#include "TEncFrameWorker.h"
+#include "TEncTop.h"
+
+//! \ingroup TLibEncoder
+//! \{
+
+// ====================================================================================================================
+// Constructor / destructor / create / destroy
+// ====================================================================================================================
+
+TEncFrameWorker::TEncFrameWorker()
+: m_iNumSubstreams      ( 0 )
+, m_pcBitCounters       ( NULL )
+, m_ppppcRDSbacCoders   ( NULL )
+, m_ppppcBinCodersCABAC ( NULL )
+{
+}
+
+TEncFrameWorker::~TEncFrameWorker()
+{
+}
+
+/** \param pcEncTop pointer of encoder class (provides the configuration)
+ */
+Void TEncFrameWorker::create( TEncTop* pcEncTop )
+{
+  m_cSliceEncoder.create( pcEncTop->getSourceWidth(), pcEncTop->getSourceHeight(), pcEncTop->getChromaFormatIdc(), g_uiMaxCUWidth, g_uiMaxCUHeight, g_uiMaxCUDepth );
+  m_cTools.create( pcEncTop->getChromaFormatIdc() );
+}
+
+Void TEncFrameWorker::destroy()
+{
+  m_cSliceEncoder.destroy();
+  m_cTools.destroy();
+
+  for ( UInt ui = 0; ui < m_iNumSubstreams; ui++ )
+  {
+    for ( Int iDepth = 0; iDepth < g_uiMaxCUDepth+1; iDepth++ )
+    {
+      for (Int iCIIdx = 0; iCIIdx < CI_NUM; iCIIdx ++ )
+      {
+        delete m_ppppcRDSbacCoders  [ui][iDepth][iCIIdx];
+        delete m_ppppcBinCodersCABAC[ui][iDepth][iCIIdx];
+      }
+      delete [] m_ppppcRDSbacCoders  [ui][iDepth];
+      delete [] m_ppppcBinCodersCABAC[ui][iDepth];
+    }
+    delete[] m_ppppcRDSbacCoders  [ui];
+    delete[] m_ppppcBinCodersCABAC[ui];
+  }
+  delete[] m_ppppcRDSbacCoders;
+  delete[] m_ppppcBinCodersCABAC;
+  delete[] m_pcBitCounters;
+  m_ppppcRDSbacCoders   = NULL;
+  m_ppppcBinCodersCABAC = NULL;
+  m_pcBitCounters       = NULL;
+  m_iNumSubstreams      = 0;
+}
+
+/** \param pcEncTop pointer of encoder class (provides the configuration)
+ */
+Void TEncFrameWorker::init( TEncTop* pcEncTop )
+{
+  m_cTools.init( pcEncTop );
+  m_cSliceEncoder.init( pcEncTop, &m_cTools, &m_cCavlcCoder );
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** \param iNumSubstreams Determines how much information to allocate.
+ */
+Void TEncFrameWorker::createWPPCoders( Int iNumSubstreams )
+{
+  if ( m_pcBitCounters != NULL )
+  {
+    return; // already generated.
+  }
+
+  m_iNumSubstreams      = iNumSubstreams;
+  m_pcBitCounters       = new TComBitCounter  [iNumSubstreams];
+  m_ppppcRDSbacCoders   = new TEncSbac***     [iNumSubstreams];
+  m_ppppcBinCodersCABAC = new TEncBinCABAC*** [iNumSubstreams];
+  for ( UInt ui = 0 ; ui < iNumSubstreams ; ui++ )
+  {
+    m_ppppcRDSbacCoders[ui]  = new TEncSbac** [g_uiMaxCUDepth+1];
+    m_ppppcBinCodersCABAC[ui]= new TEncBinCABAC** [g_uiMaxCUDepth+1];
+
+    for ( Int iDepth = 0; iDepth < g_uiMaxCUDepth+1; iDepth++ )
+    {
+      m_ppppcRDSbacCoders[ui][iDepth]  = new TEncSbac*     [CI_NUM];
+      m_ppppcBinCodersCABAC[ui][iDepth]= new TEncBinCABAC* [CI_NUM];
+
+      for (Int iCIIdx = 0; iCIIdx < CI_NUM; iCIIdx ++ )
+      {
+        m_ppppcRDSbacCoders  [ui][iDepth][iCIIdx] = new TEncSbac;
+        m_ppppcBinCodersCABAC[ui][iDepth][iCIIdx] = new TEncBinCABAC;
+        m_ppppcRDSbacCoders  [ui][iDepth][iCIIdx]->init( m_ppppcBinCodersCABAC[ui][iDepth][iCIIdx] );
+      }
+    }
+  }
+  m_cSliceEncoder.setWPPCoders( m_ppppcRDSbacCoders, m_pcBitCounters );
+}
+
+//! \}
@@ -0,0 +1,85 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.  
+ *
+ * Copyright (c) 2010-2013, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncFrameWorker.h
+    \brief    per-picture coding tools for parallel picture encoding (header)
+*/
+
+#ifndef __TENCFRAMEWORKER__
+#define __TENCFRAMEWORKER__
+
+// Include files
+#include "TLibCommon/CommonDef.h"
+#include "TEncSlice.h"
+#include "TEncSliceWorker.h"
+#include "TEncCavlc.h"
+
+//! \ingroup TLibEncoder
+//! \{
+
+class TEncTop;
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// private slice encoder and coding tools, so that several pictures of a GOP can be compressed at the same time
+class TEncFrameWorker
+{
+private:
+  TEncSlice               m_cSliceEncoder;                ///< slice encoder
+  TEncSliceWorker         m_cTools;                       ///< CU-level coding tools of the slice encoder
+  TEncCavlc               m_cCavlcCoder;                  ///< CAVLC encoder
+  Int                     m_iNumSubstreams;               ///< # of top-level elements allocated.
+  TComBitCounter*         m_pcBitCounters;                ///< bit counters for RD optimization per substream
+  TEncSbac****            m_ppppcRDSbacCoders;            ///< temporal storage for RD computation per substream
+  TEncBinCABAC****        m_ppppcBinCodersCABAC;          ///< temporal CABAC state storage for RD computation per substream
+
+public:
+  TEncFrameWorker();
+  virtual ~TEncFrameWorker();
+
+  Void    create              ( TEncTop* pcEncTop );
+  Void    destroy             ();
+  Void    init                ( TEncTop* pcEncTop );
+
+  /// allocate the RD coders of the substreams, as TEncTop::createWPPCoders() does for the main slice encoder
+  Void    createWPPCoders     ( Int iNumSubstreams );
+
+  TEncSlice*              getSliceEncoder       () { return &m_cSliceEncoder;       }
+  TEncSliceWorker*        getTools              () { return &m_cTools;              }
+};
+
+//! \}
+
+#endif // __TENCFRAMEWORKER__
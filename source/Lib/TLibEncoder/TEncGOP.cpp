@@ -369,601 +369,55 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
   UInt *accumBitsDU = NULL;
   UInt *accumNalsDU = NULL;
   SEIDecodingUnitInfo decodingUnitInfoSEI;
-  for ( Int iGOPid=0; iGOPid < m_iGopSize; iGOPid++ )
+  for ( Int iGOPid=0; iGOPid < m_iGopSize || !m_cPicturesInFlight.empty(); )
   {
-    UInt uiColDir = 1;
-    //-- For time output for each slice
-    long iBeforeTime = clock();
-
-    //select uiColDir
-    Int iCloseLeft=1, iCloseRight=-1;
-    for(Int i = 0; i<m_pcCfg->getGOPEntry(iGOPid).m_numRefPics; i++)
-    {
-      Int iRef = m_pcCfg->getGOPEntry(iGOPid).m_referencePics[i];
-      if(iRef>0&&(iRef<iCloseRight||iCloseRight==-1))
-      {
-        iCloseRight=iRef;
-      }
-      else if(iRef<0&&(iRef>iCloseLeft||iCloseLeft==1))
-      {
-        iCloseLeft=iRef;
-      }
-    }
-    if(iCloseRight>-1)
-    {
-      iCloseRight=iCloseRight+m_pcCfg->getGOPEntry(iGOPid).m_POC-1;
-    }
-    if(iCloseLeft<1)
-    {
-      iCloseLeft=iCloseLeft+m_pcCfg->getGOPEntry(iGOPid).m_POC-1;
-      while(iCloseLeft<0)
-      {
-        iCloseLeft+=m_iGopSize;
-      }
-    }
-    Int iLeftQP=0, iRightQP=0;
-    for(Int i=0; i<m_iGopSize; i++)
+    // prepare the pictures of the GOP in coding order until the first prepared one is compressed
+    if ( !xCompressPictures( iGOPid == m_iGopSize ) )
     {
-      if(m_pcCfg->getGOPEntry(i).m_POC==(iCloseLeft%m_iGopSize)+1)
-      {
-        iLeftQP= m_pcCfg->getGOPEntry(i).m_QPOffset;
-      }
-      if (m_pcCfg->getGOPEntry(i).m_POC==(iCloseRight%m_iGopSize)+1)
+      m_cPicturesInFlight.push_back( TEncGOPPicture() );
+      if ( !xPreparePicture( m_cPicturesInFlight.back(), iGOPid, iPOCLast, iNumPicRcvd, rcListPic, rcListPicYuvRecOut, accessUnitsInGOP, isField ) )
       {
-        iRightQP=m_pcCfg->getGOPEntry(i).m_QPOffset;
+        m_cPicturesInFlight.pop_back();
       }
-    }
-    if(iCloseRight>-1&&iRightQP<iLeftQP)
-    {
-      uiColDir=0;
-    }
-
-    /////////////////////////////////////////////////////////////////////////////////////////////////// Initial to start encoding
-    Int iTimeOffset;
-    Int pocCurr;
-
-    if(iPOCLast == 0) //case first frame or first top field
-    {
-      pocCurr=0;
-      iTimeOffset = 1;
-    }
-    else if(iPOCLast == 1 && isField) //case first bottom field, just like the first frame, the poc computation is not right anymore, we set the right value
-    {
-      pocCurr = 1;
-      iTimeOffset = 1;
-    }
-    else
-    {
-      pocCurr = iPOCLast - iNumPicRcvd + m_pcCfg->getGOPEntry(iGOPid).m_POC - ((isField && m_iGopSize>1) ? 1:0);
-      iTimeOffset = m_pcCfg->getGOPEntry(iGOPid).m_POC;
-    }
-
-    if(pocCurr>=m_pcCfg->getFramesToBeEncoded())
-    {
+      iGOPid++;
       continue;
     }
 
-    if( getNalUnitType(pocCurr, m_iLastIDR) == NAL_UNIT_CODED_SLICE_IDR_W_RADL || getNalUnitType(pocCurr, m_iLastIDR) == NAL_UNIT_CODED_SLICE_IDR_N_LP )
-    {
-      m_iLastIDR = pocCurr;
-    }
-    // start a new access unit: create an entry in the list of output access units
-    accessUnitsInGOP.push_back(AccessUnit());
-    AccessUnit& accessUnit = accessUnitsInGOP.back();
-    xGetBuffer( rcListPic, rcListPicYuvRecOut, iNumPicRcvd, iTimeOffset, pcPic, pcPicYuvRecOut, pocCurr, isField );
-
-    //  Slice data initialization
-    pcPic->clearSliceBuffer();
-    assert(pcPic->getNumAllocatedSlice() == 1);
-    m_pcSliceEncoder->setSliceIdx(0);
-    pcPic->setCurrSliceIdx(0);
-
-    m_pcSliceEncoder->initEncSlice ( pcPic, iPOCLast, pocCurr, iNumPicRcvd, iGOPid, pcSlice, m_pcEncTop->getSPS(), m_pcEncTop->getPPS(), isField );
-
-    //Set Frame/Field coding
-    pcSlice->getPic()->setField(isField);
-
-    pcSlice->setLastIDR(m_iLastIDR);
-    pcSlice->setSliceIdx(0);
-    //set default slice level flag to the same as SPS level flag
-    pcSlice->setLFCrossSliceBoundaryFlag(  pcSlice->getPPS()->getLoopFilterAcrossSlicesEnabledFlag()  );
-    pcSlice->setScalingList ( m_pcEncTop->getScalingList()  );
-    if(m_pcEncTop->getUseScalingListId() == SCALING_LIST_OFF)
-    {
-      m_pcEncTop->getTrQuant()->setFlatScalingList(pcSlice->getSPS()->getChromaFormatIdc());
-      m_pcEncTop->getTrQuant()->setUseScalingList(false);
-      m_pcEncTop->getSPS()->setScalingListPresentFlag(false);
-      m_pcEncTop->getPPS()->setScalingListPresentFlag(false);
-    }
-    else if(m_pcEncTop->getUseScalingListId() == SCALING_LIST_DEFAULT)
-    {
-      pcSlice->setDefaultScalingList ();
-      m_pcEncTop->getSPS()->setScalingListPresentFlag(false);
-      m_pcEncTop->getPPS()->setScalingListPresentFlag(false);
-      m_pcEncTop->getTrQuant()->setScalingList(pcSlice->getScalingList(), pcSlice->getSPS()->getChromaFormatIdc());
-      m_pcEncTop->getTrQuant()->setUseScalingList(true);
-    }
-    else if(m_pcEncTop->getUseScalingListId() == SCALING_LIST_FILE_READ)
-    {
-      if(pcSlice->getScalingList()->xParseScalingList(m_pcCfg->getScalingListFile()))
-      {
-        pcSlice->setDefaultScalingList ();
-      }
-      pcSlice->getScalingList()->checkDcOfMatrix();
-      m_pcEncTop->getSPS()->setScalingListPresentFlag(pcSlice->checkDefaultScalingList());
-      m_pcEncTop->getPPS()->setScalingListPresentFlag(false);
-      m_pcEncTop->getTrQuant()->setScalingList(pcSlice->getScalingList(), pcSlice->getSPS()->getChromaFormatIdc());
-      m_pcEncTop->getTrQuant()->setUseScalingList(true);
-    }
-    else
-    {
-      printf("error : ScalingList == %d no support\n",m_pcEncTop->getUseScalingListId());
-      assert(0);
-    }
-
-    if(pcSlice->getSliceType()==B_SLICE&&m_pcCfg->getGOPEntry(iGOPid).m_sliceType=='P')
-    {
-      pcSlice->setSliceType(P_SLICE);
-    }
-    // Set the nal unit type
-    pcSlice->setNalUnitType(getNalUnitType(pocCurr, m_iLastIDR));
-    if(pcSlice->getTemporalLayerNonReferenceFlag())
-    {
-      if (pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_TRAIL_R &&
-          !(m_iGopSize == 1 && pcSlice->getSliceType() == I_SLICE))
-        // Add this condition to avoid POC issues with encoder_intra_main.cfg configuration (see #1127 in bug tracker)
-      {
-        pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_TRAIL_N);
-      }
-      if(pcSlice->getNalUnitType()==NAL_UNIT_CODED_SLICE_RADL_R)
-      {
-        pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_RADL_N);
-      }
-      if(pcSlice->getNalUnitType()==NAL_UNIT_CODED_SLICE_RASL_R)
-      {
-        pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_RASL_N);
-      }
-    }
-
-    // Do decoding refresh marking if any
-    pcSlice->decodingRefreshMarking(m_pocCRA, m_bRefreshPending, rcListPic);
-    m_pcEncTop->selectReferencePictureSet(pcSlice, pocCurr, iGOPid);
-    pcSlice->getRPS()->setNumberOfLongtermPictures(0);
-
-#if FIX1071
-    if ((pcSlice->checkThatAllRefPicsAreAvailable(rcListPic, pcSlice->getRPS(), false) != 0) || (pcSlice->isIRAP()))
-    {
-      pcSlice->createExplicitReferencePictureSetFromReference(rcListPic, pcSlice->getRPS(), pcSlice->isIRAP());
-    }
-#else
-    if(pcSlice->checkThatAllRefPicsAreAvailable(rcListPic, pcSlice->getRPS(), false) != 0)
-    {
-      pcSlice->createExplicitReferencePictureSetFromReference(rcListPic, pcSlice->getRPS());
-    }
-#endif
-
-    pcSlice->applyReferencePictureSet(rcListPic, pcSlice->getRPS());
-
-    if(pcSlice->getTLayer() > 0)
-    {
-      if(pcSlice->isTemporalLayerSwitchingPoint(rcListPic) || pcSlice->getSPS()->getTemporalIdNestingFlag())
-      {
-        if(pcSlice->getTemporalLayerNonReferenceFlag())
-        {
-          pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_TSA_N);
-        }
-        else
-        {
-          pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_TLA_R);
-        }
-      }
-      else if(pcSlice->isStepwiseTemporalLayerSwitchingPointCandidate(rcListPic))
-      {
-        Bool isSTSA=true;
-        for(Int ii=iGOPid+1;(ii<m_pcCfg->getGOPSize() && isSTSA==true);ii++)
-        {
-          Int lTid= m_pcCfg->getGOPEntry(ii).m_temporalId;
-          if(lTid==pcSlice->getTLayer())
-          {
-            TComReferencePictureSet* nRPS = pcSlice->getSPS()->getRPSList()->getReferencePictureSet(ii);
-            for(Int jj=0;jj<nRPS->getNumberOfPictures();jj++)
-            {
-              if(nRPS->getUsed(jj))
-              {
-                Int tPoc=m_pcCfg->getGOPEntry(ii).m_POC+nRPS->getDeltaPOC(jj);
-                Int kk=0;
-                for(kk=0;kk<m_pcCfg->getGOPSize();kk++)
-                {
-                  if(m_pcCfg->getGOPEntry(kk).m_POC==tPoc)
-                    break;
-                }
-                Int tTid=m_pcCfg->getGOPEntry(kk).m_temporalId;
-                if(tTid >= pcSlice->getTLayer())
-                {
-                  isSTSA=false;
-                  break;
-                }
-              }
-            }
-          }
-        }
-        if(isSTSA==true)
-        {
-          if(pcSlice->getTemporalLayerNonReferenceFlag())
-          {
-            pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_STSA_N);
-          }
-          else
-          {
-            pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_STSA_R);
-          }
-        }
-      }
-    }
-    arrangeLongtermPicturesInRPS(pcSlice, rcListPic);
-    TComRefPicListModification* refPicListModification = pcSlice->getRefPicListModification();
-    refPicListModification->setRefPicListModificationFlagL0(0);
-    refPicListModification->setRefPicListModificationFlagL1(0);
-    pcSlice->setNumRefIdx(REF_PIC_LIST_0,min(m_pcCfg->getGOPEntry(iGOPid).m_numRefPicsActive,pcSlice->getRPS()->getNumberOfPictures()));
-    pcSlice->setNumRefIdx(REF_PIC_LIST_1,min(m_pcCfg->getGOPEntry(iGOPid).m_numRefPicsActive,pcSlice->getRPS()->getNumberOfPictures()));
-
-#if ADAPTIVE_QP_SELECTION
-    pcSlice->setTrQuant( m_pcEncTop->getTrQuant() );
-#endif
-
-    //  Set reference list
-    pcSlice->setRefPicList ( rcListPic );
-
-    //  Slice info. refinement
-    if ( (pcSlice->getSliceType() == B_SLICE) && (pcSlice->getNumRefIdx(REF_PIC_LIST_1) == 0) )
-    {
-      pcSlice->setSliceType ( P_SLICE );
-    }
-
-    if (pcSlice->getSliceType() == B_SLICE)
-    {
-      pcSlice->setColFromL0Flag(1-uiColDir);
-      Bool bLowDelay = true;
-      Int  iCurrPOC  = pcSlice->getPOC();
-      Int iRefIdx = 0;
-
-      for (iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx(REF_PIC_LIST_0) && bLowDelay; iRefIdx++)
-      {
-        if ( pcSlice->getRefPic(REF_PIC_LIST_0, iRefIdx)->getPOC() > iCurrPOC )
-        {
-          bLowDelay = false;
-        }
-      }
-      for (iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx(REF_PIC_LIST_1) && bLowDelay; iRefIdx++)
-      {
-        if ( pcSlice->getRefPic(REF_PIC_LIST_1, iRefIdx)->getPOC() > iCurrPOC )
-        {
-          bLowDelay = false;
-        }
-      }
-
-      pcSlice->setCheckLDC(bLowDelay);
-    }
-    else
-    {
-      pcSlice->setCheckLDC(true);
-    }
-
-    uiColDir = 1-uiColDir;
-
-    //-------------------------------------------------------------
-    pcSlice->setRefPOCList();
-
-    pcSlice->setList1IdxToList0Idx();
-
-    if (m_pcEncTop->getTMVPModeId() == 2)
-    {
-      if (iGOPid == 0) // first picture in SOP (i.e. forward B)
-      {
-        pcSlice->setEnableTMVPFlag(0);
-      }
-      else
-      {
-        // Note: pcSlice->getColFromL0Flag() is assumed to be always 0 and getcolRefIdx() is always 0.
-        pcSlice->setEnableTMVPFlag(1);
-      }
-      pcSlice->getSPS()->setTMVPFlagsPresent(1);
-    }
-    else if (m_pcEncTop->getTMVPModeId() == 1)
-    {
-      pcSlice->getSPS()->setTMVPFlagsPresent(1);
-      pcSlice->setEnableTMVPFlag(1);
-    }
-    else
-    {
-      pcSlice->getSPS()->setTMVPFlagsPresent(0);
-      pcSlice->setEnableTMVPFlag(0);
-    }
-    /////////////////////////////////////////////////////////////////////////////////////////////////// Compress a slice
-    //  Slice compression
-    if (m_pcCfg->getUseASR())
-    {
-      m_pcSliceEncoder->setSearchRange(pcSlice);
-    }
-
-    Bool bGPBcheck=false;
-    if ( pcSlice->getSliceType() == B_SLICE)
-    {
-      if ( pcSlice->getNumRefIdx(RefPicList( 0 ) ) == pcSlice->getNumRefIdx(RefPicList( 1 ) ) )
-      {
-        bGPBcheck=true;
-        Int i;
-        for ( i=0; i < pcSlice->getNumRefIdx(RefPicList( 1 ) ); i++ )
-        {
-          if ( pcSlice->getRefPOC(RefPicList(1), i) != pcSlice->getRefPOC(RefPicList(0), i) )
-          {
-            bGPBcheck=false;
-            break;
-          }
-        }
-      }
-    }
-    if(bGPBcheck)
-    {
-      pcSlice->setMvdL1ZeroFlag(true);
-    }
-    else
-    {
-      pcSlice->setMvdL1ZeroFlag(false);
-    }
-    pcPic->getSlice(pcSlice->getSliceIdx())->setMvdL1ZeroFlag(pcSlice->getMvdL1ZeroFlag());
+    TEncGOPPicture& rcPicture = m_cPicturesInFlight.front();
+    pcPic          = rcPicture.m_pcPic;
+    pcPicYuvRecOut = rcPicture.m_pcPicYuvRecOut;
+    pcSlice        = pcPic->getSlice(0);
 
+    AccessUnit& accessUnit       = *rcPicture.m_pcAccessUnit;
+    Int         pocCurr          = rcPicture.m_iPOC;
+    long        iBeforeTime      = rcPicture.m_iBeforeTime;
+    UInt        uiNumSlices      = rcPicture.m_uiNumSlices;
+    UInt        uiRealEndAddress = rcPicture.m_uiRealEndAddress;
+    Int         iNumSubstreams   = pcSlice->getPPS()->getNumSubstreams();
 #if RATE_CONTROL_LAMBDA_DOMAIN
-    Double lambda            = 0.0;
+    Double lambda            = rcPicture.m_dLambda;
     Int actualHeadBits       = 0;
     Int actualTotalBits      = 0;
-    Int estimatedBits        = 0;
+    Int estimatedBits        = rcPicture.m_iEstimatedBits;
     Int tmpBitsBeforeWriting = 0;
-    if ( m_pcCfg->getUseRateCtrl() )
-    {
-      Int frameLevel = m_pcRateCtrl->getRCSeq()->getGOPID2Level( iGOPid );
-      if ( pcPic->getSlice(0)->getSliceType() == I_SLICE )
-      {
-        frameLevel = 0;
-      }
-      m_pcRateCtrl->initRCPic( frameLevel );
-      estimatedBits = m_pcRateCtrl->getRCPic()->getTargetBits();
-
-      Int sliceQP = m_pcCfg->getInitialQP();
-      if ( ( pcSlice->getPOC() == 0 && m_pcCfg->getInitialQP() > 0 ) || ( frameLevel == 0 && m_pcCfg->getForceIntraQP() ) ) // QP is specified
-      {
-        Int    NumberBFrames = ( m_pcCfg->getGOPSize() - 1 );
-        Double dLambda_scale = 1.0 - Clip3( 0.0, 0.5, 0.05*(Double)NumberBFrames );
-        Double dQPFactor     = 0.57*dLambda_scale;
-        Int    SHIFT_QP      = 12;
-        Int    bitdepth_luma_qp_scale = 0;
-        Double qp_temp = (Double) sliceQP + bitdepth_luma_qp_scale - SHIFT_QP;
-        lambda = dQPFactor*pow( 2.0, qp_temp/3.0 );
-      }
-      else if ( frameLevel == 0 )   // intra case, but use the model
-      {
-#if RATE_CONTROL_INTRA
-        m_pcSliceEncoder->calCostSliceI(pcPic);
-#endif
-        if ( m_pcCfg->getIntraPeriod() != 1 )   // do not refine allocated bits for all intra case
-        {
-          Int bits = m_pcRateCtrl->getRCSeq()->getLeftAverageBits();
-#if RATE_CONTROL_INTRA
-          bits = m_pcRateCtrl->getRCPic()->getRefineBitsForIntra( bits );
-#else
-          bits = m_pcRateCtrl->getRCSeq()->getRefineBitsForIntra( bits );
-#endif
-          if ( bits < 200 )
-          {
-            bits = 200;
-          }
-          m_pcRateCtrl->getRCPic()->setTargetBits( bits );
-        }
-
-        list<TEncRCPic*> listPreviousPicture = m_pcRateCtrl->getPicList();
-#if RATE_CONTROL_INTRA
-        m_pcRateCtrl->getRCPic()->getLCUInitTargetBits();
-        lambda  = m_pcRateCtrl->getRCPic()->estimatePicLambda( listPreviousPicture, pcSlice->getSliceType());
-#else
-        lambda  = m_pcRateCtrl->getRCPic()->estimatePicLambda( listPreviousPicture );
-#endif
-        sliceQP = m_pcRateCtrl->getRCPic()->estimatePicQP( lambda, listPreviousPicture );
-      }
-      else    // normal case
-      {
-        list<TEncRCPic*> listPreviousPicture = m_pcRateCtrl->getPicList();
-#if RATE_CONTROL_INTRA
-        lambda  = m_pcRateCtrl->getRCPic()->estimatePicLambda( listPreviousPicture, pcSlice->getSliceType());
-#else
-        lambda  = m_pcRateCtrl->getRCPic()->estimatePicLambda( listPreviousPicture );
-#endif
-        sliceQP = m_pcRateCtrl->getRCPic()->estimatePicQP( lambda, listPreviousPicture );
-      }
-
-      sliceQP = Clip3( -pcSlice->getSPS()->getQpBDOffset(CHANNEL_TYPE_LUMA), MAX_QP, sliceQP );
-      m_pcRateCtrl->getRCPic()->setPicEstQP( sliceQP );
-
-      m_pcSliceEncoder->resetQP( pcPic, sliceQP, lambda );
-    }
 #endif
+    UInt uiInternalAddress, uiExternalAddress, uiPosX, uiPosY, uiWidth, uiHeight;
+    UInt startCUAddrSliceIdx, startCUAddrSliceSegmentIdx, nextCUAddr;
+    Int  j;
 
-    UInt uiNumSlices = 1;
-
-    UInt uiInternalAddress = pcPic->getNumPartInCU()-4;
-    UInt uiExternalAddress = pcPic->getPicSym()->getNumberOfCUsInFrame()-1;
-    UInt uiPosX = ( uiExternalAddress % pcPic->getFrameWidthInCU() ) * g_uiMaxCUWidth+ g_auiRasterToPelX[ g_auiZscanToRaster[uiInternalAddress] ];
-    UInt uiPosY = ( uiExternalAddress / pcPic->getFrameWidthInCU() ) * g_uiMaxCUHeight+ g_auiRasterToPelY[ g_auiZscanToRaster[uiInternalAddress] ];
-    UInt uiWidth = pcSlice->getSPS()->getPicWidthInLumaSamples();
-    UInt uiHeight = pcSlice->getSPS()->getPicHeightInLumaSamples();
-    while(uiPosX>=uiWidth||uiPosY>=uiHeight)
-    {
-      uiInternalAddress--;
-      uiPosX = ( uiExternalAddress % pcPic->getFrameWidthInCU() ) * g_uiMaxCUWidth+ g_auiRasterToPelX[ g_auiZscanToRaster[uiInternalAddress] ];
-      uiPosY = ( uiExternalAddress / pcPic->getFrameWidthInCU() ) * g_uiMaxCUHeight+ g_auiRasterToPelY[ g_auiZscanToRaster[uiInternalAddress] ];
-    }
-    uiInternalAddress++;
-    if(uiInternalAddress==pcPic->getNumPartInCU())
-    {
-      uiInternalAddress = 0;
-      uiExternalAddress++;
-    }
-    UInt uiRealEndAddress = uiExternalAddress*pcPic->getNumPartInCU()+uiInternalAddress;
-
-    UInt uiCummulativeTileWidth;
-    UInt uiCummulativeTileHeight;
-    Int  p, j;
-    UInt uiEncCUAddr;
-
-    //set NumColumnsMinus1 and NumRowsMinus1
-    pcPic->getPicSym()->setNumColumnsMinus1( pcSlice->getPPS()->getNumColumnsMinus1() );
-    pcPic->getPicSym()->setNumRowsMinus1( pcSlice->getPPS()->getNumRowsMinus1() );
-
-    //create the TComTileArray
-    pcPic->getPicSym()->xCreateTComTileArray();
-
-    if( pcSlice->getPPS()->getUniformSpacingFlag() == 1 )
-    {
-      //set the width for each tile
-      for(j=0; j < pcPic->getPicSym()->getNumRowsMinus1()+1; j++)
-      {
-        for(p=0; p < pcPic->getPicSym()->getNumColumnsMinus1()+1; p++)
-        {
-          pcPic->getPicSym()->getTComTile( j * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + p )->
-            setTileWidth( (p+1)*pcPic->getPicSym()->getFrameWidthInCU()/(pcPic->getPicSym()->getNumColumnsMinus1()+1)
-            - (p*pcPic->getPicSym()->getFrameWidthInCU())/(pcPic->getPicSym()->getNumColumnsMinus1()+1) );
-        }
-      }
-
-      //set the height for each tile
-      for(j=0; j < pcPic->getPicSym()->getNumColumnsMinus1()+1; j++)
-      {
-        for(p=0; p < pcPic->getPicSym()->getNumRowsMinus1()+1; p++)
-        {
-          pcPic->getPicSym()->getTComTile( p * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + j )->
-            setTileHeight( (p+1)*pcPic->getPicSym()->getFrameHeightInCU()/(pcPic->getPicSym()->getNumRowsMinus1()+1)
-            - (p*pcPic->getPicSym()->getFrameHeightInCU())/(pcPic->getPicSym()->getNumRowsMinus1()+1) );
-        }
-      }
-    }
-    else
-    {
-      //set the width for each tile
-      for(j=0; j < pcPic->getPicSym()->getNumRowsMinus1()+1; j++)
-      {
-        uiCummulativeTileWidth = 0;
-        for(p=0; p < pcPic->getPicSym()->getNumColumnsMinus1(); p++)
-        {
-          pcPic->getPicSym()->getTComTile( j * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + p )->setTileWidth( pcSlice->getPPS()->getColumnWidth(p) );
-          uiCummulativeTileWidth += pcSlice->getPPS()->getColumnWidth(p);
-        }
-        pcPic->getPicSym()->getTComTile(j * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + p)->setTileWidth( pcPic->getPicSym()->getFrameWidthInCU()-uiCummulativeTileWidth );
-      }
-
-      //set the height for each tile
-      for(j=0; j < pcPic->getPicSym()->getNumColumnsMinus1()+1; j++)
-      {
-        uiCummulativeTileHeight = 0;
-        for(p=0; p < pcPic->getPicSym()->getNumRowsMinus1(); p++)
-        {
-          pcPic->getPicSym()->getTComTile( p * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + j )->setTileHeight( pcSlice->getPPS()->getRowHeight(p) );
-          uiCummulativeTileHeight += pcSlice->getPPS()->getRowHeight(p);
-        }
-        pcPic->getPicSym()->getTComTile(p * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + j)->setTileHeight( pcPic->getPicSym()->getFrameHeightInCU()-uiCummulativeTileHeight );
-      }
-    }
-    //intialize each tile of the current picture
-    pcPic->getPicSym()->xInitTiles();
-
-    // Allocate some coders, now we know how many tiles there are.
-    Int iNumSubstreams = pcSlice->getPPS()->getNumSubstreams();
-
-    //generate the Coding Order Map and Inverse Coding Order Map
-    for(p=0, uiEncCUAddr=0; p<pcPic->getPicSym()->getNumberOfCUsInFrame(); p++, uiEncCUAddr = pcPic->getPicSym()->xCalculateNxtCUAddr(uiEncCUAddr))
-    {
-      pcPic->getPicSym()->setCUOrderMap(p, uiEncCUAddr);
-      pcPic->getPicSym()->setInverseCUOrderMap(uiEncCUAddr, p);
-    }
-    pcPic->getPicSym()->setCUOrderMap(pcPic->getPicSym()->getNumberOfCUsInFrame(), pcPic->getPicSym()->getNumberOfCUsInFrame());
-    pcPic->getPicSym()->setInverseCUOrderMap(pcPic->getPicSym()->getNumberOfCUsInFrame(), pcPic->getPicSym()->getNumberOfCUsInFrame());
-
-    // Allocate some coders, now we know how many tiles there are.
-    m_pcEncTop->createWPPCoders(iNumSubstreams);
     pcSbacCoders = m_pcEncTop->getSbacCoders();
     pcSubstreamsOut = new TComOutputBitstream[iNumSubstreams];
 
-    UInt startCUAddrSliceIdx = 0; // used to index "m_uiStoredStartCUAddrForEncodingSlice" containing locations of slice boundaries
-    UInt startCUAddrSlice    = 0; // used to keep track of current slice's starting CU addr.
-    pcSlice->setSliceCurStartCUAddr( startCUAddrSlice ); // Setting "start CU addr" for current slice
-    m_storedStartCUAddrForEncodingSlice.clear();
-
-    UInt startCUAddrSliceSegmentIdx = 0; // used to index "m_uiStoredStartCUAddrForEntropyEncodingSlice" containing locations of slice boundaries
-    UInt startCUAddrSliceSegment    = 0; // used to keep track of current Dependent slice's starting CU addr.
-    pcSlice->setSliceSegmentCurStartCUAddr( startCUAddrSliceSegment ); // Setting "start CU addr" for current Dependent slice
-
-    m_storedStartCUAddrForEncodingSliceSegment.clear();
-    UInt nextCUAddr = 0;
-    m_storedStartCUAddrForEncodingSlice.push_back (nextCUAddr);
-    startCUAddrSliceIdx++;
-    m_storedStartCUAddrForEncodingSliceSegment.push_back(nextCUAddr);
-    startCUAddrSliceSegmentIdx++;
-
-    while(nextCUAddr<uiRealEndAddress) // determine slice boundaries
+    if ( rcPicture.m_pcFrameWorker != NULL )
     {
-      pcSlice->setNextSlice       ( false );
-      pcSlice->setNextSliceSegment( false );
-      assert(pcPic->getNumAllocatedSlice() == startCUAddrSliceIdx);
-      m_pcSliceEncoder->precompressSlice( pcPic );
-      m_pcSliceEncoder->compressSlice   ( pcPic );
-
-      Bool bNoBinBitConstraintViolated = (!pcSlice->isNextSlice() && !pcSlice->isNextSliceSegment());
-      if (pcSlice->isNextSlice() || (bNoBinBitConstraintViolated && m_pcCfg->getSliceMode()==FIXED_NUMBER_OF_LCU))
-      {
-        startCUAddrSlice = pcSlice->getSliceCurEndCUAddr();
-        // Reconstruction slice
-        m_storedStartCUAddrForEncodingSlice.push_back(startCUAddrSlice);
-        startCUAddrSliceIdx++;
-        // Dependent slice
-        if (startCUAddrSliceSegmentIdx>0 && m_storedStartCUAddrForEncodingSliceSegment[startCUAddrSliceSegmentIdx-1] != startCUAddrSlice)
-        {
-          m_storedStartCUAddrForEncodingSliceSegment.push_back(startCUAddrSlice);
-          startCUAddrSliceSegmentIdx++;
-        }
-
-        if (startCUAddrSlice < uiRealEndAddress)
-        {
-          pcPic->allocateNewSlice();
-          pcPic->setCurrSliceIdx                  ( startCUAddrSliceIdx-1 );
-          m_pcSliceEncoder->setSliceIdx           ( startCUAddrSliceIdx-1 );
-          pcSlice = pcPic->getSlice               ( startCUAddrSliceIdx-1 );
-          pcSlice->copySliceInfo                  ( pcPic->getSlice(0)      );
-          pcSlice->setSliceIdx                    ( startCUAddrSliceIdx-1 );
-          pcSlice->setSliceCurStartCUAddr         ( startCUAddrSlice      );
-          pcSlice->setSliceSegmentCurStartCUAddr  ( startCUAddrSlice      );
-          pcSlice->setSliceBits(0);
-          uiNumSlices ++;
-        }
-      }
-      else if (pcSlice->isNextSliceSegment() || (bNoBinBitConstraintViolated && m_pcCfg->getSliceSegmentMode()==FIXED_NUMBER_OF_LCU))
-      {
-        startCUAddrSliceSegment                                                     = pcSlice->getSliceSegmentCurEndCUAddr();
-        m_storedStartCUAddrForEncodingSliceSegment.push_back(startCUAddrSliceSegment);
-        startCUAddrSliceSegmentIdx++;
-        pcSlice->setSliceSegmentCurStartCUAddr( startCUAddrSliceSegment );
-      }
-      else
-      {
-        startCUAddrSlice                                                            = pcSlice->getSliceCurEndCUAddr();
-        startCUAddrSliceSegment                                                     = pcSlice->getSliceSegmentCurEndCUAddr();
-      }
-
-      nextCUAddr = (startCUAddrSlice > startCUAddrSliceSegment) ? startCUAddrSlice : startCUAddrSliceSegment;
+      // leave the coders as the compression of the picture by the encoder class does (SAO RDO reuses the go-on coder)
+      TEncSbac* pcRDGoOnSbacCoder = m_pcEncTop->getRDGoOnSbacCoder();
+      m_pcSbacCoder->init( m_pcBinCABAC );
+      pcRDGoOnSbacCoder->load( rcPicture.m_pcFrameWorker->getTools()->getRDGoOnSbacCoder() );
+      ((TEncBinCABAC*)pcRDGoOnSbacCoder->getEncBinIf())->setBinCountingEnableFlag( true );
+      m_pcEntropyCoder->setEntropyCoder ( pcRDGoOnSbacCoder, pcSlice );
+      m_pcEntropyCoder->setBitstream( m_pcBitCounter );
     }
-    m_storedStartCUAddrForEncodingSlice.push_back( pcSlice->getSliceCurEndCUAddr());
-    startCUAddrSliceIdx++;
-    m_storedStartCUAddrForEncodingSliceSegment.push_back(pcSlice->getSliceCurEndCUAddr());
-    startCUAddrSliceSegmentIdx++;
-
-    pcSlice = pcPic->getSlice(0);
 
     // SAO parameter estimation using non-deblocked pixels for LCU bottom and right boundary areas
     if( m_pcCfg->getSaoLcuBasedOptimization() && m_pcCfg->getSaoLcuBoundary() )
@@ -989,8 +443,8 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
       {
         LFCrossSliceBoundaryFlag.push_back(  ((uiNumSlices==1)?true:pcPic->getSlice(s)->getLFCrossSliceBoundaryFlag()) );
       }
-      m_storedStartCUAddrForEncodingSlice.resize(uiNumSlices+1);
-      pcPic->createNonDBFilterInfo(m_storedStartCUAddrForEncodingSlice, 0, &LFCrossSliceBoundaryFlag ,pcPic->getPicSym()->getNumTiles() ,bLFCrossTileBoundary);
+      rcPicture.m_storedStartCUAddrForEncodingSlice.resize(uiNumSlices+1);
+      pcPic->createNonDBFilterInfo(rcPicture.m_storedStartCUAddrForEncodingSlice, 0, &LFCrossSliceBoundaryFlag ,pcPic->getPicSym()->getNumTiles() ,bLFCrossTileBoundary);
     }
 
 
@@ -1077,14 +531,14 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
       SOPDescriptionSEI.m_sopSeqParameterSetId = pcSlice->getSPS()->getSPSId();
 
       UInt i = 0;
-      UInt prevEntryId = iGOPid;
-      for (j = iGOPid; j < m_iGopSize; j++)
+      UInt prevEntryId = rcPicture.m_iGOPid;
+      for (j = rcPicture.m_iGOPid; j < m_iGopSize; j++)
       {
         Int deltaPOC = m_pcCfg->getGOPEntry(j).m_POC - m_pcCfg->getGOPEntry(prevEntryId).m_POC;
         if ((SOPcurrPOC + deltaPOC) < m_pcCfg->getFramesToBeEncoded())
         {
           SOPcurrPOC += deltaPOC;
-          SOPDescriptionSEI.m_sopDescVclNaluType[i] = getNalUnitType(SOPcurrPOC, m_iLastIDR);
+          SOPDescriptionSEI.m_sopDescVclNaluType[i] = getNalUnitType(SOPcurrPOC, rcPicture.m_iLastIDR);
           SOPDescriptionSEI.m_sopDescTemporalId[i] = m_pcCfg->getGOPEntry(j).m_temporalId;
           SOPDescriptionSEI.m_sopDescStRpsIdx[i] = m_pcEncTop->getReferencePictureSetIdxForSOP(pcSlice, SOPcurrPOC, j);
           SOPDescriptionSEI.m_sopDescPocDelta[i] = deltaPOC;
@@ -1269,11 +723,8 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     /* use the main bitstream buffer for storing the marshalled picture */
     m_pcEntropyCoder->setBitstream(NULL);
 
-    startCUAddrSliceIdx = 0;
-    startCUAddrSlice    = 0;
-
+    startCUAddrSliceIdx        = 0;
     startCUAddrSliceSegmentIdx = 0;
-    startCUAddrSliceSegment    = 0;
     nextCUAddr                 = 0;
     pcSlice = pcPic->getSlice(startCUAddrSliceIdx);
 
@@ -1287,7 +738,7 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
         {
           pcSlice->setNextSlice       ( false );
           pcSlice->setNextSliceSegment( false );
-          if (nextCUAddr == m_storedStartCUAddrForEncodingSlice[startCUAddrSliceIdx])
+          if (nextCUAddr == rcPicture.m_storedStartCUAddrForEncodingSlice[startCUAddrSliceIdx])
           {
             pcSlice = pcPic->getSlice(startCUAddrSliceIdx);
             if(startCUAddrSliceIdx > 0 && pcSlice->getSliceType()!= I_SLICE)
@@ -1299,21 +750,21 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
             assert(startCUAddrSliceIdx == pcSlice->getSliceIdx());
             // Reconstruction slice
             pcSlice->setSliceCurStartCUAddr( nextCUAddr );  // to be used in encodeSlice() + context restriction
-            pcSlice->setSliceCurEndCUAddr  ( m_storedStartCUAddrForEncodingSlice[startCUAddrSliceIdx+1 ] );
+            pcSlice->setSliceCurEndCUAddr  ( rcPicture.m_storedStartCUAddrForEncodingSlice[startCUAddrSliceIdx+1 ] );
             // Dependent slice
             pcSlice->setSliceSegmentCurStartCUAddr( nextCUAddr );  // to be used in encodeSlice() + context restriction
-            pcSlice->setSliceSegmentCurEndCUAddr  ( m_storedStartCUAddrForEncodingSliceSegment[startCUAddrSliceSegmentIdx+1 ] );
+            pcSlice->setSliceSegmentCurEndCUAddr  ( rcPicture.m_storedStartCUAddrForEncodingSliceSegment[startCUAddrSliceSegmentIdx+1 ] );
 
             pcSlice->setNextSlice       ( true );
 
             startCUAddrSliceIdx++;
             startCUAddrSliceSegmentIdx++;
           }
-          else if (nextCUAddr == m_storedStartCUAddrForEncodingSliceSegment[startCUAddrSliceSegmentIdx])
+          else if (nextCUAddr == rcPicture.m_storedStartCUAddrForEncodingSliceSegment[startCUAddrSliceSegmentIdx])
           {
             // Dependent slice
             pcSlice->setSliceSegmentCurStartCUAddr( nextCUAddr );  // to be used in encodeSlice() + context restriction
-            pcSlice->setSliceSegmentCurEndCUAddr  ( m_storedStartCUAddrForEncodingSliceSegment[startCUAddrSliceSegmentIdx+1 ] );
+            pcSlice->setSliceSegmentCurEndCUAddr  ( rcPicture.m_storedStartCUAddrForEncodingSliceSegment[startCUAddrSliceSegmentIdx+1 ] );
 
             pcSlice->setNextSliceSegment( true );
 
@@ -1348,8 +799,8 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
           if(endAddress<=pcSlice->getSliceSegmentCurStartCUAddr())
           {
             UInt boundingAddrSlice, boundingAddrSliceSegment;
-            boundingAddrSlice          = m_storedStartCUAddrForEncodingSlice[startCUAddrSliceIdx];
-            boundingAddrSliceSegment = m_storedStartCUAddrForEncodingSliceSegment[startCUAddrSliceSegmentIdx];
+            boundingAddrSlice          = rcPicture.m_storedStartCUAddrForEncodingSlice[startCUAddrSliceIdx];
+            boundingAddrSliceSegment = rcPicture.m_storedStartCUAddrForEncodingSliceSegment[startCUAddrSliceSegmentIdx];
             nextCUAddr               = min(boundingAddrSlice, boundingAddrSliceSegment);
             if(pcSlice->isNextSlice())
             {
@@ -1507,8 +958,8 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
           }
 
           UInt boundingAddrSlice, boundingAddrSliceSegment;
-          boundingAddrSlice        = m_storedStartCUAddrForEncodingSlice[startCUAddrSliceIdx];
-          boundingAddrSliceSegment = m_storedStartCUAddrForEncodingSliceSegment[startCUAddrSliceSegmentIdx];
+          boundingAddrSlice        = rcPicture.m_storedStartCUAddrForEncodingSlice[startCUAddrSliceIdx];
+          boundingAddrSliceSegment = rcPicture.m_storedStartCUAddrForEncodingSliceSegment[startCUAddrSliceSegmentIdx];
           nextCUAddr               = min(boundingAddrSlice, boundingAddrSliceSegment);
           // If current NALU is the first NALU of slice (containing slice header) and more NALUs exist (due to multiple dependent slices) then buffer it.
           // If current NALU is the last NALU of slice and a NALU was buffered, then (a) Write current NALU (b) Update an write buffered NALU at approproate location in NALU list.
@@ -1615,6 +1066,13 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
 
       pcPic->compressMotion();
 
+      if ( m_pcCfg->getNumParallelFrames() > 1 )
+      {
+        // the borders may have been extended when the picture was referenced by a picture prepared before its filtering
+        pcPic->getPicYuvRec()->setBorderExtension( false );
+        pcPic->getPicYuvRec()->extendPicBorder();
+      }
+
       //-- For time output for each slice
       Double dEncTime = (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
 
@@ -1940,6 +1398,7 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
       fflush(stdout);
 
       delete[] pcSubstreamsOut;
+      m_cPicturesInFlight.pop_front();
   }
 #if !RATE_CONTROL_LAMBDA_DOMAIN
   if(m_pcCfg->getUseRateCtrl())
@@ -1955,6 +1414,746 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
   assert ( (m_iNumPicCoded == iNumPicRcvd) );
 }
 
+/** Prepare a picture of the GOP for its compression: slice header, reference picture set and lists, tiles.
+ * When several pictures may be compressed at the same time, the picture is given a slice encoder of its own.
+ * \param rcPicture          picture in flight to set up
+ * \param iGOPid             index of the picture in the GOP structure
+ * \param iPOCLast           POC of the last received picture
+ * \param iNumPicRcvd        number of received pictures
+ * \param rcListPic          list of pictures
+ * \param rcListPicYuvRecOut list of reconstruction output buffers
+ * \param accessUnitsInGOP   list of access units of the GOP
+ * \param isField            field coding
+ * \returns false if the picture is not coded
+ */
+Bool TEncGOP::xPreparePicture( TEncGOPPicture& rcPicture, Int iGOPid, Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rcListPic,
+                               TComList<TComPicYuv*>& rcListPicYuvRecOut, std::list<AccessUnit>& accessUnitsInGOP, Bool isField )
+{
+  TComPic*         pcPic;
+  TComPicYuv*      pcPicYuvRecOut;
+  TComSlice*       pcSlice;
+  TEncSlice*       pcSliceEncoder = m_pcSliceEncoder;
+  TComTrQuant*     pcTrQuant      = m_pcEncTop->getTrQuant();
+  TEncFrameWorker* pcFrameWorker  = NULL;
+
+  if ( m_pcCfg->getNumParallelFrames() > 1 )
+  {
+    // the pictures in flight use consecutive slice encoders
+    pcFrameWorker  = m_pcEncTop->getFrameWorker( ( m_iNumPicCoded + (Int)m_cPicturesInFlight.size() - 1 ) % m_pcCfg->getNumParallelFrames() );
+    pcSliceEncoder = pcFrameWorker->getSliceEncoder();
+    pcTrQuant      = pcFrameWorker->getTools()->getTrQuant();
+  }
+
+  UInt uiColDir = 1;
+  //-- For time output for each slice
+  rcPicture.m_iBeforeTime = clock();
+
+  //select uiColDir
+  Int iCloseLeft=1, iCloseRight=-1;
+  for(Int i = 0; i<m_pcCfg->getGOPEntry(iGOPid).m_numRefPics; i++)
+  {
+    Int iRef = m_pcCfg->getGOPEntry(iGOPid).m_referencePics[i];
+    if(iRef>0&&(iRef<iCloseRight||iCloseRight==-1))
+    {
+      iCloseRight=iRef;
+    }
+    else if(iRef<0&&(iRef>iCloseLeft||iCloseLeft==1))
+    {
+      iCloseLeft=iRef;
+    }
+  }
+  if(iCloseRight>-1)
+  {
+    iCloseRight=iCloseRight+m_pcCfg->getGOPEntry(iGOPid).m_POC-1;
+  }
+  if(iCloseLeft<1)
+  {
+    iCloseLeft=iCloseLeft+m_pcCfg->getGOPEntry(iGOPid).m_POC-1;
+    while(iCloseLeft<0)
+    {
+      iCloseLeft+=m_iGopSize;
+    }
+  }
+  Int iLeftQP=0, iRightQP=0;
+  for(Int i=0; i<m_iGopSize; i++)
+  {
+    if(m_pcCfg->getGOPEntry(i).m_POC==(iCloseLeft%m_iGopSize)+1)
+    {
+      iLeftQP= m_pcCfg->getGOPEntry(i).m_QPOffset;
+    }
+    if (m_pcCfg->getGOPEntry(i).m_POC==(iCloseRight%m_iGopSize)+1)
+    {
+      iRightQP=m_pcCfg->getGOPEntry(i).m_QPOffset;
+    }
+  }
+  if(iCloseRight>-1&&iRightQP<iLeftQP)
+  {
+    uiColDir=0;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////////////////////////// Initial to start encoding
+  Int iTimeOffset;
+  Int pocCurr;
+
+  if(iPOCLast == 0) //case first frame or first top field
+  {
+    pocCurr=0;
+    iTimeOffset = 1;
+  }
+  else if(iPOCLast == 1 && isField) //case first bottom field, just like the first frame, the poc computation is not right anymore, we set the right value
+  {
+    pocCurr = 1;
+    iTimeOffset = 1;
+  }
+  else
+  {
+    pocCurr = iPOCLast - iNumPicRcvd + m_pcCfg->getGOPEntry(iGOPid).m_POC - ((isField && m_iGopSize>1) ? 1:0);
+    iTimeOffset = m_pcCfg->getGOPEntry(iGOPid).m_POC;
+  }
+
+  if(pocCurr>=m_pcCfg->getFramesToBeEncoded())
+  {
+    return false;
+  }
+
+  if( getNalUnitType(pocCurr, m_iLastIDR) == NAL_UNIT_CODED_SLICE_IDR_W_RADL || getNalUnitType(pocCurr, m_iLastIDR) == NAL_UNIT_CODED_SLICE_IDR_N_LP )
+  {
+    m_iLastIDR = pocCurr;
+  }
+  // start a new access unit: create an entry in the list of output access units
+  accessUnitsInGOP.push_back(AccessUnit());
+  AccessUnit& accessUnit = accessUnitsInGOP.back();
+  xGetBuffer( rcListPic, rcListPicYuvRecOut, iNumPicRcvd, iTimeOffset, pcPic, pcPicYuvRecOut, pocCurr, isField );
+
+  //  Slice data initialization
+  pcPic->clearSliceBuffer();
+  assert(pcPic->getNumAllocatedSlice() == 1);
+  pcSliceEncoder->setSliceIdx(0);
+  pcPic->setCurrSliceIdx(0);
+
+  pcSliceEncoder->initEncSlice ( pcPic, iPOCLast, pocCurr, iNumPicRcvd, iGOPid, pcSlice, m_pcEncTop->getSPS(), m_pcEncTop->getPPS(), isField );
+
+  //Set Frame/Field coding
+  pcSlice->getPic()->setField(isField);
+
+  pcSlice->setLastIDR(m_iLastIDR);
+  pcSlice->setSliceIdx(0);
+  //set default slice level flag to the same as SPS level flag
+  pcSlice->setLFCrossSliceBoundaryFlag(  pcSlice->getPPS()->getLoopFilterAcrossSlicesEnabledFlag()  );
+  pcSlice->setScalingList ( m_pcEncTop->getScalingList()  );
+  if(m_pcEncTop->getUseScalingListId() == SCALING_LIST_OFF)
+  {
+    pcTrQuant->setFlatScalingList(pcSlice->getSPS()->getChromaFormatIdc());
+    pcTrQuant->setUseScalingList(false);
+    m_pcEncTop->getSPS()->setScalingListPresentFlag(false);
+    m_pcEncTop->getPPS()->setScalingListPresentFlag(false);
+  }
+  else if(m_pcEncTop->getUseScalingListId() == SCALING_LIST_DEFAULT)
+  {
+    pcSlice->setDefaultScalingList ();
+    m_pcEncTop->getSPS()->setScalingListPresentFlag(false);
+    m_pcEncTop->getPPS()->setScalingListPresentFlag(false);
+    pcTrQuant->setScalingList(pcSlice->getScalingList(), pcSlice->getSPS()->getChromaFormatIdc());
+    pcTrQuant->setUseScalingList(true);
+  }
+  else if(m_pcEncTop->getUseScalingListId() == SCALING_LIST_FILE_READ)
+  {
+    if(pcSlice->getScalingList()->xParseScalingList(m_pcCfg->getScalingListFile()))
+    {
+      pcSlice->setDefaultScalingList ();
+    }
+    pcSlice->getScalingList()->checkDcOfMatrix();
+    m_pcEncTop->getSPS()->setScalingListPresentFlag(pcSlice->checkDefaultScalingList());
+    m_pcEncTop->getPPS()->setScalingListPresentFlag(false);
+    pcTrQuant->setScalingList(pcSlice->getScalingList(), pcSlice->getSPS()->getChromaFormatIdc());
+    pcTrQuant->setUseScalingList(true);
+  }
+  else
+  {
+    printf("error : ScalingList == %d no support\n",m_pcEncTop->getUseScalingListId());
+    assert(0);
+  }
+
+  if(pcSlice->getSliceType()==B_SLICE&&m_pcCfg->getGOPEntry(iGOPid).m_sliceType=='P')
+  {
+    pcSlice->setSliceType(P_SLICE);
+  }
+  // Set the nal unit type
+  pcSlice->setNalUnitType(getNalUnitType(pocCurr, m_iLastIDR));
+  if(pcSlice->getTemporalLayerNonReferenceFlag())
+  {
+    if (pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_TRAIL_R &&
+        !(m_iGopSize == 1 && pcSlice->getSliceType() == I_SLICE))
+      // Add this condition to avoid POC issues with encoder_intra_main.cfg configuration (see #1127 in bug tracker)
+    {
+      pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_TRAIL_N);
+    }
+    if(pcSlice->getNalUnitType()==NAL_UNIT_CODED_SLICE_RADL_R)
+    {
+      pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_RADL_N);
+    }
+    if(pcSlice->getNalUnitType()==NAL_UNIT_CODED_SLICE_RASL_R)
+    {
+      pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_RASL_N);
+    }
+  }
+
+  // Do decoding refresh marking if any
+  pcSlice->decodingRefreshMarking(m_pocCRA, m_bRefreshPending, rcListPic);
+  m_pcEncTop->selectReferencePictureSet(pcSlice, pocCurr, iGOPid);
+  pcSlice->getRPS()->setNumberOfLongtermPictures(0);
+
+#if FIX1071
+  if ((pcSlice->checkThatAllRefPicsAreAvailable(rcListPic, pcSlice->getRPS(), false) != 0) || (pcSlice->isIRAP()))
+  {
+    pcSlice->createExplicitReferencePictureSetFromReference(rcListPic, pcSlice->getRPS(), pcSlice->isIRAP());
+  }
+#else
+  if(pcSlice->checkThatAllRefPicsAreAvailable(rcListPic, pcSlice->getRPS(), false) != 0)
+  {
+    pcSlice->createExplicitReferencePictureSetFromReference(rcListPic, pcSlice->getRPS());
+  }
+#endif
+
+  pcSlice->applyReferencePictureSet(rcListPic, pcSlice->getRPS());
+
+  if(pcSlice->getTLayer() > 0)
+  {
+    if(pcSlice->isTemporalLayerSwitchingPoint(rcListPic) || pcSlice->getSPS()->getTemporalIdNestingFlag())
+    {
+      if(pcSlice->getTemporalLayerNonReferenceFlag())
+      {
+        pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_TSA_N);
+      }
+      else
+      {
+        pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_TLA_R);
+      }
+    }
+    else if(pcSlice->isStepwiseTemporalLayerSwitchingPointCandidate(rcListPic))
+    {
+      Bool isSTSA=true;
+      for(Int ii=iGOPid+1;(ii<m_pcCfg->getGOPSize() && isSTSA==true);ii++)
+      {
+        Int lTid= m_pcCfg->getGOPEntry(ii).m_temporalId;
+        if(lTid==pcSlice->getTLayer())
+        {
+          TComReferencePictureSet* nRPS = pcSlice->getSPS()->getRPSList()->getReferencePictureSet(ii);
+          for(Int jj=0;jj<nRPS->getNumberOfPictures();jj++)
+          {
+            if(nRPS->getUsed(jj))
+            {
+              Int tPoc=m_pcCfg->getGOPEntry(ii).m_POC+nRPS->getDeltaPOC(jj);
+              Int kk=0;
+              for(kk=0;kk<m_pcCfg->getGOPSize();kk++)
+              {
+                if(m_pcCfg->getGOPEntry(kk).m_POC==tPoc)
+                  break;
+              }
+              Int tTid=m_pcCfg->getGOPEntry(kk).m_temporalId;
+              if(tTid >= pcSlice->getTLayer())
+              {
+                isSTSA=false;
+                break;
+              }
+            }
+          }
+        }
+      }
+      if(isSTSA==true)
+      {
+        if(pcSlice->getTemporalLayerNonReferenceFlag())
+        {
+          pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_STSA_N);
+        }
+        else
+        {
+          pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_STSA_R);
+        }
+      }
+    }
+  }
+  arrangeLongtermPicturesInRPS(pcSlice, rcListPic);
+  TComRefPicListModification* refPicListModification = pcSlice->getRefPicListModification();
+  refPicListModification->setRefPicListModificationFlagL0(0);
+  refPicListModification->setRefPicListModificationFlagL1(0);
+  pcSlice->setNumRefIdx(REF_PIC_LIST_0,min(m_pcCfg->getGOPEntry(iGOPid).m_numRefPicsActive,pcSlice->getRPS()->getNumberOfPictures()));
+  pcSlice->setNumRefIdx(REF_PIC_LIST_1,min(m_pcCfg->getGOPEntry(iGOPid).m_numRefPicsActive,pcSlice->getRPS()->getNumberOfPictures()));
+
+#if ADAPTIVE_QP_SELECTION
+  pcSlice->setTrQuant( pcTrQuant );
+#endif
+
+  //  Set reference list
+  pcSlice->setRefPicList ( rcListPic );
+
+  //  Slice info. refinement
+  if ( (pcSlice->getSliceType() == B_SLICE) && (pcSlice->getNumRefIdx(REF_PIC_LIST_1) == 0) )
+  {
+    pcSlice->setSliceType ( P_SLICE );
+  }
+
+  if (pcSlice->getSliceType() == B_SLICE)
+  {
+    pcSlice->setColFromL0Flag(1-uiColDir);
+    Bool bLowDelay = true;
+    Int  iCurrPOC  = pcSlice->getPOC();
+    Int iRefIdx = 0;
+
+    for (iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx(REF_PIC_LIST_0) && bLowDelay; iRefIdx++)
+    {
+      if ( pcSlice->getRefPic(REF_PIC_LIST_0, iRefIdx)->getPOC() > iCurrPOC )
+      {
+        bLowDelay = false;
+      }
+    }
+    for (iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx(REF_PIC_LIST_1) && bLowDelay; iRefIdx++)
+    {
+      if ( pcSlice->getRefPic(REF_PIC_LIST_1, iRefIdx)->getPOC() > iCurrPOC )
+      {
+        bLowDelay = false;
+      }
+    }
+
+    pcSlice->setCheckLDC(bLowDelay);
+  }
+  else
+  {
+    pcSlice->setCheckLDC(true);
+  }
+
+  uiColDir = 1-uiColDir;
+
+  //-------------------------------------------------------------
+  pcSlice->setRefPOCList();
+
+  pcSlice->setList1IdxToList0Idx();
+
+  if (m_pcEncTop->getTMVPModeId() == 2)
+  {
+    if (iGOPid == 0) // first picture in SOP (i.e. forward B)
+    {
+      pcSlice->setEnableTMVPFlag(0);
+    }
+    else
+    {
+      // Note: pcSlice->getColFromL0Flag() is assumed to be always 0 and getcolRefIdx() is always 0.
+      pcSlice->setEnableTMVPFlag(1);
+    }
+    pcSlice->getSPS()->setTMVPFlagsPresent(1);
+  }
+  else if (m_pcEncTop->getTMVPModeId() == 1)
+  {
+    pcSlice->getSPS()->setTMVPFlagsPresent(1);
+    pcSlice->setEnableTMVPFlag(1);
+  }
+  else
+  {
+    pcSlice->getSPS()->setTMVPFlagsPresent(0);
+    pcSlice->setEnableTMVPFlag(0);
+  }
+  /////////////////////////////////////////////////////////////////////////////////////////////////// Compress a slice
+  //  Slice compression
+  if (m_pcCfg->getUseASR())
+  {
+    pcSliceEncoder->setSearchRange(pcSlice);
+  }
+
+  Bool bGPBcheck=false;
+  if ( pcSlice->getSliceType() == B_SLICE)
+  {
+    if ( pcSlice->getNumRefIdx(RefPicList( 0 ) ) == pcSlice->getNumRefIdx(RefPicList( 1 ) ) )
+    {
+      bGPBcheck=true;
+      Int i;
+      for ( i=0; i < pcSlice->getNumRefIdx(RefPicList( 1 ) ); i++ )
+      {
+        if ( pcSlice->getRefPOC(RefPicList(1), i) != pcSlice->getRefPOC(RefPicList(0), i) )
+        {
+          bGPBcheck=false;
+          break;
+        }
+      }
+    }
+  }
+  if(bGPBcheck)
+  {
+    pcSlice->setMvdL1ZeroFlag(true);
+  }
+  else
+  {
+    pcSlice->setMvdL1ZeroFlag(false);
+  }
+  pcPic->getSlice(pcSlice->getSliceIdx())->setMvdL1ZeroFlag(pcSlice->getMvdL1ZeroFlag());
+
+#if RATE_CONTROL_LAMBDA_DOMAIN
+  Double lambda            = 0.0;
+  Int estimatedBits        = 0;
+  if ( m_pcCfg->getUseRateCtrl() )
+  {
+    Int frameLevel = m_pcRateCtrl->getRCSeq()->getGOPID2Level( iGOPid );
+    if ( pcPic->getSlice(0)->getSliceType() == I_SLICE )
+    {
+      frameLevel = 0;
+    }
+    m_pcRateCtrl->initRCPic( frameLevel );
+    estimatedBits = m_pcRateCtrl->getRCPic()->getTargetBits();
+
+    Int sliceQP = m_pcCfg->getInitialQP();
+    if ( ( pcSlice->getPOC() == 0 && m_pcCfg->getInitialQP() > 0 ) || ( frameLevel == 0 && m_pcCfg->getForceIntraQP() ) ) // QP is specified
+    {
+      Int    NumberBFrames = ( m_pcCfg->getGOPSize() - 1 );
+      Double dLambda_scale = 1.0 - Clip3( 0.0, 0.5, 0.05*(Double)NumberBFrames );
+      Double dQPFactor     = 0.57*dLambda_scale;
+      Int    SHIFT_QP      = 12;
+      Int    bitdepth_luma_qp_scale = 0;
+      Double qp_temp = (Double) sliceQP + bitdepth_luma_qp_scale - SHIFT_QP;
+      lambda = dQPFactor*pow( 2.0, qp_temp/3.0 );
+    }
+    else if ( frameLevel == 0 )   // intra case, but use the model
+    {
+#if RATE_CONTROL_INTRA
+      pcSliceEncoder->calCostSliceI(pcPic);
+#endif
+      if ( m_pcCfg->getIntraPeriod() != 1 )   // do not refine allocated bits for all intra case
+      {
+        Int bits = m_pcRateCtrl->getRCSeq()->getLeftAverageBits();
+#if RATE_CONTROL_INTRA
+        bits = m_pcRateCtrl->getRCPic()->getRefineBitsForIntra( bits );
+#else
+        bits = m_pcRateCtrl->getRCSeq()->getRefineBitsForIntra( bits );
+#endif
+        if ( bits < 200 )
+        {
+          bits = 200;
+        }
+        m_pcRateCtrl->getRCPic()->setTargetBits( bits );
+      }
+
+      list<TEncRCPic*> listPreviousPicture = m_pcRateCtrl->getPicList();
+#if RATE_CONTROL_INTRA
+      m_pcRateCtrl->getRCPic()->getLCUInitTargetBits();
+      lambda  = m_pcRateCtrl->getRCPic()->estimatePicLambda( listPreviousPicture, pcSlice->getSliceType());
+#else
+      lambda  = m_pcRateCtrl->getRCPic()->estimatePicLambda( listPreviousPicture );
+#endif
+      sliceQP = m_pcRateCtrl->getRCPic()->estimatePicQP( lambda, listPreviousPicture );
+    }
+    else    // normal case
+    {
+      list<TEncRCPic*> listPreviousPicture = m_pcRateCtrl->getPicList();
+#if RATE_CONTROL_INTRA
+      lambda  = m_pcRateCtrl->getRCPic()->estimatePicLambda( listPreviousPicture, pcSlice->getSliceType());
+#else
+      lambda  = m_pcRateCtrl->getRCPic()->estimatePicLambda( listPreviousPicture );
+#endif
+      sliceQP = m_pcRateCtrl->getRCPic()->estimatePicQP( lambda, listPreviousPicture );
+    }
+
+    sliceQP = Clip3( -pcSlice->getSPS()->getQpBDOffset(CHANNEL_TYPE_LUMA), MAX_QP, sliceQP );
+    m_pcRateCtrl->getRCPic()->setPicEstQP( sliceQP );
+
+    pcSliceEncoder->resetQP( pcPic, sliceQP, lambda );
+  }
+#endif
+
+  UInt uiNumSlices = 1;
+
+  UInt uiInternalAddress = pcPic->getNumPartInCU()-4;
+  UInt uiExternalAddress = pcPic->getPicSym()->getNumberOfCUsInFrame()-1;
+  UInt uiPosX = ( uiExternalAddress % pcPic->getFrameWidthInCU() ) * g_uiMaxCUWidth+ g_auiRasterToPelX[ g_auiZscanToRaster[uiInternalAddress] ];
+  UInt uiPosY = ( uiExternalAddress / pcPic->getFrameWidthInCU() ) * g_uiMaxCUHeight+ g_auiRasterToPelY[ g_auiZscanToRaster[uiInternalAddress] ];
+  UInt uiWidth = pcSlice->getSPS()->getPicWidthInLumaSamples();
+  UInt uiHeight = pcSlice->getSPS()->getPicHeightInLumaSamples();
+  while(uiPosX>=uiWidth||uiPosY>=uiHeight)
+  {
+    uiInternalAddress--;
+    uiPosX = ( uiExternalAddress % pcPic->getFrameWidthInCU() ) * g_uiMaxCUWidth+ g_auiRasterToPelX[ g_auiZscanToRaster[uiInternalAddress] ];
+    uiPosY = ( uiExternalAddress / pcPic->getFrameWidthInCU() ) * g_uiMaxCUHeight+ g_auiRasterToPelY[ g_auiZscanToRaster[uiInternalAddress] ];
+  }
+  uiInternalAddress++;
+  if(uiInternalAddress==pcPic->getNumPartInCU())
+  {
+    uiInternalAddress = 0;
+    uiExternalAddress++;
+  }
+  UInt uiRealEndAddress = uiExternalAddress*pcPic->getNumPartInCU()+uiInternalAddress;
+
+  UInt uiCummulativeTileWidth;
+  UInt uiCummulativeTileHeight;
+  Int  p, j;
+  UInt uiEncCUAddr;
+
+  //set NumColumnsMinus1 and NumRowsMinus1
+  pcPic->getPicSym()->setNumColumnsMinus1( pcSlice->getPPS()->getNumColumnsMinus1() );
+  pcPic->getPicSym()->setNumRowsMinus1( pcSlice->getPPS()->getNumRowsMinus1() );
+
+  //create the TComTileArray
+  pcPic->getPicSym()->xCreateTComTileArray();
+
+  if( pcSlice->getPPS()->getUniformSpacingFlag() == 1 )
+  {
+    //set the width for each tile
+    for(j=0; j < pcPic->getPicSym()->getNumRowsMinus1()+1; j++)
+    {
+      for(p=0; p < pcPic->getPicSym()->getNumColumnsMinus1()+1; p++)
+      {
+        pcPic->getPicSym()->getTComTile( j * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + p )->
+          setTileWidth( (p+1)*pcPic->getPicSym()->getFrameWidthInCU()/(pcPic->getPicSym()->getNumColumnsMinus1()+1)
+          - (p*pcPic->getPicSym()->getFrameWidthInCU())/(pcPic->getPicSym()->getNumColumnsMinus1()+1) );
+      }
+    }
+
+    //set the height for each tile
+    for(j=0; j < pcPic->getPicSym()->getNumColumnsMinus1()+1; j++)
+    {
+      for(p=0; p < pcPic->getPicSym()->getNumRowsMinus1()+1; p++)
+      {
+        pcPic->getPicSym()->getTComTile( p * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + j )->
+          setTileHeight( (p+1)*pcPic->getPicSym()->getFrameHeightInCU()/(pcPic->getPicSym()->getNumRowsMinus1()+1)
+          - (p*pcPic->getPicSym()->getFrameHeightInCU())/(pcPic->getPicSym()->getNumRowsMinus1()+1) );
+      }
+    }
+  }
+  else
+  {
+    //set the width for each tile
+    for(j=0; j < pcPic->getPicSym()->getNumRowsMinus1()+1; j++)
+    {
+      uiCummulativeTileWidth = 0;
+      for(p=0; p < pcPic->getPicSym()->getNumColumnsMinus1(); p++)
+      {
+        pcPic->getPicSym()->getTComTile( j * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + p )->setTileWidth( pcSlice->getPPS()->getColumnWidth(p) );
+        uiCummulativeTileWidth += pcSlice->getPPS()->getColumnWidth(p);
+      }
+      pcPic->getPicSym()->getTComTile(j * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + p)->setTileWidth( pcPic->getPicSym()->getFrameWidthInCU()-uiCummulativeTileWidth );
+    }
+
+    //set the height for each tile
+    for(j=0; j < pcPic->getPicSym()->getNumColumnsMinus1()+1; j++)
+    {
+      uiCummulativeTileHeight = 0;
+      for(p=0; p < pcPic->getPicSym()->getNumRowsMinus1(); p++)
+      {
+        pcPic->getPicSym()->getTComTile( p * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + j )->setTileHeight( pcSlice->getPPS()->getRowHeight(p) );
+        uiCummulativeTileHeight += pcSlice->getPPS()->getRowHeight(p);
+      }
+      pcPic->getPicSym()->getTComTile(p * (pcPic->getPicSym()->getNumColumnsMinus1()+1) + j)->setTileHeight( pcPic->getPicSym()->getFrameHeightInCU()-uiCummulativeTileHeight );
+    }
+  }
+  //intialize each tile of the current picture
+  pcPic->getPicSym()->xInitTiles();
+
+  // Allocate some coders, now we know how many tiles there are.
+  Int iNumSubstreams = pcSlice->getPPS()->getNumSubstreams();
+
+  //generate the Coding Order Map and Inverse Coding Order Map
+  for(p=0, uiEncCUAddr=0; p<pcPic->getPicSym()->getNumberOfCUsInFrame(); p++, uiEncCUAddr = pcPic->getPicSym()->xCalculateNxtCUAddr(uiEncCUAddr))
+  {
+    pcPic->getPicSym()->setCUOrderMap(p, uiEncCUAddr);
+    pcPic->getPicSym()->setInverseCUOrderMap(uiEncCUAddr, p);
+  }
+  pcPic->getPicSym()->setCUOrderMap(pcPic->getPicSym()->getNumberOfCUsInFrame(), pcPic->getPicSym()->getNumberOfCUsInFrame());
+  pcPic->getPicSym()->setInverseCUOrderMap(pcPic->getPicSym()->getNumberOfCUsInFrame(), pcPic->getPicSym()->getNumberOfCUsInFrame());
+
+  // Allocate some coders, now we know how many tiles there are.
+  m_pcEncTop->createWPPCoders(iNumSubstreams);
+
+  rcPicture.m_iGOPid           = iGOPid;
+  rcPicture.m_iPOC             = pocCurr;
+  rcPicture.m_iLastIDR         = m_iLastIDR;
+  rcPicture.m_pcPic            = pcPic;
+  rcPicture.m_pcPicYuvRecOut   = pcPicYuvRecOut;
+  rcPicture.m_pcAccessUnit     = &accessUnit;
+  rcPicture.m_pcSliceEncoder   = pcSliceEncoder;
+  rcPicture.m_pcFrameWorker    = pcFrameWorker;
+  rcPicture.m_uiRealEndAddress = uiRealEndAddress;
+  rcPicture.m_uiNumSlices      = uiNumSlices;
+#if RATE_CONTROL_LAMBDA_DOMAIN
+  rcPicture.m_dLambda          = lambda;
+  rcPicture.m_iEstimatedBits   = estimatedBits;
+#endif
+  rcPicture.m_bCompressed      = false;
+  return true;
+}
+
+/** Compress a prepared picture: determine the slice boundaries and compress the slices.
+ * \param rcPicture picture in flight
+ */
+Void TEncGOP::xCompressPicture( TEncGOPPicture& rcPicture )
+{
+  TComPic*   pcPic          = rcPicture.m_pcPic;
+  TComSlice* pcSlice        = pcPic->getSlice(0);
+  TEncSlice* pcSliceEncoder = rcPicture.m_pcSliceEncoder;
+
+  UInt startCUAddrSliceIdx = 0; // used to index "m_uiStoredStartCUAddrForEncodingSlice" containing locations of slice boundaries
+  UInt startCUAddrSlice    = 0; // used to keep track of current slice's starting CU addr.
+  pcSlice->setSliceCurStartCUAddr( startCUAddrSlice ); // Setting "start CU addr" for current slice
+  rcPicture.m_storedStartCUAddrForEncodingSlice.clear();
+
+  UInt startCUAddrSliceSegmentIdx = 0; // used to index "m_uiStoredStartCUAddrForEntropyEncodingSlice" containing locations of slice boundaries
+  UInt startCUAddrSliceSegment    = 0; // used to keep track of current Dependent slice's starting CU addr.
+  pcSlice->setSliceSegmentCurStartCUAddr( startCUAddrSliceSegment ); // Setting "start CU addr" for current Dependent slice
+
+  rcPicture.m_storedStartCUAddrForEncodingSliceSegment.clear();
+  UInt nextCUAddr = 0;
+  rcPicture.m_storedStartCUAddrForEncodingSlice.push_back (nextCUAddr);
+  startCUAddrSliceIdx++;
+  rcPicture.m_storedStartCUAddrForEncodingSliceSegment.push_back(nextCUAddr);
+  startCUAddrSliceSegmentIdx++;
+
+  while(nextCUAddr<rcPicture.m_uiRealEndAddress) // determine slice boundaries
+  {
+    pcSlice->setNextSlice       ( false );
+    pcSlice->setNextSliceSegment( false );
+    assert(pcPic->getNumAllocatedSlice() == startCUAddrSliceIdx);
+    pcSliceEncoder->precompressSlice( pcPic );
+    pcSliceEncoder->compressSlice   ( pcPic );
+
+    Bool bNoBinBitConstraintViolated = (!pcSlice->isNextSlice() && !pcSlice->isNextSliceSegment());
+    if (pcSlice->isNextSlice() || (bNoBinBitConstraintViolated && m_pcCfg->getSliceMode()==FIXED_NUMBER_OF_LCU))
+    {
+      startCUAddrSlice = pcSlice->getSliceCurEndCUAddr();
+      // Reconstruction slice
+      rcPicture.m_storedStartCUAddrForEncodingSlice.push_back(startCUAddrSlice);
+      startCUAddrSliceIdx++;
+      // Dependent slice
+      if (startCUAddrSliceSegmentIdx>0 && rcPicture.m_storedStartCUAddrForEncodingSliceSegment[startCUAddrSliceSegmentIdx-1] != startCUAddrSlice)
+      {
+        rcPicture.m_storedStartCUAddrForEncodingSliceSegment.push_back(startCUAddrSlice);
+        startCUAddrSliceSegmentIdx++;
+      }
+
+      if (startCUAddrSlice < rcPicture.m_uiRealEndAddress)
+      {
+        pcPic->allocateNewSlice();
+        pcPic->setCurrSliceIdx                  ( startCUAddrSliceIdx-1 );
+        pcSliceEncoder->setSliceIdx           ( startCUAddrSliceIdx-1 );
+        pcSlice = pcPic->getSlice               ( startCUAddrSliceIdx-1 );
+        pcSlice->copySliceInfo                  ( pcPic->getSlice(0)      );
+        pcSlice->setSliceIdx                    ( startCUAddrSliceIdx-1 );
+        pcSlice->setSliceCurStartCUAddr         ( startCUAddrSlice      );
+        pcSlice->setSliceSegmentCurStartCUAddr  ( startCUAddrSlice      );
+        pcSlice->setSliceBits(0);
+        rcPicture.m_uiNumSlices++;
+      }
+    }
+    else if (pcSlice->isNextSliceSegment() || (bNoBinBitConstraintViolated && m_pcCfg->getSliceSegmentMode()==FIXED_NUMBER_OF_LCU))
+    {
+      startCUAddrSliceSegment                                                     = pcSlice->getSliceSegmentCurEndCUAddr();
+      rcPicture.m_storedStartCUAddrForEncodingSliceSegment.push_back(startCUAddrSliceSegment);
+      startCUAddrSliceSegmentIdx++;
+      pcSlice->setSliceSegmentCurStartCUAddr( startCUAddrSliceSegment );
+    }
+    else
+    {
+      startCUAddrSlice                                                            = pcSlice->getSliceCurEndCUAddr();
+      startCUAddrSliceSegment                                                     = pcSlice->getSliceSegmentCurEndCUAddr();
+    }
+
+    nextCUAddr = (startCUAddrSlice > startCUAddrSliceSegment) ? startCUAddrSlice : startCUAddrSliceSegment;
+  }
+  rcPicture.m_storedStartCUAddrForEncodingSlice.push_back( pcSlice->getSliceCurEndCUAddr());
+  startCUAddrSliceIdx++;
+  rcPicture.m_storedStartCUAddrForEncodingSliceSegment.push_back(pcSlice->getSliceCurEndCUAddr());
+  startCUAddrSliceSegmentIdx++;
+
+  rcPicture.m_bCompressed = true;
+}
+
+/** Compress one picture of the current batch (thread pool job).
+ * \param iPictureIdx index of the picture within the batch
+ * \param iThreadIdx  index of the executing thread
+ */
+Void TEncGOP::xCompressPictureJob( Int iPictureIdx, Int iThreadIdx )
+{
+  xCompressPicture( *m_apcPictureBatch[iPictureIdx] );
+}
+
+/** Check whether a picture in flight references one of the pictures of the current batch.
+ * \param rcPicture picture in flight
+ * \returns true if a reference picture of the picture belongs to the batch
+ */
+Bool TEncGOP::xReferencesPictureBatch( TEncGOPPicture& rcPicture )
+{
+  TComSlice* pcSlice = rcPicture.m_pcPic->getSlice(0);
+
+  for ( Int iList = 0; iList < 2; iList++ )
+  {
+    RefPicList eRefPicList = RefPicList( iList );
+    for ( Int iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx( eRefPicList ); iRefIdx++ )
+    {
+      for ( UInt ui = 0; ui < m_apcPictureBatch.size(); ui++ )
+      {
+        if ( pcSlice->getRefPic( eRefPicList, iRefIdx ) == m_apcPictureBatch[ui]->m_pcPic )
+        {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+/** Compress the pictures in flight once enough of them have been prepared.
+ * The pictures are compressed in batches of consecutive pictures that do not reference each other. A batch is
+ * compressed when the next prepared picture references one of its pictures, when it holds ParallelFrames pictures
+ * or when the whole GOP has been prepared, and its pictures are distributed over the threads. The pictures are
+ * written in coding order afterwards, so that a picture is in-loop filtered before any picture referencing it is
+ * compressed.
+ * \param bFlush all the pictures of the GOP have been prepared
+ * \returns true if the first picture in flight is compressed and can be written
+ */
+Bool TEncGOP::xCompressPictures( Bool bFlush )
+{
+  if ( m_cPicturesInFlight.empty() )
+  {
+    return false;
+  }
+  if ( m_cPicturesInFlight.front().m_bCompressed )
+  {
+    return true;
+  }
+
+  m_apcPictureBatch.clear();
+  Bool bReferenced = false;
+  for ( std::list<TEncGOPPicture>::iterator it = m_cPicturesInFlight.begin(); it != m_cPicturesInFlight.end() && !bReferenced; it++ )
+  {
+    bReferenced = xReferencesPictureBatch( *it );
+    if ( !bReferenced )
+    {
+      m_apcPictureBatch.push_back( &(*it) );
+    }
+  }
+  if ( !bReferenced && !bFlush && (Int)m_apcPictureBatch.size() < m_pcCfg->getNumParallelFrames() )
+  {
+    return false;
+  }
+
+  const Int       iNumPictures = (Int)m_apcPictureBatch.size();
+  TComThreadPool* pcThreadPool = m_pcEncTop->getThreadPool();
+
+  // the threads are used for the CTUs of a picture compressed alone
+  for ( Int i = 0; i < iNumPictures; i++ )
+  {
+    m_apcPictureBatch[i]->m_pcSliceEncoder->setParallelCTUs( iNumPictures == 1 );
+  }
+
+  if ( iNumPictures > 1 && pcThreadPool->getNumThreads() > 1 )
+  {
+    TComMemberJob<TEncGOP> cPictureJob( this, &TEncGOP::xCompressPictureJob );
+    pcThreadPool->execute( &cPictureJob, iNumPictures );
+  }
+  else
+  {
+    for ( Int i = 0; i < iNumPictures; i++ )
+    {
+      xCompressPicture( *m_apcPictureBatch[i] );
+    }
+  }
+  return true;
+}
+
 Void TEncGOP::printOutSummary(UInt uiNumAllPicCoded, Bool isField, const Bool printMSEBasedSNR)
 {
   assert (uiNumAllPicCoded == m_gcAnalyzeAll.getNumPic());
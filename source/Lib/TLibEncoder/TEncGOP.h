@@ -62,11 +62,35 @@
 //! \{
 
 class TEncTop;
+class TEncFrameWorker;
 
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
 
+/// picture of the GOP between its preparation and the writing of its access unit
+struct TEncGOPPicture
+{
+  Int                     m_iGOPid;                       ///< index of the picture in the GOP structure
+  Int                     m_iPOC;                         ///< POC of the picture
+  Int                     m_iLastIDR;                     ///< POC of the last IDR picture when the picture was prepared
+  long                    m_iBeforeTime;                  ///< start time of the picture, for the timing output
+  TComPic*                m_pcPic;                        ///< picture
+  TComPicYuv*             m_pcPicYuvRecOut;               ///< reconstruction output buffer
+  AccessUnit*             m_pcAccessUnit;                 ///< access unit of the picture
+  TEncSlice*              m_pcSliceEncoder;               ///< slice encoder compressing the picture
+  TEncFrameWorker*        m_pcFrameWorker;                ///< owner of the slice encoder, NULL for the one of the encoder class
+  UInt                    m_uiRealEndAddress;             ///< address following the last partition of the picture
+  UInt                    m_uiNumSlices;                  ///< number of slices of the picture
+  std::vector<Int>        m_storedStartCUAddrForEncodingSlice;
+  std::vector<Int>        m_storedStartCUAddrForEncodingSliceSegment;
+#if RATE_CONTROL_LAMBDA_DOMAIN
+  Double                  m_dLambda;                      ///< rate control: estimated picture lambda
+  Int                     m_iEstimatedBits;               ///< rate control: target bits of the picture
+#endif
+  Bool                    m_bCompressed;                  ///< the slices of the picture have been compressed
+};
+
 /// GOP encoder class
 static const UInt MAX_NUM_LONG_TERM_REF_PICS=33;
 
@@ -108,8 +132,10 @@ private:
   // clean decoding refresh
   Bool                    m_bRefreshPending;
   Int                     m_pocCRA;
-  std::vector<Int>        m_storedStartCUAddrForEncodingSlice;
-  std::vector<Int>        m_storedStartCUAddrForEncodingSliceSegment;
+
+  // parallel pictures
+  std::list<TEncGOPPicture>    m_cPicturesInFlight;       ///< prepared pictures that have not been written, in coding order
+  std::vector<TEncGOPPicture*> m_apcPictureBatch;         ///< pictures compressed at the same time
 
   std::vector<Int> m_vRVM_RP;
   UInt                    m_lastBPSEI;
@@ -158,6 +184,13 @@ protected:
   Void  xInitGOP          ( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRecOut, Bool isField );
   Void  xInitGOP          ( Int iPOC, Int iNumPicRcvd, TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRecOut );
   Void  xGetBuffer        ( TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRecOut, Int iNumPicRcvd, Int iTimeOffset, TComPic*& rpcPic, TComPicYuv*& rpcPicYuvRecOut, Int pocCurr, Bool isField );
+
+  Bool  xPreparePicture   ( TEncGOPPicture& rcPicture, Int iGOPid, Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rcListPic,
+                            TComList<TComPicYuv*>& rcListPicYuvRecOut, std::list<AccessUnit>& accessUnitsInGOP, Bool isField );
+  Void  xCompressPicture  ( TEncGOPPicture& rcPicture );
+  Void  xCompressPictureJob    ( Int iPictureIdx, Int iThreadIdx );
+  Bool  xReferencesPictureBatch( TEncGOPPicture& rcPicture );
+  Bool  xCompressPictures ( Bool bFlush );
   
 #if RExt__COLOUR_SPACE_CONVERSIONS
   Void  xCalculateAddPSNR          ( TComPic* pcPic, TComPicYuv* pcPicD, const AccessUnit&, Double dEncTime, const InputColourSpaceConversion snr_conversion );
@@ -36,6 +36,7 @@
  \brief       estimation part of sample adaptive offset class
  */
 #include "TEncSampleAdaptiveOffset.h"
+#include "TLibCommon/TComSimd.h"
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -59,6 +60,10 @@ TEncSampleAdaptiveOffset::TEncSampleAdaptiveOffset()
   m_dCostPartBest = NULL;
   m_iDistOrg = NULL;
   m_iTypePartBest = NULL;
+  m_count_PreDblk = NULL;
+  m_offsetOrg_PreDblk = NULL;
+  m_countCtu = NULL;
+  m_offsetOrgCtu = NULL;
 }
 TEncSampleAdaptiveOffset::~TEncSampleAdaptiveOffset()
 {
@@ -524,6 +529,8 @@ Void TEncSampleAdaptiveOffset::destroyEncBuffer()
         {
           delete [] m_offsetOrg_PreDblk[i][j][k];
         }
+        delete [] m_countCtu    [i][j][k];
+        delete [] m_offsetOrgCtu[i][j][k];
       }
       if (m_count_PreDblk [i][j])
       {
@@ -533,6 +540,8 @@ Void TEncSampleAdaptiveOffset::destroyEncBuffer()
       {
         delete [] m_offsetOrg_PreDblk[i][j];
       }
+      delete [] m_countCtu    [i][j];
+      delete [] m_offsetOrgCtu[i][j];
     }
     if (m_count_PreDblk [i])
     {
@@ -542,6 +551,8 @@ Void TEncSampleAdaptiveOffset::destroyEncBuffer()
     {
       delete [] m_offsetOrg_PreDblk[i];
     }
+    delete [] m_countCtu    [i];
+    delete [] m_offsetOrgCtu[i];
   }
   if (m_count_PreDblk)
   {
@@ -551,6 +562,14 @@ Void TEncSampleAdaptiveOffset::destroyEncBuffer()
   {
     delete [] m_offsetOrg_PreDblk ; m_offsetOrg_PreDblk = NULL;
   }
+  if (m_countCtu)
+  {
+    delete [] m_countCtu ; m_countCtu = NULL;
+  }
+  if (m_offsetOrgCtu)
+  {
+    delete [] m_offsetOrgCtu ; m_offsetOrgCtu = NULL;
+  }
 
   Int iMaxDepth = 4;
   Int iDepth;
@@ -611,20 +630,28 @@ Void TEncSampleAdaptiveOffset::createEncBuffer()
   Int numLcu = m_iNumCuInWidth * m_iNumCuInHeight;
   m_count_PreDblk  = new Int64 ***[numLcu];
   m_offsetOrg_PreDblk = new Int64 ***[numLcu];
+  m_countCtu       = new Int64 ***[numLcu];
+  m_offsetOrgCtu   = new Int64 ***[numLcu];
   for (Int i=0; i<numLcu; i++)
   {
     m_count_PreDblk[i]  = new Int64 **[3];
     m_offsetOrg_PreDblk[i] = new Int64 **[3];
+    m_countCtu[i]       = new Int64 **[3];
+    m_offsetOrgCtu[i]   = new Int64 **[3];
 
     for (Int j=0;j<3;j++)
     {
       m_count_PreDblk [i][j] = new Int64 *[MAX_NUM_SAO_TYPE];
       m_offsetOrg_PreDblk[i][j] = new Int64 *[MAX_NUM_SAO_TYPE];
+      m_countCtu      [i][j] = new Int64 *[MAX_NUM_SAO_TYPE];
+      m_offsetOrgCtu  [i][j] = new Int64 *[MAX_NUM_SAO_TYPE];
 
       for (Int k=0;k<MAX_NUM_SAO_TYPE;k++)
       {
         m_count_PreDblk [i][j][k]   = new Int64 [MAX_NUM_SAO_CLASS];
         m_offsetOrg_PreDblk[i][j][k]= new Int64 [MAX_NUM_SAO_CLASS];
+        m_countCtu      [i][j][k]   = new Int64 [MAX_NUM_SAO_CLASS];
+        m_offsetOrgCtu  [i][j][k]   = new Int64 [MAX_NUM_SAO_CLASS];
       }
     }
   }
@@ -692,6 +719,229 @@ inline Int xSign(Int x)
   return ((x >> 31) | ((Int)( (((UInt) -x)) >> 31)));
 }
 
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+// ====================================================================================================================
+// SIMD functions
+// ====================================================================================================================
+
+// Eight samples are processed at a time in 16-bit lanes. The per-lane sums and counts are folded into the 64-bit
+// statistics every SAO_STATS_ROWS rows, before they can overflow.
+
+#define SAO_STATS_ROWS 16
+
+/** sum of the 32-bit lanes
+ */
+static inline SIMD_TARGET_SSE41 Int xHorizontalSumSSE41( __m128i v )
+{
+  v = _mm_add_epi32( v, _mm_shuffle_epi32( v, 0x4e ) );
+  v = _mm_add_epi32( v, _mm_shuffle_epi32( v, 0xb1 ) );
+  return _mm_cvtsi128_si32( v );
+}
+
+/** accumulate edge offset statistics of a rectangle of samples
+ * \param pRec       top-left sample of the rectangle before SAO
+ * \param pOrg       top-left sample of the rectangle in the original picture
+ * \param stride     picture buffer stride
+ * \param width      rectangle width
+ * \param height     rectangle height
+ * \param upOffset   offset of the first neighbour of the edge class
+ * \param downOffset offset of the second neighbour of the edge class
+ * \param stats      statistics buffer of the edge class
+ * \param count      counter buffer of the edge class
+ * \param eoTable    mapping from edge type to class
+ */
+static SIMD_TARGET_SSE41 Void xSaoEdgeStatsSSE41( const Pel* pRec, const Pel* pOrg, Int stride, Int width, Int height, Int upOffset, Int downOffset,
+                                                  Int64* stats, Int64* count, const UInt* eoTable )
+{
+  const __m128i one    = _mm_set1_epi16( 1 );
+  const Int     width8 = width & ~7;
+  Int64 diffSum[SAO_EO_LEN+1] = { 0, 0, 0, 0, 0 };
+  Int64 numSamples[SAO_EO_LEN+1] = { 0, 0, 0, 0, 0 };
+
+  for (Int y0 = 0; y0 < height; y0 += SAO_STATS_ROWS)
+  {
+    const Int y1 = min( y0 + SAO_STATS_ROWS, height );
+    __m128i vSum[SAO_EO_LEN+1];
+    __m128i vCount[SAO_EO_LEN+1];
+    for (Int k = 0; k <= SAO_EO_LEN; k++)
+    {
+      vSum[k]   = _mm_setzero_si128();
+      vCount[k] = _mm_setzero_si128();
+    }
+
+    for (Int y = y0; y < y1; y++)
+    {
+      const Pel* rec = pRec + y * stride;
+      const Pel* org = pOrg + y * stride;
+      Int x = 0;
+      for (; x < width8; x += 8)
+      {
+        const __m128i c = _mm_loadu_si128( (const __m128i*)(rec + x) );
+        const __m128i u = _mm_loadu_si128( (const __m128i*)(rec + x + upOffset) );
+        const __m128i d = _mm_loadu_si128( (const __m128i*)(rec + x + downOffset) );
+        const __m128i diff = _mm_sub_epi16( _mm_loadu_si128( (const __m128i*)(org + x) ), c );
+
+        // edge type - 2 = sign(c-u) + sign(c-d), with sign(a-b) = (a>b) - (a<b) from the all-ones compare masks
+        __m128i e = _mm_sub_epi16( _mm_cmpgt_epi16( u, c ), _mm_cmpgt_epi16( c, u ) );
+        e = _mm_add_epi16( e, _mm_sub_epi16( _mm_cmpgt_epi16( d, c ), _mm_cmpgt_epi16( c, d ) ) );
+
+        for (Int k = 0; k <= SAO_EO_LEN; k++)
+        {
+          const __m128i mask = _mm_cmpeq_epi16( e, _mm_set1_epi16( k - 2 ) );
+          vCount[k] = _mm_sub_epi16( vCount[k], mask );
+          vSum[k]   = _mm_add_epi32( vSum[k], _mm_madd_epi16( _mm_and_si128( mask, diff ), one ) );
+        }
+      }
+      for (; x < width; x++)
+      {
+        const Int edgeType = xSign( rec[x] - rec[x+upOffset] ) + xSign( rec[x] - rec[x+downOffset] ) + 2;
+        diffSum[edgeType] += org[x] - rec[x];
+        numSamples[edgeType]++;
+      }
+    }
+
+    for (Int k = 0; k <= SAO_EO_LEN; k++)
+    {
+      diffSum[k]    += xHorizontalSumSSE41( vSum[k] );
+      numSamples[k] += xHorizontalSumSSE41( _mm_madd_epi16( vCount[k], one ) );
+    }
+  }
+
+  for (Int k = 0; k <= SAO_EO_LEN; k++)
+  {
+    stats[eoTable[k]] += diffSum[k];
+    count[eoTable[k]] += numSamples[k];
+  }
+}
+
+/** accumulate band offset statistics of a rectangle of samples
+ * \param pRec   top-left sample of the rectangle before SAO
+ * \param pOrg   top-left sample of the rectangle in the original picture
+ * \param stride picture buffer stride
+ * \param width  rectangle width
+ * \param height rectangle height
+ * \param shift  shift from a sample value to its band
+ * \param stats  band offset statistics buffer, indexed by band + 1
+ * \param count  band offset counter buffer, indexed by band + 1
+ *
+ * The bands and differences are computed eight samples at a time and gathered into four interleaved histograms, so
+ * that runs of samples in the same band do not serialise on a single counter.
+ */
+static SIMD_TARGET_SSE41 Void xSaoBandStatsSSE41( const Pel* pRec, const Pel* pOrg, Int stride, Int width, Int height, Int shift,
+                                                  Int64* stats, Int64* count )
+{
+  const __m128i vShift = _mm_cvtsi32_si128( shift );
+  const Int     width8 = width & ~7;
+  Short band[8];
+  Short diff[8];
+
+  for (Int y0 = 0; y0 < height; y0 += SAO_STATS_ROWS)
+  {
+    const Int y1 = min( y0 + SAO_STATS_ROWS, height );
+    Int diffSum[4][SAO_MAX_BO_CLASSES];
+    Int numSamples[4][SAO_MAX_BO_CLASSES];
+    memset( diffSum, 0, sizeof(diffSum) );
+    memset( numSamples, 0, sizeof(numSamples) );
+
+    for (Int y = y0; y < y1; y++)
+    {
+      const Pel* rec = pRec + y * stride;
+      const Pel* org = pOrg + y * stride;
+      Int x = 0;
+      for (; x < width8; x += 8)
+      {
+        const __m128i c = _mm_loadu_si128( (const __m128i*)(rec + x) );
+        _mm_storeu_si128( (__m128i*)band, _mm_srl_epi16( c, vShift ) );
+        _mm_storeu_si128( (__m128i*)diff, _mm_sub_epi16( _mm_loadu_si128( (const __m128i*)(org + x) ), c ) );
+        for (Int i = 0; i < 8; i++)
+        {
+          diffSum[i&3][band[i]] += diff[i];
+          numSamples[i&3][band[i]]++;
+        }
+      }
+      for (; x < width; x++)
+      {
+        diffSum[0][rec[x] >> shift] += org[x] - rec[x];
+        numSamples[0][rec[x] >> shift]++;
+      }
+    }
+
+    for (Int b = 0; b < SAO_MAX_BO_CLASSES; b++)
+    {
+      stats[b+1] += diffSum[0][b] + diffSum[1][b] + diffSum[2][b] + diffSum[3][b];
+      count[b+1] += numSamples[0][b] + numSamples[1][b] + numSamples[2][b] + numSamples[3][b];
+    }
+  }
+}
+
+/** calculate SAO statistics of a block, covering the same samples as the scalar code of calcSaoStatsBlock()
+ * \param  pRec          to-be-filtered block buffer pointer
+ * \param  pOrg          original block buffer pointer
+ * \param  stride        picture buffer stride
+ * \param  ppStats       statistics buffer
+ * \param  ppCount       counter buffer
+ * \param  width         block width
+ * \param  height        block height, at least 2
+ * \param  pbBorderAvail availabilities of block border pixels
+ * \param  bitDepth      sample bit depth
+ * \param  eoTable       mapping from edge type to class
+ */
+static Void xSaoStatsBlockSSE41( const Pel* pRec, const Pel* pOrg, Int stride, Int64** ppStats, Int64** ppCount, Int width, Int height,
+                                 const Bool* pbBorderAvail, Int bitDepth, const UInt* eoTable )
+{
+  const Int startX = (pbBorderAvail[SGU_L]) ? 0 : 1;
+  const Int endX   = (pbBorderAvail[SGU_R]) ? width : (width - 1);
+  const Int startY = (pbBorderAvail[SGU_T]) ? 0 : 1;
+  const Int endY   = (pbBorderAvail[SGU_B]) ? height : (height - 1);
+  const Int last   = (height - 1) * stride;
+  Int up;
+
+  xSaoBandStatsSSE41( pRec, pOrg, stride, width, height, bitDepth - SAO_BO_BITS, ppStats[SAO_BO], ppCount[SAO_BO] );
+
+  xSaoEdgeStatsSSE41( pRec + startX, pOrg + startX, stride, endX - startX, height, -1, 1, ppStats[SAO_EO_0], ppCount[SAO_EO_0], eoTable );
+
+  xSaoEdgeStatsSSE41( pRec + startY * stride, pOrg + startY * stride, stride, width, endY - startY, -stride, stride, ppStats[SAO_EO_1], ppCount[SAO_EO_1], eoTable );
+
+  up = -stride - 1;
+  if (pbBorderAvail[SGU_TL])
+  {
+    xSaoEdgeStatsSSE41( pRec, pOrg, stride, 1, 1, up, -up, ppStats[SAO_EO_2], ppCount[SAO_EO_2], eoTable );
+  }
+  if (pbBorderAvail[SGU_T])
+  {
+    xSaoEdgeStatsSSE41( pRec + 1, pOrg + 1, stride, endX - 1, 1, up, -up, ppStats[SAO_EO_2], ppCount[SAO_EO_2], eoTable );
+  }
+  xSaoEdgeStatsSSE41( pRec + stride + startX, pOrg + stride + startX, stride, endX - startX, height - 2, up, -up, ppStats[SAO_EO_2], ppCount[SAO_EO_2], eoTable );
+  if (pbBorderAvail[SGU_B])
+  {
+    xSaoEdgeStatsSSE41( pRec + last + startX, pOrg + last + startX, stride, width - 1 - startX, 1, up, -up, ppStats[SAO_EO_2], ppCount[SAO_EO_2], eoTable );
+  }
+  if (pbBorderAvail[SGU_BR])
+  {
+    xSaoEdgeStatsSSE41( pRec + last + width - 1, pOrg + last + width - 1, stride, 1, 1, up, -up, ppStats[SAO_EO_2], ppCount[SAO_EO_2], eoTable );
+  }
+
+  up = -stride + 1;
+  if (pbBorderAvail[SGU_T])
+  {
+    xSaoEdgeStatsSSE41( pRec + startX, pOrg + startX, stride, width - 1 - startX, 1, up, -up, ppStats[SAO_EO_3], ppCount[SAO_EO_3], eoTable );
+  }
+  if (pbBorderAvail[SGU_TR])
+  {
+    xSaoEdgeStatsSSE41( pRec + width - 1, pOrg + width - 1, stride, 1, 1, up, -up, ppStats[SAO_EO_3], ppCount[SAO_EO_3], eoTable );
+  }
+  xSaoEdgeStatsSSE41( pRec + stride + startX, pOrg + stride + startX, stride, endX - startX, height - 2, up, -up, ppStats[SAO_EO_3], ppCount[SAO_EO_3], eoTable );
+  if (pbBorderAvail[SGU_BL])
+  {
+    xSaoEdgeStatsSSE41( pRec + last, pOrg + last, stride, 1, 1, up, -up, ppStats[SAO_EO_3], ppCount[SAO_EO_3], eoTable );
+  }
+  if (pbBorderAvail[SGU_B])
+  {
+    xSaoEdgeStatsSSE41( pRec + last + 1, pOrg + last + 1, stride, endX - 1, 1, up, -up, ppStats[SAO_EO_3], ppCount[SAO_EO_3], eoTable );
+  }
+}
+#endif
+
 /** Calculate SAO statistics for non-cross-slice or non-cross-tile processing
  * \param  pRecStart to-be-filtered block buffer pointer
  * \param  pOrgStart original block buffer pointer
@@ -704,6 +954,11 @@ inline Int xSign(Int x)
  */
 Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart, Int stride, Int64** ppStats, Int64** ppCount, UInt width, UInt height, Bool* pbBorderAvail, ComponentID iYCbCr)
 {
+  Int  upBuff1Base[MAX_CU_SIZE+2];
+  Int  upBufftBase[MAX_CU_SIZE+2];
+  Int* upBuff1 = upBuff1Base + 1;   // line buffers of this call, so that CTUs can be processed concurrently
+  Int* upBufft = upBufftBase + 1;
+  Int* swapBuff;
   Int64 *stats, *count;
   Int classIdx, posShift, startX, endX, startY, endY, signLeft,signRight,signDown,signDown1;
   Pel *pOrg, *pRec;
@@ -711,6 +966,14 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
   Int x, y;
   Pel *pTableBo = m_aTableBo[toChannelType(iYCbCr)];
 
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+  if (TComSimd::getLevel() != SIMD_SCALAR && height > 1)
+  {
+    xSaoStatsBlockSSE41(pRecStart, pOrgStart, stride, ppStats, ppCount, width, height, pbBorderAvail, g_bitDepth[toChannelType(iYCbCr)], m_auiEoTable);
+    return;
+  }
+#endif
+
   //--------- Band offset-----------//
   stats = ppStats[SAO_BO];
   count = ppCount[SAO_BO];
@@ -771,15 +1034,15 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
 
   for (x=0; x< width; x++)
   {
-    m_iUpBuff1[x] = xSign(pRec[x] - pRec[x-stride]);
+    upBuff1[x] = xSign(pRec[x] - pRec[x-stride]);
   }
   for (y=startY; y<endY; y++)
   {
     for (x=0; x< width; x++)
     {
       signDown     =  xSign(pRec[x] - pRec[x+stride]);
-      edgeType    =  signDown + m_iUpBuff1[x] + 2;
-      m_iUpBuff1[x] = -signDown;
+      edgeType    =  signDown + upBuff1[x] + 2;
+      upBuff1[x] = -signDown;
 
       stats[m_auiEoTable[edgeType]] += (pOrg[x] - pRec[x]);
       count[m_auiEoTable[edgeType]] ++;
@@ -802,7 +1065,7 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
   pRec += stride;
   for (x=startX; x< endX+1; x++)
   {
-    m_iUpBuff1[x] = xSign(pRec[x] - pRec[x- posShift]);
+    upBuff1[x] = xSign(pRec[x] - pRec[x- posShift]);
   }
 
   //1st line
@@ -810,7 +1073,7 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
   if(pbBorderAvail[SGU_TL])
   {
     x= 0;
-    edgeType      =  xSign(pRec[x] - pRec[x- posShift]) - m_iUpBuff1[x+1] + 2;
+    edgeType      =  xSign(pRec[x] - pRec[x- posShift]) - upBuff1[x+1] + 2;
     stats[m_auiEoTable[edgeType]] += (pOrg[x] - pRec[x]);
     count[m_auiEoTable[edgeType]] ++;
   }
@@ -818,7 +1081,7 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
   {
     for(x= 1; x< endX; x++)
     {
-      edgeType      =  xSign(pRec[x] - pRec[x- posShift]) - m_iUpBuff1[x+1] + 2;
+      edgeType      =  xSign(pRec[x] - pRec[x- posShift]) - upBuff1[x+1] + 2;
       stats[m_auiEoTable[edgeType]] += (pOrg[x] - pRec[x]);
       count[m_auiEoTable[edgeType]] ++;
     }
@@ -832,17 +1095,17 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
     for (x=startX; x<endX; x++)
     {
       signDown1      =  xSign(pRec[x] - pRec[x+ posShift]) ;
-      edgeType      =  signDown1 + m_iUpBuff1[x] + 2;
+      edgeType      =  signDown1 + upBuff1[x] + 2;
       stats[m_auiEoTable[edgeType]] += (pOrg[x] - pRec[x]);
       count[m_auiEoTable[edgeType]] ++;
 
-      m_iUpBufft[x+1] = -signDown1;
+      upBufft[x+1] = -signDown1;
     }
-    m_iUpBufft[startX] = xSign(pRec[stride+startX] - pRec[startX-1]);
+    upBufft[startX] = xSign(pRec[stride+startX] - pRec[startX-1]);
 
-    ipSwap     = m_iUpBuff1;
-    m_iUpBuff1 = m_iUpBufft;
-    m_iUpBufft = ipSwap;
+    swapBuff = upBuff1;
+    upBuff1  = upBufft;
+    upBufft  = swapBuff;
 
     pRec  += stride;
     pOrg  += stride;
@@ -853,7 +1116,7 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
   {
     for(x= startX; x< width-1; x++)
     {
-      edgeType =  xSign(pRec[x] - pRec[x+ posShift]) + m_iUpBuff1[x] + 2;
+      edgeType =  xSign(pRec[x] - pRec[x+ posShift]) + upBuff1[x] + 2;
       stats[m_auiEoTable[edgeType]] += (pOrg[x] - pRec[x]);
       count[m_auiEoTable[edgeType]] ++;
     }
@@ -861,7 +1124,7 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
   if(pbBorderAvail[SGU_BR])
   {
     x= width -1;
-    edgeType =  xSign(pRec[x] - pRec[x+ posShift]) + m_iUpBuff1[x] + 2;
+    edgeType =  xSign(pRec[x] - pRec[x+ posShift]) + upBuff1[x] + 2;
     stats[m_auiEoTable[edgeType]] += (pOrg[x] - pRec[x]);
     count[m_auiEoTable[edgeType]] ++;
   }
@@ -881,7 +1144,7 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
   pRec += stride;
   for (x=startX-1; x< endX; x++)
   {
-    m_iUpBuff1[x] = xSign(pRec[x] - pRec[x- posShift]);
+    upBuff1[x] = xSign(pRec[x] - pRec[x- posShift]);
   }
 
 
@@ -891,7 +1154,7 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
   {
     for(x= startX; x< width -1; x++)
     {
-      edgeType = xSign(pRec[x] - pRec[x- posShift]) -m_iUpBuff1[x-1] + 2;
+      edgeType = xSign(pRec[x] - pRec[x- posShift]) -upBuff1[x-1] + 2;
       stats[m_auiEoTable[edgeType]] += (pOrg[x] - pRec[x]);
       count[m_auiEoTable[edgeType]] ++;
     }
@@ -899,7 +1162,7 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
   if(pbBorderAvail[SGU_TR])
   {
     x= width-1;
-    edgeType = xSign(pRec[x] - pRec[x- posShift]) -m_iUpBuff1[x-1] + 2;
+    edgeType = xSign(pRec[x] - pRec[x- posShift]) -upBuff1[x-1] + 2;
     stats[m_auiEoTable[edgeType]] += (pOrg[x] - pRec[x]);
     count[m_auiEoTable[edgeType]] ++;
   }
@@ -912,14 +1175,14 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
     for(x= startX; x< endX; x++)
     {
       signDown1      =  xSign(pRec[x] - pRec[x+ posShift]) ;
-      edgeType      =  signDown1 + m_iUpBuff1[x] + 2;
+      edgeType      =  signDown1 + upBuff1[x] + 2;
 
       stats[m_auiEoTable[edgeType]] += (pOrg[x] - pRec[x]);
       count[m_auiEoTable[edgeType]] ++;
-      m_iUpBuff1[x-1] = -signDown1;
+      upBuff1[x-1] = -signDown1;
 
     }
-    m_iUpBuff1[endX-1] = xSign(pRec[endX-1 + stride] - pRec[endX]);
+    upBuff1[endX-1] = xSign(pRec[endX-1 + stride] - pRec[endX]);
 
     pRec  += stride;
     pOrg  += stride;
@@ -929,7 +1192,7 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
   if(pbBorderAvail[SGU_BL])
   {
     x= 0;
-    edgeType = xSign(pRec[x] - pRec[x+ posShift]) + m_iUpBuff1[x] + 2;
+    edgeType = xSign(pRec[x] - pRec[x+ posShift]) + upBuff1[x] + 2;
     stats[m_auiEoTable[edgeType]] += (pOrg[x] - pRec[x]);
     count[m_auiEoTable[edgeType]] ++;
 
@@ -938,7 +1201,7 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
   {
     for(x= 1; x< endX; x++)
     {
-      edgeType = xSign(pRec[x] - pRec[x+ posShift]) + m_iUpBuff1[x] + 2;
+      edgeType = xSign(pRec[x] - pRec[x+ posShift]) + upBuff1[x] + 2;
       stats[m_auiEoTable[edgeType]] += (pOrg[x] - pRec[x]);
       count[m_auiEoTable[edgeType]] ++;
     }
@@ -946,19 +1209,19 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart
 }
 
 /** Calculate SAO statistics for current LCU
- * \param  iAddr,  iPartIdx,  iYCbCr
+ * \param  iAddr LCU address
+ * \param  iYCbCr color component index
+ * \param  ppStats statistics buffer the LCU is added to
+ * \param  ppCount counter buffer the LCU is added to
  */
-Void TEncSampleAdaptiveOffset::calcSaoStatsCu(Int iAddr, Int iPartIdx, ComponentID iYCbCr)
+Void TEncSampleAdaptiveOffset::calcSaoStatsCu(Int iAddr, ComponentID iYCbCr, Int64** ppStats, Int64** ppCount)
 {
   if(!m_bUseNIF)
   {
-    calcSaoStatsCuOrg( iAddr, iPartIdx, iYCbCr);
+    calcSaoStatsCuOrg( iAddr, iYCbCr, ppStats, ppCount);
   }
   else
   {
-    Int64** ppStats = m_iOffsetOrg[iPartIdx];
-    Int64** ppCount = m_iCount    [iPartIdx];
-
     //parameters
     Int  stride   = m_pcPic->getStride(iYCbCr);
     Pel* pPicOrg  = getPicYuvAddr (m_pcPic->getPicYuvOrg(), iYCbCr);
@@ -990,10 +1253,15 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCu(Int iAddr, Int iPartIdx, Component
 }
 
 /** Calculate SAO statistics for current LCU without non-crossing slice
- * \param  iAddr,  iPartIdx,  iYCbCr
+ * \param  iAddr,  iYCbCr,  ppStats,  ppCount
  */
-Void TEncSampleAdaptiveOffset::calcSaoStatsCuOrg(Int iAddr, Int iPartIdx, ComponentID iYCbCr)
+Void TEncSampleAdaptiveOffset::calcSaoStatsCuOrg(Int iAddr, ComponentID iYCbCr, Int64** ppStats, Int64** ppCount)
 {
+  Int  upBuff1Base[MAX_CU_SIZE+2];
+  Int  upBufftBase[MAX_CU_SIZE+2];
+  Int* upBuff1 = upBuff1Base + 1;
+  Int* upBufft = upBufftBase + 1;
+  Int* swapBuff;
   Int x,y;
   TComDataCU *pTmpCu = m_pcPic->getCU(iAddr);
   TComSPS *pTmpSPS =  m_pcPic->getSlice(0)->getSPS();
@@ -1057,8 +1325,8 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCuOrg(Int iAddr, Int iPartIdx, Compon
       numSkipLineRight = 4-(2*csx);
     }
 
-    iStats = m_iOffsetOrg[iPartIdx][SAO_BO];
-    iCount = m_iCount    [iPartIdx][SAO_BO];
+    iStats = ppStats[SAO_BO];
+    iCount = ppCount[SAO_BO];
 
     pOrg = getPicYuvAddr(m_pcPic->getPicYuvOrg(), iYCbCr, iAddr);
     pRec = getPicYuvAddr(m_pcPic->getPicYuvRec(), iYCbCr, iAddr);
@@ -1066,19 +1334,28 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCuOrg(Int iAddr, Int iPartIdx, Compon
     iEndX   = (uiRPelX == iPicWidthTmp) ? iLcuWidth : iLcuWidth-numSkipLineRight;
 
     iEndY   = (uiBPelY == iPicHeightTmp) ? iLcuHeight : iLcuHeight-numSkipLine;
-    for (y=0; y<iEndY; y++)
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+    if (TComSimd::getLevel() != SIMD_SCALAR)
+    {
+      xSaoBandStatsSSE41(pRec, pOrg, iStride, iEndX, iEndY, g_bitDepth[toChannelType(iYCbCr)] - SAO_BO_BITS, iStats, iCount);
+    }
+    else
+#endif
     {
-      for (x=0; x<iEndX; x++)
+      for (y=0; y<iEndY; y++)
       {
-        iClassIdx = pTableBo[pRec[x]];
-        if (iClassIdx)
+        for (x=0; x<iEndX; x++)
         {
-          iStats[iClassIdx] += (pOrg[x] - pRec[x]);
-          iCount[iClassIdx] ++;
+          iClassIdx = pTableBo[pRec[x]];
+          if (iClassIdx)
+          {
+            iStats[iClassIdx] += (pOrg[x] - pRec[x]);
+            iCount[iClassIdx] ++;
+          }
         }
+        pOrg += iStride;
+        pRec += iStride;
       }
-      pOrg += iStride;
-      pRec += iStride;
     }
 
   }
@@ -1100,28 +1377,37 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCuOrg(Int iAddr, Int iPartIdx, Compon
         numSkipLineRight = 5-(2*csx);
       }
 
-      iStats = m_iOffsetOrg[iPartIdx][SAO_EO_0];
-      iCount = m_iCount    [iPartIdx][SAO_EO_0];
+      iStats = ppStats[SAO_EO_0];
+      iCount = ppCount[SAO_EO_0];
 
       pOrg = getPicYuvAddr(m_pcPic->getPicYuvOrg(), iYCbCr, iAddr);
       pRec = getPicYuvAddr(m_pcPic->getPicYuvRec(), iYCbCr, iAddr);
 
       iStartX = (uiLPelX == 0) ? 1 : 0;
       iEndX   = (uiRPelX == iPicWidthTmp) ? iLcuWidth-1 : iLcuWidth-numSkipLineRight;
-      for (y=0; y<iLcuHeight-numSkipLine; y++)
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+      if (TComSimd::getLevel() != SIMD_SCALAR)
+      {
+        xSaoEdgeStatsSSE41(pRec + iStartX, pOrg + iStartX, iStride, iEndX - iStartX, iLcuHeight - numSkipLine, -1, 1, iStats, iCount, m_auiEoTable);
+      }
+      else
+#endif
       {
-        iSignLeft = xSign(pRec[iStartX] - pRec[iStartX-1]);
-        for (x=iStartX; x< iEndX; x++)
+        for (y=0; y<iLcuHeight-numSkipLine; y++)
         {
-          iSignRight =  xSign(pRec[x] - pRec[x+1]);
-          uiEdgeType =  iSignRight + iSignLeft + 2;
-          iSignLeft  = -iSignRight;
+          iSignLeft = xSign(pRec[iStartX] - pRec[iStartX-1]);
+          for (x=iStartX; x< iEndX; x++)
+          {
+            iSignRight =  xSign(pRec[x] - pRec[x+1]);
+            uiEdgeType =  iSignRight + iSignLeft + 2;
+            iSignLeft  = -iSignRight;
 
-          iStats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
-          iCount[m_auiEoTable[uiEdgeType]] ++;
+            iStats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
+            iCount[m_auiEoTable[uiEdgeType]] ++;
+          }
+          pOrg += iStride;
+          pRec += iStride;
         }
-        pOrg += iStride;
-        pRec += iStride;
       }
     }
 
@@ -1133,8 +1419,8 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCuOrg(Int iAddr, Int iPartIdx, Compon
         numSkipLineRight = 4-(2*csx);
       }
 
-      iStats = m_iOffsetOrg[iPartIdx][SAO_EO_1];
-      iCount = m_iCount    [iPartIdx][SAO_EO_1];
+      iStats = ppStats[SAO_EO_1];
+      iCount = ppCount[SAO_EO_1];
 
       pOrg = getPicYuvAddr(m_pcPic->getPicYuvOrg(), iYCbCr, iAddr);
       pRec = getPicYuvAddr(m_pcPic->getPicYuvRec(), iYCbCr, iAddr);
@@ -1148,23 +1434,32 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCuOrg(Int iAddr, Int iPartIdx, Compon
         pRec += iStride;
       }
 
-      for (x=0; x< iLcuWidth; x++)
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+      if (TComSimd::getLevel() != SIMD_SCALAR)
       {
-        m_iUpBuff1[x] = xSign(pRec[x] - pRec[x-iStride]);
+        xSaoEdgeStatsSSE41(pRec, pOrg, iStride, iEndX, iEndY - iStartY, -iStride, iStride, iStats, iCount, m_auiEoTable);
       }
-      for (y=iStartY; y<iEndY; y++)
+      else
+#endif
       {
-        for (x=0; x<iEndX; x++)
+        for (x=0; x< iLcuWidth; x++)
         {
-          iSignDown     =  xSign(pRec[x] - pRec[x+iStride]);
-          uiEdgeType    =  iSignDown + m_iUpBuff1[x] + 2;
-          m_iUpBuff1[x] = -iSignDown;
+          upBuff1[x] = xSign(pRec[x] - pRec[x-iStride]);
+        }
+        for (y=iStartY; y<iEndY; y++)
+        {
+          for (x=0; x<iEndX; x++)
+          {
+            iSignDown     =  xSign(pRec[x] - pRec[x+iStride]);
+            uiEdgeType    =  iSignDown + upBuff1[x] + 2;
+            upBuff1[x] = -iSignDown;
 
-          iStats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
-          iCount[m_auiEoTable[uiEdgeType]] ++;
+            iStats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
+            iCount[m_auiEoTable[uiEdgeType]] ++;
+          }
+          pOrg += iStride;
+          pRec += iStride;
         }
-        pOrg += iStride;
-        pRec += iStride;
       }
     }
   //if (iSaoType == EO_2)
@@ -1175,8 +1470,8 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCuOrg(Int iAddr, Int iPartIdx, Compon
         numSkipLineRight = 5-(2*csx);
       }
 
-      iStats = m_iOffsetOrg[iPartIdx][SAO_EO_2];
-      iCount = m_iCount    [iPartIdx][SAO_EO_2];
+      iStats = ppStats[SAO_EO_2];
+      iCount = ppCount[SAO_EO_2];
 
       pOrg = getPicYuvAddr(m_pcPic->getPicYuvOrg(), iYCbCr, iAddr);
       pRec = getPicYuvAddr(m_pcPic->getPicYuvRec(), iYCbCr, iAddr);
@@ -1192,28 +1487,37 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCuOrg(Int iAddr, Int iPartIdx, Compon
         pRec += iStride;
       }
 
-      for (x=iStartX; x<iEndX; x++)
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+      if (TComSimd::getLevel() != SIMD_SCALAR)
       {
-        m_iUpBuff1[x] = xSign(pRec[x] - pRec[x-iStride-1]);
+        xSaoEdgeStatsSSE41(pRec + iStartX, pOrg + iStartX, iStride, iEndX - iStartX, iEndY - iStartY, -iStride - 1, iStride + 1, iStats, iCount, m_auiEoTable);
       }
-      for (y=iStartY; y<iEndY; y++)
+      else
+#endif
       {
-        iSignDown2 = xSign(pRec[iStride+iStartX] - pRec[iStartX-1]);
         for (x=iStartX; x<iEndX; x++)
         {
-          iSignDown1      =  xSign(pRec[x] - pRec[x+iStride+1]) ;
-          uiEdgeType      =  iSignDown1 + m_iUpBuff1[x] + 2;
-          m_iUpBufft[x+1] = -iSignDown1;
-          iStats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
-          iCount[m_auiEoTable[uiEdgeType]] ++;
+          upBuff1[x] = xSign(pRec[x] - pRec[x-iStride-1]);
         }
-        m_iUpBufft[iStartX] = iSignDown2;
-        ipSwap     = m_iUpBuff1;
-        m_iUpBuff1 = m_iUpBufft;
-        m_iUpBufft = ipSwap;
+        for (y=iStartY; y<iEndY; y++)
+        {
+          iSignDown2 = xSign(pRec[iStride+iStartX] - pRec[iStartX-1]);
+          for (x=iStartX; x<iEndX; x++)
+          {
+            iSignDown1      =  xSign(pRec[x] - pRec[x+iStride+1]) ;
+            uiEdgeType      =  iSignDown1 + upBuff1[x] + 2;
+            upBufft[x+1] = -iSignDown1;
+            iStats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
+            iCount[m_auiEoTable[uiEdgeType]] ++;
+          }
+          upBufft[iStartX] = iSignDown2;
+          swapBuff = upBuff1;
+          upBuff1  = upBufft;
+          upBufft  = swapBuff;
 
-        pRec += iStride;
-        pOrg += iStride;
+          pRec += iStride;
+          pOrg += iStride;
+        }
       }
     }
   //if (iSaoType == EO_3  )
@@ -1224,8 +1528,8 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCuOrg(Int iAddr, Int iPartIdx, Compon
         numSkipLineRight = 5-(2*csx);
       }
 
-      iStats = m_iOffsetOrg[iPartIdx][SAO_EO_3];
-      iCount = m_iCount    [iPartIdx][SAO_EO_3];
+      iStats = ppStats[SAO_EO_3];
+      iCount = ppCount[SAO_EO_3];
 
       pOrg = getPicYuvAddr(m_pcPic->getPicYuvOrg(), iYCbCr, iAddr);
       pRec = getPicYuvAddr(m_pcPic->getPicYuvRec(), iYCbCr, iAddr);
@@ -1241,33 +1545,68 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCuOrg(Int iAddr, Int iPartIdx, Compon
         pRec += iStride;
       }
 
-      for (x=iStartX-1; x<iEndX; x++)
+#if SIMD_X86 && !RExt__HIGH_BIT_DEPTH_SUPPORT
+      if (TComSimd::getLevel() != SIMD_SCALAR)
       {
-        m_iUpBuff1[x] = xSign(pRec[x] - pRec[x-iStride+1]);
+        xSaoEdgeStatsSSE41(pRec + iStartX, pOrg + iStartX, iStride, iEndX - iStartX, iEndY - iStartY, -iStride + 1, iStride - 1, iStats, iCount, m_auiEoTable);
       }
-
-      for (y=iStartY; y<iEndY; y++)
+      else
+#endif
       {
-        for (x=iStartX; x<iEndX; x++)
+        for (x=iStartX-1; x<iEndX; x++)
         {
-          iSignDown1      =  xSign(pRec[x] - pRec[x+iStride-1]) ;
-          uiEdgeType      =  iSignDown1 + m_iUpBuff1[x] + 2;
-          m_iUpBuff1[x-1] = -iSignDown1;
-          iStats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
-          iCount[m_auiEoTable[uiEdgeType]] ++;
+          upBuff1[x] = xSign(pRec[x] - pRec[x-iStride+1]);
         }
-        m_iUpBuff1[iEndX-1] = xSign(pRec[iEndX-1 + iStride] - pRec[iEndX]);
 
-        pRec += iStride;
-        pOrg += iStride;
+        for (y=iStartY; y<iEndY; y++)
+        {
+          for (x=iStartX; x<iEndX; x++)
+          {
+            iSignDown1      =  xSign(pRec[x] - pRec[x+iStride-1]) ;
+            uiEdgeType      =  iSignDown1 + upBuff1[x] + 2;
+            upBuff1[x-1] = -iSignDown1;
+            iStats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
+            iCount[m_auiEoTable[uiEdgeType]] ++;
+          }
+          upBuff1[iEndX-1] = xSign(pRec[iEndX-1 + iStride] - pRec[iEndX]);
+
+          pRec += iStride;
+          pOrg += iStride;
+        }
       }
     }
   }
 }
 
 
+/** Calculate SAO statistics of the LCU bottom and right boundary areas before deblocking, for all LCUs
+ * \param  pcPic picture, the CTU rows are processed on the threads set with setThreadPool()
+ */
 Void TEncSampleAdaptiveOffset::calcSaoStatsCu_BeforeDblk( TComPic* pcPic )
 {
+  m_pcPic = pcPic;
+
+  if (m_pcThreadPool)
+  {
+    TComMemberJob<TEncSampleAdaptiveOffset> cRowJob( this, &TEncSampleAdaptiveOffset::xCalcSaoStatsCTURowBeforeDblkJob );
+    m_pcThreadPool->execute( &cRowJob, m_iNumCuInHeight );
+  }
+  else
+  {
+    for (Int idxY = 0; idxY < m_iNumCuInHeight; idxY++)
+    {
+      xCalcSaoStatsCTURowBeforeDblkJob( idxY, 0 );
+    }
+  }
+}
+
+/** Calculate SAO statistics before deblocking for the LCUs of one CTU row
+ * \param  idxY CTU row
+ * \param  iThreadIdx index of the executing thread
+ */
+Void TEncSampleAdaptiveOffset::xCalcSaoStatsCTURowBeforeDblkJob( Int idxY, Int iThreadIdx )
+{
+  TComPic* pcPic = m_pcPic;
   Int addr;
   Int x,y;
   TComSPS *pTmpSPS =  pcPic->getSlice(0)->getSPS();
@@ -1290,9 +1629,7 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCu_BeforeDblk( TComPic* pcPic )
   Int endY;
   Int firstX, firstY;
 
-  Int idxY;
   Int idxX;
-  Int frameHeightInCU = m_iNumCuInHeight;
   Int frameWidthInCU  = m_iNumCuInWidth;
   Int j, k;
 
@@ -1301,262 +1638,264 @@ Void TEncSampleAdaptiveOffset::calcSaoStatsCu_BeforeDblk( TComPic* pcPic )
   UInt lPelX, tPelY;
   TComDataCU *pTmpCu;
   Pel* pTableBo;
+  Int  upBuff1Base[MAX_CU_SIZE+2];
+  Int  upBufftBase[MAX_CU_SIZE+2];
+  Int* upBuff1 = upBuff1Base + 1;
+  Int* upBufft = upBufftBase + 1;
+  Int* swapBuff;
 
   const UInt numberValidComponents = pcPic->getNumberValidComponents();
 
-  for (idxY = 0; idxY< frameHeightInCU; idxY++)
+  for (idxX = 0; idxX< frameWidthInCU; idxX++)
   {
-    for (idxX = 0; idxX< frameWidthInCU; idxX++)
+    addr     = idxX  + frameWidthInCU*idxY;
+    pTmpCu = pcPic->getCU(addr);
+    for(UInt component = 0; component < numberValidComponents; component++ )
     {
-      addr     = idxX  + frameWidthInCU*idxY;
-      pTmpCu = pcPic->getCU(addr);
-      for(UInt component = 0; component < numberValidComponents; component++ )
-      {
-        const ComponentID compID = ComponentID(component);
+      const ComponentID compID = ComponentID(component);
 
-        const UInt csx = m_pcPic->getComponentScaleX(compID);
-        const UInt csy = m_pcPic->getComponentScaleY(compID);
+      const UInt csx = m_pcPic->getComponentScaleX(compID);
+      const UInt csy = m_pcPic->getComponentScaleY(compID);
 
-        for ( j=0;j<MAX_NUM_SAO_TYPE;j++)
+      for ( j=0;j<MAX_NUM_SAO_TYPE;j++)
+      {
+        for ( k=0;k< MAX_NUM_SAO_CLASS;k++)
         {
-          for ( k=0;k< MAX_NUM_SAO_CLASS;k++)
-          {
-            m_count_PreDblk    [addr][compID][j][k] = 0;
-            m_offsetOrg_PreDblk[addr][compID][j][k] = 0;
-          }
+          m_count_PreDblk    [addr][compID][j][k] = 0;
+          m_offsetOrg_PreDblk[addr][compID][j][k] = 0;
         }
+      }
 
-        picWidthTmp  = m_iPicWidth               >> csx;
-        picHeightTmp = m_iPicHeight              >> csy;
-        lcuWidth     = pTmpSPS->getMaxCUWidth()  >> csx;
-        lcuHeight    = pTmpSPS->getMaxCUHeight() >> csy;
-        lPelX        = pTmpCu->getCUPelX()       >> csx;
-        tPelY        = pTmpCu->getCUPelY()       >> csy;
-        rPelX        = lPelX + lcuWidth  ;
-        bPelY        = tPelY + lcuHeight ;
-        rPelX        = rPelX > picWidthTmp  ? picWidthTmp  : rPelX;
-        bPelY        = bPelY > picHeightTmp ? picHeightTmp : bPelY;
-        lcuWidth     = rPelX - lPelX;
-        lcuHeight    = bPelY - tPelY;
-        stride       = pcPic->getStride(compID);
-        pTableBo     = m_aTableBo[toChannelType(compID)];
-
-        //if(iSaoType == BO)
+      picWidthTmp  = m_iPicWidth               >> csx;
+      picHeightTmp = m_iPicHeight              >> csy;
+      lcuWidth     = pTmpSPS->getMaxCUWidth()  >> csx;
+      lcuHeight    = pTmpSPS->getMaxCUHeight() >> csy;
+      lPelX        = pTmpCu->getCUPelX()       >> csx;
+      tPelY        = pTmpCu->getCUPelY()       >> csy;
+      rPelX        = lPelX + lcuWidth  ;
+      bPelY        = tPelY + lcuHeight ;
+      rPelX        = rPelX > picWidthTmp  ? picWidthTmp  : rPelX;
+      bPelY        = bPelY > picHeightTmp ? picHeightTmp : bPelY;
+      lcuWidth     = rPelX - lPelX;
+      lcuHeight    = bPelY - tPelY;
+      stride       = pcPic->getStride(compID);
+      pTableBo     = m_aTableBo[toChannelType(compID)];
 
-        numSkipLine      = 3-(2*csy);
-        numSkipLineRight = 4-(2*csx);
+      //if(iSaoType == BO)
+
+      numSkipLine      = 3-(2*csy);
+      numSkipLineRight = 4-(2*csx);
 
-        stats = m_offsetOrg_PreDblk[addr][compID][SAO_BO];
-        count = m_count_PreDblk[addr][compID][SAO_BO];
+      stats = m_offsetOrg_PreDblk[addr][compID][SAO_BO];
+      count = m_count_PreDblk[addr][compID][SAO_BO];
 
-        pOrg = getPicYuvAddr(pcPic->getPicYuvOrg(), compID, addr);
-        pRec = getPicYuvAddr(pcPic->getPicYuvRec(), compID, addr);
+      pOrg = getPicYuvAddr(pcPic->getPicYuvOrg(), compID, addr);
+      pRec = getPicYuvAddr(pcPic->getPicYuvRec(), compID, addr);
 
-        startX   = (rPelX == picWidthTmp) ? lcuWidth : lcuWidth-numSkipLineRight;
-        startY   = (bPelY == picHeightTmp) ? lcuHeight : lcuHeight-numSkipLine;
+      startX   = (rPelX == picWidthTmp) ? lcuWidth : lcuWidth-numSkipLineRight;
+      startY   = (bPelY == picHeightTmp) ? lcuHeight : lcuHeight-numSkipLine;
 
-        for (y=0; y<lcuHeight; y++)
+      for (y=0; y<lcuHeight; y++)
+      {
+        for (x=0; x<lcuWidth; x++)
         {
-          for (x=0; x<lcuWidth; x++)
-          {
-            if( x < startX && y < startY )
-              continue;
+          if( x < startX && y < startY )
+            continue;
 
-            classIdx = pTableBo[pRec[x]];
-            if (classIdx)
-            {
-              stats[classIdx] += (pOrg[x] - pRec[x]);
-              count[classIdx] ++;
-            }
+          classIdx = pTableBo[pRec[x]];
+          if (classIdx)
+          {
+            stats[classIdx] += (pOrg[x] - pRec[x]);
+            count[classIdx] ++;
           }
-          pOrg += stride;
-          pRec += stride;
         }
+        pOrg += stride;
+        pRec += stride;
+      }
 
-        Int signLeft;
-        Int signRight;
-        Int signDown;
-        Int signDown1;
-        Int signDown2;
+      Int signLeft;
+      Int signRight;
+      Int signDown;
+      Int signDown1;
+      Int signDown2;
 
-        UInt uiEdgeType;
+      UInt uiEdgeType;
 
-        //if (iSaoType == EO_0)
+      //if (iSaoType == EO_0)
 
-        numSkipLine      = 3-(2*csy);
-        numSkipLineRight = 5-(2*csx);
+      numSkipLine      = 3-(2*csy);
+      numSkipLineRight = 5-(2*csx);
 
-        stats = m_offsetOrg_PreDblk[addr][compID][SAO_EO_0];
-        count = m_count_PreDblk[addr][compID][SAO_EO_0];
+      stats = m_offsetOrg_PreDblk[addr][compID][SAO_EO_0];
+      count = m_count_PreDblk[addr][compID][SAO_EO_0];
 
-        pOrg = getPicYuvAddr(pcPic->getPicYuvOrg(), compID, addr);
-        pRec = getPicYuvAddr(pcPic->getPicYuvRec(), compID, addr);
+      pOrg = getPicYuvAddr(pcPic->getPicYuvOrg(), compID, addr);
+      pRec = getPicYuvAddr(pcPic->getPicYuvRec(), compID, addr);
 
-        startX   = (rPelX == picWidthTmp) ? lcuWidth-1 : lcuWidth-numSkipLineRight;
-        startY   = (bPelY == picHeightTmp) ? lcuHeight : lcuHeight-numSkipLine;
-        firstX   = (lPelX == 0) ? 1 : 0;
-        endX   = (rPelX == picWidthTmp) ? lcuWidth-1 : lcuWidth;
+      startX   = (rPelX == picWidthTmp) ? lcuWidth-1 : lcuWidth-numSkipLineRight;
+      startY   = (bPelY == picHeightTmp) ? lcuHeight : lcuHeight-numSkipLine;
+      firstX   = (lPelX == 0) ? 1 : 0;
+      endX   = (rPelX == picWidthTmp) ? lcuWidth-1 : lcuWidth;
 
-        for (y=0; y<lcuHeight; y++)
+      for (y=0; y<lcuHeight; y++)
+      {
+        signLeft = xSign(pRec[firstX] - pRec[firstX-1]);
+        for (x=firstX; x< endX; x++)
         {
-          signLeft = xSign(pRec[firstX] - pRec[firstX-1]);
-          for (x=firstX; x< endX; x++)
-          {
-            signRight =  xSign(pRec[x] - pRec[x+1]);
-            uiEdgeType =  signRight + signLeft + 2;
-            signLeft  = -signRight;
+          signRight =  xSign(pRec[x] - pRec[x+1]);
+          uiEdgeType =  signRight + signLeft + 2;
+          signLeft  = -signRight;
 
-            if( x < startX && y < startY )
-              continue;
+          if( x < startX && y < startY )
+            continue;
 
-            stats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
-            count[m_auiEoTable[uiEdgeType]] ++;
-          }
-          pOrg += stride;
-          pRec += stride;
+          stats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
+          count[m_auiEoTable[uiEdgeType]] ++;
         }
+        pOrg += stride;
+        pRec += stride;
+      }
 
-        //if (iSaoType == EO_1)
+      //if (iSaoType == EO_1)
 
-        numSkipLine      = 4-(2*csy);
-        numSkipLineRight = 4-(2*csx);
+      numSkipLine      = 4-(2*csy);
+      numSkipLineRight = 4-(2*csx);
 
-        stats = m_offsetOrg_PreDblk[addr][compID][SAO_EO_1];
-        count = m_count_PreDblk[addr][compID][SAO_EO_1];
+      stats = m_offsetOrg_PreDblk[addr][compID][SAO_EO_1];
+      count = m_count_PreDblk[addr][compID][SAO_EO_1];
 
-        pOrg = getPicYuvAddr(pcPic->getPicYuvOrg(), compID, addr);
-        pRec = getPicYuvAddr(pcPic->getPicYuvRec(), compID, addr);
+      pOrg = getPicYuvAddr(pcPic->getPicYuvOrg(), compID, addr);
+      pRec = getPicYuvAddr(pcPic->getPicYuvRec(), compID, addr);
 
-        startX   = (rPelX == picWidthTmp) ? lcuWidth : lcuWidth-numSkipLineRight;
-        startY   = (bPelY == picHeightTmp) ? lcuHeight-1 : lcuHeight-numSkipLine;
-        firstY = (tPelY == 0) ? 1 : 0;
-        endY   = (bPelY == picHeightTmp) ? lcuHeight-1 : lcuHeight;
-        if (firstY == 1)
-        {
-          pOrg += stride;
-          pRec += stride;
-        }
+      startX   = (rPelX == picWidthTmp) ? lcuWidth : lcuWidth-numSkipLineRight;
+      startY   = (bPelY == picHeightTmp) ? lcuHeight-1 : lcuHeight-numSkipLine;
+      firstY = (tPelY == 0) ? 1 : 0;
+      endY   = (bPelY == picHeightTmp) ? lcuHeight-1 : lcuHeight;
+      if (firstY == 1)
+      {
+        pOrg += stride;
+        pRec += stride;
+      }
 
-        for (x=0; x< lcuWidth; x++)
-        {
-          m_iUpBuff1[x] = xSign(pRec[x] - pRec[x-stride]);
-        }
-        for (y=firstY; y<endY; y++)
+      for (x=0; x< lcuWidth; x++)
+      {
+        upBuff1[x] = xSign(pRec[x] - pRec[x-stride]);
+      }
+      for (y=firstY; y<endY; y++)
+      {
+        for (x=0; x<lcuWidth; x++)
         {
-          for (x=0; x<lcuWidth; x++)
-          {
-            signDown     =  xSign(pRec[x] - pRec[x+stride]);
-            uiEdgeType    =  signDown + m_iUpBuff1[x] + 2;
-            m_iUpBuff1[x] = -signDown;
+          signDown     =  xSign(pRec[x] - pRec[x+stride]);
+          uiEdgeType    =  signDown + upBuff1[x] + 2;
+          upBuff1[x] = -signDown;
 
-            if( x < startX && y < startY )
-              continue;
+          if( x < startX && y < startY )
+            continue;
 
-            stats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
-            count[m_auiEoTable[uiEdgeType]] ++;
-          }
-          pOrg += stride;
-          pRec += stride;
+          stats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
+          count[m_auiEoTable[uiEdgeType]] ++;
         }
+        pOrg += stride;
+        pRec += stride;
+      }
 
-        //if (iSaoType == EO_2)
+      //if (iSaoType == EO_2)
 
-        numSkipLine      = 4-(2*csy);
-        numSkipLineRight = 5-(2*csx);
+      numSkipLine      = 4-(2*csy);
+      numSkipLineRight = 5-(2*csx);
 
-        stats = m_offsetOrg_PreDblk[addr][compID][SAO_EO_2];
-        count = m_count_PreDblk[addr][compID][SAO_EO_2];
+      stats = m_offsetOrg_PreDblk[addr][compID][SAO_EO_2];
+      count = m_count_PreDblk[addr][compID][SAO_EO_2];
 
-        pOrg = getPicYuvAddr(pcPic->getPicYuvOrg(), compID, addr);
-        pRec = getPicYuvAddr(pcPic->getPicYuvRec(), compID, addr);
+      pOrg = getPicYuvAddr(pcPic->getPicYuvOrg(), compID, addr);
+      pRec = getPicYuvAddr(pcPic->getPicYuvRec(), compID, addr);
 
-        startX   = (rPelX == picWidthTmp) ? lcuWidth-1 : lcuWidth-numSkipLineRight;
-        startY   = (bPelY == picHeightTmp) ? lcuHeight-1 : lcuHeight-numSkipLine;
-        firstX   = (lPelX == 0) ? 1 : 0;
-        firstY = (tPelY == 0) ? 1 : 0;
-        endX   = (rPelX == picWidthTmp) ? lcuWidth-1 : lcuWidth;
-        endY   = (bPelY == picHeightTmp) ? lcuHeight-1 : lcuHeight;
-        if (firstY == 1)
-        {
-          pOrg += stride;
-          pRec += stride;
-        }
+      startX   = (rPelX == picWidthTmp) ? lcuWidth-1 : lcuWidth-numSkipLineRight;
+      startY   = (bPelY == picHeightTmp) ? lcuHeight-1 : lcuHeight-numSkipLine;
+      firstX   = (lPelX == 0) ? 1 : 0;
+      firstY = (tPelY == 0) ? 1 : 0;
+      endX   = (rPelX == picWidthTmp) ? lcuWidth-1 : lcuWidth;
+      endY   = (bPelY == picHeightTmp) ? lcuHeight-1 : lcuHeight;
+      if (firstY == 1)
+      {
+        pOrg += stride;
+        pRec += stride;
+      }
 
+      for (x=firstX; x<endX; x++)
+      {
+        upBuff1[x] = xSign(pRec[x] - pRec[x-stride-1]);
+      }
+      for (y=firstY; y<endY; y++)
+      {
+        signDown2 = xSign(pRec[stride+startX] - pRec[startX-1]);
         for (x=firstX; x<endX; x++)
         {
-          m_iUpBuff1[x] = xSign(pRec[x] - pRec[x-stride-1]);
-        }
-        for (y=firstY; y<endY; y++)
-        {
-          signDown2 = xSign(pRec[stride+startX] - pRec[startX-1]);
-          for (x=firstX; x<endX; x++)
-          {
-            signDown1      =  xSign(pRec[x] - pRec[x+stride+1]) ;
-            uiEdgeType      =  signDown1 + m_iUpBuff1[x] + 2;
-            m_iUpBufft[x+1] = -signDown1;
-
-            if( x < startX && y < startY )
-              continue;
+          signDown1      =  xSign(pRec[x] - pRec[x+stride+1]) ;
+          uiEdgeType      =  signDown1 + upBuff1[x] + 2;
+          upBufft[x+1] = -signDown1;
 
-            stats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
-            count[m_auiEoTable[uiEdgeType]] ++;
-          }
-          m_iUpBufft[firstX] = signDown2;
-          ipSwap     = m_iUpBuff1;
-          m_iUpBuff1 = m_iUpBufft;
-          m_iUpBufft = ipSwap;
+          if( x < startX && y < startY )
+            continue;
 
-          pRec += stride;
-          pOrg += stride;
+          stats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
+          count[m_auiEoTable[uiEdgeType]] ++;
         }
+        upBufft[firstX] = signDown2;
+        swapBuff = upBuff1;
+        upBuff1  = upBufft;
+        upBufft  = swapBuff;
 
-        //if (iSaoType == EO_3)
+        pRec += stride;
+        pOrg += stride;
+      }
 
-        numSkipLine      = 4-(2*csy);
-        numSkipLineRight = 5-(2*csx);
+      //if (iSaoType == EO_3)
 
-        stats = m_offsetOrg_PreDblk[addr][compID][SAO_EO_3];
-        count = m_count_PreDblk[addr][compID][SAO_EO_3];
+      numSkipLine      = 4-(2*csy);
+      numSkipLineRight = 5-(2*csx);
 
-        pOrg = getPicYuvAddr(pcPic->getPicYuvOrg(), compID, addr);
-        pRec = getPicYuvAddr(pcPic->getPicYuvRec(), compID, addr);
+      stats = m_offsetOrg_PreDblk[addr][compID][SAO_EO_3];
+      count = m_count_PreDblk[addr][compID][SAO_EO_3];
 
-        startX   = (rPelX == picWidthTmp) ? lcuWidth-1 : lcuWidth-numSkipLineRight;
-        startY   = (bPelY == picHeightTmp) ? lcuHeight-1 : lcuHeight-numSkipLine;
-        firstX   = (lPelX == 0) ? 1 : 0;
-        firstY = (tPelY == 0) ? 1 : 0;
-        endX   = (rPelX == picWidthTmp) ? lcuWidth-1 : lcuWidth;
-        endY   = (bPelY == picHeightTmp) ? lcuHeight-1 : lcuHeight;
-        if (firstY == 1)
-        {
-          pOrg += stride;
-          pRec += stride;
-        }
+      pOrg = getPicYuvAddr(pcPic->getPicYuvOrg(), compID, addr);
+      pRec = getPicYuvAddr(pcPic->getPicYuvRec(), compID, addr);
 
-        for (x=firstX-1; x<endX; x++)
-        {
-          m_iUpBuff1[x] = xSign(pRec[x] - pRec[x-stride+1]);
-        }
+      startX   = (rPelX == picWidthTmp) ? lcuWidth-1 : lcuWidth-numSkipLineRight;
+      startY   = (bPelY == picHeightTmp) ? lcuHeight-1 : lcuHeight-numSkipLine;
+      firstX   = (lPelX == 0) ? 1 : 0;
+      firstY = (tPelY == 0) ? 1 : 0;
+      endX   = (rPelX == picWidthTmp) ? lcuWidth-1 : lcuWidth;
+      endY   = (bPelY == picHeightTmp) ? lcuHeight-1 : lcuHeight;
+      if (firstY == 1)
+      {
+        pOrg += stride;
+        pRec += stride;
+      }
 
-        for (y=firstY; y<endY; y++)
-        {
-          for (x=firstX; x<endX; x++)
-          {
-            signDown1      =  xSign(pRec[x] - pRec[x+stride-1]) ;
-            uiEdgeType      =  signDown1 + m_iUpBuff1[x] + 2;
-            m_iUpBuff1[x-1] = -signDown1;
+      for (x=firstX-1; x<endX; x++)
+      {
+        upBuff1[x] = xSign(pRec[x] - pRec[x-stride+1]);
+      }
 
-            if( x < startX && y < startY )
-              continue;
+      for (y=firstY; y<endY; y++)
+      {
+        for (x=firstX; x<endX; x++)
+        {
+          signDown1      =  xSign(pRec[x] - pRec[x+stride-1]) ;
+          uiEdgeType      =  signDown1 + upBuff1[x] + 2;
+          upBuff1[x-1] = -signDown1;
 
-            stats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
-            count[m_auiEoTable[uiEdgeType]] ++;
-          }
-          m_iUpBuff1[endX-1] = xSign(pRec[endX-1 + stride] - pRec[endX]);
+          if( x < startX && y < startY )
+            continue;
 
-          pRec += stride;
-          pOrg += stride;
+          stats[m_auiEoTable[uiEdgeType]] += (pOrg[x] - pRec[x]);
+          count[m_auiEoTable[uiEdgeType]] ++;
         }
+        upBuff1[endX-1] = xSign(pRec[endX-1 + stride] - pRec[endX]);
+
+        pRec += stride;
+        pOrg += stride;
       }
     }
   }
@@ -1579,6 +1918,10 @@ Void TEncSampleAdaptiveOffset::getSaoStats(SAOQTPart *psQTPart, ComponentID iYCb
   Int iPartStart;
   Int iPartEnd;
   SAOQTPart*  pOnePart;
+  Bool abComponent[MAX_NUM_COMPONENT] = { false, false, false };
+
+  abComponent[iYCbCr] = true;
+  calcSaoStatsAllCtus(abComponent);
 
   if (m_uiMaxSplitLevel == 0)
   {
@@ -1589,7 +1932,7 @@ Void TEncSampleAdaptiveOffset::getSaoStats(SAOQTPart *psQTPart, ComponentID iYCb
       for (LcuIdxX = pOnePart->StartCUX; LcuIdxX<= pOnePart->EndCUX; LcuIdxX++)
       {
         iAddr = LcuIdxY*iFrameWidthInCU + LcuIdxX;
-        calcSaoStatsCu(iAddr, iPartIdx, iYCbCr);
+        xAddSaoStatsCu(iAddr, iPartIdx, iYCbCr);
       }
     }
   }
@@ -1603,7 +1946,7 @@ Void TEncSampleAdaptiveOffset::getSaoStats(SAOQTPart *psQTPart, ComponentID iYCb
         for (LcuIdxX = pOnePart->StartCUX; LcuIdxX<= pOnePart->EndCUX; LcuIdxX++)
         {
           iAddr = LcuIdxY*iFrameWidthInCU + LcuIdxX;
-          calcSaoStatsCu(iAddr, iPartIdx, iYCbCr);
+          xAddSaoStatsCu(iAddr, iPartIdx, iYCbCr);
         }
       }
     }
@@ -1632,6 +1975,80 @@ Void TEncSampleAdaptiveOffset::getSaoStats(SAOQTPart *psQTPart, ComponentID iYCb
   }
 }
 
+/** Calculate the SAO statistics of every LCU into m_countCtu and m_offsetOrgCtu, on the threads set with setThreadPool()
+ * \param  abComponent components whose statistics are gathered, the statistics of the others are only initialised
+ *
+ * \note The statistics start from the ones before deblocking with LCU-based optimisation and boundary estimation.
+ *       Each LCU only writes its own statistics, the RDO that uses them afterwards stays sequential.
+ */
+Void TEncSampleAdaptiveOffset::calcSaoStatsAllCtus(const Bool abComponent[MAX_NUM_COMPONENT])
+{
+  for (Int compIdx = 0; compIdx < MAX_NUM_COMPONENT; compIdx++)
+  {
+    m_abStatsComponent[compIdx] = abComponent[compIdx];
+  }
+
+  if (m_pcThreadPool)
+  {
+    TComMemberJob<TEncSampleAdaptiveOffset> cRowJob( this, &TEncSampleAdaptiveOffset::xCalcSaoStatsCTURowJob );
+    m_pcThreadPool->execute( &cRowJob, m_iNumCuInHeight );
+  }
+  else
+  {
+    for (Int idxY = 0; idxY < m_iNumCuInHeight; idxY++)
+    {
+      xCalcSaoStatsCTURowJob( idxY, 0 );
+    }
+  }
+}
+
+/** Calculate the SAO statistics of the LCUs of one CTU row
+ * \param  idxY CTU row
+ * \param  iThreadIdx index of the executing thread
+ */
+Void TEncSampleAdaptiveOffset::xCalcSaoStatsCTURowJob( Int idxY, Int iThreadIdx )
+{
+  const Bool bFromPreDblk = m_saoLcuBasedOptimization && m_saoLcuBoundary;
+
+  for (Int idxX = 0; idxX < m_iNumCuInWidth; idxX++)
+  {
+    const Int addr = idxY * m_iNumCuInWidth + idxX;
+
+    for (UInt compIdx = 0; compIdx < m_pcPic->getNumberValidComponents(); compIdx++)
+    {
+      const ComponentID compID = ComponentID(compIdx);
+
+      for (Int j=0;j<MAX_NUM_SAO_TYPE;j++)
+      {
+        for (Int k=0;k< MAX_NUM_SAO_CLASS;k++)
+        {
+          m_countCtu    [addr][compID][j][k] = bFromPreDblk ? m_count_PreDblk    [addr][compID][j][k] : 0;
+          m_offsetOrgCtu[addr][compID][j][k] = bFromPreDblk ? m_offsetOrg_PreDblk[addr][compID][j][k] : 0;
+        }
+      }
+      if (m_abStatsComponent[compID])
+      {
+        calcSaoStatsCu(addr, compID, m_offsetOrgCtu[addr][compID], m_countCtu[addr][compID]);
+      }
+    }
+  }
+}
+
+/** Add the statistics of an LCU gathered by calcSaoStatsAllCtus() to an SAO part
+ * \param  iAddr,  iPartIdx,  iYCbCr
+ */
+Void TEncSampleAdaptiveOffset::xAddSaoStatsCu(Int iAddr, Int iPartIdx, ComponentID iYCbCr)
+{
+  for (Int j=0;j<MAX_NUM_SAO_TYPE;j++)
+  {
+    for (Int k=0;k< MAX_NUM_SAO_CLASS;k++)
+    {
+      m_iCount    [iPartIdx][j][k] += m_countCtu    [iAddr][iYCbCr][j][k];
+      m_iOffsetOrg[iPartIdx][j][k] += m_offsetOrgCtu[iAddr][iYCbCr][j][k];
+    }
+  }
+}
+
 /** reset offset statistics
  * \param
  */
@@ -1745,13 +2162,20 @@ Void TEncSampleAdaptiveOffset::SAOProcess(SAOParam *pcSaoParam, Double dLambda)
     }
   }
 
-  for (Int compIdx = 0; compIdx < numValidComponent; compIdx++)
+  if (m_pcThreadPool)
   {
-    const ComponentID compID = ComponentID(compIdx);
-
-    if (pcSaoParam->bSaoFlag[toChannelType(compID)])
+    processSaoUnitAllParallel(pcSaoParam);
+  }
+  else
+  {
+    for (Int compIdx = 0; compIdx < numValidComponent; compIdx++)
     {
-      processSaoUnitAll( pcSaoParam->saoLcuParam[compID], pcSaoParam->oneUnitFlag[compID], compID);
+      const ComponentID compID = ComponentID(compIdx);
+
+      if (pcSaoParam->bSaoFlag[toChannelType(compID)])
+      {
+        processSaoUnitAll( pcSaoParam->saoLcuParam[compID], pcSaoParam->oneUnitFlag[compID], compID);
+      }
     }
   }
 }
@@ -1951,6 +2375,18 @@ Void TEncSampleAdaptiveOffset::rdoSaoUnitAll(SAOParam *saoParam, const Double la
   m_pcRDGoOnSbacCoder->store(m_pppcRDSbacCoder[0][CI_NEXT_BEST]); // next best if SAO is to be disabled.
 #endif
 
+  // the statistics of all LCUs are gathered up front, the decisions below depend on each other and stay in raster order
+  Bool abComponent[MAX_NUM_COMPONENT];
+  for (UInt compIdx = 0; compIdx < MAX_NUM_COMPONENT; compIdx++)
+  {
+#if SAO_ENCODING_CHOICE
+    abComponent[compIdx] = saoParam->bSaoFlag[toChannelType(ComponentID(compIdx))];
+#else
+    abComponent[compIdx] = true;
+#endif
+  }
+  calcSaoStatsAllCtus(abComponent);
+
   for (idxY = 0; idxY< frameHeightInCU; idxY++)
   {
     for (idxX = 0; idxX< frameWidthInCU; idxX++)
@@ -2012,28 +2448,14 @@ Void TEncSampleAdaptiveOffset::rdoSaoUnitAll(SAOParam *saoParam, const Double la
           for ( k=0;k< MAX_NUM_SAO_CLASS;k++)
           {
             m_iOffset   [compID][j][k] = 0;
-            if( m_saoLcuBasedOptimization && m_saoLcuBoundary ){
-              m_iCount    [compID][j][k] = m_count_PreDblk    [addr][compID][j][k];
-              m_iOffsetOrg[compID][j][k] = m_offsetOrg_PreDblk[addr][compID][j][k];
-            }
-            else
-            {
-              m_iCount    [compID][j][k] = 0;
-              m_iOffsetOrg[compID][j][k] = 0;
-            }
+            m_iCount    [compID][j][k] = m_countCtu    [addr][compID][j][k];
+            m_iOffsetOrg[compID][j][k] = m_offsetOrgCtu[addr][compID][j][k];
           }
         }
         saoParam->saoLcuParam[compID][addr].typeIdx       =  -1;
         saoParam->saoLcuParam[compID][addr].mergeUpFlag   = 0;
         saoParam->saoLcuParam[compID][addr].mergeLeftFlag = 0;
         saoParam->saoLcuParam[compID][addr].subTypeIdx    = 0;
-
-#if SAO_ENCODING_CHOICE
-        if( saoParam->bSaoFlag[toChannelType(compID)] )
-#endif
-        {
-          calcSaoStatsCu(addr, compIdx, compID);
-        }
       }
 #if RExt__BACKWARDS_COMPATIBILITY_HM_TICKET_990_SAO
       saoComponentParamDist(allowMergeLeft, allowMergeUp, saoParam, addr, addrUp, addrLeft, COMPONENT_Y,  lambda, &mergeSaoParam[COMPONENT_Y][0], &compDistortion[COMPONENT_Y]);
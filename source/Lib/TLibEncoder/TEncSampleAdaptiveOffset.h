@@ -70,6 +70,9 @@ private:
   Int64  ***m_iOffsetOrg;  //[MAX_NUM_SAO_PART][MAX_NUM_SAO_TYPE]; 
   Int64  ****m_count_PreDblk;      //[LCU][YCbCr][MAX_NUM_SAO_TYPE][MAX_NUM_SAO_CLASS]; 
   Int64  ****m_offsetOrg_PreDblk;  //[LCU][YCbCr][MAX_NUM_SAO_TYPE][MAX_NUM_SAO_CLASS]; 
+  Int64  ****m_countCtu;           //[LCU][YCbCr][MAX_NUM_SAO_TYPE][MAX_NUM_SAO_CLASS]; statistics of each LCU, see calcSaoStatsAllCtus()
+  Int64  ****m_offsetOrgCtu;       //[LCU][YCbCr][MAX_NUM_SAO_TYPE][MAX_NUM_SAO_CLASS]; 
+  Bool   m_abStatsComponent[MAX_NUM_COMPONENT]; ///< components gathered by calcSaoStatsAllCtus()
   Int64  **m_iRate;        //[MAX_NUM_SAO_PART][MAX_NUM_SAO_TYPE]; 
   Int64  **m_iDist;        //[MAX_NUM_SAO_PART][MAX_NUM_SAO_TYPE]; 
   Double **m_dCost;        //[MAX_NUM_SAO_PART][MAX_NUM_SAO_TYPE]; 
@@ -78,6 +81,10 @@ private:
   Int    *m_iTypePartBest; //[MAX_NUM_SAO_PART]; 
   Int     m_iOffsetTh[MAX_NUM_CHANNEL_TYPE];
   Bool    m_bUseSBACRD;
+
+  Void xCalcSaoStatsCTURowJob          ( Int idxY, Int iThreadIdx );
+  Void xCalcSaoStatsCTURowBeforeDblkJob( Int idxY, Int iThreadIdx );
+  Void xAddSaoStatsCu                  ( Int iAddr, Int iPartIdx, ComponentID iYCbCr );
 #if SAO_ENCODING_CHOICE
 #if SAO_ENCODING_CHOICE_CHROMA
   std::vector<Double> m_depthSaoRate; // [0]=(depth0, channel0), [1]=(depth0, channel 1), [MAX_NUM_CHANNEL_TYPE]=(depth 1, channel 0), etc
@@ -116,10 +123,11 @@ public:
   
   Void disablePartTree(SAOQTPart *psQTPart, Int iPartIdx);
   Void getSaoStats(SAOQTPart *psQTPart, ComponentID iYCbCr);
-  Void calcSaoStatsCu(Int iAddr, Int iPartIdx, ComponentID iYCbCr);
+  Void calcSaoStatsCu(Int iAddr, ComponentID iYCbCr, Int64** ppStats, Int64** ppCount);
   Void calcSaoStatsBlock( Pel* pRecStart, Pel* pOrgStart, Int stride, Int64** ppStats, Int64** ppCount, UInt width, UInt height, Bool* pbBorderAvail, ComponentID iYCbCr);
-  Void calcSaoStatsCuOrg(Int iAddr, Int iPartIdx, ComponentID iYCbCr);
+  Void calcSaoStatsCuOrg(Int iAddr, ComponentID iYCbCr, Int64** ppStats, Int64** ppCount);
   Void calcSaoStatsCu_BeforeDblk( TComPic* pcPic );
+  Void calcSaoStatsAllCtus(const Bool abComponent[MAX_NUM_COMPONENT]);
   Void destroyEncBuffer();
   Void createEncBuffer();
   Void assignSaoUnitSyntax(SaoLcuParam* saoLcuParam,  SAOQTPart* saoPart, Bool &oneUnitFlag);
@@ -58,6 +58,17 @@ TEncSlice::TEncSlice()
   m_pcBufferBinCoderCABACs  = NULL;
   m_pcBufferLowLatSbacCoders    = NULL;
   m_pcBufferLowLatBinCoderCABACs  = NULL;
+  m_pcRowSbacCoders       = NULL;
+  m_pcRowBinCoderCABACs   = NULL;
+  m_pcTileSubstreams      = NULL;
+  m_uiNumTileSubstreams   = 0;
+  m_pcParallelPic         = NULL;
+  m_uiParallelStartLCU    = 0;
+  m_uiParallelEndLCU      = 0;
+  m_iLastCTUThreadIdx     = 0;
+  m_bParallelCTUs         = true;
+  m_ppppcRDSbacCoders     = NULL;
+  m_pcBitCounters         = NULL;
 }
 
 TEncSlice::~TEncSlice()
@@ -130,6 +141,14 @@ Void TEncSlice::destroy()
     delete[] m_pcBufferLowLatSbacCoders;
   if ( m_pcBufferLowLatBinCoderCABACs )
     delete[] m_pcBufferLowLatBinCoderCABACs;
+  delete[] m_pcRowSbacCoders;
+  delete[] m_pcRowBinCoderCABACs;
+  m_pcRowSbacCoders     = NULL;
+  m_pcRowBinCoderCABACs = NULL;
+  m_cRowProgress.destroy();
+  delete[] m_pcTileSubstreams;
+  m_pcTileSubstreams    = NULL;
+  m_uiNumTileSubstreams = 0;
 }
 
 Void TEncSlice::init( TEncTop* pcEncTop )
@@ -159,6 +178,30 @@ Void TEncSlice::init( TEncTop* pcEncTop )
   m_pcRateCtrl        = pcEncTop->getRateCtrl();
 }
 
+/** Initialize a slice encoder that uses its own coding tools instead of the ones of the encoder class.
+ * \param pcEncTop     pointer of encoder class (provides the configuration)
+ * \param pcTools      CU-level coding tools of the slice encoder
+ * \param pcCavlcCoder CAVLC encoder of the slice encoder
+ */
+Void TEncSlice::init( TEncTop* pcEncTop, TEncSliceWorker* pcTools, TEncCavlc* pcCavlcCoder )
+{
+  init( pcEncTop );
+
+  m_pcCuEncoder       = pcTools->getCuEncoder();
+  m_pcPredSearch      = pcTools->getPredSearch();
+
+  m_pcEntropyCoder    = pcTools->getEntropyCoder();
+  m_pcCavlcCoder      = pcCavlcCoder;
+  m_pcSbacCoder       = pcTools->getSbacCoder();
+  m_pcBinCABAC        = pcTools->getBinCABAC();
+  m_pcTrQuant         = pcTools->getTrQuant();
+
+  m_pcBitCounter      = pcTools->getBitCounter();
+  m_pcRdCost          = pcTools->getRdCost();
+  m_pppcRDSbacCoder   = pcTools->getRDSbacCoder();
+  m_pcRDGoOnSbacCoder = pcTools->getRDGoOnSbacCoder();
+}
+
 
 
 Void
@@ -779,9 +822,8 @@ Void TEncSlice::compressSlice( TComPic*& rpcPic )
     }
   }
 #endif
-  TEncTop* pcEncTop = (TEncTop*) m_pcCfg;
-  TEncSbac**** ppppcRDSbacCoders    = pcEncTop->getRDSbacCoders();
-  TComBitCounter* pcBitCounters     = pcEncTop->getBitCounters();
+  TEncSbac**** ppppcRDSbacCoders    = m_ppppcRDSbacCoders;
+  TComBitCounter* pcBitCounters     = m_pcBitCounters;
   Int  iNumSubstreams = 1;
   UInt uiTilesAcross  = 0;
 
@@ -864,6 +906,21 @@ Void TEncSlice::compressSlice( TComPic*& rpcPic )
       CTXMem[0]->loadContexts(m_pcSbacCoder);
     }
   }
+  // compress the CTU rows of a wavefront slice concurrently
+  if( xUseParallelRows( rpcPic, bWp_explicit ) )
+  {
+    xCompressSliceRows( rpcPic, uiStartCUAddr, uiBoundingCUAddr );
+    xRestoreWPparam( pcSlice );
+    return;
+  }
+  // compress the tiles of the slice concurrently
+  if( xUseParallelTiles( rpcPic, bWp_explicit ) )
+  {
+    xCompressSliceTiles( rpcPic, uiStartCUAddr, uiBoundingCUAddr );
+    xRestoreWPparam( pcSlice );
+    return;
+  }
+
   // for every CU in slice
   UInt uiEncCUOrder;
   for( uiEncCUOrder = uiStartCUAddr/rpcPic->getNumPartInCU();
@@ -943,6 +1000,9 @@ Void TEncSlice::compressSlice( TComPic*& rpcPic )
       {
         sliceType = (SliceType) pcSlice->getPPS()->getEncCABACTableIdx();
       }
+      // tiles are independent: start from the state of the start of the slice rather than the end of the previous
+      // tile, as the tile jobs of xCompressSliceTiles() do, so that the output does not depend on the thread count
+      m_pppcRDSbacCoder[0][CI_CURR_BEST]->load( m_pcSbacCoder );
       m_pcEntropyCoder->updateContextTables ( sliceType, pcSlice->getSliceQp(), false );
       m_pcEntropyCoder->setEntropyCoder     ( m_pppcRDSbacCoder[0][CI_CURR_BEST], pcSlice );
       m_pcEntropyCoder->updateContextTables ( sliceType, pcSlice->getSliceQp() );
@@ -1188,6 +1248,381 @@ Void TEncSlice::compressSlice( TComPic*& rpcPic )
 #endif
 }
 
+/** Check whether the CTU rows of the current slice can be compressed concurrently.
+ * This requires wavefront substreams (one per CTU row) in a single tile and no dependency between CTUs other than the
+ * wavefront one: slices ending after a number of bytes, dependent slice segments, rate control and adaptive QP
+ * selection are processed sequentially, as well as explicit weighted prediction, whose distortion parameters are shared.
+ * \param pcPic       picture class
+ * \param bWpExplicit explicit weighted prediction is used by the slice
+ * \returns true if the rows are compressed by the thread pool
+ */
+Bool TEncSlice::xUseParallelRows( TComPic* pcPic, Bool bWpExplicit )
+{
+  TEncTop*   pcEncTop = (TEncTop*) m_pcCfg;
+  TComSlice* pcSlice  = pcPic->getSlice(getSliceIdx());
+
+  return pcEncTop->getThreadPool()->getNumThreads() > 1
+      && m_bParallelCTUs
+      && m_pcCfg->getUseSBACRD()
+      && m_pcCfg->getWaveFrontsynchro()
+      && pcSlice->getPPS()->getNumSubstreams() == pcPic->getFrameHeightInCU()
+      && pcPic->getPicSym()->getNumTiles() == 1
+      && !pcSlice->getPPS()->getDependentSliceSegmentsEnabledFlag()
+      && m_pcCfg->getSliceMode() != FIXED_NUMBER_OF_BYTES
+      && m_pcCfg->getSliceSegmentMode() != FIXED_NUMBER_OF_BYTES
+      && !m_pcCfg->getUseRateCtrl()
+#if ADAPTIVE_QP_SELECTION
+      && !m_pcCfg->getUseAdaptQpSelect()
+#endif
+      && !bWpExplicit;
+}
+
+/** Check whether the tiles of the current slice can be compressed and encoded concurrently.
+ * This requires several tiles without wavefronts, so that all the tiles of the slice are written to one substream,
+ * and the same restrictions as xUseParallelRows().
+ * \param pcPic       picture class
+ * \param bWpExplicit explicit weighted prediction is used by the slice
+ * \returns true if the tiles are processed by the thread pool
+ */
+Bool TEncSlice::xUseParallelTiles( TComPic* pcPic, Bool bWpExplicit )
+{
+  TEncTop*   pcEncTop = (TEncTop*) m_pcCfg;
+  TComSlice* pcSlice  = pcPic->getSlice(getSliceIdx());
+
+  return pcEncTop->getThreadPool()->getNumThreads() > 1
+      && m_bParallelCTUs
+      && m_pcCfg->getUseSBACRD()
+      && !m_pcCfg->getWaveFrontsynchro()
+      && pcSlice->getPPS()->getNumSubstreams() == 1
+      && pcPic->getPicSym()->getNumTiles() > 1
+      && !pcSlice->getPPS()->getDependentSliceSegmentsEnabledFlag()
+      && m_pcCfg->getSliceMode() != FIXED_NUMBER_OF_BYTES
+      && m_pcCfg->getSliceSegmentMode() != FIXED_NUMBER_OF_BYTES
+      && !m_pcCfg->getUseRateCtrl()
+#if ADAPTIVE_QP_SELECTION
+      && !m_pcCfg->getUseAdaptQpSelect()
+#endif
+      && !bWpExplicit;
+}
+
+/** Compress the CTU rows of a wavefront slice with the thread pool.
+ * Each row is compressed by one thread with its own coding tools. A CTU is started once the CTU above-right of it
+ * is finished, and the contexts are inherited from the row above after its second CTU, exactly as in the sequential
+ * loop of compressSlice(), so that the decisions and the bitstream do not depend on the number of threads.
+ * \param pcPic            picture class
+ * \param uiStartCUAddr    start address of the slice
+ * \param uiBoundingCUAddr bounding address of the slice
+ */
+Void TEncSlice::xCompressSliceRows( TComPic* pcPic, UInt uiStartCUAddr, UInt uiBoundingCUAddr )
+{
+  TEncTop*         pcEncTop          = (TEncTop*) m_pcCfg;
+  TComSlice*       pcSlice           = pcPic->getSlice(getSliceIdx());
+  TEncSbac****     ppppcRDSbacCoders = m_ppppcRDSbacCoders;
+  TComBitCounter*  pcBitCounters     = m_pcBitCounters;
+  TComThreadPool*  pcThreadPool      = pcEncTop->getThreadPool();
+  const UInt       uiWidthInLCUs     = pcPic->getFrameWidthInCU();
+  const UInt       uiHeightInLCUs    = pcPic->getFrameHeightInCU();
+
+  m_pcParallelPic      = pcPic;
+  m_uiParallelStartLCU = uiStartCUAddr/pcPic->getNumPartInCU();
+  m_uiParallelEndLCU   = (uiBoundingCUAddr+(pcPic->getNumPartInCU()-1))/pcPic->getNumPartInCU();
+
+  const UInt uiFirstRow = m_uiParallelStartLCU / uiWidthInLCUs;
+  const UInt uiLastRow  = (m_uiParallelEndLCU - 1) / uiWidthInLCUs;
+
+  if ( m_cRowProgress.getNumCounters() != uiHeightInLCUs )
+  {
+    delete[] m_pcRowSbacCoders;
+    delete[] m_pcRowBinCoderCABACs;
+    m_pcRowSbacCoders     = new TEncSbac    [uiHeightInLCUs];
+    m_pcRowBinCoderCABACs = new TEncBinCABAC[uiHeightInLCUs];
+    for ( UInt ui = 0; ui < uiHeightInLCUs; ui++ )
+    {
+      m_pcRowSbacCoders[ui].init( &m_pcRowBinCoderCABACs[ui] );
+    }
+    m_cRowProgress.create( uiHeightInLCUs );
+  }
+  // the CTUs of the first row that precede the slice are finished
+  m_cRowProgress.reset();
+  m_cRowProgress.set( uiFirstRow, m_uiParallelStartLCU % uiWidthInLCUs );
+
+  for ( Int i = 0; i < pcThreadPool->getNumThreads(); i++ )
+  {
+    TEncSliceWorker* pcWorker = pcEncTop->getSliceWorker( i );
+    pcWorker->loadSliceSettings( m_pcRdCost, m_pcTrQuant, m_pcPredSearch );
+    pcWorker->getCuEncoder()->setSliceBitsMutex( &m_cSliceBitsMutex );
+  }
+
+  TComMemberJob<TEncSlice> cRowJob( this, &TEncSlice::xCompressCTURow );
+  pcThreadPool->execute( &cRowJob, uiLastRow - uiFirstRow + 1 );
+
+  // accumulate in coding order, as the sequential loop does
+  for ( UInt uiCUAddr = m_uiParallelStartLCU; uiCUAddr < m_uiParallelEndLCU; uiCUAddr++ )
+  {
+    TComDataCU* pcCU = pcPic->getCU( uiCUAddr );
+    m_uiPicTotalBits += pcCU->getTotalBits();
+    m_dPicRdCost     += pcCU->getTotalCost();
+    m_uiPicDist      += pcCU->getTotalDistortion();
+  }
+
+  // leave the coders as the sequential loop does after the last CTU (SAO RDO reuses the go-on coder and its bit counter)
+  m_pppcRDSbacCoder[0][CI_CURR_BEST]->load( ppppcRDSbacCoders[uiLastRow][0][CI_CURR_BEST] );
+  m_pcRDGoOnSbacCoder->load( pcEncTop->getSliceWorker( m_iLastCTUThreadIdx )->getRDGoOnSbacCoder() );
+  ((TEncBinCABAC*)m_pcRDGoOnSbacCoder->getEncBinIf())->setBinCountingEnableFlag( true );
+  m_pcEntropyCoder->setEntropyCoder ( m_pcRDGoOnSbacCoder, pcSlice );
+  m_pcEntropyCoder->setBitstream( &pcBitCounters[uiLastRow] );
+  m_pcEntropyCoder->setEntropyCoder ( m_pppcRDSbacCoder[0][CI_CURR_BEST], pcSlice );
+  m_pcEntropyCoder->setBitstream( &pcBitCounters[uiLastRow] );
+  m_pcCuEncoder->setBitCounter( &pcBitCounters[uiLastRow] );
+  m_pcBitCounter = &pcBitCounters[uiLastRow];
+  m_pcParallelPic = NULL;
+
+  pcSlice->setNextSlice( true );
+}
+
+/** Compress the tiles of a slice with the thread pool.
+ * Each tile is compressed by one thread with its own coding tools, starting from the contexts of the start of the
+ * slice, which are reset at the tile boundary as in the sequential loop of compressSlice().
+ * \param pcPic            picture class
+ * \param uiStartCUAddr    start address of the slice
+ * \param uiBoundingCUAddr bounding address of the slice
+ */
+Void TEncSlice::xCompressSliceTiles( TComPic* pcPic, UInt uiStartCUAddr, UInt uiBoundingCUAddr )
+{
+  TEncTop*         pcEncTop          = (TEncTop*) m_pcCfg;
+  TComSlice*       pcSlice           = pcPic->getSlice(getSliceIdx());
+  TEncSbac****     ppppcRDSbacCoders = m_ppppcRDSbacCoders;
+  TComBitCounter*  pcBitCounters     = m_pcBitCounters;
+  TComThreadPool*  pcThreadPool      = pcEncTop->getThreadPool();
+
+  xSetTileStarts( pcPic, uiStartCUAddr, uiBoundingCUAddr );
+
+  for ( Int i = 0; i < pcThreadPool->getNumThreads(); i++ )
+  {
+    TEncSliceWorker* pcWorker = pcEncTop->getSliceWorker( i );
+    pcWorker->loadSliceSettings( m_pcRdCost, m_pcTrQuant, m_pcPredSearch );
+    pcWorker->getCuEncoder()->setSliceBitsMutex( &m_cSliceBitsMutex );
+  }
+
+  // initialise the CTUs in coding order before the tiles start: a tile reads the slice and address of the CTUs of its
+  // neighbouring tiles to check their availability
+  for ( UInt uiEncCUOrder = m_uiParallelStartLCU; uiEncCUOrder < m_uiParallelEndLCU; uiEncCUOrder++ )
+  {
+    const UInt uiCUAddr = pcPic->getPicSym()->getCUOrderMap( uiEncCUOrder );
+    pcPic->getCU( uiCUAddr )->initCU( pcPic, uiCUAddr );
+  }
+
+  TComMemberJob<TEncSlice> cTileJob( this, &TEncSlice::xCompressTile );
+  pcThreadPool->execute( &cTileJob, (Int)m_tileStartLCU.size() );
+
+  // accumulate in coding order, as the sequential loop does
+  for ( UInt uiEncCUOrder = m_uiParallelStartLCU; uiEncCUOrder < m_uiParallelEndLCU; uiEncCUOrder++ )
+  {
+    TComDataCU* pcCU = pcPic->getCU( pcPic->getPicSym()->getCUOrderMap( uiEncCUOrder ) );
+    m_uiPicTotalBits += pcCU->getTotalBits();
+    m_dPicRdCost     += pcCU->getTotalCost();
+    m_uiPicDist      += pcCU->getTotalDistortion();
+  }
+
+  // leave the coders as the sequential loop does after the last CTU (SAO RDO reuses the go-on coder and its bit counter),
+  // the job of the last tile has stored its state in m_pppcRDSbacCoder and m_pcRDGoOnSbacCoder
+  ppppcRDSbacCoders[0][0][CI_CURR_BEST]->load( m_pppcRDSbacCoder[0][CI_CURR_BEST] );
+  ((TEncBinCABAC*)m_pcRDGoOnSbacCoder->getEncBinIf())->setBinCountingEnableFlag( true );
+  m_pcEntropyCoder->setEntropyCoder ( m_pcRDGoOnSbacCoder, pcSlice );
+  m_pcEntropyCoder->setBitstream( &pcBitCounters[0] );
+  m_pcEntropyCoder->setEntropyCoder ( m_pppcRDSbacCoder[0][CI_CURR_BEST], pcSlice );
+  m_pcEntropyCoder->setBitstream( &pcBitCounters[0] );
+  m_pcCuEncoder->setBitCounter( &pcBitCounters[0] );
+  m_pcBitCounter = &pcBitCounters[0];
+  m_pcParallelPic = NULL;
+}
+
+/** Compress the CTUs of one CTU row of the slice (thread pool job).
+ * \param iRowIdx    index of the row within the slice
+ * \param iThreadIdx index of the executing thread, selects the coding tools
+ */
+Void TEncSlice::xCompressCTURow( Int iRowIdx, Int iThreadIdx )
+{
+  TEncTop*          pcEncTop          = (TEncTop*) m_pcCfg;
+  TComPic*          pcPic             = m_pcParallelPic;
+  TComSlice*        pcSlice           = pcPic->getSlice(getSliceIdx());
+  TEncSbac****      ppppcRDSbacCoders = m_ppppcRDSbacCoders;
+  TComBitCounter*   pcBitCounters     = m_pcBitCounters;
+  TEncSliceWorker*  pcWorker          = pcEncTop->getSliceWorker( iThreadIdx );
+  TEncBinCABAC*     pcRDSbacBinCoder  = (TEncBinCABAC*) pcWorker->getRDSbacCoder()[0][CI_CURR_BEST]->getEncBinIf();
+
+  const UInt uiWidthInLCUs = pcPic->getFrameWidthInCU();
+  const UInt uiMaxParts    = 1<<(pcSlice->getSPS()->getMaxCUDepth()<<1);
+  const UInt uiFirstRow    = m_uiParallelStartLCU / uiWidthInLCUs;
+  const UInt uiLin         = uiFirstRow + iRowIdx;
+  const UInt uiSubStrm     = uiLin;
+  const UInt uiRowStart    = max( m_uiParallelStartLCU, uiLin * uiWidthInLCUs );
+  const UInt uiRowEnd      = min( m_uiParallelEndLCU, (uiLin + 1) * uiWidthInLCUs );
+
+  pcRDSbacBinCoder->setBinCountingEnableFlag( false );
+  pcRDSbacBinCoder->setBinsCoded( 0 );
+  if ( uiRowEnd == m_uiParallelEndLCU )
+  {
+    m_iLastCTUThreadIdx = iThreadIdx;
+  }
+
+  for( UInt uiCUAddr = uiRowStart; uiCUAddr < uiRowEnd; uiCUAddr++ )
+  {
+    const UInt uiCol = uiCUAddr % uiWidthInLCUs;
+
+    // wait for the CTU above-right
+    if ( uiLin > uiFirstRow )
+    {
+      m_cRowProgress.waitFor( uiLin - 1, min( uiCol + 2, uiWidthInLCUs ) );
+    }
+
+    TComDataCU* pcCU = pcPic->getCU( uiCUAddr );
+    pcCU->initCU( pcPic, uiCUAddr );
+
+    // inherit from TR if it is available
+    if ( uiCol == 0 )
+    {
+      TComDataCU *pcCUTR = NULL;
+      if ( pcCU->getCUAbove() && (uiCol+1 < uiWidthInLCUs) )
+      {
+        pcCUTR = pcPic->getCU( uiCUAddr - uiWidthInLCUs + 1 );
+      }
+      if ( pcCUTR != NULL && pcCUTR->getSlice() != NULL && pcCUTR->getSCUAddr()+uiMaxParts-1 >= pcSlice->getSliceCurStartCUAddr() )
+      {
+        ppppcRDSbacCoders[uiSubStrm][0][CI_CURR_BEST]->loadContexts( &m_pcRowSbacCoders[uiLin-1] );
+      }
+    }
+
+    xCompressCTU( pcWorker, pcCU, ppppcRDSbacCoders[uiSubStrm][0][CI_CURR_BEST], &pcBitCounters[uiSubStrm], false );
+
+    //Store probabilties of second LCU in line into buffer
+    if ( uiCol == 1 )
+    {
+      m_pcRowSbacCoders[uiLin].loadContexts( ppppcRDSbacCoders[uiSubStrm][0][CI_CURR_BEST] );
+    }
+
+    m_cRowProgress.set( uiLin, uiCol + 1 );
+  }
+}
+
+/** Compress the CTUs of one tile of the slice (thread pool job).
+ * \param iTileIdx   index of the tile within the slice
+ * \param iThreadIdx index of the executing thread, selects the coding tools
+ */
+Void TEncSlice::xCompressTile( Int iTileIdx, Int iThreadIdx )
+{
+  TEncTop*          pcEncTop          = (TEncTop*) m_pcCfg;
+  TComPic*          pcPic             = m_pcParallelPic;
+  TComSlice*        pcSlice           = pcPic->getSlice(getSliceIdx());
+  TEncSliceWorker*  pcWorker          = pcEncTop->getSliceWorker( iThreadIdx );
+  TEncSbac*         pcSubstreamCoder  = pcWorker->getSbacCoder();
+  TEncBinCABAC*     pcRDSbacBinCoder  = (TEncBinCABAC*) pcWorker->getRDSbacCoder()[0][CI_CURR_BEST]->getEncBinIf();
+
+  const UInt uiTileStart = m_tileStartLCU[iTileIdx];
+  const UInt uiTileEnd   = iTileIdx+1 < m_tileStartLCU.size() ? m_tileStartLCU[iTileIdx+1] : m_uiParallelEndLCU;
+  const UInt uiSliceStartLCU        = pcPic->getPicSym()->getPicSCUAddr( pcSlice->getSliceCurStartCUAddr() ) / pcPic->getNumPartInCU();
+  const UInt uiSliceSegmentStartLCU = pcPic->getPicSym()->getPicSCUAddr( pcSlice->getSliceSegmentCurStartCUAddr() ) / pcPic->getNumPartInCU();
+
+  pcRDSbacBinCoder->setBinCountingEnableFlag( false );
+  pcRDSbacBinCoder->setBinsCoded( 0 );
+
+  // all the tiles share substream 0, which holds the state of the start of the slice
+  pcSubstreamCoder->load( m_ppppcRDSbacCoders[0][0][CI_CURR_BEST] );
+
+  for( UInt uiEncCUOrder = uiTileStart; uiEncCUOrder < uiTileEnd; uiEncCUOrder++ )
+  {
+    const UInt uiCUAddr = pcPic->getPicSym()->getCUOrderMap( uiEncCUOrder );
+    TComDataCU* pcCU = pcPic->getCU( uiCUAddr );
+
+    const Bool bTileStart = uiCUAddr == pcPic->getPicSym()->getTComTile(pcPic->getPicSym()->getTileIdxMap(uiCUAddr))->getFirstCUAddr()
+                         && uiCUAddr != 0 && uiCUAddr != uiSliceSegmentStartLCU && uiCUAddr != uiSliceStartLCU;
+
+    xCompressCTU( pcWorker, pcCU, pcSubstreamCoder, pcWorker->getBitCounter(), bTileStart );
+  }
+
+  // the tiles run in any order and the thread may go on with another tile: keep the state after the last CTU now
+  if ( uiTileEnd == m_uiParallelEndLCU )
+  {
+    m_pppcRDSbacCoder[0][CI_CURR_BEST]->load( pcSubstreamCoder );
+    m_pcRDGoOnSbacCoder->load( pcWorker->getRDGoOnSbacCoder() );
+  }
+}
+
+/** Compress one CTU with the coding tools of a thread, as the sequential loop of compressSlice() does.
+ * \param pcWorker          coding tools of the executing thread
+ * \param pcCU              CTU to be compressed
+ * \param pcSubstreamCoder  entropy coder state of the substream, updated with the coded CTU
+ * \param pcBitCounter      bit counter of the substream
+ * \param bTileStart        the CTU is the first of a tile inside the slice, the contexts are reset
+ */
+Void TEncSlice::xCompressCTU( TEncSliceWorker* pcWorker, TComDataCU* pcCU, TEncSbac* pcSubstreamCoder, TComBitCounter* pcBitCounter, Bool bTileStart )
+{
+  TComSlice*        pcSlice           = m_pcParallelPic->getSlice(getSliceIdx());
+  TEncCu*           pcCuEncoder       = pcWorker->getCuEncoder();
+  TEncEntropy*      pcEntropyCoder    = pcWorker->getEntropyCoder();
+  TEncSbac***       pppcRDSbacCoder   = pcWorker->getRDSbacCoder();
+  TEncSbac*         pcRDGoOnSbacCoder = pcWorker->getRDGoOnSbacCoder();
+  TEncBinCABAC*     pcRDSbacBinCoder  = (TEncBinCABAC*) pppcRDSbacCoder[0][CI_CURR_BEST]->getEncBinIf();
+
+  pppcRDSbacCoder[0][CI_CURR_BEST]->load( pcSubstreamCoder );
+
+  // reset the entropy coder
+  if ( bTileStart )
+  {
+    SliceType sliceType = pcSlice->getSliceType();
+    if (!pcSlice->isIntra() && pcSlice->getPPS()->getCabacInitPresentFlag() && pcSlice->getPPS()->getEncCABACTableIdx()!=I_SLICE)
+    {
+      sliceType = (SliceType) pcSlice->getPPS()->getEncCABACTableIdx();
+    }
+    pcEntropyCoder->setEntropyCoder     ( pppcRDSbacCoder[0][CI_CURR_BEST], pcSlice );
+    pcEntropyCoder->setBitstream        ( pcBitCounter );
+    pcEntropyCoder->updateContextTables ( sliceType, pcSlice->getSliceQp(), false );
+    pcEntropyCoder->updateContextTables ( sliceType, pcSlice->getSliceQp() );
+  }
+
+  // set go-on entropy coder
+  pcEntropyCoder->setEntropyCoder ( pcRDGoOnSbacCoder, pcSlice );
+  pcEntropyCoder->setBitstream( pcBitCounter );
+  ((TEncBinCABAC*)pcRDGoOnSbacCoder->getEncBinIf())->setBinCountingEnableFlag(true);
+
+  // run CU encoder
+  pcCuEncoder->compressCU( pcCU );
+
+  // restore entropy coder to an initial stage
+  pcEntropyCoder->setEntropyCoder ( pppcRDSbacCoder[0][CI_CURR_BEST], pcSlice );
+  pcEntropyCoder->setBitstream( pcBitCounter );
+  pcCuEncoder->setBitCounter( pcBitCounter );
+  pcRDSbacBinCoder->setBinCountingEnableFlag( true );
+  pcBitCounter->resetBits();
+  pcRDSbacBinCoder->setBinsCoded( 0 );
+  pcCuEncoder->encodeCU( pcCU );
+  pcRDSbacBinCoder->setBinCountingEnableFlag( false );
+
+  pcSubstreamCoder->load( pppcRDSbacCoder[0][CI_CURR_BEST] );
+}
+
+/** Collect the first CTU of each tile of the slice.
+ * \param pcPic            picture class
+ * \param uiStartCUAddr    start address of the slice
+ * \param uiBoundingCUAddr bounding address of the slice
+ */
+Void TEncSlice::xSetTileStarts( TComPic* pcPic, UInt uiStartCUAddr, UInt uiBoundingCUAddr )
+{
+  m_pcParallelPic      = pcPic;
+  m_uiParallelStartLCU = uiStartCUAddr/pcPic->getNumPartInCU();
+  m_uiParallelEndLCU   = (uiBoundingCUAddr+(pcPic->getNumPartInCU()-1))/pcPic->getNumPartInCU();
+
+  m_tileStartLCU.clear();
+  for ( UInt uiEncCUOrder = m_uiParallelStartLCU; uiEncCUOrder < m_uiParallelEndLCU; uiEncCUOrder++ )
+  {
+    UInt uiCUAddr = pcPic->getPicSym()->getCUOrderMap( uiEncCUOrder );
+    if ( uiEncCUOrder == m_uiParallelStartLCU || uiCUAddr == pcPic->getPicSym()->getTComTile(pcPic->getPicSym()->getTileIdxMap(uiCUAddr))->getFirstCUAddr() )
+    {
+      m_tileStartLCU.push_back( uiEncCUOrder );
+    }
+  }
+}
+
 /**
  \param  rpcPic        picture class
  \retval rpcBitstream  bitstream class
@@ -1198,8 +1633,6 @@ Void TEncSlice::encodeSlice   ( TComPic*& rpcPic, TComOutputBitstream* pcSubstre
   UInt       uiStartCUAddr;
   UInt       uiBoundingCUAddr;
   TComSlice* pcSlice = rpcPic->getSlice(getSliceIdx());
-  const UInt numberValidComponents = rpcPic->getNumberValidComponents();
-  const Bool bChroma = isChromaEnabled(rpcPic->getChromaFormat());
 
   uiStartCUAddr=pcSlice->getSliceSegmentCurStartCUAddr();
   uiBoundingCUAddr=pcSlice->getSliceSegmentCurEndCUAddr();
@@ -1230,6 +1663,19 @@ Void TEncSlice::encodeSlice   ( TComPic*& rpcPic, TComOutputBitstream* pcSubstre
   UInt uiBitsOriginallyInSubstreams = 0;
   {
     UInt uiTilesAcross = rpcPic->getPicSym()->getNumColumnsMinus1()+1;
+    if ( m_pcBufferSbacCoders == NULL )
+    {
+      // the picture has been compressed by another slice encoder
+      m_pcBufferSbacCoders           = new TEncSbac    [uiTilesAcross];
+      m_pcBufferBinCoderCABACs       = new TEncBinCABAC[uiTilesAcross];
+      m_pcBufferLowLatSbacCoders     = new TEncSbac    [uiTilesAcross];
+      m_pcBufferLowLatBinCoderCABACs = new TEncBinCABAC[uiTilesAcross];
+      for (UInt ui = 0; ui < uiTilesAcross; ui++)
+      {
+        m_pcBufferSbacCoders[ui].init( &m_pcBufferBinCoderCABACs[ui] );
+        m_pcBufferLowLatSbacCoders[ui].init( &m_pcBufferLowLatBinCoderCABACs[ui] );
+      }
+    }
     for (UInt ui = 0; ui < uiTilesAcross; ui++)
     {
       m_pcBufferSbacCoders[ui].load(m_pcSbacCoder); //init. state
@@ -1291,6 +1737,19 @@ Void TEncSlice::encodeSlice   ( TComPic*& rpcPic, TComOutputBitstream* pcSubstre
     }
   }
 
+#if !ENC_DEC_TRACE
+  // encode the tiles of the slice segment concurrently
+  if( xUseParallelTiles( rpcPic, false ) )
+  {
+    xEncodeSliceTiles( rpcPic, pcSubstreams, uiStartCUAddr, uiBoundingCUAddr, uiBitsOriginallyInSubstreams );
+    if (pcSlice->getPPS()->getCabacInitPresentFlag())
+    {
+      m_pcEntropyCoder->determineCabacInitIdx();
+    }
+    return;
+  }
+#endif
+
   UInt uiEncCUOrder;
   for( uiEncCUOrder = uiStartCUAddr /rpcPic->getNumPartInCU();
        uiEncCUOrder < (uiBoundingCUAddr+rpcPic->getNumPartInCU()-1)/rpcPic->getNumPartInCU();
@@ -1383,89 +1842,7 @@ Void TEncSlice::encodeSlice   ( TComPic*& rpcPic, TComOutputBitstream* pcSubstre
     }
 
     TComDataCU*& pcCU = rpcPic->getCU( uiCUAddr );
-    if ( pcSlice->getSPS()->getUseSAO() && (pcSlice->getSaoEnabledFlag()||pcSlice->getSaoEnabledFlagChroma()) )
-    {
-      SAOParam *saoParam = pcSlice->getPic()->getPicSym()->getSaoParam();
-      Int iNumCuInWidth     = saoParam->numCuInWidth;
-      Int iCUAddrInSlice    = uiCUAddr - rpcPic->getPicSym()->getCUOrderMap(pcSlice->getSliceCurStartCUAddr()/rpcPic->getNumPartInCU());
-      Int iCUAddrUpInSlice  = iCUAddrInSlice - iNumCuInWidth;
-      Int rx = uiCUAddr % iNumCuInWidth;
-      Int ry = uiCUAddr / iNumCuInWidth;
-      Int allowMergeLeft = 1;
-      Int allowMergeUp   = 1;
-      if (rx!=0)
-      {
-        if (rpcPic->getPicSym()->getTileIdxMap(uiCUAddr-1) != rpcPic->getPicSym()->getTileIdxMap(uiCUAddr))
-        {
-          allowMergeLeft = 0;
-        }
-      }
-      if (ry!=0)
-      {
-        if (rpcPic->getPicSym()->getTileIdxMap(uiCUAddr-iNumCuInWidth) != rpcPic->getPicSym()->getTileIdxMap(uiCUAddr))
-        {
-          allowMergeUp = 0;
-        }
-      }
-      Int addr = pcCU->getAddr();
-      allowMergeLeft = allowMergeLeft && (rx>0) && (iCUAddrInSlice!=0);
-      allowMergeUp = allowMergeUp && (ry>0) && (iCUAddrUpInSlice>=0);
-      if( saoParam->bSaoFlag[CHANNEL_TYPE_LUMA] || (bChroma && saoParam->bSaoFlag[CHANNEL_TYPE_CHROMA]) )
-      {
-        Int mergeLeft = saoParam->saoLcuParam[0][addr].mergeLeftFlag;
-        Int mergeUp = saoParam->saoLcuParam[0][addr].mergeUpFlag;
-        if (allowMergeLeft)
-        {
-          m_pcEntropyCoder->m_pcEntropyCoderIf->codeSaoMerge(mergeLeft);
-        }
-        else
-        {
-          mergeLeft = 0;
-        }
-        if(mergeLeft == 0)
-        {
-          if (allowMergeUp)
-          {
-            m_pcEntropyCoder->m_pcEntropyCoderIf->codeSaoMerge(mergeUp);
-          }
-          else
-          {
-            mergeUp = 0;
-          }
-          if(mergeUp == 0)
-          {
-            for (Int compIdx=0;compIdx<numberValidComponents;compIdx++)
-            {
-              const ComponentID compID=ComponentID(compIdx);
-              if( saoParam->bSaoFlag[toChannelType(compID)])
-              {
-                m_pcEntropyCoder->encodeSaoOffset(&saoParam->saoLcuParam[compIdx][addr], compID);
-              }
-            }
-          }
-        }
-      }
-    }
-    else if (pcSlice->getSPS()->getUseSAO())
-    {
-      Int addr = pcCU->getAddr();
-      SAOParam *saoParam = pcSlice->getPic()->getPicSym()->getSaoParam();
-      for (Int cIdx=0; cIdx<3; cIdx++)
-      {
-        SaoLcuParam *saoLcuParam = &(saoParam->saoLcuParam[cIdx][addr]);
-        if ( ((cIdx == 0) && !pcSlice->getSaoEnabledFlag()) || ((cIdx == 1 || cIdx == 2) && !pcSlice->getSaoEnabledFlagChroma()))
-        {
-          saoLcuParam->mergeUpFlag   = 0;
-          saoLcuParam->mergeLeftFlag = 0;
-          saoLcuParam->subTypeIdx    = 0;
-          saoLcuParam->typeIdx       = -1;
-          saoLcuParam->offset[0]     = 0;
-          saoLcuParam->offset[1]     = 0;
-          saoLcuParam->offset[2]     = 0;
-          saoLcuParam->offset[3]     = 0;
-        }
-      }
-    }
+    xEncodeSAOParameters( m_pcEntropyCoder, rpcPic, pcSlice, pcCU );
 #if ENC_DEC_TRACE
     g_bJustDoIt = g_bEncDecTraceEnable;
 #endif
@@ -1520,6 +1897,212 @@ Void TEncSlice::encodeSlice   ( TComPic*& rpcPic, TComOutputBitstream* pcSubstre
   }
 }
 
+/** Encode the tiles of a slice segment with the thread pool.
+ * Each tile is coded by one thread to a bitstream of its own. The tiles are then appended to substream 0 in tile
+ * order, and the tile entry points recorded, as the sequential loop of encodeSlice() does.
+ * \param pcPic                        picture class
+ * \param pcSubstreams                 substreams of the slice
+ * \param uiStartCUAddr                start address of the slice segment
+ * \param uiBoundingCUAddr             bounding address of the slice segment
+ * \param uiBitsOriginallyInSubstreams number of bits in the substreams before the slice segment
+ */
+Void TEncSlice::xEncodeSliceTiles( TComPic* pcPic, TComOutputBitstream* pcSubstreams, UInt uiStartCUAddr, UInt uiBoundingCUAddr, UInt uiBitsOriginallyInSubstreams )
+{
+  TEncTop*         pcEncTop      = (TEncTop*) m_pcCfg;
+  TComSlice*       pcSlice       = pcPic->getSlice(getSliceIdx());
+  TEncSbac*        pcSbacCoders  = pcEncTop->getSbacCoders();
+  TComThreadPool*  pcThreadPool  = pcEncTop->getThreadPool();
+
+  xSetTileStarts( pcPic, uiStartCUAddr, uiBoundingCUAddr );
+
+  const UInt uiNumTiles = (UInt)m_tileStartLCU.size();
+  if ( m_uiNumTileSubstreams < uiNumTiles )
+  {
+    delete[] m_pcTileSubstreams;
+    m_pcTileSubstreams    = new TComOutputBitstream[uiNumTiles];
+    m_uiNumTileSubstreams = uiNumTiles;
+  }
+
+  for ( Int i = 0; i < pcThreadPool->getNumThreads(); i++ )
+  {
+    TEncSliceWorker* pcWorker = pcEncTop->getSliceWorker( i );
+    pcWorker->getCuEncoder()->setBitCounter( NULL );
+    pcWorker->getCuEncoder()->setSliceBitsMutex( &m_cSliceBitsMutex );
+  }
+
+  TComMemberJob<TEncSlice> cTileJob( this, &TEncSlice::xEncodeTile );
+  pcThreadPool->execute( &cTileJob, (Int)uiNumTiles );
+
+  for ( UInt uiTile = 0; uiTile < uiNumTiles; uiTile++ )
+  {
+    // every tile but the first one starts at a tile boundary inside the slice segment
+    if ( uiTile > 0 )
+    {
+      UInt numStartCodeEmulations = pcSubstreams[0].countStartCodeEmulations();
+      UInt uiAccumulatedSubstreamLength = pcSubstreams[0].getNumberOfWrittenBits();
+      pcSlice->addTileLocation( ((pcSlice->getTileOffstForMultES() + uiAccumulatedSubstreamLength - uiBitsOriginallyInSubstreams) >> 3) + numStartCodeEmulations );
+    }
+    pcSubstreams[0].addSubstream( &m_pcTileSubstreams[uiTile] );
+  }
+
+  // continue with the state after the last tile, stored in m_pcSbacCoder by its job
+  pcSbacCoders[0].load( m_pcSbacCoder );
+  m_pcEntropyCoder->setBitstream( &pcSubstreams[0] );
+  m_pcParallelPic = NULL;
+}
+
+/** Encode the CTUs of one tile of the slice segment (thread pool job).
+ * \param iTileIdx   index of the tile within the slice segment
+ * \param iThreadIdx index of the executing thread, selects the coding tools
+ */
+Void TEncSlice::xEncodeTile( Int iTileIdx, Int iThreadIdx )
+{
+  TEncTop*              pcEncTop       = (TEncTop*) m_pcCfg;
+  TComPic*              pcPic          = m_pcParallelPic;
+  TComSlice*            pcSlice        = pcPic->getSlice(getSliceIdx());
+  TEncSliceWorker*      pcWorker       = pcEncTop->getSliceWorker( iThreadIdx );
+  TEncCu*               pcCuEncoder    = pcWorker->getCuEncoder();
+  TEncEntropy*          pcEntropyCoder = pcWorker->getEntropyCoder();
+  TEncSbac*             pcSbacCoder    = pcWorker->getSbacCoder();
+  TComOutputBitstream*  pcTileStream   = &m_pcTileSubstreams[iTileIdx];
+
+  const UInt uiTileStart = m_tileStartLCU[iTileIdx];
+  const UInt uiTileEnd   = iTileIdx+1 < m_tileStartLCU.size() ? m_tileStartLCU[iTileIdx+1] : m_uiParallelEndLCU;
+
+  SliceType sliceType = pcSlice->getSliceType();
+  if (!pcSlice->isIntra() && pcSlice->getPPS()->getCabacInitPresentFlag() && pcSlice->getPPS()->getEncCABACTableIdx()!=I_SLICE)
+  {
+    sliceType = (SliceType) pcSlice->getPPS()->getEncCABACTableIdx();
+  }
+
+  pcTileStream->clear();
+  pcSbacCoder->load( &pcEncTop->getSbacCoders()[0] );
+  pcEntropyCoder->setEntropyCoder ( pcSbacCoder, pcSlice );
+  pcEntropyCoder->setBitstream( pcTileStream );
+  if ( iTileIdx > 0 )
+  {
+    // reset the contexts at the tile boundary; the previous tile is terminated by its own job
+    pcEntropyCoder->updateContextTables( sliceType, pcSlice->getSliceQp() );
+    pcTileStream->clear();
+  }
+
+  for( UInt uiEncCUOrder = uiTileStart; uiEncCUOrder < uiTileEnd; uiEncCUOrder++ )
+  {
+    TComDataCU* pcCU = pcPic->getCU( pcPic->getPicSym()->getCUOrderMap( uiEncCUOrder ) );
+    xEncodeSAOParameters( pcEntropyCoder, pcPic, pcSlice, pcCU );
+    pcCuEncoder->encodeCU( pcCU );
+  }
+
+  if ( uiTileEnd != m_uiParallelEndLCU )
+  {
+    // terminate the tile as the sequential loop does when crossing into the next tile
+    pcEntropyCoder->updateContextTables( sliceType, pcSlice->getSliceQp() );
+    pcTileStream->writeByteAlignment();
+  }
+  else
+  {
+    // the thread may go on with another tile: keep the state after the last tile now
+    m_pcSbacCoder->load( pcSbacCoder );
+  }
+}
+
+/** Encode the SAO parameters of a CTU.
+ * \param pcEntropyCoder entropy encoder
+ * \param pcPic          picture class
+ * \param pcSlice        slice of the CTU
+ * \param pcCU           CTU
+ */
+Void TEncSlice::xEncodeSAOParameters( TEncEntropy* pcEntropyCoder, TComPic* pcPic, TComSlice* pcSlice, TComDataCU* pcCU )
+{
+  const UInt numberValidComponents = pcPic->getNumberValidComponents();
+  const Bool bChroma = isChromaEnabled(pcPic->getChromaFormat());
+  const UInt uiCUAddr = pcCU->getAddr();
+
+  if ( pcSlice->getSPS()->getUseSAO() && (pcSlice->getSaoEnabledFlag()||pcSlice->getSaoEnabledFlagChroma()) )
+  {
+    SAOParam *saoParam = pcSlice->getPic()->getPicSym()->getSaoParam();
+    Int iNumCuInWidth     = saoParam->numCuInWidth;
+    Int iCUAddrInSlice    = uiCUAddr - pcPic->getPicSym()->getCUOrderMap(pcSlice->getSliceCurStartCUAddr()/pcPic->getNumPartInCU());
+    Int iCUAddrUpInSlice  = iCUAddrInSlice - iNumCuInWidth;
+    Int rx = uiCUAddr % iNumCuInWidth;
+    Int ry = uiCUAddr / iNumCuInWidth;
+    Int allowMergeLeft = 1;
+    Int allowMergeUp   = 1;
+    if (rx!=0)
+    {
+      if (pcPic->getPicSym()->getTileIdxMap(uiCUAddr-1) != pcPic->getPicSym()->getTileIdxMap(uiCUAddr))
+      {
+        allowMergeLeft = 0;
+      }
+    }
+    if (ry!=0)
+    {
+      if (pcPic->getPicSym()->getTileIdxMap(uiCUAddr-iNumCuInWidth) != pcPic->getPicSym()->getTileIdxMap(uiCUAddr))
+      {
+        allowMergeUp = 0;
+      }
+    }
+    Int addr = pcCU->getAddr();
+    allowMergeLeft = allowMergeLeft && (rx>0) && (iCUAddrInSlice!=0);
+    allowMergeUp = allowMergeUp && (ry>0) && (iCUAddrUpInSlice>=0);
+    if( saoParam->bSaoFlag[CHANNEL_TYPE_LUMA] || (bChroma && saoParam->bSaoFlag[CHANNEL_TYPE_CHROMA]) )
+    {
+      Int mergeLeft = saoParam->saoLcuParam[0][addr].mergeLeftFlag;
+      Int mergeUp = saoParam->saoLcuParam[0][addr].mergeUpFlag;
+      if (allowMergeLeft)
+      {
+        pcEntropyCoder->m_pcEntropyCoderIf->codeSaoMerge(mergeLeft);
+      }
+      else
+      {
+        mergeLeft = 0;
+      }
+      if(mergeLeft == 0)
+      {
+        if (allowMergeUp)
+        {
+          pcEntropyCoder->m_pcEntropyCoderIf->codeSaoMerge(mergeUp);
+        }
+        else
+        {
+          mergeUp = 0;
+        }
+        if(mergeUp == 0)
+        {
+          for (Int compIdx=0;compIdx<numberValidComponents;compIdx++)
+          {
+            const ComponentID compID=ComponentID(compIdx);
+            if( saoParam->bSaoFlag[toChannelType(compID)])
+            {
+              pcEntropyCoder->encodeSaoOffset(&saoParam->saoLcuParam[compIdx][addr], compID);
+            }
+          }
+        }
+      }
+    }
+  }
+  else if (pcSlice->getSPS()->getUseSAO())
+  {
+    Int addr = pcCU->getAddr();
+    SAOParam *saoParam = pcSlice->getPic()->getPicSym()->getSaoParam();
+    for (Int cIdx=0; cIdx<3; cIdx++)
+    {
+      SaoLcuParam *saoLcuParam = &(saoParam->saoLcuParam[cIdx][addr]);
+      if ( ((cIdx == 0) && !pcSlice->getSaoEnabledFlag()) || ((cIdx == 1 || cIdx == 2) && !pcSlice->getSaoEnabledFlagChroma()))
+      {
+        saoLcuParam->mergeUpFlag   = 0;
+        saoLcuParam->mergeLeftFlag = 0;
+        saoLcuParam->subTypeIdx    = 0;
+        saoLcuParam->typeIdx       = -1;
+        saoLcuParam->offset[0]     = 0;
+        saoLcuParam->offset[1]     = 0;
+        saoLcuParam->offset[2]     = 0;
+        saoLcuParam->offset[3]     = 0;
+      }
+    }
+  }
+}
+
 /** Determines the starting and bounding LCU address of current slice / dependent slice
  * \param bEncodeSlice Identifies if the calling function is compressSlice() [false] or encodeSlice() [true]
  * \returns Updates uiStartCUAddr, uiBoundingCUAddr with appropriate LCU address
@@ -43,6 +43,7 @@
 #include "TLibCommon/TComList.h"
 #include "TLibCommon/TComPic.h"
 #include "TLibCommon/TComPicYuv.h"
+#include "TLibCommon/TComThreadPool.h"
 #include "TEncCu.h"
 #include "WeightPredAnalysis.h"
 #include "TEncRateCtrl.h"
@@ -52,6 +53,7 @@
 
 class TEncTop;
 class TEncGOP;
+class TEncSliceWorker;
 
 // ====================================================================================================================
 // Class definition
@@ -99,6 +101,20 @@ private:
   TEncSbac*               m_pcBufferSbacCoders;                 ///< line to store temporary contexts
   TEncBinCABAC*           m_pcBufferLowLatBinCoderCABACs;       ///< dependent tiles: line of bin coder CABAC
   TEncSbac*               m_pcBufferLowLatSbacCoders;           ///< dependent tiles: line to store temporary contexts
+  TEncBinCABAC*           m_pcRowBinCoderCABACs;                ///< parallel wavefront: bin coder CABAC of each CTU row
+  TEncSbac*               m_pcRowSbacCoders;                    ///< parallel wavefront: contexts after the second CTU of each CTU row
+  TComProgressCounters    m_cRowProgress;                       ///< parallel wavefront: number of finished CTUs of each CTU row
+  std::vector<UInt>       m_tileStartLCU;                       ///< parallel tiles: first CTU (encoding order) of each tile of the slice
+  TComOutputBitstream*    m_pcTileSubstreams;                   ///< parallel tiles: coded data of each tile of the slice
+  UInt                    m_uiNumTileSubstreams;                ///< parallel tiles: size of m_pcTileSubstreams
+  TComMutex               m_cSliceBitsMutex;                    ///< parallel CTUs: guards the slice bit counts
+  TComPic*                m_pcParallelPic;                      ///< parallel CTUs: picture being coded
+  UInt                    m_uiParallelStartLCU;                 ///< parallel CTUs: first CTU (encoding order) of the slice
+  UInt                    m_uiParallelEndLCU;                   ///< parallel CTUs: CTU (encoding order) following the last CTU of the slice
+  Int                     m_iLastCTUThreadIdx;                  ///< parallel CTU rows: thread that coded the last CTU of the slice
+  Bool                    m_bParallelCTUs;                      ///< parallel CTUs: the thread pool may be used for the CTUs of the slice
+  TEncSbac****            m_ppppcRDSbacCoders;                  ///< storage for SBAC-based RD optimization per substream
+  TComBitCounter*         m_pcBitCounters;                      ///< bit counters for RD optimization per substream
   TEncRateCtrl*           m_pcRateCtrl;                         ///< Rate control manager
   UInt                    m_uiSliceIdx;
   std::vector<TEncSbac*> CTXMem;
@@ -112,6 +128,7 @@ public:
   Void    create              ( Int iWidth, Int iHeight, ChromaFormat chromaFormat, UInt iMaxCUWidth, UInt iMaxCUHeight, UChar uhTotalDepth );
   Void    destroy             ();
   Void    init                ( TEncTop* pcEncTop );
+  Void    init                ( TEncTop* pcEncTop, TEncSliceWorker* pcTools, TEncCavlc* pcCavlcCoder );
   
   /// preparation of slice encoding (reference marking, QP and lambda)
   Void    initEncSlice        ( TComPic*  pcPic, Int pocLast, Int pocCurr, Int iNumPicRcvd,
@@ -139,9 +156,22 @@ public:
   Void    setSliceIdx(UInt i)   { m_uiSliceIdx = i;                       }
   Void      initCtxMem( UInt i );
   Void      setCtxMem( TEncSbac* sb, Int b )   { CTXMem[b] = sb; }
+  Void      setWPPCoders( TEncSbac**** ppppcRDSbacCoders, TComBitCounter* pcBitCounters ) { m_ppppcRDSbacCoders = ppppcRDSbacCoders; m_pcBitCounters = pcBitCounters; }
+  Void      setParallelCTUs( Bool b )   { m_bParallelCTUs = b; }
 
 private:
   Double  xGetQPValueAccordingToLambda ( Double lambda );
+  Bool    xUseParallelRows    ( TComPic* pcPic, Bool bWpExplicit );
+  Bool    xUseParallelTiles   ( TComPic* pcPic, Bool bWpExplicit );
+  Void    xCompressSliceRows  ( TComPic* pcPic, UInt uiStartCUAddr, UInt uiBoundingCUAddr );
+  Void    xCompressSliceTiles ( TComPic* pcPic, UInt uiStartCUAddr, UInt uiBoundingCUAddr );
+  Void    xCompressCTURow     ( Int iRowIdx, Int iThreadIdx );
+  Void    xCompressTile       ( Int iTileIdx, Int iThreadIdx );
+  Void    xCompressCTU        ( TEncSliceWorker* pcWorker, TComDataCU* pcCU, TEncSbac* pcSubstreamCoder, TComBitCounter* pcBitCounter, Bool bTileStart );
+  Void    xEncodeSliceTiles   ( TComPic* pcPic, TComOutputBitstream* pcSubstreams, UInt uiStartCUAddr, UInt uiBoundingCUAddr, UInt uiBitsOriginallyInSubstreams );
+  Void    xEncodeTile         ( Int iTileIdx, Int iThreadIdx );
+  Void    xEncodeSAOParameters( TEncEntropy* pcEntropyCoder, TComPic* pcPic, TComSlice* pcSlice, TComDataCU* pcCU );
+  Void    xSetTileStarts      ( TComPic* pcPic, UInt uiStartCUAddr, UInt uiBoundingCUAddr );
 };
 
 //! \}
@@ -79,6 +79,8 @@ TEncTop::TEncTop()
   m_pcRDGoOnBinCodersCABAC = NULL;
   m_pcBitCounters          = NULL;
   m_pcRdCosts              = NULL;
+  m_pcSliceWorkers         = NULL;
+  m_pcFrameWorkers         = NULL;
 }
 
 TEncTop::~TEncTop()
@@ -96,6 +98,9 @@ Void TEncTop::create ()
   // initialize global variables
   initROM();
 
+  // the distortion functions were set up when the encoder was constructed, before the SIMD level was chosen
+  m_cRdCost.init();
+
   // create processing unit classes
   m_cGOPEncoder.        create( );
   m_cSliceEncoder.      create( getSourceWidth(), getSourceHeight(), m_chromaFormatIDC, g_uiMaxCUWidth, g_uiMaxCUHeight, g_uiMaxCUDepth );
@@ -158,6 +163,31 @@ Void TEncTop::create ()
       }
     }
   }
+
+  // per-thread coding tools for parallel CTU compression
+  if( m_iNumThreads > 1 && m_bUseSBACRD )
+  {
+    m_cThreadPool.create( m_iNumThreads );
+    m_pcSliceWorkers = new TEncSliceWorker[m_iNumThreads];
+    for ( Int i = 0; i < m_iNumThreads; i++ )
+    {
+      m_pcSliceWorkers[i].create( m_chromaFormatIDC );
+    }
+    if (m_bUseSAO)
+    {
+      m_cEncSAO.setThreadPool( &m_cThreadPool );
+    }
+  }
+
+  // per-picture slice encoders for parallel picture compression
+  if( m_iNumParallelFrames > 1 )
+  {
+    m_pcFrameWorkers = new TEncFrameWorker[m_iNumParallelFrames];
+    for ( Int i = 0; i < m_iNumParallelFrames; i++ )
+    {
+      m_pcFrameWorkers[i].create( this );
+    }
+  }
 }
 
 /**
@@ -208,6 +238,14 @@ Void TEncTop::createWPPCoders(Int iNumSubstreams)
       }
     }
   }
+  m_cSliceEncoder.setWPPCoders( m_ppppcRDSbacCoders, m_pcBitCounters );
+  if ( m_pcFrameWorkers )
+  {
+    for ( Int i = 0; i < m_iNumParallelFrames; i++ )
+    {
+      m_pcFrameWorkers[i].createWPPCoders( iNumSubstreams );
+    }
+  }
 }
 
 Void TEncTop::destroy ()
@@ -223,6 +261,25 @@ Void TEncTop::destroy ()
   }
   m_cLoopFilter.        destroy();
   m_cRateCtrl.          destroy();
+  m_cThreadPool.        destroy();
+  if ( m_pcSliceWorkers )
+  {
+    for ( Int i = 0; i < m_iNumThreads; i++ )
+    {
+      m_pcSliceWorkers[i].destroy();
+    }
+    delete [] m_pcSliceWorkers;
+    m_pcSliceWorkers = NULL;
+  }
+  if ( m_pcFrameWorkers )
+  {
+    for ( Int i = 0; i < m_iNumParallelFrames; i++ )
+    {
+      m_pcFrameWorkers[i].destroy();
+    }
+    delete [] m_pcFrameWorkers;
+    m_pcFrameWorkers = NULL;
+  }
   // SBAC RD
   if( m_bUseSBACRD )
   {
@@ -321,6 +378,21 @@ Void TEncTop::init(Bool isFieldCoding)
   // initialize encoder search class
   m_cSearch.init( this, &m_cTrQuant, m_iSearchRange, m_bipredSearchRange, m_iFastSearch, 0, &m_cEntropyCoder, &m_cRdCost, getRDSbacCoder(), getRDGoOnSbacCoder() );
 
+  if ( m_pcSliceWorkers )
+  {
+    for ( Int i = 0; i < m_iNumThreads; i++ )
+    {
+      m_pcSliceWorkers[i].init( this );
+    }
+  }
+  if ( m_pcFrameWorkers )
+  {
+    for ( Int i = 0; i < m_iNumParallelFrames; i++ )
+    {
+      m_pcFrameWorkers[i].init( this );
+    }
+  }
+
   m_iMaxRefPicNum = 0;
 }
 
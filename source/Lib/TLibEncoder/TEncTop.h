@@ -43,12 +43,15 @@
 #include "TLibCommon/TComPrediction.h"
 #include "TLibCommon/TComTrQuant.h"
 #include "TLibCommon/AccessUnit.h"
+#include "TLibCommon/TComThreadPool.h"
 
 #include "TLibVideoIO/TVideoIOYuv.h"
 
 #include "TEncCfg.h"
 #include "TEncGOP.h"
 #include "TEncSlice.h"
+#include "TEncSliceWorker.h"
+#include "TEncFrameWorker.h"
 #include "TEncEntropy.h"
 #include "TEncCavlc.h"
 #include "TEncSbac.h"
@@ -115,6 +118,11 @@ private:
   TEncBinCABAC****        m_ppppcBinCodersCABAC;           ///< temporal CABAC state storage for RD computation per substream
   TEncBinCABAC*           m_pcRDGoOnBinCodersCABAC;        ///< going on bin coder CABAC for RD stage per substream
 
+  // multi-threading
+  TComThreadPool          m_cThreadPool;                   ///< worker threads
+  TEncSliceWorker*        m_pcSliceWorkers;                ///< CU-level coding tools, one set per thread
+  TEncFrameWorker*        m_pcFrameWorkers;                ///< slice encoders, one per picture compressed at the same time
+
   // quality control
   TEncPreanalyzer         m_cPreanalyzer;                 ///< image characteristics analyzer for TM5-step3-like adaptive QP
 
@@ -169,6 +177,9 @@ public:
   TEncSbac****            getRDSbacCoders       () { return  m_ppppcRDSbacCoders;     }
   TEncSbac*               getRDGoOnSbacCoders   () { return  m_pcRDGoOnSbacCoders;   }
   TEncRateCtrl*           getRateCtrl           () { return &m_cRateCtrl;             }
+  TComThreadPool*         getThreadPool         () { return &m_cThreadPool;           }
+  TEncSliceWorker*        getSliceWorker        ( Int iThreadIdx ) { return &m_pcSliceWorkers[iThreadIdx]; }
+  TEncFrameWorker*        getFrameWorker        ( Int iFrameIdx  ) { return &m_pcFrameWorkers[iFrameIdx];  }
   TComSPS*                getSPS                () { return  &m_cSPS;                 }
   TComPPS*                getPPS                () { return  &m_cPPS;                 }
   Void selectReferencePictureSet(TComSlice* slice, Int POCCurr, Int GOPid );
@@ -44,6 +44,7 @@
 #include <memory.h>
 
 #include "TLibCommon/TComRom.h"
+#include "TLibCommon/TComSimd.h"
 #include "TVideoIOYuv.h"
 
 using namespace std;
@@ -71,6 +72,169 @@ static const ComponentID CHANNEL_ORDER[2/*0 = GBR/YUV, 1 = RGB*/][2/*0 = normal,
 // Local Functions
 // ====================================================================================================================
 
+#if SIMD_X86
+// ====================================================================================================================
+// SIMD functions
+// ====================================================================================================================
+
+// The kernels handle 16-bit Pel and, with RExt__HIGH_BIT_DEPTH_SUPPORT, 32-bit Pel. File samples are little-endian,
+// as are the processors these kernels run on.
+
+/// number of Pel in a 128-bit vector
+static const UInt SIMD_PELS = UInt(sizeof(__m128i) / sizeof(Pel));
+
+/**
+ * Multiply all pixels of img by 2<sup>shiftbits</sup> with SSE4.1, see scalePlane().
+ */
+static SIMD_TARGET_SSE41 Void scalePlaneUpSSE41(Pel* img, const UInt stride, const UInt width, const UInt height, Int shiftbits)
+{
+  const __m128i vShift = _mm_cvtsi32_si128(shiftbits);
+
+  for (UInt y = 0; y < height; y++, img+=stride)
+  {
+    UInt x = 0;
+    for (; x + SIMD_PELS <= width; x += SIMD_PELS)
+    {
+      __m128i* p = (__m128i*)(img + x);
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+      _mm_storeu_si128(p, _mm_sll_epi32(_mm_loadu_si128(p), vShift));
+#else
+      _mm_storeu_si128(p, _mm_sll_epi16(_mm_loadu_si128(p), vShift));
+#endif
+    }
+    for (; x < width; x++)
+      img[x] <<= shiftbits;
+  }
+}
+
+/**
+ * Divide and round all pixels of img by 2<sup>shiftbits</sup> and clip with SSE4.1, see scalePlane().
+ * The rounding is done in 32-bit lanes, as the scalar code does in Int.
+ */
+static SIMD_TARGET_SSE41 Void scalePlaneDownSSE41(Pel* img, const UInt stride, const UInt width, const UInt height, Int shiftbits, Pel minval, Pel maxval)
+{
+  const Pel     rounding  = 1 << (shiftbits-1);
+  const __m128i vShift    = _mm_cvtsi32_si128(shiftbits);
+  const __m128i vRounding = _mm_set1_epi32(rounding);
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  const __m128i vMin      = _mm_set1_epi32(minval);
+  const __m128i vMax      = _mm_set1_epi32(maxval);
+#else
+  const __m128i vMin      = _mm_set1_epi16(minval);
+  const __m128i vMax      = _mm_set1_epi16(maxval);
+#endif
+
+  for (UInt y = 0; y < height; y++, img+=stride)
+  {
+    UInt x = 0;
+    for (; x + SIMD_PELS <= width; x += SIMD_PELS)
+    {
+      __m128i* p = (__m128i*)(img + x);
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+      const __m128i v  = _mm_sra_epi32(_mm_add_epi32(_mm_loadu_si128(p), vRounding), vShift);
+      _mm_storeu_si128(p, _mm_min_epi32(_mm_max_epi32(v, vMin), vMax));
+#else
+      const __m128i v  = _mm_loadu_si128(p);
+      const __m128i lo = _mm_sra_epi32(_mm_add_epi32(_mm_cvtepi16_epi32(v), vRounding), vShift);
+      const __m128i hi = _mm_sra_epi32(_mm_add_epi32(_mm_cvtepi16_epi32(_mm_unpackhi_epi64(v, v)), vRounding), vShift);
+      _mm_storeu_si128(p, _mm_min_epi16(_mm_max_epi16(_mm_packs_epi32(lo, hi), vMin), vMax));
+#endif
+    }
+    for (; x < width; x++)
+      img[x] = Clip3(minval, maxval, Pel((img[x] + rounding) >> shiftbits));
+  }
+}
+
+/**
+ * Convert a line of file samples to Pel with SSE4.1, as readPlane() does when the file and destination have the same
+ * horizontal subsampling.
+ */
+static SIMD_TARGET_SSE41 Void unpackLineSSE41(Pel* dst, const UChar* buf, const UInt width, const Bool is16bit)
+{
+  UInt x = 0;
+  if (!is16bit)
+  {
+    for (; x + 8 <= width; x += 8)
+    {
+      const __m128i v = _mm_loadl_epi64((const __m128i*)(buf + x));
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+      _mm_storeu_si128((__m128i*)(dst + x),     _mm_cvtepu8_epi32(v));
+      _mm_storeu_si128((__m128i*)(dst + x + 4), _mm_cvtepu8_epi32(_mm_srli_si128(v, 4)));
+#else
+      _mm_storeu_si128((__m128i*)(dst + x),     _mm_cvtepu8_epi16(v));
+#endif
+    }
+    for (; x < width; x++)
+      dst[x] = buf[x];
+  }
+  else
+  {
+    for (; x + 8 <= width; x += 8)
+    {
+      const __m128i v = _mm_loadu_si128((const __m128i*)(buf + 2*x));
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+      _mm_storeu_si128((__m128i*)(dst + x),     _mm_cvtepu16_epi32(v));
+      _mm_storeu_si128((__m128i*)(dst + x + 4), _mm_cvtepu16_epi32(_mm_unpackhi_epi64(v, v)));
+#else
+      _mm_storeu_si128((__m128i*)(dst + x),     v);
+#endif
+    }
+    for (; x < width; x++)
+      dst[x] = Pel(buf[x*2+0]) | (Pel(buf[x*2+1])<<8);
+  }
+}
+
+/**
+ * Convert a line of Pel to file samples with SSE4.1, as writePlane() does when the source and file have the same
+ * horizontal subsampling. Samples are truncated to 8 or 16 bits, as in the scalar code.
+ */
+static SIMD_TARGET_SSE41 Void packLineSSE41(UChar* buf, const Pel* src, const UInt width, const Bool is16bit)
+{
+  UInt x = 0;
+  if (!is16bit)
+  {
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+    const __m128i vMask = _mm_set1_epi32(0xff);
+#else
+    const __m128i vMask = _mm_set1_epi16(0xff);
+#endif
+    for (; x + 8 <= width; x += 8)
+    {
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+      const __m128i v = _mm_packus_epi32(_mm_and_si128(_mm_loadu_si128((const __m128i*)(src + x)),     vMask),
+                                         _mm_and_si128(_mm_loadu_si128((const __m128i*)(src + x + 4)), vMask));
+#else
+      const __m128i v = _mm_and_si128(_mm_loadu_si128((const __m128i*)(src + x)), vMask);
+#endif
+      _mm_storel_epi64((__m128i*)(buf + x), _mm_packus_epi16(v, v));
+    }
+    for (; x < width; x++)
+      buf[x] = (UChar)(src[x]);
+  }
+  else
+  {
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+    const __m128i vMask = _mm_set1_epi32(0xffff);
+#endif
+    for (; x + 8 <= width; x += 8)
+    {
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+      const __m128i v = _mm_packus_epi32(_mm_and_si128(_mm_loadu_si128((const __m128i*)(src + x)),     vMask),
+                                         _mm_and_si128(_mm_loadu_si128((const __m128i*)(src + x + 4)), vMask));
+#else
+      const __m128i v = _mm_loadu_si128((const __m128i*)(src + x));
+#endif
+      _mm_storeu_si128((__m128i*)(buf + 2*x), v);
+    }
+    for (; x < width; x++)
+    {
+      buf[2*x  ] = (src[x]>>0) & 0xff;
+      buf[2*x+1] = (src[x]>>8) & 0xff;
+    }
+  }
+}
+#endif
+
 /**
  * Scale all pixels in img depending upon sign of shiftbits by a factor of
  * 2<sup>shiftbits</sup>.
@@ -88,6 +252,21 @@ static const ComponentID CHANNEL_ORDER[2/*0 = GBR/YUV, 1 = RGB*/][2/*0 = normal,
  */
 static Void scalePlane(Pel* img, const UInt stride, const UInt width, const UInt height, Int shiftbits, Pel minval, Pel maxval)
 {
+#if SIMD_X86
+  if (shiftbits != 0 && TComSimd::getLevel() != SIMD_SCALAR)
+  {
+    if (shiftbits > 0)
+    {
+      scalePlaneUpSSE41(img, stride, width, height, shiftbits);
+    }
+    else
+    {
+      scalePlaneDownSSE41(img, stride, width, height, -shiftbits, minval, maxval);
+    }
+    return;
+  }
+#endif
+
   if (shiftbits > 0)
   {
     for (UInt y = 0; y < height; y++, img+=stride)
@@ -335,6 +514,13 @@ static Bool readPlane(Pel* dst,
         {
           // eg file is 422, dest is 444.
           const UInt sx=csx_file-csx_dest;
+#if SIMD_X86
+          if (sx==0 && TComSimd::getLevel() != SIMD_SCALAR)
+          {
+            unpackLineSSE41(dst, buf, width_dest, is16bit);
+          }
+          else
+#endif
           if (!is16bit)
           {
             for (UInt x = 0; x < width_dest; x++)
@@ -463,6 +649,13 @@ static Bool writePlane(ostream& fd, Pel* src, Bool is16bit,
         {
           // eg file is 422, src is 444.
           const UInt sx=csx_file-csx_src;
+#if SIMD_X86
+          if (sx==0 && TComSimd::getLevel() != SIMD_SCALAR)
+          {
+            packLineSSE41(buf, src, width_file, is16bit);
+          }
+          else
+#endif
           if (!is16bit)
           {
             for (UInt x = 0; x < width_file; x++)